@@ -316,12 +316,27 @@ eae6320::cResult eae6320::Application::cbApplication::PopulateGraphicsInitializa
 {
 	EAE6320_ASSERT( m_mainWindow != NULL );
 	o_initializationParameters.mainWindow = m_mainWindow;
-#if defined( EAE6320_PLATFORM_D3D )
-	o_initializationParameters.resolutionWidth = m_resolutionWidth;
-	o_initializationParameters.resolutionHeight = m_resolutionHeight;
-#elif defined( EAE6320_PLATFORM_GL )
+#if defined( EAE6320_PLATFORM_GL )
 	o_initializationParameters.thisInstanceOfTheApplication = m_thisInstanceOfTheApplication;
 #endif
+	o_initializationParameters.resolutionWidth = m_resolutionWidth;
+	o_initializationParameters.resolutionHeight = m_resolutionHeight;
+	// Override the default texture memory budget with the user's desired one
+	{
+		uint32_t textureMemoryBudget_inMegabytes;
+		if ( UserSettings::GetTextureMemoryBudget( textureMemoryBudget_inMegabytes ) )
+		{
+			o_initializationParameters.textureMemoryBudget = static_cast<size_t>( textureMemoryBudget_inMegabytes ) * 1024 * 1024;
+		}
+	}
+	// Asset retention caches are only used if the user's settings ask for them
+	{
+		uint32_t assetCacheBudget_inMegabytes;
+		if ( UserSettings::GetAssetCacheBudget( assetCacheBudget_inMegabytes ) )
+		{
+			o_initializationParameters.assetCacheBudget = static_cast<size_t>( assetCacheBudget_inMegabytes ) * 1024 * 1024;
+		}
+	}
 	return Results::Success;
 }
 
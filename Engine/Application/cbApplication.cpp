@@ -6,10 +6,52 @@
 #include <algorithm>
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/AsyncLoading.h>
+#include <Engine/Assets/ContentManifest.h>
+#include <Engine/Assets/ManagerContentionBenchmark.h>
+#include <Engine/Assets/PrefetchProfile.h>
+#include <Engine/Assets/UploadQueueCheck.h>
+#include <Engine/Concurrency/BackgroundThrottling.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Concurrency/JobSystem.h>
+#include <Engine/Concurrency/LockStressTest.h>
+#include <Engine/Concurrency/MutexProfiling.h>
+#include <Engine/Concurrency/ParallelReduceCheck.h>
+#include <Engine/Concurrency/QueueThroughputBenchmark.h>
+#include <Engine/Concurrency/WakeLatencyBenchmark.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Platform/AsyncFileIo.h>
+#include <Engine/Platform/AsyncFileIoBenchmark.h>
+#include <Engine/Platform/Platform.h>
 #include <Engine/Time/Time.h>
 #include <Engine/UserOutput/UserOutput.h>
+#include <Engine/UserSettings/UserSettings.h>
+#include <string>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// This is in the same directory as the user settings file
+	constexpr auto* const s_prefetchProfilePath = "PrefetchProfile.txt";
+	// This is written by the asset build
+	constexpr auto* const s_contentManifestPath = "data/ContentManifest.bin";
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// The kinds of threads are the same ones that the user settings use
+	// (see UserSettings::GetThreadOptions()),
+	// and any options that the user settings specify replace the defaults
+	eae6320::Concurrency::sThreadOptions GetThreadOptions( const char* const i_threadKind );
+	// Each benchmark outputs its results to the log
+	void RunBenchmarks();
+}
 
 // Interface
 //==========
@@ -185,6 +227,10 @@ void eae6320::Application::cbApplication::UpdateUntilExit()
 		// Submit data for the render thread to use to render a new frame
 		// after it has finished rendering the current frame with the previously-submitted data
 		{
+			// Report how long this iteration's work took
+			// (before waiting for the render thread, which isn't work)
+			Concurrency::BackgroundThrottling::ReportFrameWorkTime( Concurrency::BackgroundThrottling::eFrameThread::Application,
+				Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - m_tickCount_systemTime_current ) );
 			// Wait until the render thread is ready to accept new submitted data
 			{
 				// Conceptually the wait is infinite
@@ -276,18 +322,80 @@ eae6320::cResult eae6320::Application::cbApplication::Initialize_all( const sEnt
 		EAE6320_ASSERT( false );
 		goto OnExit;
 	}
+	// The thread that initializes the application is the render thread
+	{
+		if ( !( result = Concurrency::ApplyOptionsToCurrentThread( GetThreadOptions( "Render" ) ) ) )
+		{
+			EAE6320_ASSERT( false );
+			goto OnExit;
+		}
+	}
+	// Initialize background throttling before any background work (including prefetching) starts
+	if ( result = Concurrency::BackgroundThrottling::Initialize() )
+	{
+		Concurrency::BackgroundThrottling::SetFrameDeadline( GetTargetFramePeriod_inSeconds() );
+	}
+	else
+	{
+		EAE6320_ASSERT( false );
+		goto OnExit;
+	}
+	// Mount asset packages and start prefetching next
+	// so that files are read while the window and engine are initialized
+	{
+		// If the asset build put assets into packages they are loaded from there,
+		// and otherwise they are loaded from loose files
+		{
+			std::string errorMessage;
+			if ( !Platform::MountPackagesInDirectory( "data/", &errorMessage ) )
+			{
+				// This isn't fatal because loose files can still be used
+				Logging::OutputError( "Asset packages couldn't be mounted (loose files will be used instead): %s", errorMessage.c_str() );
+			}
+		}
+		// Prefetching is only used if the user's settings ask for it
+		bool shouldAssetsBePrefetched;
+		if ( UserSettings::GetShouldAssetsBePrefetched( shouldAssetsBePrefetched ) && shouldAssetsBePrefetched )
+		{
+			if ( !Assets::PrefetchProfile::Initialize( s_prefetchProfilePath ) )
+			{
+				// This isn't fatal because the assets can still be loaded without being prefetched
+				Logging::OutputError( "Asset prefetching couldn't be started" );
+			}
+		}
+	}
 	// Initialize the new application instance with entry point parameters
 	if ( !( result = Initialize_base( i_entryPointParameters ) ) )
 	{
 		EAE6320_ASSERT( false );
 		goto OnExit;
 	}
+	// The ParallelReduce() check initializes the job system itself with different numbers of worker threads,
+	// and so it is run before the engine is initialized
+	{
+		bool shouldBenchmarksBeRun;
+		if ( UserSettings::GetShouldBenchmarksBeRun( shouldBenchmarksBeRun ) && shouldBenchmarksBeRun )
+		{
+			// This isn't fatal because it is only informational
+			Concurrency::ParallelReduceCheck::LogReport( GetThreadOptions( "Worker" ) );
+		}
+	}
 	// Initialize engine systems
 	if ( !( result = Initialize_engine() ) )
 	{
 		EAE6320_ASSERT( false );
 		goto OnExit;
 	}
+	// The benchmarks are only run if the user's settings ask for it
+	// (they run before the application loop thread starts so that nothing else is competing with them)
+	{
+		bool shouldBenchmarksBeRun;
+		if ( UserSettings::GetShouldBenchmarksBeRun( shouldBenchmarksBeRun ) && shouldBenchmarksBeRun )
+		{
+			// This isn't fatal because it is only informational
+			RunBenchmarks();
+		}
+	}
 	// Initialize the derived application
 	if ( !( result = Initialize() ) )
 	{
@@ -296,7 +404,7 @@ eae6320::cResult eae6320::Application::cbApplication::Initialize_all( const sEnt
 	}
 
 	// Start the application loop thread
-	if ( !( result = m_applicationLoopThread.Start( EntryPoint_applicationLoopThread, this ) ) )
+	if ( !( result = m_applicationLoopThread.Start( EntryPoint_applicationLoopThread, this, GetThreadOptions( "Application" ) ) ) )
 	{
 		EAE6320_ASSERT( false );
 		Logging::OutputError( "The application loop thread couldn't be started" );
@@ -329,6 +437,46 @@ eae6320::cResult eae6320::Application::cbApplication::Initialize_engine()
 			goto OnExit;
 		}
 	}
+	// Job System
+	{
+		constexpr unsigned int useDefaultWorkerThreadCount = 0;
+		if ( !( result = Concurrency::JobSystem::Initialize( useDefaultWorkerThreadCount, GetThreadOptions( "Worker" ) ) ) )
+		{
+			EAE6320_ASSERT( false );
+			goto OnExit;
+		}
+	}
+	// Asynchronous File I/O
+	{
+		constexpr unsigned int ioThreadCount = 4;
+		if ( !( result = Platform::AsyncFileIo::Initialize( ioThreadCount, GetThreadOptions( "Background" ) ) ) )
+		{
+			EAE6320_ASSERT( false );
+			goto OnExit;
+		}
+	}
+	// Asynchronous Loading
+	{
+		// This thread is the render thread,
+		// and so it is the one that creates the platform-specific objects for assets that are loaded asynchronously
+		constexpr unsigned int workerThreadCount = 2;
+		constexpr size_t uploadByteBudgetPerFrame = 8 * 1024 * 1024;
+		if ( !( result = Assets::AsyncLoading::Initialize( workerThreadCount, uploadByteBudgetPerFrame, GetThreadOptions( "Background" ) ) ) )
+		{
+			EAE6320_ASSERT( false );
+			goto OnExit;
+		}
+	}
+	// Content Manifest
+	{
+		// The asset managers use this to share assets with identical contents,
+		// and so it must be loaded before Graphics initializes them
+		if ( !( result = Assets::ContentManifest::Initialize( s_contentManifestPath ) ) )
+		{
+			EAE6320_ASSERT( false );
+			goto OnExit;
+		}
+	}
 	// Graphics
 	{
 		Graphics::sInitializationParameters initializationParameters;
@@ -414,6 +562,35 @@ eae6320::cResult eae6320::Application::cbApplication::CleanUp_all()
 			}
 		}
 	}
+	// Stop prefetching (which records this session's profile) and unmount asset packages
+	// now that nothing else can load files
+	{
+		const auto localResult = Assets::PrefetchProfile::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+		Platform::UnmountAllPackages();
+	}
+	// Clean up background throttling now that every thread that does background work has stopped
+	{
+		const auto localResult = Concurrency::BackgroundThrottling::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// Report how contended the named mutexes were now that every thread that used them has stopped
+	// (this doesn't do anything unless mutex profiling is enabled)
+	Concurrency::MutexProfiling::LogReport();
 	// Clean up time second-to-last in case any clean up times are measured
 	{
 		const auto localResult = Time::CleanUp();
@@ -446,6 +623,32 @@ eae6320::cResult eae6320::Application::cbApplication::CleanUp_engine()
 {
 	auto result = Results::Success;
 
+	// Job System
+	{
+		// Any jobs that are still running finish before the systems that they use are cleaned up
+		const auto localResult = Concurrency::JobSystem::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// Asynchronous Loading
+	{
+		// Any loads that are still in progress finish before Graphics is cleaned up
+		const auto localResult = Assets::AsyncLoading::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
 	// Graphics
 	{
 		const auto localResult = Graphics::CleanUp();
@@ -458,6 +661,33 @@ eae6320::cResult eae6320::Application::cbApplication::CleanUp_engine()
 			}
 		}
 	}
+	// Content Manifest
+	{
+		// Every asset has been released once Graphics has been cleaned up,
+		// and so this reports how much memory sharing assets saved during the whole session
+		const auto localResult = Assets::ContentManifest::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// Asynchronous File I/O
+	{
+		// Texture streaming cancels its requests when Graphics is cleaned up
+		const auto localResult = Platform::AsyncFileIo::CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
 	// User Output
 	{
 		const auto localResult = UserOutput::CleanUp();
@@ -473,3 +703,47 @@ eae6320::cResult eae6320::Application::cbApplication::CleanUp_engine()
 
 	return result;
 }
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::Concurrency::sThreadOptions GetThreadOptions( const char* const i_threadKind )
+	{
+		eae6320::Concurrency::sThreadOptions threadOptions;
+		const std::string threadKind = i_threadKind;
+		if ( ( threadKind == "Render" ) || ( threadKind == "Application" ) )
+		{
+			threadOptions.name = ( threadKind == "Render" ) ? "Render" : "Application Loop";
+			// A frame isn't finished until both of these threads have done their work,
+			// and so they shouldn't have to wait for background work
+			threadOptions.priority = eae6320::Concurrency::eThreadPriority::AboveNormal;
+			// Each one is kept on its own physical core
+			// (logical processors on the same core would compete for its execution units),
+			// but only if that would leave at least one other core for everything else
+			if ( eae6320::Concurrency::GetPhysicalCoreCount() >= 3 )
+			{
+				threadOptions.affinityMask = eae6320::Concurrency::GetPhysicalCoreAffinityMask( ( threadKind == "Render" ) ? 0 : 1 );
+			}
+		}
+		else if ( threadKind == "Background" )
+		{
+			// Loading can take longer than a frame anyway
+			threadOptions.priority = eae6320::Concurrency::eThreadPriority::BelowNormal;
+		}
+		eae6320::UserSettings::GetThreadOptions( i_threadKind, threadOptions );
+		return threadOptions;
+	}
+
+	void RunBenchmarks()
+	{
+		eae6320::Logging::OutputMessage( "Running the startup benchmarks" );
+		eae6320::Concurrency::WakeLatencyBenchmark::LogReport();
+		eae6320::Concurrency::QueueThroughputBenchmark::LogReport();
+		eae6320::Concurrency::LockStressTest::LogReport();
+		eae6320::Assets::ManagerContentionBenchmark::LogReport();
+		eae6320::Assets::UploadQueueCheck::LogReport();
+		eae6320::Platform::AsyncFileIoBenchmark::LogReport();
+	}
+}
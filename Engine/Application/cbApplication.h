@@ -136,6 +136,12 @@ namespace eae6320
 			// and observe the change in responsiveness or simulation accuracy.
 			virtual float GetSimulationUpdatePeriod_inSeconds() const { return 1.0f / 15.0f; }
 
+			// Background work (e.g. asynchronous loading) is throttled
+			// when the application loop or render thread is close to taking longer than this to finish a frame
+			// (see BackgroundThrottling.h).
+			// The default value is for 60 frames per second.
+			virtual float GetTargetFramePeriod_inSeconds() const { return 1.0f / 60.0f; }
+
 			// Run
 			//----
 
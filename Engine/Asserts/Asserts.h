@@ -24,8 +24,10 @@
 
 	#include <sstream>
 
-	#ifdef EAE6320_PLATFORM_WINDOWS
+	#if defined( EAE6320_PLATFORM_WINDOWS )
 		#include <intrin.h>
+	#elif defined( EAE6320_PLATFORM_POSIX )
+		#include <csignal>
 	#endif
 
 #endif
@@ -54,6 +56,9 @@
 	// but then the debugger would break in Asserts.cpp rather than in the file where the failed assert is
 	#if defined( EAE6320_PLATFORM_WINDOWS )
 		#define EAE6320_ASSERTS_BREAK __debugbreak()
+	#elif defined( EAE6320_PLATFORM_POSIX )
+		// A debugger stops on this signal, and without one the program exits
+		#define EAE6320_ASSERTS_BREAK std::raise( SIGTRAP )
 	#else
 		#error "No implementation exists for breaking in the debugger when an assert fails"
 	#endif
@@ -67,12 +72,15 @@
 			EAE6320_ASSERTS_BREAK;	\
 		}	\
 	}
-	#define EAE6320_ASSERTF( i_assertion, i_messageToDisplayWhenAssertionIsFalse, ... )	\
+	// The message is part of the variable arguments
+	// so that a message without any insertions doesn't leave a trailing comma
+	// (which only some compilers remove)
+	#define EAE6320_ASSERTF( i_assertion, ... )	\
 	{	\
 		static bool shouldThisAssertBeIgnored = false;	\
 		if ( !shouldThisAssertBeIgnored && !static_cast<bool>( i_assertion ) \
 			&& eae6320::Asserts::ShowMessageIfAssertionIsFalseAndReturnWhetherToBreak( __LINE__, __FILE__,	\
-				shouldThisAssertBeIgnored, i_messageToDisplayWhenAssertionIsFalse, __VA_ARGS__ ) )	\
+				shouldThisAssertBeIgnored, __VA_ARGS__ ) )	\
 		{	\
 			EAE6320_ASSERTS_BREAK;	\
 		}	\
@@ -80,7 +88,7 @@
 #else
 	// The macros do nothing when asserts aren't enabled
 	#define EAE6320_ASSERT( i_assertion )
-	#define EAE6320_ASSERTF( i_assertion, i_messageToDisplayWhenAssertionIsFalse, ... )
+	#define EAE6320_ASSERTF( i_assertion, ... )
 #endif
 
 #endif	// EAE6320_ASSERTS_H
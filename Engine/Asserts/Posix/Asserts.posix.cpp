@@ -0,0 +1,27 @@
+// Include Files
+//==============
+
+#include "../Asserts.h"
+
+#ifdef EAE6320_ASSERTS_AREENABLED
+	#include <cstdio>
+#endif
+
+// Helper Function Definitions
+//============================
+
+#ifdef EAE6320_ASSERTS_AREENABLED
+
+bool eae6320::Asserts::ShowMessageIfAssertionIsFalseAndReturnWhetherToBreak_platformSpecific(
+	std::ostringstream& io_message, bool& io_shouldThisAssertBeIgnoredInTheFuture )
+{
+	// There is no standard way to ask the user what to do,
+	// and so the message is written to the standard error stream and the code always breaks
+	io_message << "\n";
+	std::fputs( io_message.str().c_str(), stderr );
+	std::fflush( stderr );
+	io_shouldThisAssertBeIgnoredInTheFuture = false;
+	return true;
+}
+
+#endif	// EAE6320_ASSERTS_AREENABLED
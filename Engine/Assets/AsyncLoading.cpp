@@ -0,0 +1,376 @@
+// Include Files
+//==============
+
+#include "AsyncLoading.h"
+
+#include <algorithm>
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Logging/Logging.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Jobs waiting to be run by a worker thread, one queue for every priority
+	std::deque<eae6320::Assets::AsyncLoading::fJob> s_backgroundJobs[static_cast<size_t>( eae6320::Assets::AsyncLoading::ePriority::Count )];
+	// Jobs waiting to be run by the render thread
+	std::vector<eae6320::Assets::AsyncLoading::fJob> s_renderThreadJobs;
+	// Uploads waiting to be run by the render thread within the per-frame budget
+	eae6320::Assets::cUploadQueue s_uploadQueue;
+	eae6320::Concurrency::cMutex s_jobsMutex{ "Assets::AsyncLoading" };
+	eae6320::Concurrency::cEvent s_whenBackgroundJobsArePending;
+	// This is signaled every time that the render thread runs jobs
+	// so that threads waiting for a load to finish can check again
+	eae6320::Concurrency::cEvent s_whenRenderThreadJobsHaveRun;
+
+	constexpr unsigned int s_maxWorkerThreadCount = 8;
+	eae6320::Concurrency::cThread s_workerThreads[s_maxWorkerThreadCount];
+	unsigned int s_workerThreadCount = 0;
+	bool s_shouldWorkerThreadsExit = false;
+
+	std::thread::id s_renderThreadId;
+	bool s_isInitialized = false;
+
+	// Waiting for progress on other threads times out periodically
+	// in case the event was signaled for a different waiting thread
+	constexpr unsigned int s_maxTimeToWaitForProgress_inMilliseconds = 5;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void EntryPoint_workerThread( void* const io_userData );
+}
+
+// Interface
+//==========
+
+// Jobs
+//-----
+
+void eae6320::Assets::AsyncLoading::QueueBackgroundJob( const fJob& i_job, const ePriority i_priority )
+{
+	EAE6320_ASSERT( i_priority < ePriority::Count );
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+		if ( s_isInitialized )
+		{
+			s_backgroundJobs[static_cast<size_t>( i_priority )].push_back( i_job );
+			const auto result = s_whenBackgroundJobsArePending.Signal();
+			EAE6320_ASSERT( result );
+			return;
+		}
+	}
+	i_job();
+}
+
+void eae6320::Assets::AsyncLoading::QueueRenderThreadJob( const fJob& i_job )
+{
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+		if ( s_isInitialized )
+		{
+			s_renderThreadJobs.push_back( i_job );
+			return;
+		}
+	}
+	i_job();
+}
+
+eae6320::Assets::cUploadQueue& eae6320::Assets::AsyncLoading::GetUploadQueue()
+{
+	return s_uploadQueue;
+}
+
+// Render Thread
+//--------------
+
+void eae6320::Assets::AsyncLoading::RunRenderThreadJobs()
+{
+	EAE6320_ASSERTF( IsRenderThread(), "Render thread jobs can only be run by the render thread" );
+	std::vector<fJob> jobs;
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+		std::swap( jobs, s_renderThreadJobs );
+	}
+	for ( const auto& job : jobs )
+	{
+		job();
+	}
+	// Uploads are run after the other jobs
+	// so that any uploads that those jobs queue can be run this frame
+	const auto hadUploads = !s_uploadQueue.IsEmpty();
+	s_uploadQueue.Service();
+	if ( !jobs.empty() || hadUploads )
+	{
+		s_whenRenderThreadJobsHaveRun.Signal();
+	}
+}
+
+bool eae6320::Assets::AsyncLoading::IsRenderThread()
+{
+	return !s_isInitialized || ( std::this_thread::get_id() == s_renderThreadId );
+}
+
+// Waiting
+//--------
+
+void eae6320::Assets::AsyncLoading::WaitForProgress()
+{
+	if ( IsRenderThread() )
+	{
+		RunRenderThreadJobs();
+		// Give the worker threads a chance to finish something before checking again
+		std::this_thread::yield();
+	}
+	else
+	{
+		Concurrency::WaitForEvent( s_whenRenderThreadJobsHaveRun, s_maxTimeToWaitForProgress_inMilliseconds );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::AsyncLoading::Initialize( const unsigned int i_workerThreadCount, const size_t i_uploadByteBudgetPerFrame,
+	const Concurrency::sThreadOptions& i_threadOptions )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !s_isInitialized, "Asynchronous loading has already been initialized" );
+	s_shouldWorkerThreadsExit = false;
+	s_renderThreadId = std::this_thread::get_id();
+
+	if ( !( result = s_whenBackgroundJobsArePending.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the asynchronous loading event" );
+		Logging::OutputError( "Failed to initialize the event that signals asynchronous loading jobs" );
+		goto OnExit;
+	}
+	if ( !( result = s_whenRenderThreadJobsHaveRun.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the asynchronous loading event" );
+		Logging::OutputError( "Failed to initialize the event that signals asynchronous loading progress" );
+		goto OnExit;
+	}
+	if ( !( result = s_uploadQueue.Initialize( i_uploadByteBudgetPerFrame ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the upload queue" );
+		Logging::OutputError( "Failed to initialize the asynchronous loading upload queue" );
+		goto OnExit;
+	}
+	{
+		const auto workerThreadCount = std::min( std::max( i_workerThreadCount, 1u ), s_maxWorkerThreadCount );
+		for ( s_workerThreadCount = 0; s_workerThreadCount < workerThreadCount; ++s_workerThreadCount )
+		{
+			const auto threadName = std::string( i_threadOptions.name ? i_threadOptions.name : "Asynchronous Loading" ) + " " + std::to_string( s_workerThreadCount + 1 );
+			auto threadOptions = i_threadOptions;
+			threadOptions.name = threadName.c_str();
+			if ( !( result = s_workerThreads[s_workerThreadCount].Start( EntryPoint_workerThread, nullptr, threadOptions ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start an asynchronous loading thread" );
+				Logging::OutputError( "Failed to start asynchronous loading thread #%u", s_workerThreadCount );
+				goto OnExit;
+			}
+		}
+	}
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+		s_isInitialized = true;
+	}
+	Logging::OutputMessage( "Asynchronous loading was initialized with %u worker threads and an upload budget of %u KB per frame",
+		s_workerThreadCount, static_cast<unsigned int>( i_uploadByteBudgetPerFrame / 1024 ) );
+
+OnExit:
+
+	if ( !result )
+	{
+		const auto localResult = CleanUp();
+		EAE6320_ASSERT( localResult );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::AsyncLoading::CleanUp()
+{
+	auto result = Results::Success;
+
+	// Stop the worker threads
+	// (they keep running jobs until there aren't any left)
+	if ( s_workerThreadCount > 0 )
+	{
+		{
+			Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+			s_shouldWorkerThreadsExit = true;
+		}
+		if ( s_whenBackgroundJobsArePending.Signal() )
+		{
+			for ( unsigned int i = 0; i < s_workerThreadCount; ++i )
+			{
+				// While the workers finish their jobs they may be queueing render thread jobs
+				// that other threads are waiting for
+				while ( true )
+				{
+					constexpr unsigned int timeToWait_inMilliseconds = 10;
+					const auto localResult = Concurrency::WaitForThreadToStop( s_workerThreads[i], timeToWait_inMilliseconds );
+					if ( localResult )
+					{
+						break;
+					}
+					else if ( localResult == Results::TimeOut )
+					{
+						RunRenderThreadJobs();
+					}
+					else
+					{
+						EAE6320_ASSERTF( false, "Couldn't wait for an asynchronous loading thread to stop" );
+						Logging::OutputError( "Failed to wait for asynchronous loading thread #%u to stop", i );
+						if ( result )
+						{
+							result = localResult;
+						}
+						break;
+					}
+				}
+			}
+		}
+		s_workerThreadCount = 0;
+	}
+	// Run any jobs that are left
+	{
+		{
+			Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+			s_isInitialized = false;
+		}
+		std::deque<fJob> backgroundJobs[static_cast<size_t>( ePriority::Count )];
+		std::vector<fJob> renderThreadJobs;
+		{
+			Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+			for ( size_t i = 0; i < static_cast<size_t>( ePriority::Count ); ++i )
+			{
+				std::swap( backgroundJobs[i], s_backgroundJobs[i] );
+			}
+			std::swap( renderThreadJobs, s_renderThreadJobs );
+		}
+		// Since asynchronous loading is no longer initialized
+		// any render thread jobs that these queue will be run immediately
+		for ( const auto& jobs : backgroundJobs )
+		{
+			for ( const auto& job : jobs )
+			{
+				job();
+			}
+		}
+		for ( const auto& job : renderThreadJobs )
+		{
+			job();
+		}
+		// Any uploads that are still queued are run regardless of the budget
+		const auto localResult = s_uploadQueue.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	{
+		const auto localResult = s_whenBackgroundJobsArePending.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	{
+		const auto localResult = s_whenRenderThreadJobsHaveRun.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void EntryPoint_workerThread( void* const io_userData )
+	{
+		while ( true )
+		{
+			const auto result = eae6320::Concurrency::WaitForEvent( s_whenBackgroundJobsArePending );
+			if ( !result )
+			{
+				EAE6320_ASSERTF( false, "Waiting for asynchronous loading jobs failed" );
+				eae6320::Logging::OutputError( "An asynchronous loading thread failed to wait for jobs and will exit" );
+				return;
+			}
+			// Run jobs until there aren't any left
+			while ( true )
+			{
+				eae6320::Assets::AsyncLoading::fJob job;
+				auto priority = eae6320::Assets::AsyncLoading::ePriority::Count;
+				{
+					eae6320::Concurrency::cMutex::cScopeLock autoLock( s_jobsMutex );
+					// Find the highest priority job
+					for ( size_t i = 0; i < static_cast<size_t>( eae6320::Assets::AsyncLoading::ePriority::Count ); ++i )
+					{
+						if ( !s_backgroundJobs[i].empty() )
+						{
+							priority = static_cast<eae6320::Assets::AsyncLoading::ePriority>( i );
+							break;
+						}
+					}
+					if ( priority == eae6320::Assets::AsyncLoading::ePriority::Count )
+					{
+						if ( s_shouldWorkerThreadsExit )
+						{
+							// The event resets automatically,
+							// and so it must be signaled again for the next worker thread to see that it should exit
+							s_whenBackgroundJobsArePending.Signal();
+							return;
+						}
+						break;
+					}
+					auto& backgroundJobs = s_backgroundJobs[static_cast<size_t>( priority )];
+					job = std::move( backgroundJobs.front() );
+					backgroundJobs.pop_front();
+					// If there are more jobs another worker thread can start on them
+					if ( std::any_of( std::begin( s_backgroundJobs ), std::end( s_backgroundJobs ),
+						[]( const std::deque<eae6320::Assets::AsyncLoading::fJob>& i_backgroundJobs ) { return !i_backgroundJobs.empty(); } ) )
+					{
+						s_whenBackgroundJobsArePending.Signal();
+					}
+				}
+				// If the frame is close to missing its deadline the job waits
+				// (while any other worker threads can still run higher priority jobs)
+				eae6320::Concurrency::BackgroundThrottling::WaitUntilWorkIsAllowed( priority );
+				job();
+			}
+		}
+	}
+}
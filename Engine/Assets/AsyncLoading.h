@@ -0,0 +1,88 @@
+/*
+	Asynchronous loading lets assets be loaded without blocking the thread that requested them
+
+	Loading an asset asynchronously happens in two steps:
+		* The file is read and parsed by a background worker thread
+		* The platform-specific objects (e.g. GPU buffers) are created by the render thread
+			through an upload queue that limits how many bytes are uploaded every frame
+	Asset managers use this to implement cManager::LoadAsync()
+	(see cManager.h for the requirements that an asset type must meet).
+*/
+
+#ifndef EAE6320_ASSETS_ASYNCLOADING_H
+#define EAE6320_ASSETS_ASYNCLOADING_H
+
+// Include Files
+//==============
+
+#include "cUploadQueue.h"
+
+#include <cstddef>
+#include <Engine/Concurrency/BackgroundThrottling.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Results/Results.h>
+#include <functional>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace AsyncLoading
+		{
+			using fJob = std::function<void()>;
+			using ePriority = Concurrency::BackgroundThrottling::ePriority;
+
+			// Jobs
+			//-----
+
+			// The job will be run by a background worker thread
+			// (if asynchronous loading hasn't been initialized it is run immediately).
+			// Higher priority jobs are run first,
+			// and jobs whose priority is being throttled wait before they are run (see BackgroundThrottling.h).
+			void QueueBackgroundJob( const fJob& i_job, const ePriority i_priority = ePriority::Normal );
+			// The job will be run by the render thread the next time that it calls RunRenderThreadJobs()
+			// (if asynchronous loading hasn't been initialized it is run immediately)
+			void QueueRenderThreadJob( const fJob& i_job );
+			// Jobs that upload data to the GPU should be queued here instead
+			// so that the number of bytes uploaded every frame is limited
+			// (the upload queue is serviced by RunRenderThreadJobs(),
+			// and if asynchronous loading hasn't been initialized uploads are run immediately)
+			cUploadQueue& GetUploadQueue();
+
+			// Render Thread
+			//--------------
+
+			// This must be called regularly by the render thread
+			// (Graphics::RenderFrame() does this every frame)
+			void RunRenderThreadJobs();
+			// The render thread is the thread that called Initialize()
+			bool IsRenderThread();
+
+			// Waiting
+			//--------
+
+			// This is called by code that is waiting for a load to finish.
+			// On the render thread it runs any render thread jobs (so that waiting can't deadlock),
+			// and on any other thread it waits briefly for a job to finish.
+			void WaitForProgress();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// This must be called from the render thread.
+			// The upload budget can be changed later with GetUploadQueue().SetByteBudgetPerService().
+			// Every worker thread is started with the provided options
+			// (the thread's number is appended to the name).
+			cResult Initialize( const unsigned int i_workerThreadCount = 2, const size_t i_uploadByteBudgetPerFrame = 8 * 1024 * 1024,
+				const Concurrency::sThreadOptions& i_threadOptions = Concurrency::sThreadOptions() );
+			// Every job and upload that has been queued is run before this returns
+			// (and so this must also be called from the render thread while it can still create platform-specific objects)
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_ASYNCLOADING_H
@@ -0,0 +1,58 @@
+/*
+	These let a task (see Engine/Concurrency/cTask.h) move between the threads that asynchronous loading uses
+	(e.g. parse a file on a worker thread and then create its GPU objects on the render thread)
+
+	Coroutines must be enabled for every file that includes this header.
+*/
+
+#ifndef EAE6320_ASSETS_ASYNCLOADINGAWAITABLES_H
+#define EAE6320_ASSETS_ASYNCLOADINGAWAITABLES_H
+
+// Include Files
+//==============
+
+#include "AsyncLoading.h"
+
+#include <Engine/Concurrency/cTask.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace AsyncLoading
+		{
+			// Awaiting this resumes the task on the render thread the next time that it runs render thread jobs
+			// (or immediately if the task is already running on the render thread)
+			struct sResumeOnRenderThread
+			{
+				bool await_ready() const { return IsRenderThread(); }
+				void await_suspend( Concurrency::CoroutineLibrary::coroutine_handle<> i_coroutine )
+				{
+					QueueRenderThreadJob( [i_coroutine]() { i_coroutine.resume(); } );
+				}
+				void await_resume() const noexcept {}
+			};
+			inline sResumeOnRenderThread ResumeOnRenderThread() { return {}; }
+
+			// Awaiting this resumes the task on one of asynchronous loading's background worker threads
+			// (with the priority of a background job, see QueueBackgroundJob())
+			struct sResumeOnBackgroundThread
+			{
+				ePriority priority = ePriority::Normal;
+
+				bool await_ready() const noexcept { return false; }
+				void await_suspend( Concurrency::CoroutineLibrary::coroutine_handle<> i_coroutine )
+				{
+					QueueBackgroundJob( [i_coroutine]() { i_coroutine.resume(); }, priority );
+				}
+				void await_resume() const noexcept {}
+			};
+			inline sResumeOnBackgroundThread ResumeOnBackgroundThread( const ePriority i_priority = ePriority::Normal ) { return { i_priority }; }
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_ASYNCLOADINGAWAITABLES_H
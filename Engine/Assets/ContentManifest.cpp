@@ -0,0 +1,141 @@
+// Include Files
+//==============
+
+#include "ContentManifest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Package.h>
+#include <Engine/Platform/Platform.h>
+#include <string>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The entries are only changed by Initialize() and CleanUp()
+	// (which must not be called while assets are being loaded)
+	std::vector<eae6320::Assets::ContentManifest::sEntry> s_entries;
+
+	eae6320::Assets::ContentManifest::sStatistics s_statistics;
+	eae6320::Concurrency::cMutex s_statisticsMutex{ "Assets::ContentManifest" };
+}
+
+// Interface
+//==========
+
+// Run-Time
+//---------
+
+bool eae6320::Assets::ContentManifest::FindContent( const char* const i_path, sContent& o_content )
+{
+	if ( s_entries.empty() )
+	{
+		return false;
+	}
+	const auto pathHash = Platform::Package::CalculatePathHash( i_path, std::strlen( i_path ) );
+	const auto iterator = std::lower_bound( s_entries.begin(), s_entries.end(), pathHash,
+		[]( const sEntry& i_entry, const uint64_t i_pathHash ) { return i_entry.pathHash < i_pathHash; } );
+	if ( ( iterator != s_entries.end() ) && ( iterator->pathHash == pathHash ) )
+	{
+		o_content.hash = iterator->contentHash;
+		o_content.size = iterator->size;
+		return true;
+	}
+	return false;
+}
+
+void eae6320::Assets::ContentManifest::RecordSharedLoad( const size_t i_byteCount )
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_statisticsMutex );
+	++s_statistics.sharedLoadCount;
+	s_statistics.savedByteCount += i_byteCount;
+}
+
+eae6320::Assets::ContentManifest::sStatistics eae6320::Assets::ContentManifest::GetStatistics()
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_statisticsMutex );
+	return s_statistics;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::ContentManifest::Initialize( const char* const i_path )
+{
+	auto result = Results::Success;
+
+	Platform::sDataFromFile dataFromFile;
+	std::string errorMessage;
+
+	EAE6320_ASSERTF( s_entries.empty(), "The content manifest has already been initialized" );
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_statisticsMutex );
+		s_statistics = sStatistics();
+	}
+
+	if ( !Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) )
+	{
+		// Without a manifest every path is loaded separately
+		Logging::OutputMessage( "The content manifest %s couldn't be loaded, and so identical assets won't be shared: %s",
+			i_path, errorMessage.c_str() );
+		goto OnExit;
+	}
+	{
+		sHeader header;
+		if ( dataFromFile.size < sizeof( header ) )
+		{
+			result = Results::InvalidFile;
+			goto OnExit;
+		}
+		std::memcpy( &header, dataFromFile.data, sizeof( header ) );
+		if ( ( header.signature != s_signature ) || ( header.version != s_version )
+			|| ( ( dataFromFile.size - sizeof( header ) ) / sizeof( sEntry ) ) < header.entryCount )
+		{
+			result = Results::InvalidFile;
+			goto OnExit;
+		}
+		s_entries.resize( header.entryCount );
+		std::memcpy( s_entries.data(), static_cast<const uint8_t*>( dataFromFile.data ) + sizeof( header ), header.entryCount * sizeof( sEntry ) );
+		if ( !std::is_sorted( s_entries.begin(), s_entries.end(),
+			[]( const sEntry& i_lhs, const sEntry& i_rhs ) { return i_lhs.pathHash < i_rhs.pathHash; } ) )
+		{
+			result = Results::InvalidFile;
+			goto OnExit;
+		}
+	}
+	Logging::OutputMessage( "The content manifest %s lists %u built files", i_path, static_cast<unsigned int>( s_entries.size() ) );
+
+OnExit:
+
+	if ( result == Results::InvalidFile )
+	{
+		EAE6320_ASSERTF( false, "The content manifest %s is invalid", i_path );
+		Logging::OutputError( "The content manifest %s is invalid and will be ignored", i_path );
+		s_entries.clear();
+		// An invalid manifest only means that identical assets won't be shared
+		result = Results::Success;
+	}
+	dataFromFile.Free();
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::ContentManifest::CleanUp()
+{
+	if ( !s_entries.empty() )
+	{
+		const auto statistics = GetStatistics();
+		Logging::OutputMessage( "Sharing assets with identical contents saved %u loads and %u KB",
+			statistics.sharedLoadCount, static_cast<unsigned int>( statistics.savedByteCount / 1024 ) );
+	}
+	s_entries.clear();
+	s_entries.shrink_to_fit();
+
+	return Results::Success;
+}
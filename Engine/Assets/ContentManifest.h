@@ -0,0 +1,109 @@
+/*
+	The content manifest lists a hash of the contents of every built asset file
+
+	The asset build writes the manifest after every asset has been built.
+	At run-time it lets an asset manager notice that two different paths are byte-identical files
+	so that it can share a single loaded asset between them instead of loading the same data twice
+	(see cManager::EnableContentDeduplication()).
+
+	The layout of the manifest file is:
+		* An sHeader
+		* One sEntry for every built file, sorted by path hash
+*/
+
+#ifndef EAE6320_ASSETS_CONTENTMANIFEST_H
+#define EAE6320_ASSETS_CONTENTMANIFEST_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace ContentManifest
+		{
+			// Format
+			//-------
+
+			constexpr uint32_t s_signature = 0x4e4d4345;	// "ECMN" when read as bytes
+			constexpr uint16_t s_version = 1;
+
+			struct sHeader
+			{
+				uint32_t signature;
+				uint16_t version;
+				uint16_t padding;
+				uint32_t entryCount;
+				uint32_t padding2;
+			};
+			static_assert( sizeof( sHeader ) == 16, "The header is read directly from the file and must be tightly packed" );
+
+			struct sEntry
+			{
+				// This is Platform::Package::CalculatePathHash() of the run-time path (e.g. "data/Meshes/Cube.binmsh")
+				uint64_t pathHash;
+				uint64_t contentHash;
+				// The size of the built file
+				uint64_t size;
+			};
+			static_assert( sizeof( sEntry ) == 24, "The entries are read directly from the file and must be tightly packed" );
+
+			// This is the 64-bit FNV-1a hash of the file's bytes.
+			// Files are only considered the same if both their hashes and their sizes match.
+			inline uint64_t CalculateContentHash( const void* const i_data, const size_t i_size )
+			{
+				const auto* const data = static_cast<const uint8_t*>( i_data );
+				uint64_t hash = 0xcbf29ce484222325;
+				for ( size_t i = 0; i < i_size; ++i )
+				{
+					hash = ( hash ^ data[i] ) * 0x100000001b3;
+				}
+				return hash;
+			}
+
+			// Run-Time
+			//---------
+
+			struct sContent
+			{
+				uint64_t hash = 0;
+				uint64_t size = 0;
+
+				bool IsValid() const { return size != 0; }
+				bool operator ==( const sContent& i_other ) const { return ( hash == i_other.hash ) && ( size == i_other.size ); }
+			};
+			// Returns false if the path isn't in the manifest (or if no manifest was loaded).
+			// This is thread-safe.
+			bool FindContent( const char* const i_path, sContent& o_content );
+
+			// Asset managers call this when a load shares an asset that was loaded from a different path
+			// with the number of bytes that loading it again would have used
+			void RecordSharedLoad( const size_t i_byteCount );
+			struct sStatistics
+			{
+				uint32_t sharedLoadCount = 0;
+				uint64_t savedByteCount = 0;
+			};
+			sStatistics GetStatistics();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// If the manifest file doesn't exist nothing is shared
+			// (but this still succeeds so that content that was built without a manifest can be loaded)
+			cResult Initialize( const char* const i_path );
+			// A report of how much memory was saved by sharing assets is logged
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_CONTENTMANIFEST_H
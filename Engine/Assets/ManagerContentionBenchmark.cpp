@@ -0,0 +1,331 @@
+// Include Files
+//==============
+
+#include "ManagerContentionBenchmark.h"
+
+#include "cManager.h"
+#include "ReferenceCountedAssets.h"
+
+#include <atomic>
+#include <chrono>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// This asset doesn't have any data,
+	// and so loading it only measures the work that the manager does
+	class cBenchmarkAsset
+	{
+		// Interface
+		//==========
+
+	public:
+
+		static eae6320::cResult Load( const char* const i_path, cBenchmarkAsset*& o_asset )
+		{
+			o_asset = new ( std::nothrow ) cBenchmarkAsset();
+			return o_asset ? eae6320::Results::Success : eae6320::Results::OutOfMemory;
+		}
+		size_t GetMemorySize() const { return sizeof( *this ); }
+
+		EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cBenchmarkAsset )
+
+		// Reference Counting
+		//-------------------
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS()
+
+		// Data
+		//=====
+
+	private:
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNT()
+
+		// Implementation
+		//===============
+
+	private:
+
+		cBenchmarkAsset() = default;
+		~cBenchmarkAsset() = default;
+	};
+}
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The readers get every one of these assets in turn
+	constexpr unsigned int s_heldAssetCount = 64;
+	// The other thread loads and releases these assets in turn
+	constexpr unsigned int s_churnedAssetCount = 256;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	eae6320::cResult MeasureMode( const bool i_shouldGetUseMutex, const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		double& o_getsPerSecond, uint64_t& o_loadAndReleaseCount );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::ManagerContentionBenchmark::Measure( sResults& o_results,
+	const unsigned int i_readerThreadCount, const unsigned int i_timeToRunEachMode_inMilliseconds )
+{
+	auto result = Results::Success;
+
+	if ( !( result = MeasureMode( true, i_readerThreadCount, i_timeToRunEachMode_inMilliseconds,
+		o_results.getsPerSecond_mutex, o_results.loadAndReleaseCount_mutex ) ) )
+	{
+		return result;
+	}
+	if ( !( result = MeasureMode( false, i_readerThreadCount, i_timeToRunEachMode_inMilliseconds,
+		o_results.getsPerSecond_waitFree, o_results.loadAndReleaseCount_waitFree ) ) )
+	{
+		return result;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::ManagerContentionBenchmark::LogReport( const unsigned int i_readerThreadCount,
+	const unsigned int i_timeToRunEachMode_inMilliseconds )
+{
+	sResults results;
+	const auto result = Measure( results, i_readerThreadCount, i_timeToRunEachMode_inMilliseconds );
+	if ( result )
+	{
+		Logging::OutputMessage( "Asset manager Get() contention (%u reader threads and 1 loading thread):"
+			" %.2f million gets per second with a mutex (%llu loads), %.2f million gets per second wait-free (%llu loads)",
+			i_readerThreadCount,
+			results.getsPerSecond_mutex * 1.0e-6, static_cast<unsigned long long>( results.loadAndReleaseCount_mutex ),
+			results.getsPerSecond_waitFree * 1.0e-6, static_cast<unsigned long long>( results.loadAndReleaseCount_waitFree ) );
+	}
+	else
+	{
+		Logging::OutputError( "The asset manager contention couldn't be measured" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult MeasureMode( const bool i_shouldGetUseMutex, const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		double& o_getsPerSecond, uint64_t& o_loadAndReleaseCount )
+	{
+		auto result = eae6320::Results::Success;
+
+		struct sSharedData
+		{
+			eae6320::Assets::cManager<cBenchmarkAsset> manager;
+			eae6320::Assets::cHandle<cBenchmarkAsset> heldHandles[s_heldAssetCount];
+			eae6320::Assets::cPathId churnedPathIds[s_churnedAssetCount];
+			// When the mutex is used every Get(), Load(), and Release() is serialized by it
+			// (which is how Get() used to work)
+			eae6320::Concurrency::cMutex mutex;
+			bool shouldGetUseMutex = false;
+			eae6320::Concurrency::cEvent whenToStart;
+			std::atomic<bool> shouldStop{ false };
+			uint64_t loadAndReleaseCount = 0;
+		} sharedData;
+		// Each reader counts in its own cache line
+		struct alignas( 64 ) sReaderData
+		{
+			sSharedData* sharedData = nullptr;
+			uint64_t getCount = 0;
+			uint64_t nullAssetCount = 0;
+		};
+		std::vector<sReaderData> readerData( i_readerThreadCount );
+		std::vector<eae6320::Concurrency::cThread> readerThreads( i_readerThreadCount );
+		eae6320::Concurrency::cThread loadingThread;
+		auto startedThreadCount = 0u;
+		auto hasLoadingThreadStarted = false;
+		auto startTime = std::chrono::steady_clock::now();
+
+		sharedData.shouldGetUseMutex = i_shouldGetUseMutex;
+		if ( !( result = sharedData.manager.Initialize() ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the manager contention benchmark's asset manager" );
+			goto OnExit;
+		}
+		if ( !( result = sharedData.whenToStart.Initialize( eae6320::Concurrency::EventType::RemainSignaledUntilReset ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the manager contention benchmark's start event" );
+			goto OnExit;
+		}
+		for ( unsigned int i = 0; i < s_heldAssetCount; ++i )
+		{
+			const auto path = "ManagerContentionBenchmark/held_" + std::to_string( i );
+			if ( !( result = sharedData.manager.Load( path.c_str(), sharedData.heldHandles[i] ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't load a manager contention benchmark asset" );
+				goto OnExit;
+			}
+		}
+		for ( unsigned int i = 0; i < s_churnedAssetCount; ++i )
+		{
+			const auto path = "ManagerContentionBenchmark/churned_" + std::to_string( i );
+			sharedData.churnedPathIds[i] = eae6320::Assets::cPathId::Intern( path.c_str() );
+		}
+		// Start the threads
+		// (they all wait until every thread has been started)
+		for ( ; startedThreadCount < i_readerThreadCount; ++startedThreadCount )
+		{
+			readerData[startedThreadCount].sharedData = &sharedData;
+			if ( !( result = readerThreads[startedThreadCount].Start(
+				[]( void* const io_readerData )
+				{
+					auto& readerData = *static_cast<sReaderData*>( io_readerData );
+					auto& sharedData = *readerData.sharedData;
+					eae6320::Concurrency::WaitForEvent( sharedData.whenToStart );
+					while ( !sharedData.shouldStop.load( std::memory_order_relaxed ) )
+					{
+						for ( const auto handle : sharedData.heldHandles )
+						{
+							cBenchmarkAsset* asset;
+							if ( sharedData.shouldGetUseMutex )
+							{
+								eae6320::Concurrency::cMutex::cScopeLock autoLock( sharedData.mutex );
+								asset = sharedData.manager.Get( handle );
+							}
+							else
+							{
+								asset = sharedData.manager.Get( handle );
+							}
+							// The handle is held for the whole benchmark, and so its asset must always be returned
+							if ( asset )
+							{
+								++readerData.getCount;
+							}
+							else
+							{
+								++readerData.nullAssetCount;
+							}
+						}
+					}
+				},
+				&readerData[startedThreadCount] ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start a manager contention benchmark reader thread" );
+				goto OnExit;
+			}
+		}
+		if ( !( result = loadingThread.Start(
+			[]( void* const io_sharedData )
+			{
+				auto& sharedData = *static_cast<sSharedData*>( io_sharedData );
+				eae6320::Concurrency::WaitForEvent( sharedData.whenToStart );
+				for ( unsigned int i = 0; !sharedData.shouldStop.load( std::memory_order_relaxed ); i = ( i + 1 ) % s_churnedAssetCount )
+				{
+					eae6320::Assets::cHandle<cBenchmarkAsset> handle;
+					{
+						if ( sharedData.shouldGetUseMutex )
+						{
+							sharedData.mutex.Lock();
+						}
+						const auto result = sharedData.manager.Load( sharedData.churnedPathIds[i], handle );
+						if ( result )
+						{
+							sharedData.manager.Release( handle );
+						}
+						if ( sharedData.shouldGetUseMutex )
+						{
+							sharedData.mutex.Unlock();
+						}
+						if ( !result )
+						{
+							EAE6320_ASSERTF( false, "Couldn't load a manager contention benchmark asset" );
+							return;
+						}
+					}
+					++sharedData.loadAndReleaseCount;
+				}
+			},
+			&sharedData ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't start the manager contention benchmark loading thread" );
+			goto OnExit;
+		}
+		hasLoadingThreadStarted = true;
+		// Run for the requested amount of time
+		startTime = std::chrono::steady_clock::now();
+		if ( !( result = sharedData.whenToStart.Signal() ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't start the manager contention benchmark" );
+			goto OnExit;
+		}
+		std::this_thread::sleep_for( std::chrono::milliseconds( i_timeToRun_inMilliseconds ) );
+
+	OnExit:
+
+		// The threads must always be stopped before the data they use goes out of scope
+		// (if the start event was never signaled it is signaled here so that they can see that they should stop)
+		sharedData.shouldStop.store( true, std::memory_order_relaxed );
+		if ( startedThreadCount > 0 )
+		{
+			sharedData.whenToStart.Signal();
+		}
+		{
+			uint64_t getCount = 0;
+			uint64_t nullAssetCount = 0;
+			for ( unsigned int i = 0; i < startedThreadCount; ++i )
+			{
+				const auto localResult = eae6320::Concurrency::WaitForThreadToStop( readerThreads[i] );
+				EAE6320_ASSERT( localResult );
+				getCount += readerData[i].getCount;
+				nullAssetCount += readerData[i].nullAssetCount;
+			}
+			if ( hasLoadingThreadStarted )
+			{
+				const auto localResult = eae6320::Concurrency::WaitForThreadToStop( loadingThread );
+				EAE6320_ASSERT( localResult );
+			}
+			const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+			o_getsPerSecond = static_cast<double>( getCount ) / elapsedTime.count();
+			o_loadAndReleaseCount = sharedData.loadAndReleaseCount;
+			if ( nullAssetCount > 0 )
+			{
+				EAE6320_ASSERTF( false, "Get() returned null for a handle that was held" );
+				eae6320::Logging::OutputError( "The asset manager's Get() returned null %llu times for a handle that was held",
+					static_cast<unsigned long long>( nullAssetCount ) );
+				if ( result )
+				{
+					result = eae6320::Results::Failure;
+				}
+			}
+		}
+		for ( auto& handle : sharedData.heldHandles )
+		{
+			if ( handle )
+			{
+				sharedData.manager.Release( handle );
+			}
+		}
+		{
+			const auto localResult = sharedData.manager.CleanUp();
+			EAE6320_ASSERT( localResult );
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,51 @@
+/*
+	The manager contention benchmark measures how many times per second
+	reader threads can get assets from an asset manager
+	while another thread keeps loading and releasing other assets
+
+	It is run twice:
+		* Once with every Get() serialized with loading and releasing by a single mutex
+			(which is how cManager::Get() used to work)
+		* Once with Get() not taking any lock (which is how it works now)
+	Comparing the two shows how much the readers used to be slowed down by each other and by the loading thread.
+*/
+
+#ifndef EAE6320_ASSETS_MANAGERCONTENTIONBENCHMARK_H
+#define EAE6320_ASSETS_MANAGERCONTENTIONBENCHMARK_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace ManagerContentionBenchmark
+		{
+			struct sResults
+			{
+				// The total number of successful Get() calls per second of every reader thread together
+				double getsPerSecond_mutex = 0.0;
+				double getsPerSecond_waitFree = 0.0;
+				// How many times the other thread loaded and released an asset
+				uint64_t loadAndReleaseCount_mutex = 0;
+				uint64_t loadAndReleaseCount_waitFree = 0;
+			};
+
+			// This fails if a reader ever gets a null asset for a handle that it holds
+			cResult Measure( sResults& o_results,
+				const unsigned int i_readerThreadCount = 8, const unsigned int i_timeToRunEachMode_inMilliseconds = 500 );
+
+			// This measures and outputs the results to the log
+			cResult LogReport( const unsigned int i_readerThreadCount = 8, const unsigned int i_timeToRunEachMode_inMilliseconds = 500 );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_MANAGERCONTENTIONBENCHMARK_H
@@ -0,0 +1,398 @@
+// Include Files
+//==============
+
+#include "PrefetchProfile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/BackgroundThrottling.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Time/Time.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The files that the previous session loaded
+	struct sProfiledFile
+	{
+		std::string path;
+		double secondCount_whenLoadedPreviously = 0.0;
+		// These are only used during this session
+		double secondCount_whenLoaded = 0.0;
+		double secondCount_toPrefetch = 0.0;
+		uint64_t prefetchedByteCount = 0;
+		bool wasPrefetched = false;
+		bool wasLoaded = false;
+	};
+	// The paths are only changed while the prefetch thread isn't running,
+	// but the rest of the data is protected by the mutex
+	std::vector<sProfiledFile> s_profiledFiles;
+	std::unordered_map<std::string, size_t> s_profiledFileIndices;
+
+	// The files that this session has loaded
+	struct sRecordedFile
+	{
+		std::string path;
+		double secondCount_whenLoaded;
+	};
+	std::vector<sRecordedFile> s_recordedFiles;
+	std::unordered_set<std::string> s_recordedPaths;
+	// This keeps the profile small even if a session loads many files
+	constexpr size_t s_maxRecordedFileCount = 4096;
+
+	eae6320::Concurrency::cMutex s_mutex{ "Assets::PrefetchProfile" };
+	eae6320::Concurrency::cThread s_prefetchThread;
+	std::atomic<bool> s_shouldPrefetchingStop( false );
+	bool s_isPrefetchThreadRunning = false;
+
+	std::string s_profilePath;
+	uint64_t s_tickCount_whenInitialized = 0;
+	bool s_isInitialized = false;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void EntryPoint_prefetchThread( void* const io_userData );
+	void OnFileLoaded( const char* const i_path );
+	eae6320::cResult ReadProfile( const char* const i_path );
+	void ReportTimeSaved();
+	eae6320::cResult WriteProfile( const char* const i_path );
+	double GetSecondCountSinceInitialization();
+}
+
+// Interface
+//==========
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::PrefetchProfile::Initialize( const char* const i_profilePath )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !s_isInitialized, "The prefetch profile has already been initialized" );
+	s_profilePath = i_profilePath;
+	s_tickCount_whenInitialized = Time::GetCurrentSystemTimeTickCount();
+
+	// Read the previous session's profile
+	if ( Platform::DoesFileExist( i_profilePath ) )
+	{
+		if ( !ReadProfile( i_profilePath ) )
+		{
+			// An invalid profile isn't fatal because it will be replaced when this session ends
+			s_profiledFiles.clear();
+			s_profiledFileIndices.clear();
+		}
+	}
+	else
+	{
+		Logging::OutputMessage( "There is no prefetch profile yet (%s will be recorded during this session)", i_profilePath );
+	}
+	// Start recording the files that this session loads
+	Platform::SetFileLoadObserver( OnFileLoaded );
+	s_isInitialized = true;
+	// Start prefetching the files that the previous session loaded
+	if ( !s_profiledFiles.empty() )
+	{
+		s_shouldPrefetchingStop = false;
+		// Prefetching is only a hint, and so it shouldn't take time away from loads that are actually waited for
+		Concurrency::sThreadOptions threadOptions;
+		threadOptions.name = "Prefetch";
+		threadOptions.priority = Concurrency::eThreadPriority::Lowest;
+		if ( result = s_prefetchThread.Start( EntryPoint_prefetchThread, nullptr, threadOptions ) )
+		{
+			s_isPrefetchThreadRunning = true;
+			Logging::OutputMessage( "Started prefetching the %u files in the prefetch profile %s",
+				static_cast<unsigned int>( s_profiledFiles.size() ), i_profilePath );
+		}
+		else
+		{
+			EAE6320_ASSERTF( false, "Couldn't start the prefetch thread" );
+			Logging::OutputError( "Failed to start the thread that prefetches the files in %s", i_profilePath );
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( !result )
+	{
+		const auto localResult = CleanUp();
+		EAE6320_ASSERT( localResult );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::PrefetchProfile::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( !s_isInitialized )
+	{
+		return result;
+	}
+
+	// Stop prefetching
+	if ( s_isPrefetchThreadRunning )
+	{
+		s_shouldPrefetchingStop = true;
+		const auto localResult = Concurrency::WaitForThreadToStop( s_prefetchThread );
+		if ( localResult )
+		{
+			s_isPrefetchThreadRunning = false;
+		}
+		else
+		{
+			EAE6320_ASSERTF( false, "Couldn't wait for the prefetch thread to stop" );
+			Logging::OutputError( "Failed to wait for the prefetch thread to stop" );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// Stop recording
+	Platform::SetFileLoadObserver( nullptr );
+	// Report how well the previous session's profile predicted this session
+	if ( !s_profiledFiles.empty() )
+	{
+		ReportTimeSaved();
+	}
+	// Replace the profile with what was recorded during this session
+	if ( !s_recordedFiles.empty() )
+	{
+		const auto localResult = WriteProfile( s_profilePath.c_str() );
+		if ( !localResult )
+		{
+			// A missing profile only means that the next session won't prefetch anything
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// The data is only cleared if the prefetch thread has stopped using it
+	if ( !s_isPrefetchThreadRunning )
+	{
+		s_profiledFiles.clear();
+		s_profiledFileIndices.clear();
+		s_recordedFiles.clear();
+		s_recordedPaths.clear();
+		s_isInitialized = false;
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void EntryPoint_prefetchThread( void* const io_userData )
+	{
+		for ( auto& profiledFile : s_profiledFiles )
+		{
+			if ( s_shouldPrefetchingStop )
+			{
+				return;
+			}
+			// There's no reason to prefetch a file that has already been loaded
+			{
+				eae6320::Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+				if ( profiledFile.wasLoaded )
+				{
+					continue;
+				}
+			}
+			// Prefetching is only speculative,
+			// and so it is the first background work to wait when frames are busy
+			eae6320::Concurrency::BackgroundThrottling::WaitUntilWorkIsAllowed( eae6320::Concurrency::BackgroundThrottling::ePriority::Low );
+			const auto tickCount_beforePrefetching = eae6320::Time::GetCurrentSystemTimeTickCount();
+			uint64_t storedSize = 0;
+			std::string errorMessage;
+			if ( eae6320::Platform::PrefetchFile( profiledFile.path.c_str(), &storedSize, &errorMessage ) )
+			{
+				const auto secondCount_toPrefetch = eae6320::Time::ConvertTicksToSeconds(
+					eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_beforePrefetching );
+				eae6320::Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+				// If the file was loaded while it was being prefetched it was only partially prefetched,
+				// and so it isn't counted
+				if ( !profiledFile.wasLoaded )
+				{
+					profiledFile.wasPrefetched = true;
+					profiledFile.secondCount_toPrefetch = secondCount_toPrefetch;
+					profiledFile.prefetchedByteCount = storedSize;
+				}
+			}
+			else
+			{
+				// Files in the profile may have been deleted or renamed since it was recorded
+				eae6320::Logging::OutputMessage( "The file %s in the prefetch profile couldn't be prefetched: %s",
+					profiledFile.path.c_str(), errorMessage.c_str() );
+			}
+		}
+	}
+
+	void OnFileLoaded( const char* const i_path )
+	{
+		const auto secondCount_whenLoaded = GetSecondCountSinceInitialization();
+		const std::string path( i_path );
+
+		eae6320::Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+		// Only the first time that a file is loaded is recorded
+		if ( ( s_recordedFiles.size() < s_maxRecordedFileCount ) && s_recordedPaths.insert( path ).second )
+		{
+			s_recordedFiles.push_back( sRecordedFile{ path, secondCount_whenLoaded } );
+		}
+		{
+			const auto iterator = s_profiledFileIndices.find( path );
+			if ( iterator != s_profiledFileIndices.end() )
+			{
+				auto& profiledFile = s_profiledFiles[iterator->second];
+				if ( !profiledFile.wasLoaded )
+				{
+					profiledFile.wasLoaded = true;
+					profiledFile.secondCount_whenLoaded = secondCount_whenLoaded;
+				}
+			}
+		}
+	}
+
+	eae6320::cResult ReadProfile( const char* const i_path )
+	{
+		auto result = eae6320::Results::Success;
+
+		eae6320::Platform::sDataFromFile dataFromFile;
+		std::string errorMessage;
+		if ( !( result = eae6320::Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
+		{
+			EAE6320_ASSERTF( false, errorMessage.c_str() );
+			eae6320::Logging::OutputError( "Failed to load the prefetch profile %s: %s", i_path, errorMessage.c_str() );
+			return result;
+		}
+		// Every line is the number of seconds after the session started that the file was loaded
+		// followed by a space and then the file's path
+		{
+			std::istringstream lines( std::string( static_cast<const char*>( dataFromFile.data ), dataFromFile.size ) );
+			std::string line;
+			while ( std::getline( lines, line ) )
+			{
+				if ( line.empty() )
+				{
+					continue;
+				}
+				const auto separatorIndex = line.find( ' ' );
+				if ( ( separatorIndex == std::string::npos ) || ( separatorIndex == 0 ) || ( ( separatorIndex + 1 ) >= line.size() ) )
+				{
+					result = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputError( "The prefetch profile %s has an invalid line: %s", i_path, line.c_str() );
+					break;
+				}
+				sProfiledFile profiledFile;
+				profiledFile.secondCount_whenLoadedPreviously = std::strtod( line.c_str(), nullptr );
+				profiledFile.path = line.substr( separatorIndex + 1 );
+				if ( s_profiledFileIndices.emplace( profiledFile.path, s_profiledFiles.size() ).second )
+				{
+					s_profiledFiles.push_back( std::move( profiledFile ) );
+				}
+			}
+		}
+		dataFromFile.Free();
+
+		return result;
+	}
+
+	void ReportTimeSaved()
+	{
+		unsigned int prefetchedFileCount = 0, loadedAfterPrefetchingCount = 0, loadedBeforePrefetchingCount = 0, loadedCount = 0;
+		uint64_t prefetchedByteCount = 0;
+		double secondCount_prefetching = 0.0, secondCount_saved = 0.0;
+		double secondCount_lastLoaded = 0.0, secondCount_lastLoadedPreviously = 0.0;
+		for ( const auto& profiledFile : s_profiledFiles )
+		{
+			if ( profiledFile.wasPrefetched )
+			{
+				++prefetchedFileCount;
+				prefetchedByteCount += profiledFile.prefetchedByteCount;
+				secondCount_prefetching += profiledFile.secondCount_toPrefetch;
+			}
+			if ( profiledFile.wasLoaded )
+			{
+				++loadedCount;
+				secondCount_lastLoaded = std::max( secondCount_lastLoaded, profiledFile.secondCount_whenLoaded );
+				// The time that it took to prefetch a file is time that loading it didn't have to spend reading it
+				if ( profiledFile.wasPrefetched )
+				{
+					++loadedAfterPrefetchingCount;
+					secondCount_saved += profiledFile.secondCount_toPrefetch;
+				}
+				else
+				{
+					++loadedBeforePrefetchingCount;
+				}
+			}
+			secondCount_lastLoadedPreviously = std::max( secondCount_lastLoadedPreviously, profiledFile.secondCount_whenLoadedPreviously );
+		}
+		eae6320::Logging::OutputMessage( "Prefetched %u of the %u files in the prefetch profile (%u KB) in %.3f seconds",
+			prefetchedFileCount, static_cast<unsigned int>( s_profiledFiles.size() ),
+			static_cast<unsigned int>( prefetchedByteCount / 1024 ), secondCount_prefetching );
+		eae6320::Logging::OutputMessage( "%u prefetched files were loaded, saving an estimated %.3f seconds of reading"
+			" (%u files were loaded before they could be prefetched)",
+			loadedAfterPrefetchingCount, secondCount_saved, loadedBeforePrefetchingCount );
+		// If this session loaded every file that the previous session did
+		// the time that it took can be compared directly
+		if ( loadedCount == s_profiledFiles.size() )
+		{
+			eae6320::Logging::OutputMessage( "Every file in the prefetch profile had been loaded %.3f seconds after starting"
+				" (%.3f seconds in the previous session, a difference of %.3f seconds)",
+				secondCount_lastLoaded, secondCount_lastLoadedPreviously, secondCount_lastLoadedPreviously - secondCount_lastLoaded );
+		}
+	}
+
+	eae6320::cResult WriteProfile( const char* const i_path )
+	{
+		std::ostringstream profile;
+		profile << std::fixed << std::setprecision( 3 );
+		for ( const auto& recordedFile : s_recordedFiles )
+		{
+			profile << recordedFile.secondCount_whenLoaded << ' ' << recordedFile.path << '\n';
+		}
+		const auto contents = profile.str();
+		std::string errorMessage;
+		const auto result = eae6320::Platform::WriteBinaryFile( i_path, contents.c_str(), contents.size(), &errorMessage );
+		if ( result )
+		{
+			eae6320::Logging::OutputMessage( "Recorded the %u files that were loaded in the prefetch profile %s",
+				static_cast<unsigned int>( s_recordedFiles.size() ), i_path );
+		}
+		else
+		{
+			eae6320::Logging::OutputError( "Failed to write the prefetch profile %s: %s", i_path, errorMessage.c_str() );
+		}
+		return result;
+	}
+
+	double GetSecondCountSinceInitialization()
+	{
+		return eae6320::Time::ConvertTicksToSeconds( eae6320::Time::GetCurrentSystemTimeTickCount() - s_tickCount_whenInitialized );
+	}
+}
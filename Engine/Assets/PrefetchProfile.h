@@ -0,0 +1,45 @@
+/*
+	A prefetch profile is the ordered list of files that a session loaded
+
+	While a profile is being used:
+		* Every file that is loaded is recorded (in the order that it was first loaded, with the time since the session started),
+			and the list is written to the profile file when the session ends
+		* The files that the previous session recorded are read by a background thread
+			(in the order that they were loaded then)
+			so that they are already in the operating system's cache when the engine and game load them
+	This is started before the window and engine are initialized
+	so that the files are read while that happens instead of when the game waits for them.
+*/
+
+#ifndef EAE6320_ASSETS_PREFETCHPROFILE_H
+#define EAE6320_ASSETS_PREFETCHPROFILE_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace PrefetchProfile
+		{
+			// Initialization / Clean Up
+			//--------------------------
+
+			// If the profile file doesn't exist (e.g. the first time) nothing is prefetched,
+			// but the files that are loaded are still recorded.
+			// Packages must be mounted before this is called so that packaged files can be prefetched.
+			cResult Initialize( const char* const i_profilePath );
+			// Prefetching is stopped, a report of how much time prefetching saved is logged,
+			// and the files that were loaded during this session are written to the profile file
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_PREFETCHPROFILE_H
@@ -0,0 +1,335 @@
+// Include Files
+//==============
+
+#include "UploadQueueCheck.h"
+
+#include "cStagingRing.h"
+#include "cUploadQueue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The staging ring checks use a small ring so that the offsets are easy to follow
+	// (every size is a multiple of the ring's alignment)
+	constexpr size_t s_stagingRingCapacity = 256;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void CheckUploadQueueBudget( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	void CheckUploadQueueMinimumPerService( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	void CheckUploadQueueOrder( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	void CheckStagingRingFull( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	void CheckStagingRingWraparound( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	void CheckStagingRingOutOfOrderFrees( eae6320::Assets::UploadQueueCheck::sResults& io_results );
+
+	// The description says what should have happened
+	void Check( const bool i_condition, const char* const i_description, eae6320::Assets::UploadQueueCheck::sResults& io_results );
+	// The returned upload adds the ID to the list when it is run
+	eae6320::Assets::cUploadQueue::fUpload RecordUpload( std::vector<int>& io_uploadIds, const int i_id );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::UploadQueueCheck::Run( sResults& o_results )
+{
+	o_results = sResults();
+
+	CheckUploadQueueBudget( o_results );
+	CheckUploadQueueMinimumPerService( o_results );
+	CheckUploadQueueOrder( o_results );
+	CheckStagingRingFull( o_results );
+	CheckStagingRingWraparound( o_results );
+	CheckStagingRingOutOfOrderFrees( o_results );
+
+	if ( o_results.failedCheckCount > 0 )
+	{
+		EAE6320_ASSERTF( false, "%u upload queue checks failed", o_results.failedCheckCount );
+		return Results::Failure;
+	}
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::UploadQueueCheck::LogReport()
+{
+	sResults results;
+	const auto result = Run( results );
+	if ( result )
+	{
+		Logging::OutputMessage( "The upload queue and staging ring passed all %u checks", results.checkCount );
+	}
+	else
+	{
+		Logging::OutputError( "The upload queue and staging ring failed %u of %u checks", results.failedCheckCount, results.checkCount );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void CheckUploadQueueBudget( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		using namespace eae6320::Assets;
+
+		std::vector<int> uploadIds;
+		cUploadQueue queue;
+		// Before the queue is initialized uploads are run immediately
+		{
+			const auto fence = queue.Enqueue( 40, RecordUpload( uploadIds, -1 ) );
+			Check( ( fence != 0 ) && queue.HasCompleted( fence ) && ( uploadIds.size() == 1 ),
+				"An upload that is queued before the queue is initialized is run immediately", io_results );
+			uploadIds.clear();
+		}
+		Check( queue.Initialize( 100 ), "The upload queue can be initialized", io_results );
+		// Five uploads of 40 bytes don't fit in a budget of 100 bytes
+		cUploadQueue::tFence fences[5];
+		for ( int i = 0; i < 5; ++i )
+		{
+			fences[i] = queue.Enqueue( 40, RecordUpload( uploadIds, i ) );
+		}
+		Check( uploadIds.empty() && !queue.HasCompleted( fences[0] ) && !queue.IsEmpty(),
+			"Queued uploads aren't run until the queue is serviced", io_results );
+		// Uploads are run until the budget has been used,
+		// and so the upload that goes over the budget is still run
+		Check( ( queue.Service() == 120 ) && ( uploadIds.size() == 3 ),
+			"Service() runs uploads until the budget has been used and then stops", io_results );
+		Check( queue.HasCompleted( fences[2] ) && !queue.HasCompleted( fences[3] ),
+			"Only the fences of the uploads that Service() ran are completed", io_results );
+		Check( queue.GetStatistics().deferredServiceCount == 1,
+			"A service that leaves uploads in the queue is counted as deferred", io_results );
+		Check( ( queue.Service() == 80 ) && ( uploadIds.size() == 5 ) && queue.HasCompleted( fences[4] ) && queue.IsEmpty(),
+			"The uploads that were over the budget are run by the next service", io_results );
+		Check( queue.Service() == 0, "Servicing an empty queue doesn't upload anything", io_results );
+		{
+			const auto statistics = queue.GetStatistics();
+			Check( ( statistics.uploadCount == 5 ) && ( statistics.uploadedByteCount == 200 ) && ( statistics.deferredServiceCount == 1 ),
+				"The upload queue's statistics count every upload that was run", io_results );
+		}
+		Check( queue.CleanUp(), "The upload queue can be cleaned up", io_results );
+	}
+
+	void CheckUploadQueueMinimumPerService( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		using namespace eae6320::Assets;
+
+		std::vector<int> uploadIds;
+		cUploadQueue queue;
+		Check( queue.Initialize( 100 ), "The upload queue can be initialized", io_results );
+		// An upload bigger than the budget is run on its own
+		{
+			const auto fence_big = queue.Enqueue( 500, RecordUpload( uploadIds, 0 ) );
+			const auto fence_small = queue.Enqueue( 10, RecordUpload( uploadIds, 1 ) );
+			Check( ( queue.Service() == 500 ) && ( uploadIds.size() == 1 ) && queue.HasCompleted( fence_big ) && !queue.HasCompleted( fence_small ),
+				"An upload that is bigger than the budget is run by itself", io_results );
+			Check( ( queue.Service() == 10 ) && queue.HasCompleted( fence_small ),
+				"The upload after one that was bigger than the budget is run by the next service", io_results );
+		}
+		// Even with no budget every service runs one upload
+		{
+			queue.SetByteBudgetPerService( 0 );
+			for ( int i = 0; i < 3; ++i )
+			{
+				queue.Enqueue( 10, RecordUpload( uploadIds, 2 + i ) );
+			}
+			auto wasOneUploadRunPerService = true;
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				wasOneUploadRunPerService = wasOneUploadRunPerService && ( queue.Service() == 10 ) && ( uploadIds.size() == ( 3 + i ) );
+			}
+			Check( wasOneUploadRunPerService && queue.IsEmpty(), "Every service runs one upload when the budget is zero", io_results );
+		}
+		Check( queue.CleanUp(), "The upload queue can be cleaned up", io_results );
+	}
+
+	void CheckUploadQueueOrder( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		using namespace eae6320::Assets;
+
+		std::vector<int> uploadIds;
+		cUploadQueue queue;
+		Check( queue.Initialize( 1000 ), "The upload queue can be initialized", io_results );
+		// One of the uploads queues another upload when it is run,
+		// which must be run after every upload that was already queued
+		constexpr int nestedUploadId = 100;
+		cUploadQueue::tFence fences[8];
+		cUploadQueue::tFence fence_nested = 0;
+		for ( int i = 0; i < 8; ++i )
+		{
+			if ( i == 2 )
+			{
+				fences[i] = queue.Enqueue( 1, [&uploadIds, &queue, &fence_nested]()
+					{
+						uploadIds.push_back( 2 );
+						fence_nested = queue.Enqueue( 1, RecordUpload( uploadIds, nestedUploadId ) );
+					} );
+			}
+			else
+			{
+				fences[i] = queue.Enqueue( 1, RecordUpload( uploadIds, i ) );
+			}
+		}
+		{
+			auto doFencesIncrease = fences[0] != 0;
+			for ( size_t i = 1; i < 8; ++i )
+			{
+				doFencesIncrease = doFencesIncrease && ( fences[i] > fences[i - 1] );
+			}
+			Check( doFencesIncrease, "Fences increase in the order that uploads are queued", io_results );
+		}
+		queue.Service();
+		{
+			auto wereUploadsRunInOrder = uploadIds.size() == 9;
+			for ( size_t i = 0; wereUploadsRunInOrder && ( i < 8 ); ++i )
+			{
+				wereUploadsRunInOrder = uploadIds[i] == static_cast<int>( i );
+			}
+			Check( wereUploadsRunInOrder && ( uploadIds.back() == nestedUploadId ),
+				"Uploads are run in the order that they were queued", io_results );
+			Check( ( fence_nested > fences[7] ) && queue.HasCompleted( fence_nested ),
+				"An upload that is queued by another upload gets a later fence and is completed", io_results );
+		}
+		// Flushing to a fence only runs the uploads up to and including it
+		{
+			uploadIds.clear();
+			for ( int i = 0; i < 5; ++i )
+			{
+				fences[i] = queue.Enqueue( 1, RecordUpload( uploadIds, i ) );
+			}
+			queue.Flush( fences[2] );
+			Check( ( uploadIds.size() == 3 ) && queue.HasCompleted( fences[2] ) && !queue.HasCompleted( fences[3] ),
+				"Flushing to a fence runs every upload up to the fence and no others", io_results );
+			queue.Flush();
+			Check( ( uploadIds.size() == 5 ) && ( uploadIds.back() == 4 ) && queue.HasCompleted( fences[4] ) && queue.IsEmpty(),
+				"Flushing runs every upload that is left in order", io_results );
+		}
+		// Cleaning up runs the uploads that are left
+		{
+			const auto fence = queue.Enqueue( 1, RecordUpload( uploadIds, 5 ) );
+			Check( queue.CleanUp() && queue.HasCompleted( fence ) && ( uploadIds.back() == 5 ),
+				"Cleaning up the upload queue runs every upload that was left", io_results );
+		}
+	}
+
+	void CheckStagingRingFull( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		eae6320::Assets::cStagingRing ring;
+		Check( ring.Initialize( s_stagingRingCapacity ) && ( ring.GetCapacity() == s_stagingRingCapacity ),
+			"The staging ring can be initialized", io_results );
+		Check( !ring.Allocate( 0 ) && !ring.Allocate( s_stagingRingCapacity + 1 ),
+			"The staging ring can't allocate nothing or more than its capacity", io_results );
+		// Sizes are rounded up to the alignment
+		{
+			auto* const allocation_small = ring.Allocate( 1 );
+			auto* const allocation_odd = ring.Allocate( 17 );
+			Check( allocation_small && allocation_odd && ( ring.GetUsedByteCount() == 48 )
+				&& ( ( static_cast<uint8_t*>( allocation_odd ) - static_cast<uint8_t*>( allocation_small ) ) == 16 ),
+				"Staging allocations are rounded up to the alignment", io_results );
+			ring.Free( allocation_small );
+			ring.Free( allocation_odd );
+			Check( ring.GetUsedByteCount() == 0, "Freeing every staging allocation empties the ring", io_results );
+		}
+		// Filling the ring
+		{
+			auto* const allocation_first = ring.Allocate( s_stagingRingCapacity / 2 );
+			auto* const allocation_second = ring.Allocate( s_stagingRingCapacity / 2 );
+			Check( allocation_first && allocation_second && ( ring.GetUsedByteCount() == s_stagingRingCapacity ),
+				"The staging ring can be filled exactly", io_results );
+			Check( !ring.Allocate( 16 ), "The staging ring can't allocate when it is full", io_results );
+			ring.Free( allocation_first );
+			ring.Free( allocation_second );
+			auto* const allocation_all = ring.Allocate( s_stagingRingCapacity );
+			Check( allocation_all == allocation_first, "The whole staging ring can be allocated once it is empty", io_results );
+			ring.Free( allocation_all );
+		}
+		Check( ring.CleanUp(), "The staging ring can be cleaned up", io_results );
+	}
+
+	void CheckStagingRingWraparound( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		eae6320::Assets::cStagingRing ring;
+		Check( ring.Initialize( s_stagingRingCapacity ), "The staging ring can be initialized", io_results );
+		// Two allocations of 96 bytes leave 64 bytes at the end of the ring
+		auto* const allocation_0 = static_cast<uint8_t*>( ring.Allocate( 96 ) );
+		auto* const allocation_96 = static_cast<uint8_t*>( ring.Allocate( 96 ) );
+		Check( allocation_0 && ( allocation_96 == ( allocation_0 + 96 ) ), "Staging allocations are made in order", io_results );
+		// Once the first is freed a third allocation of 96 bytes doesn't fit at the end
+		// and so it wraps around to the beginning,
+		// and the memory at the end can't be used until the second allocation is freed
+		ring.Free( allocation_0 );
+		auto* const allocation_wrapped = static_cast<uint8_t*>( ring.Allocate( 96 ) );
+		Check( allocation_wrapped == allocation_0,
+			"A staging allocation that doesn't fit at the end of the ring wraps around to the beginning", io_results );
+		Check( ring.GetUsedByteCount() == s_stagingRingCapacity,
+			"The memory that a wrapped staging allocation skips is counted as used", io_results );
+		Check( !ring.Allocate( 16 ), "The skipped memory at the end of the staging ring can't be allocated", io_results );
+		// Once the second allocation is freed the memory after the wrapped one can be used again
+		ring.Free( allocation_96 );
+		Check( ring.GetUsedByteCount() == 96, "Freeing the oldest staging allocation releases the skipped memory", io_results );
+		auto* const allocation_rest = static_cast<uint8_t*>( ring.Allocate( s_stagingRingCapacity - 96 ) );
+		Check( allocation_rest == ( allocation_0 + 96 ), "The rest of the staging ring can be allocated after a wraparound", io_results );
+		ring.Free( allocation_wrapped );
+		ring.Free( allocation_rest );
+		Check( ring.GetUsedByteCount() == 0, "Freeing every staging allocation empties the ring", io_results );
+		Check( ring.CleanUp(), "The staging ring can be cleaned up", io_results );
+	}
+
+	void CheckStagingRingOutOfOrderFrees( eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		eae6320::Assets::cStagingRing ring;
+		Check( ring.Initialize( s_stagingRingCapacity ), "The staging ring can be initialized", io_results );
+		auto* const allocation_0 = static_cast<uint8_t*>( ring.Allocate( 64 ) );
+		auto* const allocation_64 = static_cast<uint8_t*>( ring.Allocate( 64 ) );
+		auto* const allocation_128 = static_cast<uint8_t*>( ring.Allocate( 64 ) );
+		Check( allocation_0 && allocation_64 && allocation_128, "Staging allocations succeed while there is room", io_results );
+		// Freeing the newer allocations doesn't make any memory reusable while the oldest is still allocated
+		ring.Free( allocation_128 );
+		ring.Free( allocation_64 );
+		Check( ring.GetUsedByteCount() == 192,
+			"Freeing newer staging allocations doesn't release memory while an older one is allocated", io_results );
+		auto* const allocation_192 = static_cast<uint8_t*>( ring.Allocate( 64 ) );
+		Check( ( allocation_192 == ( allocation_0 + 192 ) ) && !ring.Allocate( 16 ),
+			"Memory that was freed out of order isn't reused before the older allocations are freed", io_results );
+		// Freeing the oldest releases every allocation after it that has already been freed
+		ring.Free( allocation_0 );
+		Check( ring.GetUsedByteCount() == 64, "Freeing the oldest staging allocation releases the newer ones that were freed", io_results );
+		auto* const allocation_reused = static_cast<uint8_t*>( ring.Allocate( 192 ) );
+		Check( allocation_reused == allocation_0, "Memory that was freed out of order is reused once it has been released", io_results );
+		ring.Free( allocation_192 );
+		ring.Free( allocation_reused );
+		Check( ring.GetUsedByteCount() == 0, "Freeing every staging allocation empties the ring", io_results );
+		Check( ring.CleanUp(), "The staging ring can be cleaned up", io_results );
+	}
+
+	void Check( const bool i_condition, const char* const i_description, eae6320::Assets::UploadQueueCheck::sResults& io_results )
+	{
+		++io_results.checkCount;
+		if ( !i_condition )
+		{
+			++io_results.failedCheckCount;
+			eae6320::Logging::OutputError( "Upload queue check failed: %s", i_description );
+		}
+	}
+
+	eae6320::Assets::cUploadQueue::fUpload RecordUpload( std::vector<int>& io_uploadIds, const int i_id )
+	{
+		return [&io_uploadIds, i_id]()
+		{
+			io_uploadIds.push_back( i_id );
+		};
+	}
+}
@@ -0,0 +1,53 @@
+/*
+	The upload queue check makes sure that cUploadQueue and cStagingRing behave as documented
+	without needing a GPU (the uploads only record that they were run)
+
+	The upload queue checks are:
+		* Service() stops running uploads once the frame's byte budget has been used
+			and runs the rest the next time
+		* Service() always runs at least one upload,
+			even when it is bigger than the budget or the budget is zero
+		* Uploads are run (and their fences are completed) in the order that they were queued,
+			including uploads that are queued by another upload and ones that Flush() runs
+	The staging ring checks are:
+		* Allocations wrap around to the beginning of the ring,
+			skipping memory at the end that is too small
+		* Allocations fail when the ring is full
+		* Allocations that are freed out of order only make memory reusable
+			once every older allocation has also been freed
+*/
+
+#ifndef EAE6320_ASSETS_UPLOADQUEUECHECK_H
+#define EAE6320_ASSETS_UPLOADQUEUECHECK_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace UploadQueueCheck
+		{
+			struct sResults
+			{
+				unsigned int checkCount = 0;
+				// Every check that fails is also output to the log
+				unsigned int failedCheckCount = 0;
+			};
+
+			// This fails if any check failed
+			cResult Run( sResults& o_results );
+
+			// This runs the check and outputs the results to the log
+			cResult LogReport();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_UPLOADQUEUECHECK_H
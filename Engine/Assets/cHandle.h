@@ -116,7 +116,7 @@ namespace eae6320
 			//========
 
 			// Nothing should ever worry about the IDs except asset managers
-			template <class tAsset> friend class cManager;
+			template <class tManagedAsset> friend class cManager;
 		};
 	}
 };
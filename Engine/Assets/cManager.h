@@ -6,6 +6,14 @@
 			and can return the asset's actual pointer given its handle
 		* When every handle to an asset has been released
 			the manager releases its own reference to the asset so that it can be unloaded
+		* Assets can also be loaded asynchronously,
+			in which case the handle is returned immediately and the asset is "pending" until it has finished loading
+		* Assets are found by their interned path ID (see cPathId.h),
+			and a caller that already has a path ID can load an asset without any string handling
+		* A manager can optionally retain released assets up to a memory budget
+			so that an asset that is loaded again soon after being released doesn't have to be read again
+		* A manager can optionally share one asset between different paths whose built files are byte-identical
+			(see ContentManifest.h)
 */
 
 #ifndef EAE6320_ASSETS_CMANAGER_H
@@ -15,9 +23,14 @@
 //==============
 
 #include "cHandle.h"
+#include "ContentManifest.h"
+#include "cPathId.h"
 #include <Engine/Concurrency/cMutex.h>
+#include <atomic>
 #include <Engine/Results/Results.h>
-#include <map>
+#include <functional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 // Interface
@@ -39,15 +52,95 @@ namespace eae6320
 			//-------
 
 			// This function returns the actual pointer to the asset associated with the handle
-			// or NULL if the handle doesn't point to a valid asset
+			// or NULL if the handle doesn't point to a valid asset.
+			// It never waits for a lock, and so it can be called as often as needed from any thread.
+			// If the asset is still loading (or failed to load) the fallback asset is returned instead
+			// (which is also NULL if no fallback asset has been set).
 			tAsset* Get( const cHandle<tAsset> i_handle );
 
-			// Every handle returned from a successful call to Load() with a given path
+			// Every handle returned from a successful call to Load() or LoadAsync() with a given path
 			// must be passed to Release() when the caller is finished with it
+			// (a path ID can be passed instead of a path, which skips interning the path's string).
+			// If an earlier call to LoadAsync() is still loading the path
+			// then Load() only waits for it when it is called from the render thread;
+			// any other thread gets the handle back while the asset is still pending
+			// (and should use IsReady() or CallWhenLoaded() to find out when it has loaded)
+			// because the render thread might be waiting for that thread and so could never finish creating the asset.
 			template <typename... tConstructorArguments>
 				cResult Load( const char* const i_path, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
+			template <typename... tConstructorArguments>
+				cResult Load( const cPathId i_pathId, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
 			cResult Release( cHandle<tAsset>& io_handle );
 
+			// Asynchronous Loading
+			//---------------------
+
+			// This returns a handle immediately, and the asset is loaded using AsyncLoading.
+			// The return value only reports whether the load could be started;
+			// whether the asset actually loaded is reported by WaitUntilLoaded() or CallWhenLoaded()
+			// (and the handle must be released either way).
+			// An asset type must provide the following in order to be loaded asynchronously:
+			//	* A tAsset::sFileData struct that holds the contents of a file after it has been read
+			//		with a size_t GetUploadByteCount() const function that returns how many bytes creating the asset uploads
+			//	* static cResult ReadFile( const char* i_path, sFileData& o_fileData, i_constructorArguments... )
+			//		which is called by a background thread
+			//	* static cResult CreateFromFileData( sFileData& io_fileData, tAsset*& o_asset )
+			//		which is called by the render thread
+			template <typename... tConstructorArguments>
+				cResult LoadAsync( const char* const i_path, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
+			template <typename... tConstructorArguments>
+				cResult LoadAsync( const cPathId i_pathId, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
+			// Returns true once the asset has loaded successfully
+			bool IsReady( const cHandle<tAsset> i_handle );
+			// This blocks until the asset has either loaded or failed to load.
+			// It is safe to call from the render thread,
+			// but not from the application loop thread (the render thread waits for it every frame
+			// and so an asset could never be created); it should use IsReady() or CallWhenLoaded() instead.
+			cResult WaitUntilLoaded( const cHandle<tAsset> i_handle );
+			// The callback is called from the render thread once the asset has either loaded or failed to load
+			// (if that has already happened it is called immediately from the calling thread,
+			// and if every handle is released before it happens it is never called)
+			using fCallbackWhenLoaded = std::function<void( const cResult i_result )>;
+			cResult CallWhenLoaded( const cHandle<tAsset> i_handle, const fCallbackWhenLoaded& i_callback );
+
+			// Get() returns the fallback asset in place of any asset that is still loading.
+			// The manager holds its own reference to the fallback asset,
+			// and so the handle can be released after this is called.
+			// Passing an invalid handle clears the fallback asset.
+			cResult SetFallbackAsset( const cHandle<tAsset> i_handle );
+
+			// Retention Cache
+			//----------------
+
+			// By default an asset is unloaded as soon as every handle to it has been released.
+			// If a retention budget is set then released assets stay loaded until the total size of the released assets
+			// would be bigger than the budget, at which point the least recently released ones are unloaded first.
+			// An asset type must provide size_t GetMemorySize() const, which returns the bytes of CPU and GPU memory that it uses.
+			// A budget of zero (the default) unloads any retained assets and disables retention.
+			cResult SetRetentionBudget( const size_t i_budget_inBytes );
+			struct sCacheStatistics
+			{
+				// A hit is a load that found a retained asset,
+				// and a miss is a load that had to create a new asset
+				// (a load of an asset that still has handles is neither)
+				uint64_t hitCount = 0;
+				uint64_t missCount = 0;
+				size_t retainedAssetCount = 0;
+				size_t retainedByteCount = 0;
+				size_t budget_inBytes = 0;
+			};
+			sCacheStatistics GetCacheStatistics();
+
+			// Content Deduplication
+			//----------------------
+
+			// Once this is enabled, loading a path whose built file has the same contents (according to the content manifest)
+			// as an asset that is already loaded, loading, or retained returns a new reference to that asset
+			// instead of loading the same data again.
+			// The directory is prepended to a path to get the run-time path that the content manifest lists
+			// (e.g. MESH_FILE_DIRECTORY for meshes).
+			cResult EnableContentDeduplication( const char* const i_fileDirectory );
+
 			// Initialization / Clean Up
 			//--------------------------
 
@@ -61,18 +154,119 @@ namespace eae6320
 
 		private:
 
+			enum class eLoadState : uint8_t
+			{
+				Loaded,
+				Pending,
+				Failed,
+				// The asset has been released but is being kept by the retention cache
+				Retained,
+			};
 			struct sAssetRecord
 			{
-				tAsset* asset = nullptr;
-				uint16_t id = cHandle<tAsset>::InvalidValue;
+				// Get() doesn't lock the mutex,
+				// and so the ID and load state are packed together so that it can read both atomically
+				// and the asset is only changed while the ID and load state show that the record isn't loaded
+				std::atomic<uint32_t> idAndLoadState{ 0 };
+				std::atomic<tAsset*> asset{ nullptr };
+				// Everything else is only accessed while the mutex is locked
 				uint16_t referenceCount = 0;
+				// This is the path that the asset was loaded from
+				// (other paths with the same content can refer to the same record)
+				cPathId pathId;
+				// This is invalid if the asset's contents aren't known
+				// (in which case it is never shared)
+				ContentManifest::sContent content;
+				// This is only used while the asset is pending
+				std::vector<fCallbackWhenLoaded> callbacksWhenLoaded;
+				// These are only used while the asset is retained
+				// (the retained records are a doubly-linked list from least to most recently released)
+				size_t retainedByteCount = 0;
+				uint32_t index_previousRetained = cHandle<tAsset>::InvalidIndex;
+				uint32_t index_nextRetained = cHandle<tAsset>::InvalidIndex;
+
+				static constexpr uint32_t PackIdAndLoadState( const uint_fast16_t i_id, const eLoadState i_loadState )
+				{
+					return static_cast<uint32_t>( i_id ) | ( static_cast<uint32_t>( i_loadState ) << 16 );
+				}
+				static constexpr uint16_t UnpackId( const uint32_t i_idAndLoadState ) { return static_cast<uint16_t>( i_idAndLoadState & 0xffff ); }
+				static constexpr eLoadState UnpackLoadState( const uint32_t i_idAndLoadState ) { return static_cast<eLoadState>( i_idAndLoadState >> 16 ); }
 
-				sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount );
+				// These must only be called while the mutex is locked
+				uint16_t GetId() const { return UnpackId( idAndLoadState.load( std::memory_order_relaxed ) ); }
+				eLoadState GetLoadState() const { return UnpackLoadState( idAndLoadState.load( std::memory_order_relaxed ) ); }
+				void SetIdAndLoadState( const uint_fast16_t i_id, const eLoadState i_loadState )
+				{
+					idAndLoadState.store( PackIdAndLoadState( i_id, i_loadState ), std::memory_order_release );
+				}
 			};
-			std::vector<sAssetRecord> m_assetRecords;
+			// The records are allocated in segments that never move
+			// so that Get() can read a record while another thread is creating a new one
+			static constexpr uint_fast32_t s_assetRecordsPerSegment = 1024;
+			static constexpr uint_fast32_t s_maxAssetRecordSegmentCount =
+				( cHandle<tAsset>::InvalidIndex + s_assetRecordsPerSegment - 1 ) / s_assetRecordsPerSegment;
+			std::atomic<sAssetRecord*> m_assetRecordSegments[s_maxAssetRecordSegmentCount] = {};
+			std::atomic<uint32_t> m_assetRecordCount{ 0 };
 			std::vector<uint16_t> m_unusedAssetRecordIndices;
-			std::map< std::string, cHandle<tAsset> > m_map_pathsToHandles;
-			eae6320::Concurrency::cMutex m_mutex;
+			// This is an open-addressing hash table (with linear probing) from path IDs to handles.
+			// Entries are never removed (a path that has been loaded once is likely to be loaded again),
+			// and so an entry's handle may no longer be valid.
+			// Its size is always a power of two and it is never more than half full.
+			struct sPathEntry
+			{
+				cPathId pathId;
+				cHandle<tAsset> handle;
+			};
+			std::vector<sPathEntry> m_pathEntries;
+			size_t m_pathEntryCount = 0;
+			// Content Deduplication
+			// (like the path entries, the content entries are never removed and so an entry's handle may no longer be valid)
+			std::unordered_map<uint64_t, cHandle<tAsset>> m_contentEntries;
+			std::string m_contentDirectory;
+			bool m_isContentDeduplicationEnabled = false;
+			std::atomic<tAsset*> m_fallbackAsset{ nullptr };
+			// Retention Cache
+			size_t m_retentionBudget = 0;
+			uint32_t m_index_leastRecentlyRetained = cHandle<tAsset>::InvalidIndex;
+			uint32_t m_index_mostRecentlyRetained = cHandle<tAsset>::InvalidIndex;
+			sCacheStatistics m_cacheStatistics;
+			eae6320::Concurrency::cMutex m_mutex{ "Assets::cManager" };
+
+			// Implementation
+			//===============
+
+		private:
+
+			// The index must be less than m_assetRecordCount
+			sAssetRecord& GetAssetRecord( const uint_fast32_t i_index ) const;
+
+			// These must be called while the mutex is locked
+
+			// Returns NULL if the handle doesn't match an asset record
+			sAssetRecord* FindAssetRecord( const cHandle<tAsset> i_handle );
+			// If there is already a valid asset record for the path (or for a different path with the same content)
+			// a new reference to it is returned, and otherwise o_handle is invalid
+			// and o_content is the content that a new record should be created with
+			cResult FindExistingAsset( const cPathId i_pathId, cHandle<tAsset>& o_handle, ContentManifest::sContent& o_content );
+			// If the handle still refers to a valid asset record a new reference to it is returned,
+			// and otherwise o_handle is invalid
+			cResult ReferenceExistingAsset( const cHandle<tAsset> i_existingHandle, const cPathId i_pathId, cHandle<tAsset>& o_handle );
+			cResult CreateAssetRecord( const cPathId i_pathId, const ContentManifest::sContent& i_content, tAsset* const i_asset,
+				const eLoadState i_loadState, cHandle<tAsset>& o_handle );
+			// Returns the entry for the path ID or the empty entry where it should be inserted
+			sPathEntry& FindPathEntry( const cPathId i_pathId );
+			void SetPathEntry( const cPathId i_pathId, const cHandle<tAsset> i_handle );
+			void GrowPathEntries();
+			// The record's asset is unloaded and the record can be re-used
+			void FreeAssetRecord( const uint_fast32_t i_index );
+			// Returns false if the retention cache can't keep the asset
+			// (in which case the caller must free the record)
+			bool RetainAsset( const uint_fast32_t i_index );
+			void UnlinkRetainedAsset( sAssetRecord& io_assetRecord );
+			void EvictRetainedAssets( const size_t i_budget_inBytes );
+
+			// This is called from the render thread when an asynchronous load finishes
+			void OnAsyncLoadFinished( const cHandle<tAsset> i_handle, const cResult i_result, tAsset* const i_asset );
 		};
 	}
 }
@@ -6,9 +6,14 @@
 
 #include "cManager.h"
 
+#include "AsyncLoading.h"
+
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <limits>
+#include <memory>
+#include <new>
+#include <utility>
 
 // Interface
 //==========
@@ -20,32 +25,46 @@ template <class tAsset>
 	tAsset* eae6320::Assets::cManager<tAsset>::Get( const cHandle<tAsset> i_handle )
 {
 	EAE6320_ASSERTF( i_handle, "This handle is invalid (it has never been associated with a valid asset)" );
-	// Lock the collections
-	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	// No lock is taken:
+	// A record never moves once it has been created,
+	// and its asset only changes while its ID and load state don't match a handle that is loaded
+	// (Release() changes the ID before clearing the asset, and loading sets the asset before changing the load state)
+	const auto index = i_handle.GetIndex();
+	const auto assetCount = m_assetRecordCount.load( std::memory_order_acquire );
+	if ( index < assetCount )
 	{
-		const auto index = i_handle.GetIndex();
-		const auto assetCount = m_assetRecords.size();
-		if ( index < assetCount )
+		const auto& assetRecord = GetAssetRecord( index );
+		const auto idAndLoadState = assetRecord.idAndLoadState.load( std::memory_order_acquire );
+		const auto id_assetRecord = sAssetRecord::UnpackId( idAndLoadState );
+		const auto id_handle = i_handle.GetId();
+		if ( id_handle == id_assetRecord )
 		{
-			auto& assetRecord = m_assetRecords[index];
-			const auto id_assetRecord = assetRecord.id;
-			const auto id_handle = i_handle.GetId();
-			if ( id_handle == id_assetRecord )
+			if ( sAssetRecord::UnpackLoadState( idAndLoadState ) == eLoadState::Loaded )
 			{
-				return assetRecord.asset;
+				auto* const asset = assetRecord.asset.load( std::memory_order_acquire );
+				// If the record changed while the asset was being read
+				// then the handle was released by another thread at the same time
+				if ( assetRecord.idAndLoadState.load( std::memory_order_acquire ) == idAndLoadState )
+				{
+					return asset;
+				}
 			}
 			else
 			{
-				EAE6320_ASSERTF( false, "A handle (at index %u) has an ID (%u) that doesn't match the asset record (%u)",
-					index, id_handle, id_assetRecord );
+				return m_fallbackAsset.load( std::memory_order_acquire );
 			}
 		}
 		else
 		{
-			EAE6320_ASSERTF( false, "A handle has an index (%u) that's too big for the number of assets (%u)",
-				index, assetCount );
+			EAE6320_ASSERTF( false, "A handle (at index %u) has an ID (%u) that doesn't match the asset record (%u)",
+				index, id_handle, id_assetRecord );
 		}
 	}
+	else
+	{
+		EAE6320_ASSERTF( false, "A handle has an index (%u) that's too big for the number of assets (%u)",
+			index, assetCount );
+	}
 	// If this code is reached the handle doesn't point to a valid asset
 	return nullptr;
 }
@@ -56,99 +75,54 @@ template <class tAsset>
 template <class tAsset> template <typename... tConstructorArguments>
 	eae6320::cResult eae6320::Assets::cManager<tAsset>::Load( const char* const i_path, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments )
 {
+	return Load( cPathId::Intern( i_path ), o_handle, std::forward<tConstructorArguments>( i_constructorArguments )... );
+}
+
+template <class tAsset> template <typename... tConstructorArguments>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::Load( const cPathId i_pathId, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( i_pathId, "Assets can only be loaded with a valid path ID" );
+
 	// Get the existing asset if the path has already been loaded
+	ContentManifest::sContent content;
 	{
 		// Lock the collections
 		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 		{
-			auto iterator = m_map_pathsToHandles.find( i_path );
-			if ( iterator != m_map_pathsToHandles.end() )
+			if ( !( result = FindExistingAsset( i_pathId, o_handle, content ) ) )
 			{
-				// Even if an entry exists it may no longer be valid
-				// (the map doesn't get cleared when an asset is deleted)
-				const auto existingHandle = iterator->second;
-				const auto index = existingHandle.GetIndex();
-				const auto assetCount = m_assetRecords.size();
-				if ( index < assetCount )
-				{
-					auto& assetRecord = m_assetRecords[index];
-					const auto id_assetRecord = assetRecord.id;
-					const auto id_handle = existingHandle.GetId();
-					if ( id_handle == id_assetRecord )
-					{
-						EAE6320_ASSERT( assetRecord.asset );
-						const auto referenceCount = assetRecord.referenceCount;
-						if ( referenceCount < std::numeric_limits<decltype( assetRecord.referenceCount )>::max() )
-						{
-							assetRecord.referenceCount = referenceCount + 1;
-							o_handle = existingHandle;
-							return Results::Success;
-						}
-						else
-						{
-							EAE6320_ASSERTF( false,
-								"The asset \"%s\" has been loaded too many times (the manager's reference count is too big)", i_path );
-							Logging::OutputError( "A new instance of \"%s\" couldn't be loaded because the manager's reference count was too big", i_path );
-							return Results::Failure;
-						}
-					}
-				}
-				// If this code is reached it means that the existing entry is invalid
-				m_map_pathsToHandles.erase( iterator );
+				return result;
 			}
 		}
 	}
+	if ( o_handle )
+	{
+		// If the existing asset is still being loaded asynchronously
+		// only the render thread can wait for it to finish:
+		// Any other thread might be one that the render thread is waiting for
+		// (e.g. the application loop thread submitting a frame),
+		// in which case the render thread would never create the asset,
+		// and so the handle is returned while the asset is still pending
+		if ( AsyncLoading::IsRenderThread() )
+		{
+			if ( !( result = WaitUntilLoaded( o_handle ) ) )
+			{
+				Release( o_handle );
+			}
+		}
+		return result;
+	}
 
 	// If the asset hasn't already been loaded load it now
-	auto result = Results::Success;
-
-	tAsset* newAsset;
-	if ( result = tAsset::Load( i_path, newAsset, std::forward<tConstructorArguments>( i_constructorArguments )... ) )
+	tAsset* newAsset = nullptr;
+	if ( result = tAsset::Load( i_pathId.GetPath(), newAsset, std::forward<tConstructorArguments>( i_constructorArguments )... ) )
 	{
 		// Lock the collections
 		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 		{
-			// Look for an existing asset record that is unused
-			if ( !m_unusedAssetRecordIndices.empty() )
-			{
-				const auto index = m_unusedAssetRecordIndices.back();
-				{
-					m_unusedAssetRecordIndices.pop_back();
-				}
-				auto& assetRecord = m_assetRecords[index];
-				{
-					assetRecord.asset = newAsset;
-					assetRecord.referenceCount = 1;
-				}
-				o_handle = cHandle<tAsset>( index, assetRecord.id );
-			}
-			else
-			{
-				// Create a new asset record
-				const auto assetRecordCount = m_assetRecords.size();
-				if ( assetRecordCount < cHandle<tAsset>::InvalidIndex )
-				{
-					constexpr uint16_t id = 0;
-					{
-						constexpr uint16_t referenceCount = 1;
-						m_assetRecords.push_back( sAssetRecord( newAsset, id, referenceCount ) );
-					}
-					{
-						const auto index = static_cast<uint_fast32_t>( assetRecordCount );
-						o_handle = cHandle<tAsset>( index, id );
-					}
-				}
-				else
-				{
-					result = Results::OutOfMemory;
-					EAE6320_ASSERTF( false, "Too many of this kind of asset have been created" );
-					Logging::OutputError( "A new asset couldn't be loaded because there were too many (%u)", assetRecordCount );
-				}
-			}
-			if ( result )
-			{
-				m_map_pathsToHandles.insert( std::make_pair( i_path, o_handle ) );
-			}
+			result = CreateAssetRecord( i_pathId, content, newAsset, eLoadState::Loaded, o_handle );
 		}
 	}
 
@@ -172,11 +146,11 @@ template <class tAsset>
 		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 		{
 			const auto index = o_handle.GetIndex();
-			const auto assetCount = m_assetRecords.size();
+			const auto assetCount = m_assetRecordCount.load( std::memory_order_relaxed );
 			if ( index < assetCount )
 			{
-				auto& assetRecord = m_assetRecords[index];
-				const auto id_assetRecord = assetRecord.id;
+				auto& assetRecord = GetAssetRecord( index );
+				const auto id_assetRecord = assetRecord.GetId();
 				const auto id_handle = o_handle.GetId();
 				if ( id_handle == id_assetRecord )
 				{
@@ -188,16 +162,11 @@ template <class tAsset>
 						// If the manager's reference count is zero it means that
 						// every client that has asked to load the asset has now released it,
 						// and the manager can free the asset itself
+						// unless the retention cache keeps it in case it is loaded again
+						// (if the asset is still loading asynchronously it will be freed as soon as it finishes)
+						if ( !RetainAsset( index ) )
 						{
-							EAE6320_ASSERT( assetRecord.asset );
-							assetRecord.asset->DecrementReferenceCount();
-						}
-						// The existing asset record has already been allocated,
-						// and can be re-used for a new asset
-						{
-							assetRecord.asset = nullptr;
-							assetRecord.id = static_cast<uint16_t>( cHandle<tAsset>::IncrementId( id_assetRecord ) );
-							m_unusedAssetRecordIndices.push_back( index );
+							FreeAssetRecord( index );
 						}
 					}
 				}
@@ -222,6 +191,239 @@ template <class tAsset>
 	return result;
 }
 
+// Asynchronous Loading
+//---------------------
+
+template <class tAsset> template <typename... tConstructorArguments>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::LoadAsync( const char* const i_path, cHandle<tAsset>& o_handle,
+		tConstructorArguments&&... i_constructorArguments )
+{
+	return LoadAsync( cPathId::Intern( i_path ), o_handle, std::forward<tConstructorArguments>( i_constructorArguments )... );
+}
+
+template <class tAsset> template <typename... tConstructorArguments>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::LoadAsync( const cPathId i_pathId, cHandle<tAsset>& o_handle,
+		tConstructorArguments&&... i_constructorArguments )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( i_pathId, "Assets can only be loaded with a valid path ID" );
+
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			// If the path has already been loaded (or is already loading) the existing asset is used
+			ContentManifest::sContent content;
+			if ( !( result = FindExistingAsset( i_pathId, o_handle, content ) ) )
+			{
+				return result;
+			}
+			if ( o_handle )
+			{
+				return result;
+			}
+			// Otherwise a pending asset record is created so that the handle can be returned immediately
+			if ( !( result = CreateAssetRecord( i_pathId, content, nullptr, eLoadState::Pending, o_handle ) ) )
+			{
+				return result;
+			}
+		}
+	}
+
+	// The file is read on a background thread
+	// and then the asset is created on the render thread by the upload queue
+	{
+		const auto handle = o_handle;
+		// The interned path is valid until the program exits and so the job doesn't need its own copy
+		const auto pathId = i_pathId;
+		AsyncLoading::QueueBackgroundJob( [this, handle, pathId, i_constructorArguments...]()
+			{
+				// If every handle was released before the job started there is no reason to read the file
+				{
+					Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+					if ( !FindAssetRecord( handle ) )
+					{
+						return;
+					}
+				}
+				auto fileData = std::make_shared<typename tAsset::sFileData>();
+				const auto result_read = tAsset::ReadFile( pathId.GetPath(), *fileData, i_constructorArguments... );
+				// Creating the asset uploads its data to the GPU,
+				// and so it counts against the per-frame upload budget
+				const auto uploadByteCount = result_read ? fileData->GetUploadByteCount() : 0;
+				AsyncLoading::GetUploadQueue().Enqueue( uploadByteCount, [this, handle, fileData, result_read]()
+					{
+						tAsset* newAsset = nullptr;
+						auto result_create = result_read;
+						if ( result_create )
+						{
+							result_create = tAsset::CreateFromFileData( *fileData, newAsset );
+						}
+						OnAsyncLoadFinished( handle, result_create, newAsset );
+					} );
+			} );
+	}
+
+	return result;
+}
+
+template <class tAsset>
+	bool eae6320::Assets::cManager<tAsset>::IsReady( const cHandle<tAsset> i_handle )
+{
+	// Like Get() this doesn't need to lock the collections
+	const auto index = i_handle.GetIndex();
+	if ( index < m_assetRecordCount.load( std::memory_order_acquire ) )
+	{
+		const auto idAndLoadState = GetAssetRecord( index ).idAndLoadState.load( std::memory_order_acquire );
+		return idAndLoadState == sAssetRecord::PackIdAndLoadState( i_handle.GetId(), eLoadState::Loaded );
+	}
+	return false;
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::WaitUntilLoaded( const cHandle<tAsset> i_handle )
+{
+	while ( true )
+	{
+		// Lock the collections
+		{
+			Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+			{
+				const auto* const assetRecord = FindAssetRecord( i_handle );
+				if ( !assetRecord )
+				{
+					EAE6320_ASSERTF( false, "A handle that is being waited for doesn't match an asset record" );
+					return Results::Failure;
+				}
+				if ( assetRecord->GetLoadState() == eLoadState::Loaded )
+				{
+					return Results::Success;
+				}
+				else if ( assetRecord->GetLoadState() == eLoadState::Failed )
+				{
+					return Results::Failure;
+				}
+			}
+		}
+		AsyncLoading::WaitForProgress();
+	}
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::CallWhenLoaded( const cHandle<tAsset> i_handle, const fCallbackWhenLoaded& i_callback )
+{
+	auto loadResult = Results::Success;
+
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			auto* const assetRecord = FindAssetRecord( i_handle );
+			if ( !assetRecord )
+			{
+				EAE6320_ASSERTF( false, "A handle that is being waited for doesn't match an asset record" );
+				return Results::Failure;
+			}
+			if ( assetRecord->GetLoadState() == eLoadState::Pending )
+			{
+				assetRecord->callbacksWhenLoaded.push_back( i_callback );
+				return Results::Success;
+			}
+			loadResult = ( assetRecord->GetLoadState() == eLoadState::Loaded ) ? Results::Success : Results::Failure;
+		}
+	}
+	// The callback isn't called while the lock is held
+	// so that it can use the manager
+	i_callback( loadResult );
+
+	return Results::Success;
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::SetFallbackAsset( const cHandle<tAsset> i_handle )
+{
+	tAsset* previousFallbackAsset = nullptr;
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			tAsset* newFallbackAsset = nullptr;
+			if ( i_handle )
+			{
+				const auto* const assetRecord = FindAssetRecord( i_handle );
+				if ( !assetRecord || ( assetRecord->GetLoadState() != eLoadState::Loaded ) )
+				{
+					EAE6320_ASSERTF( false, "A fallback asset must have finished loading" );
+					return Results::Failure;
+				}
+				newFallbackAsset = assetRecord->asset.load( std::memory_order_relaxed );
+				newFallbackAsset->IncrementReferenceCount();
+			}
+			previousFallbackAsset = m_fallbackAsset.exchange( newFallbackAsset, std::memory_order_acq_rel );
+		}
+	}
+	if ( previousFallbackAsset )
+	{
+		previousFallbackAsset->DecrementReferenceCount();
+	}
+
+	return Results::Success;
+}
+
+// Retention Cache
+//----------------
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::SetRetentionBudget( const size_t i_budget_inBytes )
+{
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			m_retentionBudget = i_budget_inBytes;
+			EvictRetainedAssets( m_retentionBudget );
+		}
+	}
+
+	return Results::Success;
+}
+
+template <class tAsset>
+	typename eae6320::Assets::cManager<tAsset>::sCacheStatistics eae6320::Assets::cManager<tAsset>::GetCacheStatistics()
+{
+	// Lock the collections
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	{
+		auto cacheStatistics = m_cacheStatistics;
+		cacheStatistics.budget_inBytes = m_retentionBudget;
+		return cacheStatistics;
+	}
+}
+
+// Content Deduplication
+//----------------------
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::EnableContentDeduplication( const char* const i_fileDirectory )
+{
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			// Assets that have already been loaded don't know their contents and so they won't be shared,
+			// but any new assets will be
+			m_contentDirectory = i_fileDirectory ? i_fileDirectory : "";
+			m_isContentDeduplicationEnabled = true;
+		}
+	}
+
+	return Results::Success;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
 template <class tAsset>
 	eae6320::cResult eae6320::Assets::cManager<tAsset>::Initialize()
 {
@@ -233,6 +435,16 @@ template <class tAsset>
 {
 	auto result = Results::Success;
 
+	{
+		const auto localResult = SetFallbackAsset( cHandle<tAsset>() );
+		EAE6320_ASSERT( localResult );
+	}
+	// Retained assets aren't leaks (they don't have any handles),
+	// and so they are unloaded before checking for assets that are still in use
+	{
+		const auto localResult = SetRetentionBudget( 0 );
+		EAE6320_ASSERT( localResult );
+	}
 	{
 		bool wereThereStillAssets = false;
 
@@ -240,9 +452,11 @@ template <class tAsset>
 		{
 			Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 			{
-				for ( auto& assetRecord : m_assetRecords )
+				const auto assetCount = m_assetRecordCount.load( std::memory_order_relaxed );
+				for ( uint_fast32_t i = 0; i < assetCount; ++i )
 				{
-					if ( assetRecord.asset )
+					auto& assetRecord = GetAssetRecord( i );
+					if ( assetRecord.asset.load( std::memory_order_relaxed ) || ( assetRecord.referenceCount > 0 ) )
 					{
 						EAE6320_ASSERTF( false, "A manager still has a record of an asset that hasn't been released" );
 						result = Results::Failure;
@@ -250,17 +464,25 @@ template <class tAsset>
 						// The asset's reference count could be decremented until it gets destroyed,
 						// but there's no way of knowing that the asset still isn't being used
 						// and so the asset will leak
-						assetRecord.asset = nullptr;
 						// The following shouldn't be necessary since the manager is being cleaned up,
 						// but it doesn't hurt to be safe
-						assetRecord.id = cHandle<tAsset>::IncrementId( assetRecord.id );
+						assetRecord.SetIdAndLoadState( cHandle<tAsset>::IncrementId( assetRecord.GetId() ), eLoadState::Failed );
+						assetRecord.asset.store( nullptr, std::memory_order_release );
 						assetRecord.referenceCount = 0;
+						assetRecord.callbacksWhenLoaded.clear();
 					}
 				}
 
-				m_assetRecords.clear();
+				// Every handle is invalid once the records have been freed
+				m_assetRecordCount.store( 0, std::memory_order_release );
+				for ( auto& assetRecordSegment : m_assetRecordSegments )
+				{
+					delete [] assetRecordSegment.exchange( nullptr, std::memory_order_acq_rel );
+				}
 				m_unusedAssetRecordIndices.clear();
-				m_map_pathsToHandles.clear();
+				m_pathEntries.clear();
+				m_pathEntryCount = 0;
+				m_contentEntries.clear();
 			}
 		}
 
@@ -284,11 +506,422 @@ template <class tAsset>
 //===============
 
 template <class tAsset>
-	eae6320::Assets::cManager<tAsset>::sAssetRecord::sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount )
-	:
-	asset( i_asset ), id( i_id ), referenceCount( i_referenceCount )
+	typename eae6320::Assets::cManager<tAsset>::sAssetRecord& eae6320::Assets::cManager<tAsset>::GetAssetRecord( const uint_fast32_t i_index ) const
+{
+	auto* const assetRecordSegment = m_assetRecordSegments[i_index / s_assetRecordsPerSegment].load( std::memory_order_acquire );
+	EAE6320_ASSERT( assetRecordSegment );
+	return assetRecordSegment[i_index % s_assetRecordsPerSegment];
+}
+
+template <class tAsset>
+	typename eae6320::Assets::cManager<tAsset>::sAssetRecord* eae6320::Assets::cManager<tAsset>::FindAssetRecord( const cHandle<tAsset> i_handle )
+{
+	const auto index = i_handle.GetIndex();
+	if ( index < m_assetRecordCount.load( std::memory_order_relaxed ) )
+	{
+		auto& assetRecord = GetAssetRecord( index );
+		if ( ( i_handle.GetId() == assetRecord.GetId() ) && ( assetRecord.referenceCount > 0 ) )
+		{
+			return &assetRecord;
+		}
+	}
+	return nullptr;
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::FindExistingAsset( const cPathId i_pathId, cHandle<tAsset>& o_handle,
+		ContentManifest::sContent& o_content )
+{
+	auto result = Results::Success;
+
+	o_handle = cHandle<tAsset>();
+	o_content = ContentManifest::sContent();
+	if ( m_pathEntryCount > 0 )
+	{
+		const auto& pathEntry = FindPathEntry( i_pathId );
+		if ( pathEntry.pathId )
+		{
+			if ( !( result = ReferenceExistingAsset( pathEntry.handle, i_pathId, o_handle ) ) || o_handle )
+			{
+				return result;
+			}
+		}
+	}
+	// A different path with the same content may have already been loaded
+	if ( m_isContentDeduplicationEnabled )
+	{
+		const auto path = m_contentDirectory + i_pathId.GetPath();
+		if ( ContentManifest::FindContent( path.c_str(), o_content ) )
+		{
+			const auto iterator = m_contentEntries.find( o_content.hash );
+			if ( iterator != m_contentEntries.end() )
+			{
+				const auto existingHandle = iterator->second;
+				const auto index = existingHandle.GetIndex();
+				// Files are only the same if their sizes also match
+				if ( ( index < m_assetRecordCount.load( std::memory_order_relaxed ) ) && ( GetAssetRecord( index ).content == o_content ) )
+				{
+					if ( !( result = ReferenceExistingAsset( existingHandle, i_pathId, o_handle ) ) )
+					{
+						return result;
+					}
+					if ( o_handle )
+					{
+						// The path now refers to the shared record
+						// so that loading it again doesn't need to look up its content
+						SetPathEntry( i_pathId, o_handle );
+						const auto& assetRecord = GetAssetRecord( index );
+						const auto* const asset = ( assetRecord.GetLoadState() == eLoadState::Loaded ) ?
+							assetRecord.asset.load( std::memory_order_relaxed ) : nullptr;
+						ContentManifest::RecordSharedLoad( asset ? asset->GetMemorySize() : static_cast<size_t>( o_content.size ) );
+						return result;
+					}
+				}
+			}
+		}
+	}
+	// A new asset will have to be created
+	++m_cacheStatistics.missCount;
+	return result;
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::ReferenceExistingAsset( const cHandle<tAsset> i_existingHandle, const cPathId i_pathId,
+		cHandle<tAsset>& o_handle )
+{
+	o_handle = cHandle<tAsset>();
+	// Even if an entry exists it may no longer be valid
+	// (entries aren't removed when an asset is deleted,
+	// and an asset that failed to load is attempted again)
+	// A retained asset doesn't have any references
+	// but its record still matches the entry's handle
+	{
+		const auto index = i_existingHandle.GetIndex();
+		if ( index < m_assetRecordCount.load( std::memory_order_relaxed ) )
+		{
+			auto& assetRecord = GetAssetRecord( index );
+			if ( ( assetRecord.GetId() == i_existingHandle.GetId() ) && ( assetRecord.GetLoadState() == eLoadState::Retained ) )
+			{
+				EAE6320_ASSERT( assetRecord.referenceCount == 0 );
+				UnlinkRetainedAsset( assetRecord );
+				assetRecord.referenceCount = 1;
+				// The asset has been in the record the whole time,
+				// and changing the load state publishes it to Get() again
+				assetRecord.SetIdAndLoadState( assetRecord.GetId(), eLoadState::Loaded );
+				++m_cacheStatistics.hitCount;
+				o_handle = i_existingHandle;
+				return Results::Success;
+			}
+		}
+	}
+	auto* const assetRecord = FindAssetRecord( i_existingHandle );
+	if ( assetRecord && ( assetRecord->GetLoadState() != eLoadState::Failed ) )
+	{
+		EAE6320_ASSERT( assetRecord->asset.load( std::memory_order_relaxed ) || ( assetRecord->GetLoadState() == eLoadState::Pending ) );
+		const auto referenceCount = assetRecord->referenceCount;
+		if ( referenceCount < std::numeric_limits<decltype( assetRecord->referenceCount )>::max() )
+		{
+			assetRecord->referenceCount = referenceCount + 1;
+			o_handle = i_existingHandle;
+			return Results::Success;
+		}
+		else
+		{
+			EAE6320_ASSERTF( false,
+				"The asset \"%s\" has been loaded too many times (the manager's reference count is too big)", i_pathId.GetPath() );
+			Logging::OutputError( "A new instance of \"%s\" couldn't be loaded because the manager's reference count was too big", i_pathId.GetPath() );
+			return Results::Failure;
+		}
+	}
+	return Results::Success;
+}
+
+template <class tAsset>
+	eae6320::cResult eae6320::Assets::cManager<tAsset>::CreateAssetRecord( const cPathId i_pathId, const ContentManifest::sContent& i_content,
+		tAsset* const i_asset, const eLoadState i_loadState, cHandle<tAsset>& o_handle )
+{
+	auto result = Results::Success;
+
+	// Look for an existing asset record that is unused
+	if ( !m_unusedAssetRecordIndices.empty() )
+	{
+		const auto index = m_unusedAssetRecordIndices.back();
+		{
+			m_unusedAssetRecordIndices.pop_back();
+		}
+		auto& assetRecord = GetAssetRecord( index );
+		{
+			assetRecord.asset.store( i_asset, std::memory_order_relaxed );
+			assetRecord.referenceCount = 1;
+			assetRecord.pathId = i_pathId;
+			assetRecord.content = i_content;
+			// Setting the load state publishes the asset to Get()
+			assetRecord.SetIdAndLoadState( assetRecord.GetId(), i_loadState );
+		}
+		o_handle = cHandle<tAsset>( index, assetRecord.GetId() );
+	}
+	else
+	{
+		// Create a new asset record
+		const auto assetRecordCount = m_assetRecordCount.load( std::memory_order_relaxed );
+		if ( assetRecordCount < cHandle<tAsset>::InvalidIndex )
+		{
+			// Allocate a new segment if the existing ones are full
+			const auto segmentIndex = assetRecordCount / s_assetRecordsPerSegment;
+			if ( !m_assetRecordSegments[segmentIndex].load( std::memory_order_relaxed ) )
+			{
+				auto* const newSegment = new ( std::nothrow ) sAssetRecord[s_assetRecordsPerSegment];
+				if ( !newSegment )
+				{
+					result = Results::OutOfMemory;
+					EAE6320_ASSERTF( false, "Couldn't allocate memory for more asset records" );
+					Logging::OutputError( "A new asset couldn't be loaded because memory for its record couldn't be allocated" );
+					return result;
+				}
+				m_assetRecordSegments[segmentIndex].store( newSegment, std::memory_order_release );
+			}
+			constexpr uint16_t id = 0;
+			{
+				auto& assetRecord = GetAssetRecord( assetRecordCount );
+				assetRecord.asset.store( i_asset, std::memory_order_relaxed );
+				assetRecord.referenceCount = 1;
+				assetRecord.pathId = i_pathId;
+				assetRecord.content = i_content;
+				assetRecord.SetIdAndLoadState( id, i_loadState );
+			}
+			// Incrementing the count publishes the record to Get()
+			m_assetRecordCount.store( static_cast<uint32_t>( assetRecordCount + 1 ), std::memory_order_release );
+			{
+				const auto index = static_cast<uint_fast32_t>( assetRecordCount );
+				o_handle = cHandle<tAsset>( index, id );
+			}
+		}
+		else
+		{
+			result = Results::OutOfMemory;
+			EAE6320_ASSERTF( false, "Too many of this kind of asset have been created" );
+			Logging::OutputError( "A new asset couldn't be loaded because there were too many (%u)", assetRecordCount );
+		}
+	}
+	if ( result )
+	{
+		SetPathEntry( i_pathId, o_handle );
+		// Other paths with the same content can now find the record
+		if ( i_content.IsValid() )
+		{
+			m_contentEntries[i_content.hash] = o_handle;
+		}
+	}
+
+	return result;
+}
+
+template <class tAsset>
+	typename eae6320::Assets::cManager<tAsset>::sPathEntry& eae6320::Assets::cManager<tAsset>::FindPathEntry( const cPathId i_pathId )
+{
+	EAE6320_ASSERT( !m_pathEntries.empty() );
+	// Path IDs are interned, and so two path IDs with the same hash are only the same path if they are the same path ID
+	const auto mask = m_pathEntries.size() - 1;
+	for ( auto i = static_cast<size_t>( i_pathId.GetHash() ) & mask; ; i = ( i + 1 ) & mask )
+	{
+		auto& pathEntry = m_pathEntries[i];
+		if ( !pathEntry.pathId || ( pathEntry.pathId == i_pathId ) )
+		{
+			return pathEntry;
+		}
+	}
+}
+
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::SetPathEntry( const cPathId i_pathId, const cHandle<tAsset> i_handle )
 {
+	// Keep the table at most half full so that probe sequences stay short
+	if ( ( ( m_pathEntryCount + 1 ) * 2 ) > m_pathEntries.size() )
+	{
+		GrowPathEntries();
+	}
+	auto& pathEntry = FindPathEntry( i_pathId );
+	if ( !pathEntry.pathId )
+	{
+		pathEntry.pathId = i_pathId;
+		++m_pathEntryCount;
+	}
+	// If the entry already existed its previous handle is no longer valid
+	pathEntry.handle = i_handle;
+}
 
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::GrowPathEntries()
+{
+	constexpr size_t initialPathEntryCount = 64;
+	std::vector<sPathEntry> previousPathEntries( m_pathEntries.empty() ? initialPathEntryCount : ( m_pathEntries.size() * 2 ) );
+	std::swap( previousPathEntries, m_pathEntries );
+	for ( const auto& previousPathEntry : previousPathEntries )
+	{
+		if ( previousPathEntry.pathId )
+		{
+			FindPathEntry( previousPathEntry.pathId ) = previousPathEntry;
+		}
+	}
+}
+
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::FreeAssetRecord( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	const auto loadState = assetRecord.GetLoadState();
+	auto* const asset = ( ( loadState == eLoadState::Loaded ) || ( loadState == eLoadState::Retained ) ) ?
+		assetRecord.asset.load( std::memory_order_relaxed ) : nullptr;
+	EAE6320_ASSERT( asset || ( loadState == eLoadState::Pending ) || ( loadState == eLoadState::Failed ) );
+	assetRecord.referenceCount = 0;
+	assetRecord.callbacksWhenLoaded.clear();
+	// The existing asset record has already been allocated,
+	// and can be re-used for a new asset
+	// (the ID is changed before the asset is cleared so that Get() can't return a cleared asset)
+	{
+		assetRecord.SetIdAndLoadState( cHandle<tAsset>::IncrementId( assetRecord.GetId() ), eLoadState::Failed );
+		assetRecord.asset.store( nullptr, std::memory_order_release );
+		m_unusedAssetRecordIndices.push_back( static_cast<uint16_t>( i_index ) );
+	}
+	if ( asset )
+	{
+		asset->DecrementReferenceCount();
+	}
+}
+
+template <class tAsset>
+	bool eae6320::Assets::cManager<tAsset>::RetainAsset( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	if ( ( m_retentionBudget == 0 ) || ( assetRecord.GetLoadState() != eLoadState::Loaded ) )
+	{
+		return false;
+	}
+	const auto* const asset = assetRecord.asset.load( std::memory_order_relaxed );
+	EAE6320_ASSERT( asset );
+	const auto byteCount = asset->GetMemorySize();
+	if ( byteCount > m_retentionBudget )
+	{
+		return false;
+	}
+	// The ID is changed so that the released handles can't be used to get the retained asset,
+	// and the path's entry is updated so that loading the path again finds it
+	// (any other paths that shared the asset find it through its content entry)
+	{
+		const auto id = cHandle<tAsset>::IncrementId( assetRecord.GetId() );
+		assetRecord.SetIdAndLoadState( id, eLoadState::Retained );
+		const cHandle<tAsset> retainedHandle( i_index, id );
+		FindPathEntry( assetRecord.pathId ).handle = retainedHandle;
+		if ( assetRecord.content.IsValid() )
+		{
+			const auto iterator = m_contentEntries.find( assetRecord.content.hash );
+			if ( ( iterator != m_contentEntries.end() ) && ( iterator->second.GetIndex() == i_index ) )
+			{
+				iterator->second = retainedHandle;
+			}
+		}
+	}
+	// Add the record to the most recently released end of the list
+	{
+		assetRecord.retainedByteCount = byteCount;
+		assetRecord.index_previousRetained = m_index_mostRecentlyRetained;
+		assetRecord.index_nextRetained = cHandle<tAsset>::InvalidIndex;
+		if ( m_index_mostRecentlyRetained != cHandle<tAsset>::InvalidIndex )
+		{
+			GetAssetRecord( m_index_mostRecentlyRetained ).index_nextRetained = static_cast<uint32_t>( i_index );
+		}
+		else
+		{
+			m_index_leastRecentlyRetained = static_cast<uint32_t>( i_index );
+		}
+		m_index_mostRecentlyRetained = static_cast<uint32_t>( i_index );
+		++m_cacheStatistics.retainedAssetCount;
+		m_cacheStatistics.retainedByteCount += byteCount;
+	}
+	EvictRetainedAssets( m_retentionBudget );
+	return true;
+}
+
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::UnlinkRetainedAsset( sAssetRecord& io_assetRecord )
+{
+	EAE6320_ASSERT( io_assetRecord.GetLoadState() == eLoadState::Retained );
+	if ( io_assetRecord.index_previousRetained != cHandle<tAsset>::InvalidIndex )
+	{
+		GetAssetRecord( io_assetRecord.index_previousRetained ).index_nextRetained = io_assetRecord.index_nextRetained;
+	}
+	else
+	{
+		m_index_leastRecentlyRetained = io_assetRecord.index_nextRetained;
+	}
+	if ( io_assetRecord.index_nextRetained != cHandle<tAsset>::InvalidIndex )
+	{
+		GetAssetRecord( io_assetRecord.index_nextRetained ).index_previousRetained = io_assetRecord.index_previousRetained;
+	}
+	else
+	{
+		m_index_mostRecentlyRetained = io_assetRecord.index_previousRetained;
+	}
+	io_assetRecord.index_previousRetained = io_assetRecord.index_nextRetained = cHandle<tAsset>::InvalidIndex;
+	EAE6320_ASSERT( m_cacheStatistics.retainedAssetCount > 0 );
+	EAE6320_ASSERT( m_cacheStatistics.retainedByteCount >= io_assetRecord.retainedByteCount );
+	--m_cacheStatistics.retainedAssetCount;
+	m_cacheStatistics.retainedByteCount -= io_assetRecord.retainedByteCount;
+	io_assetRecord.retainedByteCount = 0;
+}
+
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::EvictRetainedAssets( const size_t i_budget_inBytes )
+{
+	while ( ( m_cacheStatistics.retainedByteCount > i_budget_inBytes )
+		|| ( ( i_budget_inBytes == 0 ) && ( m_index_leastRecentlyRetained != cHandle<tAsset>::InvalidIndex ) ) )
+	{
+		const auto index = m_index_leastRecentlyRetained;
+		EAE6320_ASSERT( index != cHandle<tAsset>::InvalidIndex );
+		UnlinkRetainedAsset( GetAssetRecord( index ) );
+		FreeAssetRecord( index );
+	}
+}
+
+template <class tAsset>
+	void eae6320::Assets::cManager<tAsset>::OnAsyncLoadFinished( const cHandle<tAsset> i_handle, const cResult i_result, tAsset* const i_asset )
+{
+	std::vector<fCallbackWhenLoaded> callbacksWhenLoaded;
+	auto* assetToRelease = i_asset;
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			// If every handle was released while the asset was loading the record won't be found
+			// and the asset is no longer needed
+			auto* const assetRecord = FindAssetRecord( i_handle );
+			if ( assetRecord )
+			{
+				EAE6320_ASSERT( assetRecord->GetLoadState() == eLoadState::Pending );
+				if ( i_result )
+				{
+					EAE6320_ASSERT( i_asset );
+					// The asset must be set before the load state so that Get() never sees a loaded record without it
+					assetRecord->asset.store( i_asset, std::memory_order_relaxed );
+					assetRecord->SetIdAndLoadState( assetRecord->GetId(), eLoadState::Loaded );
+					assetToRelease = nullptr;
+				}
+				else
+				{
+					assetRecord->SetIdAndLoadState( assetRecord->GetId(), eLoadState::Failed );
+				}
+				std::swap( callbacksWhenLoaded, assetRecord->callbacksWhenLoaded );
+			}
+		}
+	}
+	if ( assetToRelease )
+	{
+		assetToRelease->DecrementReferenceCount();
+	}
+	for ( const auto& callbackWhenLoaded : callbacksWhenLoaded )
+	{
+		callbackWhenLoaded( i_result );
+	}
 }
 
 #endif	// EAE6320_ASSETS_CMANAGER_INL
@@ -0,0 +1,170 @@
+// Include Files
+//==============
+
+#include "cPathId.h"
+
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <memory>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	using sInternedPath = eae6320::Assets::cPathId::sInternedPath;
+
+	// The interned strings and their records are stored in deques so that they never move
+	std::deque<std::unique_ptr<char[]>> s_internedStrings;
+	std::deque<sInternedPath> s_internedPaths;
+	// This is an open-addressing hash table (with linear probing) of the interned paths.
+	// Its size is always a power of two and it is never more than half full.
+	struct sInternedPathTable
+	{
+		std::unique_ptr<std::atomic<const sInternedPath*>[]> slots;
+		size_t size;
+	};
+	// Paths that have already been interned are found without taking the lock:
+	//	* A slot is only ever changed once (from null to an interned path)
+	//	* When the table grows a bigger one is filled and then published,
+	//		and the previous ones are kept (but never changed again)
+	//		so that a thread that is still looking in one of them doesn't read freed memory
+	// A thread that doesn't find a path in an older table takes the lock and looks again.
+	std::deque<sInternedPathTable> s_internedPathTables;
+	std::atomic<const sInternedPathTable*> s_internedPathTable( nullptr );
+	eae6320::Concurrency::cMutex s_mutex{ "Assets::cPathId" };
+
+	constexpr size_t s_initialInternedPathTableSize = 256;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Returns the interned path,
+	// or null if it isn't in the table (in which case o_slotIndex is the empty slot where it should be inserted)
+	const sInternedPath* FindInternedPath( const sInternedPathTable& i_table,
+		const char* const i_path, const size_t i_length, const uint64_t i_hash, size_t& o_slotIndex );
+	// This must only be called while the lock is held
+	void GrowInternedPathTable();
+}
+
+// Interface
+//==========
+
+// Interning
+//----------
+
+eae6320::Assets::cPathId eae6320::Assets::cPathId::Intern( const char* const i_path )
+{
+	EAE6320_ASSERT( i_path );
+	const auto length = std::strlen( i_path );
+	return Intern( i_path, length, CalculatePathHash( i_path, length ) );
+}
+
+eae6320::Assets::cPathId eae6320::Assets::cPathId::Intern( const sPrehashedPath& i_path )
+{
+	return Intern( i_path.path, i_path.length, i_path.hash );
+}
+
+// Implementation
+//===============
+
+eae6320::Assets::cPathId eae6320::Assets::cPathId::Intern( const char* const i_path, const size_t i_length, const uint64_t i_hash )
+{
+	// Almost every path has already been interned,
+	// and so the table is checked without taking the lock first
+	size_t slotIndex;
+	if ( const auto* const table = s_internedPathTable.load( std::memory_order_acquire ) )
+	{
+		if ( const auto* const internedPath = FindInternedPath( *table, i_path, i_length, i_hash, slotIndex ) )
+		{
+			return cPathId( internedPath );
+		}
+	}
+
+	Concurrency::cMutex::cScopeLock autoLock( s_mutex );
+
+	if ( !s_internedPathTable.load( std::memory_order_relaxed ) )
+	{
+		GrowInternedPathTable();
+	}
+	// Another thread might have interned the path while this one was waiting for the lock
+	if ( const auto* const internedPath = FindInternedPath( *s_internedPathTable.load( std::memory_order_relaxed ), i_path, i_length, i_hash, slotIndex ) )
+	{
+		return cPathId( internedPath );
+	}
+	// Keep the table at most half full so that probe sequences stay short
+	if ( ( ( s_internedPaths.size() + 1 ) * 2 ) > s_internedPathTable.load( std::memory_order_relaxed )->size )
+	{
+		GrowInternedPathTable();
+	}
+	{
+		std::unique_ptr<char[]> internedString( new char[i_length + 1] );
+		std::memcpy( internedString.get(), i_path, i_length );
+		internedString[i_length] = '\0';
+		s_internedPaths.push_back( sInternedPath{ i_hash, i_length, internedString.get() } );
+		s_internedStrings.push_back( std::move( internedString ) );
+	}
+	const auto& table = *s_internedPathTable.load( std::memory_order_relaxed );
+	const auto* const existingPath = FindInternedPath( table, i_path, i_length, i_hash, slotIndex );
+	EAE6320_ASSERT( !existingPath );
+	const auto* const internedPath = &s_internedPaths.back();
+	// The release makes sure that a thread that finds the path without the lock also sees its string
+	table.slots[slotIndex].store( internedPath, std::memory_order_release );
+	return cPathId( internedPath );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const sInternedPath* FindInternedPath( const sInternedPathTable& i_table,
+		const char* const i_path, const size_t i_length, const uint64_t i_hash, size_t& o_slotIndex )
+	{
+		const auto mask = i_table.size - 1;
+		for ( auto i = static_cast<size_t>( i_hash ) & mask; ; i = ( i + 1 ) & mask )
+		{
+			const auto* const internedPath = i_table.slots[i].load( std::memory_order_acquire );
+			if ( !internedPath )
+			{
+				o_slotIndex = i;
+				return nullptr;
+			}
+			// Two different paths can have the same hash,
+			// and so a path is only the same if its string is also the same
+			if ( ( internedPath->hash == i_hash ) && ( internedPath->length == i_length )
+				&& ( std::memcmp( internedPath->path, i_path, i_length ) == 0 ) )
+			{
+				return internedPath;
+			}
+		}
+	}
+
+	void GrowInternedPathTable()
+	{
+		const auto* const previousTable = s_internedPathTable.load( std::memory_order_relaxed );
+		const auto size = previousTable ? ( previousTable->size * 2 ) : s_initialInternedPathTableSize;
+		s_internedPathTables.push_back( sInternedPathTable{ std::unique_ptr<std::atomic<const sInternedPath*>[]>(
+			new std::atomic<const sInternedPath*>[size] ), size } );
+		auto& table = s_internedPathTables.back();
+		for ( size_t i = 0; i < size; ++i )
+		{
+			table.slots[i].store( nullptr, std::memory_order_relaxed );
+		}
+		for ( const auto& internedPath : s_internedPaths )
+		{
+			size_t slotIndex;
+			const auto* const existingPath = FindInternedPath( table, internedPath.path, internedPath.length, internedPath.hash, slotIndex );
+			EAE6320_ASSERT( !existingPath );
+			table.slots[slotIndex].store( &internedPath, std::memory_order_relaxed );
+		}
+		// The release makes sure that a thread that finds the new table without the lock also sees its contents
+		s_internedPathTable.store( &table, std::memory_order_release );
+	}
+}
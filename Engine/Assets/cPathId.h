@@ -0,0 +1,129 @@
+/*
+	A path ID is an interned asset path
+
+	Every path ID made from the same path refers to the same interned string,
+	and so path IDs can be compared and hashed without looking at the string:
+		* The hash of a path is calculated once when it is interned
+			(or at compile time for string literals)
+		* Two path IDs are the same path if and only if they point to the same interned string
+			(the interning table verifies that paths with the same hash really are the same string)
+	An asset manager can be given a path ID instead of a path,
+	which skips every string operation when the asset has already been loaded.
+*/
+
+#ifndef EAE6320_ASSETS_CPATHID_H
+#define EAE6320_ASSETS_CPATHID_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		// Hashing
+		//--------
+
+		// This is the 64-bit FNV-1a hash of the path
+		// (paths are hashed exactly as they are written)
+		constexpr uint64_t CalculatePathHash( const char* const i_path, const size_t i_length )
+		{
+			uint64_t hash = 0xcbf29ce484222325;
+			for ( size_t i = 0; i < i_length; ++i )
+			{
+				hash = ( hash ^ static_cast<uint8_t>( i_path[i] ) ) * 0x100000001b3;
+			}
+			return hash;
+		}
+
+		// A string literal can be hashed at compile time
+		// (e.g. constexpr sPrehashedPath path( "Cube.binmsh" );)
+		struct sPrehashedPath
+		{
+			const char* path;
+			size_t length;
+			uint64_t hash;
+
+			template <size_t tLength>
+				constexpr sPrehashedPath( const char ( &i_path )[tLength] )
+				:
+				path( i_path ), length( tLength - 1 ), hash( CalculatePathHash( i_path, tLength - 1 ) )
+			{
+
+			}
+		};
+
+		// Class Declaration
+		//==================
+
+		class cPathId
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Interning
+			//----------
+
+			// These return the path ID for the path, interning it if it hasn't been already.
+			// They are thread-safe, and the interned string is valid until the program exits.
+			// Looking up a path that has already been interned doesn't take a lock.
+			static cPathId Intern( const char* const i_path );
+			static cPathId Intern( const sPrehashedPath& i_path );
+
+			// Access
+			//-------
+
+			bool IsValid() const { return m_internedPath != nullptr; }
+			operator bool() const { return IsValid(); }
+
+			// These must only be called on a valid path ID
+			uint64_t GetHash() const { return m_internedPath->hash; }
+			const char* GetPath() const { return m_internedPath->path; }
+			size_t GetLength() const { return m_internedPath->length; }
+
+			bool operator ==( const cPathId i_rhs ) const { return m_internedPath == i_rhs.m_internedPath; }
+			bool operator !=( const cPathId i_rhs ) const { return m_internedPath != i_rhs.m_internedPath; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cPathId() = default;
+
+			// Data
+			//=====
+
+		public:
+
+			// Interned paths are never freed or moved
+			// (this is only public so that the interning table can store them)
+			struct sInternedPath
+			{
+				uint64_t hash;
+				size_t length;
+				const char* path;
+			};
+
+		private:
+
+			const sInternedPath* m_internedPath = nullptr;
+
+			// Implementation
+			//===============
+
+		private:
+
+			cPathId( const sInternedPath* const i_internedPath ) : m_internedPath( i_internedPath ) {}
+			static cPathId Intern( const char* const i_path, const size_t i_length, const uint64_t i_hash );
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETS_CPATHID_H
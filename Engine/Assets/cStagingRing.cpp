@@ -0,0 +1,181 @@
+// Include Files
+//==============
+
+#include "cStagingRing.h"
+
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every allocation starts at this alignment
+	// so that the staged data can be copied or read with any type
+	constexpr size_t s_alignment = 16;
+}
+
+// Interface
+//==========
+
+// Allocation
+//-----------
+
+void* eae6320::Assets::cStagingRing::Allocate( const size_t i_size )
+{
+	if ( ( i_size == 0 ) || ( i_size > m_capacity ) )
+	{
+		return nullptr;
+	}
+	const auto size = ( i_size + ( s_alignment - 1 ) ) & ~( s_alignment - 1 );
+
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	size_t offset = 0;
+	if ( m_allocations.empty() )
+	{
+		// When nothing is allocated the whole ring is free
+		m_nextOffset = 0;
+		offset = 0;
+	}
+	else
+	{
+		const auto oldestOffset = m_allocations.front().offset;
+		if ( m_nextOffset > oldestOffset )
+		{
+			// The free memory is after the newest allocation and before the oldest one
+			if ( ( m_capacity - m_nextOffset ) >= size )
+			{
+				offset = m_nextOffset;
+			}
+			else if ( oldestOffset >= size )
+			{
+				// The memory at the end of the ring is skipped
+				// and becomes usable again once the oldest allocation is freed
+				offset = 0;
+			}
+			else
+			{
+				return nullptr;
+			}
+		}
+		else if ( ( oldestOffset - m_nextOffset ) >= size )
+		{
+			// The newest allocations have already wrapped around
+			// (if the offsets are equal the ring is full)
+			offset = m_nextOffset;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+	sAllocation allocation;
+	{
+		allocation.offset = offset;
+		allocation.size = size;
+		allocation.isFree = false;
+	}
+	m_allocations.push_back( allocation );
+	m_nextOffset = offset + size;
+	if ( m_nextOffset == m_capacity )
+	{
+		m_nextOffset = 0;
+	}
+	return m_memory + offset;
+}
+
+void eae6320::Assets::cStagingRing::Free( void* const i_memory )
+{
+	if ( !i_memory )
+	{
+		return;
+	}
+	EAE6320_ASSERTF( Contains( i_memory ), "Memory that wasn't allocated from a staging ring can't be freed by it" );
+	const auto offset = static_cast<size_t>( static_cast<uint8_t*>( i_memory ) - m_memory );
+
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	// Allocations are usually freed in roughly the order that they were made,
+	// and so the search starts with the oldest
+	for ( auto& allocation : m_allocations )
+	{
+		if ( allocation.offset == offset )
+		{
+			EAE6320_ASSERTF( !allocation.isFree, "Staging memory was freed twice" );
+			allocation.isFree = true;
+			break;
+		}
+	}
+	// Memory can be reused once every allocation before it has been freed
+	while ( !m_allocations.empty() && m_allocations.front().isFree )
+	{
+		m_allocations.pop_front();
+	}
+}
+
+// Access
+//-------
+
+size_t eae6320::Assets::cStagingRing::GetUsedByteCount() const
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	if ( m_allocations.empty() )
+	{
+		return 0;
+	}
+	const auto oldestOffset = m_allocations.front().offset;
+	return ( m_nextOffset > oldestOffset ) ? ( m_nextOffset - oldestOffset ) : ( ( m_capacity - oldestOffset ) + m_nextOffset );
+}
+
+bool eae6320::Assets::cStagingRing::Contains( const void* const i_memory ) const
+{
+	const auto* const memory = static_cast<const uint8_t*>( i_memory );
+	return m_memory && ( memory >= m_memory ) && ( memory < ( m_memory + m_capacity ) );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::cStagingRing::Initialize( const size_t i_capacity )
+{
+	EAE6320_ASSERTF( !m_memory, "A staging ring can only be initialized once" );
+	const auto capacity = i_capacity & ~( s_alignment - 1 );
+	if ( capacity == 0 )
+	{
+		EAE6320_ASSERTF( false, "A staging ring must have room for at least %u bytes", static_cast<unsigned int>( s_alignment ) );
+		Logging::OutputError( "A staging ring can't have a capacity of %u bytes", static_cast<unsigned int>( i_capacity ) );
+		return Results::Failure;
+	}
+	m_memory = static_cast<uint8_t*>( malloc( capacity ) );
+	if ( !m_memory )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate %u bytes for a staging ring", static_cast<unsigned int>( capacity ) );
+		Logging::OutputError( "Failed to allocate %u bytes for a staging ring", static_cast<unsigned int>( capacity ) );
+		return Results::OutOfMemory;
+	}
+	m_capacity = capacity;
+	m_nextOffset = 0;
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cStagingRing::CleanUp()
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	EAE6320_ASSERTF( m_allocations.empty(), "%u staging allocations weren't freed", static_cast<unsigned int>( m_allocations.size() ) );
+	m_allocations.clear();
+	if ( m_memory )
+	{
+		free( m_memory );
+		m_memory = nullptr;
+	}
+	m_capacity = 0;
+	m_nextOffset = 0;
+	return Results::Success;
+}
+
+eae6320::Assets::cStagingRing::~cStagingRing()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
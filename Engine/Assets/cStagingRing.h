@@ -0,0 +1,91 @@
+/*
+	A staging ring is a fixed amount of memory that data waiting to be uploaded is staged in
+
+	Memory is allocated from the ring in the order that it is requested
+	and the same memory is reused once the data in it has been uploaded:
+		* Allocations can be freed in any order,
+			but memory is only reused once every allocation that was made before it has also been freed
+		* An allocation fails (rather than waiting or growing) when there isn't enough contiguous free memory,
+			and so the amount of staging memory can never exceed the ring's capacity
+	The ring doesn't depend on any platform or graphics code.
+*/
+
+#ifndef EAE6320_ASSETS_CSTAGINGRING_H
+#define EAE6320_ASSETS_CSTAGINGRING_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cStagingRing
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Allocation
+			//-----------
+
+			// These are thread-safe.
+			// Allocate() returns NULL if there isn't enough contiguous free memory
+			// (and always for sizes bigger than the capacity).
+			void* Allocate( const size_t i_size );
+			void Free( void* const i_memory );
+
+			// Access
+			//-------
+
+			size_t GetCapacity() const { return m_capacity; }
+			// This includes any memory that can't be used until the oldest allocations are freed
+			size_t GetUsedByteCount() const;
+			bool Contains( const void* const i_memory ) const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cResult Initialize( const size_t i_capacity );
+			// Every allocation must have been freed
+			cResult CleanUp();
+
+			cStagingRing() = default;
+			~cStagingRing();
+
+			cStagingRing( const cStagingRing& ) = delete;
+			cStagingRing& operator =( const cStagingRing& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			struct sAllocation
+			{
+				size_t offset;
+				size_t size;
+				bool isFree;
+			};
+			// The allocations that haven't been reused yet, oldest first
+			std::deque<sAllocation> m_allocations;
+			uint8_t* m_memory = nullptr;
+			size_t m_capacity = 0;
+			// The offset that the next allocation will start at if it fits
+			size_t m_nextOffset = 0;
+			mutable Concurrency::cMutex m_mutex{ "Assets::cStagingRing" };
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETS_CSTAGINGRING_H
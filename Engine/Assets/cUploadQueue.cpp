@@ -0,0 +1,205 @@
+// Include Files
+//==============
+
+#include "cUploadQueue.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <utility>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Uploads that are run immediately can finish in any order
+	// and so the last completed fence only ever increases
+	void MarkFenceAsCompleted( std::atomic<eae6320::Assets::cUploadQueue::tFence>& io_lastCompletedFence,
+		const eae6320::Assets::cUploadQueue::tFence i_fence );
+}
+
+// Interface
+//==========
+
+// Uploads
+//--------
+
+eae6320::Assets::cUploadQueue::tFence eae6320::Assets::cUploadQueue::Enqueue( const size_t i_byteCount, const fUpload& i_upload )
+{
+	tFence fence = 0;
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		fence = ++m_lastQueuedFence;
+		if ( m_isInitialized )
+		{
+			sUpload upload;
+			{
+				upload.upload = i_upload;
+				upload.byteCount = i_byteCount;
+				upload.fence = fence;
+			}
+			m_uploads.push_back( std::move( upload ) );
+			return fence;
+		}
+	}
+	i_upload();
+	MarkFenceAsCompleted( m_lastCompletedFence, fence );
+	return fence;
+}
+
+bool eae6320::Assets::cUploadQueue::HasCompleted( const tFence i_fence ) const
+{
+	return i_fence <= m_lastCompletedFence.load( std::memory_order_acquire );
+}
+
+bool eae6320::Assets::cUploadQueue::IsEmpty() const
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	return m_uploads.empty();
+}
+
+// Servicing
+//----------
+
+size_t eae6320::Assets::cUploadQueue::Service()
+{
+	const auto byteBudget = GetByteBudgetPerService();
+	size_t uploadedByteCount = 0;
+	// At least one upload is always run
+	// so that an upload that is bigger than the budget is still run eventually
+	if ( !RunNextUpload( uploadedByteCount ) )
+	{
+		return uploadedByteCount;
+	}
+	while ( uploadedByteCount < byteBudget )
+	{
+		if ( !RunNextUpload( uploadedByteCount ) )
+		{
+			return uploadedByteCount;
+		}
+	}
+	// If the budget stopped the queue from being emptied the rest will be run the next time
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		if ( !m_uploads.empty() )
+		{
+			++m_statistics.deferredServiceCount;
+		}
+	}
+	return uploadedByteCount;
+}
+
+void eae6320::Assets::cUploadQueue::Flush( const tFence i_fence )
+{
+	size_t uploadedByteCount = 0;
+	while ( !HasCompleted( i_fence ) && RunNextUpload( uploadedByteCount ) )
+	{
+
+	}
+}
+
+void eae6320::Assets::cUploadQueue::Flush()
+{
+	size_t uploadedByteCount = 0;
+	while ( RunNextUpload( uploadedByteCount ) )
+	{
+
+	}
+}
+
+// Budget
+//-------
+
+void eae6320::Assets::cUploadQueue::SetByteBudgetPerService( const size_t i_byteBudget )
+{
+	m_byteBudgetPerService.store( i_byteBudget, std::memory_order_relaxed );
+}
+
+eae6320::Assets::cUploadQueue::sStatistics eae6320::Assets::cUploadQueue::GetStatistics() const
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	return m_statistics;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Assets::cUploadQueue::Initialize( const size_t i_byteBudgetPerService )
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	EAE6320_ASSERTF( !m_isInitialized, "An upload queue can only be initialized once" );
+	SetByteBudgetPerService( i_byteBudgetPerService );
+	m_statistics = sStatistics();
+	m_isInitialized = true;
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cUploadQueue::CleanUp()
+{
+	// Uploads that are queued while the queue is being flushed are also run
+	// (once the queue is no longer initialized any new uploads will be run immediately)
+	Flush();
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		if ( m_isInitialized )
+		{
+			Logging::OutputMessage( "The upload queue ran %u uploads (%u KB) and deferred uploads to a later frame %u times",
+				static_cast<unsigned int>( m_statistics.uploadCount ), static_cast<unsigned int>( m_statistics.uploadedByteCount / 1024 ),
+				static_cast<unsigned int>( m_statistics.deferredServiceCount ) );
+		}
+		m_isInitialized = false;
+	}
+	Flush();
+	return Results::Success;
+}
+
+eae6320::Assets::cUploadQueue::~cUploadQueue()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+bool eae6320::Assets::cUploadQueue::RunNextUpload( size_t& io_uploadedByteCount )
+{
+	sUpload upload;
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		if ( m_uploads.empty() )
+		{
+			return false;
+		}
+		upload = std::move( m_uploads.front() );
+		m_uploads.pop_front();
+	}
+	// The upload is run without the queue locked
+	// so that it can queue more uploads
+	upload.upload();
+	io_uploadedByteCount += upload.byteCount;
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		++m_statistics.uploadCount;
+		m_statistics.uploadedByteCount += upload.byteCount;
+	}
+	MarkFenceAsCompleted( m_lastCompletedFence, upload.fence );
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void MarkFenceAsCompleted( std::atomic<eae6320::Assets::cUploadQueue::tFence>& io_lastCompletedFence,
+		const eae6320::Assets::cUploadQueue::tFence i_fence )
+	{
+		auto lastCompletedFence = io_lastCompletedFence.load( std::memory_order_relaxed );
+		while ( ( lastCompletedFence < i_fence )
+			&& !io_lastCompletedFence.compare_exchange_weak( lastCompletedFence, i_fence, std::memory_order_release, std::memory_order_relaxed ) )
+		{
+
+		}
+	}
+}
@@ -0,0 +1,128 @@
+/*
+	An upload queue limits how much data the render thread uploads to the GPU every frame
+
+	Any thread can queue an upload, which is a job that creates or updates a GPU resource
+	together with the number of bytes that it uploads:
+		* The render thread services the queue once every frame,
+			running uploads in the order that they were queued until the frame's byte budget has been used
+			(at least one upload is always run so that an upload bigger than the budget can't block the queue)
+		* Queueing an upload returns a fence,
+			and an upload has completed once its fence has been passed
+	The queue only schedules the uploads and doesn't depend on any platform or graphics code,
+	and so it can be used (and tested) without a GPU.
+	Data that is waiting to be uploaded can be staged in a cStagingRing.
+*/
+
+#ifndef EAE6320_ASSETS_CUPLOADQUEUE_H
+#define EAE6320_ASSETS_CUPLOADQUEUE_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Results/Results.h>
+#include <functional>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cUploadQueue
+		{
+			// Interface
+			//==========
+
+		public:
+
+			using fUpload = std::function<void()>;
+			// Fences increase in the order that uploads were queued
+			// (zero is never returned, and so it can be used to mean "no upload")
+			using tFence = uint64_t;
+
+			struct sStatistics
+			{
+				uint64_t uploadCount = 0;
+				uint64_t uploadedByteCount = 0;
+				// The number of times that uploads were left in the queue because the frame's budget had been used
+				uint64_t deferredServiceCount = 0;
+			};
+
+			// Uploads
+			//--------
+
+			// This is thread-safe.
+			// If the queue hasn't been initialized the upload is run immediately.
+			tFence Enqueue( const size_t i_byteCount, const fUpload& i_upload );
+			// This doesn't block
+			bool HasCompleted( const tFence i_fence ) const;
+			bool IsEmpty() const;
+
+			// Servicing
+			//----------
+
+			// These must be called from the thread that runs the uploads (i.e. the render thread).
+			// Service() returns the number of bytes that were uploaded.
+			size_t Service();
+			// Every upload that was queued before the fence is run, regardless of the budget
+			void Flush( const tFence i_fence );
+			void Flush();
+
+			// Budget
+			//-------
+
+			size_t GetByteBudgetPerService() const { return m_byteBudgetPerService.load( std::memory_order_relaxed ); }
+			void SetByteBudgetPerService( const size_t i_byteBudget );
+			sStatistics GetStatistics() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cResult Initialize( const size_t i_byteBudgetPerService );
+			// Every upload that has been queued is run before this returns
+			cResult CleanUp();
+
+			cUploadQueue() = default;
+			~cUploadQueue();
+
+			cUploadQueue( const cUploadQueue& ) = delete;
+			cUploadQueue& operator =( const cUploadQueue& ) = delete;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Runs the oldest upload if there is one
+			// and returns false if there wasn't
+			bool RunNextUpload( size_t& io_uploadedByteCount );
+
+			// Data
+			//=====
+
+		private:
+
+			struct sUpload
+			{
+				fUpload upload;
+				size_t byteCount;
+				tFence fence;
+			};
+			std::deque<sUpload> m_uploads;
+			mutable Concurrency::cMutex m_mutex{ "Assets::cUploadQueue" };
+			tFence m_lastQueuedFence = 0;
+			std::atomic<tFence> m_lastCompletedFence{ 0 };
+			std::atomic<size_t> m_byteBudgetPerService{ 0 };
+			sStatistics m_statistics;
+			bool m_isInitialized = false;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETS_CUPLOADQUEUE_H
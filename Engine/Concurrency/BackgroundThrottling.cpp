@@ -0,0 +1,282 @@
+// Include Files
+//==============
+
+#include "BackgroundThrottling.h"
+
+#include "cEvent.h"
+#include "cMutex.h"
+
+#include <atomic>
+#include <cstddef>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	using ePriority = eae6320::Concurrency::BackgroundThrottling::ePriority;
+	using eFrameThread = eae6320::Concurrency::BackgroundThrottling::eFrameThread;
+	constexpr auto s_priorityCount = static_cast<size_t>( ePriority::Count );
+	constexpr auto s_frameThreadCount = static_cast<size_t>( eFrameThread::Count );
+
+	// Low priority work is throttled when the frame pressure is above the first threshold,
+	// and normal priority work is also throttled when it is above the second
+	constexpr float s_framePressure_toThrottleLowPriorityWork = 0.6f;
+	constexpr float s_framePressure_toThrottleNormalPriorityWork = 0.9f;
+	// When a frame takes less time than the previous ones
+	// the frame pressure only falls by this fraction of the difference
+	// (so that a single fast frame doesn't let all of the background work start again)
+	constexpr float s_framePressureFallRate = 0.1f;
+	// The longest that throttled work of each priority waits before it is run anyway
+	constexpr unsigned int s_maxTimesToThrottle_inMilliseconds[s_priorityCount] = { 0, 50, 500 };
+
+	std::atomic<double> s_secondCount_perFrame( 1.0 / 60.0 );
+	// Each thread only changes its own frame pressure
+	std::atomic<float> s_framePressures[s_frameThreadCount];
+	std::atomic<unsigned int> s_loadingScreenCount( 0 );
+
+	// This is how many priorities (starting with the lowest) are throttled
+	std::atomic<size_t> s_throttledPriorityCount( 0 );
+	// Each event is signaled while work of its priority isn't throttled
+	eae6320::Concurrency::cEvent s_whenWorkIsAllowed[s_priorityCount];
+	// The frame pressure is reported by two threads,
+	// and this makes sure that the events match the last throttled priority count that was calculated
+	eae6320::Concurrency::cMutex s_eventsMutex{ "Concurrency::BackgroundThrottling" };
+	// This is how many work items of each priority had to wait
+	std::atomic<uint64_t> s_throttledWorkCounts[s_priorityCount];
+
+	std::atomic<bool> s_isInitialized( false );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	size_t CalculateThrottledPriorityCount();
+	// This must be called whenever anything that CalculateThrottledPriorityCount() uses changes
+	void UpdateThrottling();
+}
+
+// Interface
+//==========
+
+// Frame Timing
+//-------------
+
+void eae6320::Concurrency::BackgroundThrottling::SetFrameDeadline( const double i_secondCount_perFrame )
+{
+	EAE6320_ASSERTF( i_secondCount_perFrame > 0.0, "The frame deadline must be positive" );
+	s_secondCount_perFrame.store( i_secondCount_perFrame, std::memory_order_relaxed );
+}
+
+void eae6320::Concurrency::BackgroundThrottling::ReportFrameWorkTime( const eFrameThread i_thread, const double i_secondCount_working )
+{
+	EAE6320_ASSERT( i_thread < eFrameThread::Count );
+	const auto framePressure = static_cast<float>( i_secondCount_working / s_secondCount_perFrame.load( std::memory_order_relaxed ) );
+	auto& smoothedFramePressure = s_framePressures[static_cast<size_t>( i_thread )];
+	const auto previousFramePressure = smoothedFramePressure.load( std::memory_order_relaxed );
+	// A slow frame is reacted to immediately,
+	// but a fast frame only eases the pressure gradually
+	smoothedFramePressure.store( ( framePressure >= previousFramePressure ) ? framePressure
+		: ( previousFramePressure + ( ( framePressure - previousFramePressure ) * s_framePressureFallRate ) ),
+		std::memory_order_relaxed );
+	UpdateThrottling();
+}
+
+float eae6320::Concurrency::BackgroundThrottling::GetFramePressure()
+{
+	auto framePressure = 0.0f;
+	for ( const auto& threadFramePressure : s_framePressures )
+	{
+		const auto threadFramePressure_current = threadFramePressure.load( std::memory_order_relaxed );
+		framePressure = ( threadFramePressure_current > framePressure ) ? threadFramePressure_current : framePressure;
+	}
+	return framePressure;
+}
+
+// Loading Screens
+//----------------
+
+void eae6320::Concurrency::BackgroundThrottling::BeginLoadingScreen()
+{
+	s_loadingScreenCount.fetch_add( 1, std::memory_order_relaxed );
+	UpdateThrottling();
+}
+
+void eae6320::Concurrency::BackgroundThrottling::EndLoadingScreen()
+{
+	// The count is never decremented below zero
+	// (an unbalanced call would otherwise wrap it around and keep background work throttled forever)
+	auto loadingScreenCount_previous = s_loadingScreenCount.load( std::memory_order_relaxed );
+	while ( ( loadingScreenCount_previous > 0 )
+		&& !s_loadingScreenCount.compare_exchange_weak( loadingScreenCount_previous, loadingScreenCount_previous - 1, std::memory_order_relaxed ) )
+	{
+	}
+	if ( loadingScreenCount_previous > 0 )
+	{
+		UpdateThrottling();
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "A loading screen was ended without having begun" );
+		Logging::OutputError( "A loading screen was ended without having begun" );
+	}
+}
+
+// Background Work
+//----------------
+
+bool eae6320::Concurrency::BackgroundThrottling::IsWorkAllowed( const ePriority i_priority )
+{
+	EAE6320_ASSERT( i_priority < ePriority::Count );
+	return static_cast<size_t>( i_priority ) < ( s_priorityCount - s_throttledPriorityCount.load( std::memory_order_relaxed ) );
+}
+
+void eae6320::Concurrency::BackgroundThrottling::WaitUntilWorkIsAllowed( const ePriority i_priority )
+{
+	if ( !s_isInitialized.load( std::memory_order_acquire ) || IsWorkAllowed( i_priority ) )
+	{
+		return;
+	}
+	const auto priorityIndex = static_cast<size_t>( i_priority );
+	s_throttledWorkCounts[priorityIndex].fetch_add( 1, std::memory_order_relaxed );
+	// If the wait times out the work is run even though it is still being throttled
+	const auto result = WaitForEvent( s_whenWorkIsAllowed[priorityIndex], s_maxTimesToThrottle_inMilliseconds[priorityIndex] );
+	EAE6320_ASSERT( result || ( result == Results::TimeOut ) );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::BackgroundThrottling::Initialize()
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !s_isInitialized, "Background throttling has already been initialized" );
+
+	// Nothing is throttled until a frame has been reported
+	for ( auto& framePressure : s_framePressures )
+	{
+		framePressure.store( 0.0f, std::memory_order_relaxed );
+	}
+	s_throttledPriorityCount.store( 0, std::memory_order_relaxed );
+	for ( size_t i = 0; i < s_priorityCount; ++i )
+	{
+		s_throttledWorkCounts[i].store( 0, std::memory_order_relaxed );
+		if ( !( result = s_whenWorkIsAllowed[i].Initialize( EventType::RemainSignaledUntilReset, EventState::Signaled ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize a background throttling event" );
+			Logging::OutputError( "Failed to initialize the event that signals when background work is allowed" );
+			goto OnExit;
+		}
+	}
+	{
+		cMutex::cScopeLock autoLock( s_eventsMutex );
+		s_isInitialized.store( true, std::memory_order_release );
+	}
+	UpdateThrottling();
+
+OnExit:
+
+	if ( !result )
+	{
+		const auto localResult = CleanUp();
+		EAE6320_ASSERT( localResult );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::BackgroundThrottling::CleanUp()
+{
+	auto result = Results::Success;
+
+	bool wasInitialized;
+	{
+		cMutex::cScopeLock autoLock( s_eventsMutex );
+		wasInitialized = s_isInitialized.load( std::memory_order_relaxed );
+		if ( wasInitialized )
+		{
+			Logging::OutputMessage( "Background throttling delayed %llu normal priority and %llu low priority work items",
+				static_cast<unsigned long long>( s_throttledWorkCounts[static_cast<size_t>( ePriority::Normal )].load( std::memory_order_relaxed ) ),
+				static_cast<unsigned long long>( s_throttledWorkCounts[static_cast<size_t>( ePriority::Low )].load( std::memory_order_relaxed ) ) );
+		}
+		s_isInitialized.store( false, std::memory_order_release );
+		s_throttledPriorityCount.store( 0, std::memory_order_relaxed );
+	}
+	for ( auto& whenWorkIsAllowed : s_whenWorkIsAllowed )
+	{
+		// Any thread that is still waiting is released first
+		if ( wasInitialized )
+		{
+			whenWorkIsAllowed.Signal();
+		}
+		const auto localResult = whenWorkIsAllowed.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	size_t CalculateThrottledPriorityCount()
+	{
+		// Nothing else is happening during a loading screen,
+		// and so the background work can have as much time as it wants
+		if ( s_loadingScreenCount.load( std::memory_order_relaxed ) > 0 )
+		{
+			return 0;
+		}
+		const auto framePressure = eae6320::Concurrency::BackgroundThrottling::GetFramePressure();
+		if ( framePressure >= s_framePressure_toThrottleNormalPriorityWork )
+		{
+			return 2;
+		}
+		else if ( framePressure >= s_framePressure_toThrottleLowPriorityWork )
+		{
+			return 1;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	void UpdateThrottling()
+	{
+		// The lock is only needed when the throttling changes
+		// (which usually isn't every frame)
+		if ( CalculateThrottledPriorityCount() == s_throttledPriorityCount.load( std::memory_order_relaxed ) )
+		{
+			return;
+		}
+		eae6320::Concurrency::cMutex::cScopeLock autoLock( s_eventsMutex );
+		if ( !s_isInitialized.load( std::memory_order_relaxed ) )
+		{
+			return;
+		}
+		// The count is calculated again in case another thread changed something while this one was waiting for the lock
+		const auto throttledPriorityCount = CalculateThrottledPriorityCount();
+		s_throttledPriorityCount.store( throttledPriorityCount, std::memory_order_relaxed );
+		for ( size_t i = 0; i < s_priorityCount; ++i )
+		{
+			const auto result = ( i < ( s_priorityCount - throttledPriorityCount ) )
+				? s_whenWorkIsAllowed[i].Signal() : s_whenWorkIsAllowed[i].ResetToUnsignaled();
+			EAE6320_ASSERT( result );
+		}
+	}
+}
@@ -0,0 +1,105 @@
+/*
+	Background throttling keeps background work (loading, streaming, prefetching)
+	from taking CPU time and memory bandwidth away from frames that are close to missing their deadline
+
+	The application loop and render threads report how long each frame's work took,
+	and the ratio of that to the frame deadline is the frame pressure:
+		* When the pressure is low (e.g. during idle frames) all background work runs freely
+		* When the pressure is high low priority work waits
+		* When a frame is about to miss its deadline normal priority work waits, too
+	High priority work is never throttled, and nothing is throttled while a loading screen is shown
+	(when nothing else is happening and the user is waiting for the background work to finish).
+	Throttled work only waits for a limited time so that background work always makes progress.
+*/
+
+#ifndef EAE6320_CONCURRENCY_BACKGROUNDTHROTTLING_H
+#define EAE6320_CONCURRENCY_BACKGROUNDTHROTTLING_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace BackgroundThrottling
+		{
+			enum class ePriority : uint8_t
+			{
+				// Work that something is waiting for (this is never throttled)
+				High,
+				// Work that is needed soon (e.g. decoding assets that were loaded asynchronously)
+				Normal,
+				// Work that is only speculative (e.g. prefetching files that might be loaded)
+				Low,
+
+				Count
+			};
+
+			enum class eFrameThread : uint8_t
+			{
+				Application,
+				Render,
+
+				Count
+			};
+
+			// Frame Timing
+			//-------------
+
+			// Every frame is expected to take this long
+			void SetFrameDeadline( const double i_secondCount_perFrame );
+			// Each thread reports how long it spent working on a frame
+			// (time spent waiting for the other thread or for the display shouldn't be included)
+			void ReportFrameWorkTime( const eFrameThread i_thread, const double i_secondCount_working );
+			// This is the fraction of the frame deadline that the busier of the two threads is using
+			// (it rises as soon as a frame takes longer but falls gradually)
+			float GetFramePressure();
+
+			// Loading Screens
+			//----------------
+
+			// These can be nested
+			// (nothing is throttled until every loading screen that has begun has ended)
+			void BeginLoadingScreen();
+			void EndLoadingScreen();
+
+			class cScopeLoadingScreen
+			{
+			public:
+
+				cScopeLoadingScreen() { BeginLoadingScreen(); }
+				~cScopeLoadingScreen() { EndLoadingScreen(); }
+
+				cScopeLoadingScreen( const cScopeLoadingScreen& ) = delete;
+				cScopeLoadingScreen& operator =( const cScopeLoadingScreen& ) = delete;
+			};
+
+			// Background Work
+			//----------------
+
+			// This doesn't block
+			bool IsWorkAllowed( const ePriority i_priority );
+			// This must be called by a background thread before it starts a work item.
+			// If the work is being throttled this waits until it isn't
+			// (or until the maximum time that work of that priority can be delayed has elapsed).
+			// If background throttling hasn't been initialized this returns immediately.
+			void WaitUntilWorkIsAllowed( const ePriority i_priority );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cResult Initialize();
+			// Every thread that does background work must have stopped before this is called
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_BACKGROUNDTHROTTLING_H
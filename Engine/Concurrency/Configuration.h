@@ -0,0 +1,24 @@
+/*
+	This file provides configurable settings
+	that can be used to control concurrency behavior
+*/
+
+#ifndef EAE6320_CONCURRENCY_CONFIGURATION_H
+#define EAE6320_CONCURRENCY_CONFIGURATION_H
+
+// By default mutex profiling is only enabled for debug builds,
+// but you can #define it differently as necessary
+// (when it isn't defined the profiling code compiles out completely)
+#ifdef _DEBUG
+	#define EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED
+#endif
+
+// By default scratch allocations are only verified for debug builds,
+// but you can #define it differently as necessary
+// (when it is defined every allocation has a small header
+// that is used to catch memory that is still in use when its scratch scope ends)
+#ifdef _DEBUG
+	#define EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED
+#endif
+
+#endif	// EAE6320_CONCURRENCY_CONFIGURATION_H
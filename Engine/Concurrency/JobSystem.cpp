@@ -0,0 +1,489 @@
+// Include Files
+//==============
+
+#include "JobSystem.h"
+
+#include "cEvent.h"
+#include "cThread.h"
+#include "cWorkStealingDeque.h"
+
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+// Job Definition
+//===============
+
+struct eae6320::Concurrency::JobSystem::sJob
+{
+	fJob function;
+	cJobCounter* counter = nullptr;
+
+	// The job's counter is incremented when it is created
+	static sJob* Create( const fJob& i_function, cJobCounter* const io_counter );
+	// The job is deleted after it has been run
+	// and any jobs that were waiting for its counter are moved to the output
+	void RunAndDelete( std::vector<sJob*>& o_jobsThatAreReady );
+	// This returns false if the dependency is already zero
+	static bool WaitForDependency( cJobCounter& io_dependency, sJob* const i_job );
+};
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// A worker can have this many jobs waiting in its deque
+	// (any more are put in the shared queue)
+	constexpr size_t s_maxJobCountPerWorker = 4096;
+
+	struct sWorker
+	{
+		eae6320::Concurrency::cWorkStealingDeque<eae6320::Concurrency::JobSystem::sJob*, s_maxJobCountPerWorker> jobs;
+		eae6320::Concurrency::cThread thread;
+		bool hasThreadStarted = false;
+	};
+	// The workers don't change while the job system is initialized
+	// and so any thread can steal from them without a lock
+	std::vector<std::unique_ptr<sWorker>> s_workers;
+
+	// Jobs that were run by threads that aren't workers
+	std::deque<eae6320::Concurrency::JobSystem::sJob*> s_sharedJobs;
+	eae6320::Concurrency::cMutex s_sharedJobsMutex{ "Concurrency::JobSystem" };
+	// This lets workers check for shared jobs without taking the lock
+	std::atomic<size_t> s_sharedJobCount( 0 );
+
+	// Workers that run out of jobs sleep until this is signaled
+	eae6320::Concurrency::cEvent s_whenJobsArePending;
+	std::atomic<unsigned int> s_sleepingWorkerCount( 0 );
+	// A sleeping worker wakes up periodically
+	// so that it notices when it should exit
+	constexpr unsigned int s_maxTimeToSleep_inMilliseconds = 10;
+
+	std::atomic<bool> s_isInitialized( false );
+	std::atomic<bool> s_shouldWorkersExit( false );
+
+	// Statistics
+	std::atomic<uint64_t> s_runJobCount( 0 );
+	std::atomic<uint64_t> s_stolenJobCount( 0 );
+
+	// The worker that is running on the current thread
+	// (this is null for any thread that isn't a worker)
+	thread_local sWorker* s_worker_currentThread = nullptr;
+	// Each thread chooses which worker to steal from pseudo-randomly
+	// so that thieves don't all compete for the same deque
+	thread_local uint32_t s_stealRandomState = 0;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void EntryPoint_workerThread( void* const io_userData );
+
+	void QueueJob( eae6320::Concurrency::JobSystem::sJob* const i_job );
+	void QueueJobs( const std::vector<eae6320::Concurrency::JobSystem::sJob*>& i_jobs );
+	bool FindJob( eae6320::Concurrency::JobSystem::sJob*& o_job );
+	void RunJob( eae6320::Concurrency::JobSystem::sJob* const i_job );
+	void WakeWorkerIfAnyAreSleeping();
+}
+
+// Interface
+//==========
+
+// Counters
+//---------
+
+bool eae6320::Concurrency::JobSystem::cJobCounter::IsZero() const
+{
+	if ( GetValue() != 0 )
+	{
+		return false;
+	}
+	// The thread that made the last decrement might still be holding the lock
+	// and so it must be released before the counter can be destroyed
+	Concurrency::cMutex::cScopeLock autoLock( m_dependentJobsMutex );
+	return true;
+}
+
+eae6320::Concurrency::JobSystem::cJobCounter::~cJobCounter()
+{
+	EAE6320_ASSERTF( IsZero(), "A job counter is being destroyed while its jobs are still running" );
+	EAE6320_ASSERTF( m_dependentJobs.empty(), "A job counter is being destroyed while jobs are waiting for it" );
+}
+
+// Jobs
+//-----
+
+void eae6320::Concurrency::JobSystem::Run( const fJob& i_job, cJobCounter* const io_counter )
+{
+	auto* const job = sJob::Create( i_job, io_counter );
+	QueueJob( job );
+}
+
+void eae6320::Concurrency::JobSystem::RunAfter( cJobCounter& io_dependency, const fJob& i_job, cJobCounter* const io_counter )
+{
+	auto* const job = sJob::Create( i_job, io_counter );
+	if ( !sJob::WaitForDependency( io_dependency, job ) )
+	{
+		QueueJob( job );
+	}
+}
+
+// Waiting
+//--------
+
+void eae6320::Concurrency::JobSystem::WaitForCounter( const cJobCounter& i_counter )
+{
+	while ( !i_counter.IsZero() )
+	{
+		sJob* job;
+		if ( FindJob( job ) )
+		{
+			RunJob( job );
+		}
+		else
+		{
+			// The jobs that are being waited for are being run by other threads
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Access
+//-------
+
+unsigned int eae6320::Concurrency::JobSystem::GetWorkerThreadCount()
+{
+	return s_isInitialized ? static_cast<unsigned int>( s_workers.size() ) : 0;
+}
+
+bool eae6320::Concurrency::JobSystem::IsWorkerThread()
+{
+	return s_worker_currentThread != nullptr;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::JobSystem::Initialize( const unsigned int i_workerThreadCount, const sThreadOptions& i_threadOptions )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !s_isInitialized, "The job system has already been initialized" );
+
+	auto workerThreadCount = i_workerThreadCount;
+	if ( workerThreadCount == 0 )
+	{
+		// The application and render threads already have their own cores
+		const auto coreCount = std::thread::hardware_concurrency();
+		workerThreadCount = ( coreCount > 3 ) ? ( coreCount - 2 ) : 1;
+	}
+
+	if ( !( result = s_whenJobsArePending.Initialize( EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the event that wakes up job system workers" );
+		goto OnExit;
+	}
+	s_shouldWorkersExit = false;
+	s_runJobCount = 0;
+	s_stolenJobCount = 0;
+	// Every worker must exist before any of them start stealing
+	for ( unsigned int i = 0; i < workerThreadCount; ++i )
+	{
+		auto* const worker = new ( std::nothrow ) sWorker();
+		if ( !worker )
+		{
+			result = Results::OutOfMemory;
+			EAE6320_ASSERTF( false, "Couldn't allocate memory for a job system worker" );
+			Logging::OutputError( "Failed to allocate memory for a job system worker" );
+			goto OnExit;
+		}
+		s_workers.emplace_back( worker );
+	}
+	s_isInitialized = true;
+	for ( size_t i = 0; i < s_workers.size(); ++i )
+	{
+		auto& worker = s_workers[i];
+		const auto threadName = std::string( i_threadOptions.name ? i_threadOptions.name : "Job System Worker" ) + " " + std::to_string( i + 1 );
+		auto threadOptions = i_threadOptions;
+		threadOptions.name = threadName.c_str();
+		if ( !( result = worker->thread.Start( EntryPoint_workerThread, worker.get(), threadOptions ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't start a job system worker thread" );
+			goto OnExit;
+		}
+		worker->hasThreadStarted = true;
+	}
+	Logging::OutputMessage( "The job system started %u worker threads", workerThreadCount );
+
+OnExit:
+
+	if ( !result )
+	{
+		const auto localResult = CleanUp();
+		EAE6320_ASSERT( localResult );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::JobSystem::CleanUp()
+{
+	auto result = Results::Success;
+
+	const bool wasInitialized = s_isInitialized;
+	// Any jobs that are run from now on are run immediately
+	s_isInitialized = false;
+	s_shouldWorkersExit = true;
+	for ( auto& worker : s_workers )
+	{
+		if ( !worker->hasThreadStarted )
+		{
+			continue;
+		}
+		const auto localResult = WaitForThreadToStop( worker->thread );
+		if ( !localResult )
+		{
+			EAE6320_ASSERTF( false, "Couldn't wait for a job system worker thread to stop" );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	// Any jobs that the workers didn't get to are run by this thread
+	{
+		sJob* job;
+		while ( FindJob( job ) )
+		{
+			RunJob( job );
+		}
+	}
+	if ( wasInitialized )
+	{
+		Logging::OutputMessage( "The job system ran %u jobs (%u were stolen by a different worker)",
+			static_cast<unsigned int>( s_runJobCount ), static_cast<unsigned int>( s_stolenJobCount ) );
+	}
+	s_workers.clear();
+	{
+		const auto localResult = s_whenJobsArePending.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Counters
+//---------
+
+void eae6320::Concurrency::JobSystem::cJobCounter::Increment()
+{
+	m_value.fetch_add( 1, std::memory_order_acq_rel );
+}
+
+void eae6320::Concurrency::JobSystem::cJobCounter::Decrement( std::vector<sJob*>& o_jobsThatAreReady )
+{
+	// Decrements that don't reach zero don't need the lock
+	auto value = m_value.load( std::memory_order_relaxed );
+	while ( value > 1 )
+	{
+		if ( m_value.compare_exchange_weak( value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+		{
+			return;
+		}
+	}
+	// The last decrement is made with the mutex locked:
+	//	* A job that is added as a dependent after the counter reached zero won't be added to the list
+	//		(AddDependentJob() checks the value with the mutex locked)
+	//	* A thread that sees the counter reach zero can't destroy it until the mutex is unlocked
+	//		(IsZero() locks the mutex)
+	Concurrency::cMutex::cScopeLock autoLock( m_dependentJobsMutex );
+	const auto previousValue = m_value.fetch_sub( 1, std::memory_order_acq_rel );
+	EAE6320_ASSERT( previousValue > 0 );
+	if ( previousValue == 1 )
+	{
+		o_jobsThatAreReady.insert( o_jobsThatAreReady.end(), m_dependentJobs.begin(), m_dependentJobs.end() );
+		m_dependentJobs.clear();
+	}
+}
+
+bool eae6320::Concurrency::JobSystem::cJobCounter::AddDependentJob( sJob* const i_job )
+{
+	Concurrency::cMutex::cScopeLock autoLock( m_dependentJobsMutex );
+	if ( GetValue() == 0 )
+	{
+		return false;
+	}
+	m_dependentJobs.push_back( i_job );
+	return true;
+}
+
+// Jobs
+//-----
+
+eae6320::Concurrency::JobSystem::sJob* eae6320::Concurrency::JobSystem::sJob::Create( const fJob& i_function, cJobCounter* const io_counter )
+{
+	auto* const job = new sJob;
+	job->function = i_function;
+	job->counter = io_counter;
+	if ( io_counter )
+	{
+		io_counter->Increment();
+	}
+	return job;
+}
+
+void eae6320::Concurrency::JobSystem::sJob::RunAndDelete( std::vector<sJob*>& o_jobsThatAreReady )
+{
+	function();
+	auto* const jobCounter = counter;
+	delete this;
+	if ( jobCounter )
+	{
+		jobCounter->Decrement( o_jobsThatAreReady );
+	}
+}
+
+bool eae6320::Concurrency::JobSystem::sJob::WaitForDependency( cJobCounter& io_dependency, sJob* const i_job )
+{
+	return io_dependency.AddDependentJob( i_job );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void EntryPoint_workerThread( void* const io_userData )
+	{
+		auto* const worker = static_cast<sWorker*>( io_userData );
+		EAE6320_ASSERT( worker );
+		s_worker_currentThread = worker;
+		s_stealRandomState = static_cast<uint32_t>( reinterpret_cast<uintptr_t>( worker ) >> 4 ) | 1;
+
+		while ( !s_shouldWorkersExit )
+		{
+			eae6320::Concurrency::JobSystem::sJob* job;
+			if ( FindJob( job ) )
+			{
+				RunJob( job );
+				continue;
+			}
+			// The worker announces that it is going to sleep before checking one last time
+			// so that a job that is queued in between will wake it up
+			++s_sleepingWorkerCount;
+			if ( FindJob( job ) )
+			{
+				--s_sleepingWorkerCount;
+				RunJob( job );
+				continue;
+			}
+			eae6320::Concurrency::WaitForEvent( s_whenJobsArePending, s_maxTimeToSleep_inMilliseconds );
+			--s_sleepingWorkerCount;
+		}
+
+		s_worker_currentThread = nullptr;
+	}
+
+	void QueueJob( eae6320::Concurrency::JobSystem::sJob* const i_job )
+	{
+		if ( !s_isInitialized )
+		{
+			RunJob( i_job );
+			return;
+		}
+		// A worker keeps the jobs that it creates
+		// so that they are likely to be run on the same core
+		if ( !s_worker_currentThread || !s_worker_currentThread->jobs.Push( i_job ) )
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( s_sharedJobsMutex );
+			s_sharedJobs.push_back( i_job );
+			++s_sharedJobCount;
+		}
+		WakeWorkerIfAnyAreSleeping();
+	}
+
+	void QueueJobs( const std::vector<eae6320::Concurrency::JobSystem::sJob*>& i_jobs )
+	{
+		for ( auto* const job : i_jobs )
+		{
+			QueueJob( job );
+		}
+	}
+
+	bool FindJob( eae6320::Concurrency::JobSystem::sJob*& o_job )
+	{
+		// A worker's own jobs are run first
+		if ( s_worker_currentThread && s_worker_currentThread->jobs.Pop( o_job ) )
+		{
+			return true;
+		}
+		// Then jobs that were run by other threads
+		if ( s_sharedJobCount > 0 )
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( s_sharedJobsMutex );
+			if ( !s_sharedJobs.empty() )
+			{
+				o_job = s_sharedJobs.front();
+				s_sharedJobs.pop_front();
+				--s_sharedJobCount;
+				return true;
+			}
+		}
+		// Finally a job is stolen from another worker,
+		// starting with a random one
+		const auto workerCount = s_workers.size();
+		if ( workerCount > 0 )
+		{
+			// xorshift
+			auto randomState = s_stealRandomState ? s_stealRandomState : 0x9e3779b9;
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 17;
+			randomState ^= randomState << 5;
+			s_stealRandomState = randomState;
+			const auto firstWorkerIndex = static_cast<size_t>( randomState % workerCount );
+			for ( size_t i = 0; i < workerCount; ++i )
+			{
+				auto& worker = *s_workers[( firstWorkerIndex + i ) % workerCount];
+				if ( ( &worker != s_worker_currentThread ) && worker.jobs.Steal( o_job ) )
+				{
+					++s_stolenJobCount;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void RunJob( eae6320::Concurrency::JobSystem::sJob* const i_job )
+	{
+		std::vector<eae6320::Concurrency::JobSystem::sJob*> jobsThatAreReady;
+		i_job->RunAndDelete( jobsThatAreReady );
+		++s_runJobCount;
+		QueueJobs( jobsThatAreReady );
+	}
+
+	void WakeWorkerIfAnyAreSleeping()
+	{
+		if ( s_sleepingWorkerCount > 0 )
+		{
+			s_whenJobsArePending.Signal();
+		}
+	}
+}
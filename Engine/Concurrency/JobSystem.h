@@ -0,0 +1,148 @@
+/*
+	The job system runs small jobs on a pool of worker threads
+
+	There is one worker thread for every core that isn't already running the application or render thread,
+	and each worker has its own work-stealing deque:
+		* A job that is run by a worker is pushed onto that worker's deque
+			(and so a job that splits its work into more jobs keeps them on the same core)
+		* A job that is run by any other thread is put in a shared queue
+		* A worker with nothing to do takes a job from the shared queue or steals one from another worker
+	Jobs are tracked with counters:
+		* A counter is incremented when a job is run with it, and decremented when the job finishes
+		* A job can depend on a counter, and isn't started until that counter reaches zero
+		* WaitForCounter() runs other jobs while it waits instead of blocking the thread
+	The job system only uses the platform-independent interfaces of cThread, cEvent, and cMutex.
+*/
+
+#ifndef EAE6320_CONCURRENCY_JOBSYSTEM_H
+#define EAE6320_CONCURRENCY_JOBSYSTEM_H
+
+// Include Files
+//==============
+
+#include "cMutex.h"
+#include "cThread.h"
+
+#include <atomic>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <functional>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace JobSystem
+		{
+			struct sJob;
+		}
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace JobSystem
+		{
+			using fJob = std::function<void()>;
+
+			// A counter is the number of jobs that have been run with it and haven't finished yet
+			class cJobCounter
+			{
+				// Interface
+				//==========
+
+			public:
+
+				uint32_t GetValue() const { return m_value.load( std::memory_order_acquire ); }
+				// Once this returns true the counter can be destroyed
+				// (the job that decremented it to zero has finished using it)
+				bool IsZero() const;
+
+				// Initialization / Clean Up
+				//--------------------------
+
+				cJobCounter() = default;
+				~cJobCounter();
+
+				cJobCounter( const cJobCounter& ) = delete;
+				cJobCounter& operator =( const cJobCounter& ) = delete;
+
+				// Data
+				//=====
+
+			private:
+
+				std::atomic<uint32_t> m_value{ 0 };
+				// Jobs that are waiting for this counter to reach zero
+				std::vector<sJob*> m_dependentJobs;
+				// The last decrement is made with the mutex locked
+				mutable cMutex m_dependentJobsMutex;
+
+				// Implementation
+				//===============
+
+			private:
+
+				// Jobs change their counters
+				friend struct sJob;
+
+				void Increment();
+				// Any jobs that were waiting for the counter to reach zero are moved to the output
+				void Decrement( std::vector<sJob*>& o_jobsThatAreReady );
+				// This returns false if the counter is already zero
+				// (in which case the job doesn't need to wait)
+				bool AddDependentJob( sJob* const i_job );
+			};
+
+			// Jobs
+			//-----
+
+			// The job is run by a worker thread.
+			// If a counter is provided it is incremented now and decremented when the job finishes.
+			// (If the job system hasn't been initialized the job is run immediately.)
+			// This is thread-safe.
+			void Run( const fJob& i_job, cJobCounter* const io_counter = nullptr );
+			// The job isn't started until the dependency counter reaches zero
+			// (if it is already zero the job is run like Run()).
+			// The dependency must not be destroyed before it reaches zero.
+			void RunAfter( cJobCounter& io_dependency, const fJob& i_job, cJobCounter* const io_counter = nullptr );
+
+			// Waiting
+			//--------
+
+			// This returns once the counter is zero,
+			// and the calling thread runs other jobs while it waits
+			// (and so this can be called from inside of a job without using up a worker)
+			void WaitForCounter( const cJobCounter& i_counter );
+
+			// Access
+			//-------
+
+			unsigned int GetWorkerThreadCount();
+			// This returns true if the calling thread is one of the job system's worker threads
+			bool IsWorkerThread();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// If no worker thread count is provided there is one worker thread for every core
+			// except for the two that run the application and render threads (but always at least one).
+			// Every worker thread is started with the provided options
+			// (the worker's number is appended to the name).
+			cResult Initialize( const unsigned int i_workerThreadCount = 0, const sThreadOptions& i_threadOptions = sThreadOptions() );
+			// Every job that has been run is finished before this returns
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_JOBSYSTEM_H
@@ -0,0 +1,408 @@
+// Include Files
+//==============
+
+#include "LockStressTest.h"
+
+#include "cEvent.h"
+#include "cRWMutex.h"
+#include "cSeqLock.h"
+#include "cThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <thread>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// Every thread waits for the start event and then runs until it is told to stop
+	struct sThreadControl
+	{
+		eae6320::Concurrency::cEvent whenToStart;
+		std::atomic<bool> shouldStop{ false };
+	};
+
+	struct sRWMutexData : sThreadControl
+	{
+		eae6320::Concurrency::cRWMutex mutex;
+		// These are protected by the mutex.
+		// They are written one after the other and so are only different while a write is happening.
+		uint64_t value = 0;
+		uint64_t valueCopy = 0;
+		// A thread that holds a lock records it here so that other threads can check which locks are held at the same time
+		std::atomic<unsigned int> activeReaderCount{ 0 };
+		std::atomic<unsigned int> activeWriterCount{ 0 };
+		// Each thread adds its counts when it stops
+		std::atomic<uint64_t> sharedLockCount{ 0 };
+		std::atomic<uint64_t> exclusiveLockCount{ 0 };
+		std::atomic<uint64_t> upgradeCount{ 0 };
+		std::atomic<uint64_t> violationCount{ 0 };
+	};
+
+	// Every word is always the same
+	struct sSeqLockValue
+	{
+		uint64_t words[4];
+	};
+	struct sSeqLockData : sThreadControl
+	{
+		eae6320::Concurrency::cSeqLock<sSeqLockValue> seqLock;
+		// Each thread adds its counts when it stops
+		std::atomic<uint64_t> readCount{ 0 };
+		std::atomic<uint64_t> writeCount{ 0 };
+		std::atomic<uint64_t> violationCount{ 0 };
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This starts a thread for every function, lets them run for the given time, and then waits for them to stop
+	eae6320::cResult RunThreads( sThreadControl& io_control, void* const io_userData,
+		const std::vector<eae6320::Concurrency::fThreadFunction>& i_threadFunctions, const unsigned int i_timeToRun_inMilliseconds );
+
+	eae6320::cResult RunRWMutex( const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		sRWMutexData& io_data );
+	eae6320::cResult RunSeqLock( const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		sSeqLockData& io_data );
+
+	// Thread Functions
+	//-----------------
+
+	void RWMutexReader( void* const io_data );
+	void RWMutexWriter( void* const io_data );
+	void RWMutexUpgrader( void* const io_data );
+	void SeqLockReader( void* const io_data );
+	void SeqLockWriter( void* const io_data );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::LockStressTest::Run( sResults& o_results,
+	const unsigned int i_readerThreadCount, const unsigned int i_timeToRunEachLock_inMilliseconds )
+{
+	auto result = Results::Success;
+
+	o_results = sResults();
+	{
+		sRWMutexData data;
+		if ( !( result = RunRWMutex( i_readerThreadCount, i_timeToRunEachLock_inMilliseconds, data ) ) )
+		{
+			return result;
+		}
+		o_results.sharedLockCount = data.sharedLockCount;
+		o_results.exclusiveLockCount = data.exclusiveLockCount;
+		o_results.upgradeCount = data.upgradeCount;
+		o_results.violationCount += data.violationCount;
+		// Every write and every upgrade increments the value once
+		if ( ( data.value != ( o_results.exclusiveLockCount + o_results.upgradeCount ) ) || ( data.value != data.valueCopy ) )
+		{
+			++o_results.violationCount;
+		}
+	}
+	{
+		sSeqLockData data;
+		if ( !( result = RunSeqLock( i_readerThreadCount, i_timeToRunEachLock_inMilliseconds, data ) ) )
+		{
+			return result;
+		}
+		o_results.seqLockReadCount = data.readCount;
+		o_results.seqLockWriteCount = data.writeCount;
+		o_results.violationCount += data.violationCount;
+		// Writes are serialized, and so none of the increments can have been lost
+		if ( data.seqLock.Read().words[0] != o_results.seqLockWriteCount )
+		{
+			++o_results.violationCount;
+		}
+	}
+	if ( o_results.violationCount > 0 )
+	{
+		EAE6320_ASSERTF( false, "A lock allowed something that it should have prevented" );
+		result = Results::Failure;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::LockStressTest::LogReport( const unsigned int i_readerThreadCount,
+	const unsigned int i_timeToRunEachLock_inMilliseconds )
+{
+	sResults results;
+	const auto result = Run( results, i_readerThreadCount, i_timeToRunEachLock_inMilliseconds );
+	if ( result )
+	{
+		Logging::OutputMessage( "Lock stress test (%u reader threads) passed:"
+			" cRWMutex had %llu shared locks, %llu exclusive locks, and %llu upgrades; cSeqLock had %llu reads and %llu writes",
+			i_readerThreadCount,
+			static_cast<unsigned long long>( results.sharedLockCount ), static_cast<unsigned long long>( results.exclusiveLockCount ),
+			static_cast<unsigned long long>( results.upgradeCount ),
+			static_cast<unsigned long long>( results.seqLockReadCount ), static_cast<unsigned long long>( results.seqLockWriteCount ) );
+	}
+	else if ( results.violationCount > 0 )
+	{
+		Logging::OutputError( "The lock stress test failed: Threads saw %llu things that the locks should have prevented",
+			static_cast<unsigned long long>( results.violationCount ) );
+	}
+	else
+	{
+		Logging::OutputError( "The lock stress test couldn't be run" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult RunThreads( sThreadControl& io_control, void* const io_userData,
+		const std::vector<eae6320::Concurrency::fThreadFunction>& i_threadFunctions, const unsigned int i_timeToRun_inMilliseconds )
+	{
+		auto result = eae6320::Results::Success;
+
+		std::vector<eae6320::Concurrency::cThread> threads( i_threadFunctions.size() );
+		size_t startedThreadCount = 0;
+
+		if ( !( result = io_control.whenToStart.Initialize( eae6320::Concurrency::EventType::RemainSignaledUntilReset ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the lock stress test's start event" );
+			return result;
+		}
+		for ( ; startedThreadCount < i_threadFunctions.size(); ++startedThreadCount )
+		{
+			eae6320::Concurrency::sThreadOptions threadOptions;
+			threadOptions.name = "Lock Stress Test";
+			if ( !( result = threads[startedThreadCount].Start( i_threadFunctions[startedThreadCount], io_userData, threadOptions ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start a lock stress test thread" );
+				break;
+			}
+		}
+		if ( result )
+		{
+			if ( !( result = io_control.whenToStart.Signal() ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start the lock stress test" );
+			}
+			else
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( i_timeToRun_inMilliseconds ) );
+			}
+		}
+		// The threads are always woken so that they can see that they should stop
+		// (even if they weren't all started)
+		io_control.shouldStop.store( true, std::memory_order_relaxed );
+		{
+			const auto localResult = io_control.whenToStart.Signal();
+			EAE6320_ASSERT( localResult );
+		}
+		for ( size_t i = 0; i < startedThreadCount; ++i )
+		{
+			const auto localResult = eae6320::Concurrency::WaitForThreadToStop( threads[i] );
+			EAE6320_ASSERT( localResult );
+			if ( result && !localResult )
+			{
+				result = localResult;
+			}
+		}
+
+		return result;
+	}
+
+	eae6320::cResult RunRWMutex( const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		sRWMutexData& io_data )
+	{
+		// The readers and the writer race each other,
+		// and two upgrading threads race each other (for the upgradable lock) and the writer (for the exclusive lock)
+		std::vector<eae6320::Concurrency::fThreadFunction> threadFunctions( i_readerThreadCount, RWMutexReader );
+		threadFunctions.push_back( RWMutexWriter );
+		threadFunctions.push_back( RWMutexUpgrader );
+		threadFunctions.push_back( RWMutexUpgrader );
+		return RunThreads( io_data, &io_data, threadFunctions, i_timeToRun_inMilliseconds );
+	}
+
+	eae6320::cResult RunSeqLock( const unsigned int i_readerThreadCount, const unsigned int i_timeToRun_inMilliseconds,
+		sSeqLockData& io_data )
+	{
+		// There are two writers so that writers race each other as well as the readers
+		std::vector<eae6320::Concurrency::fThreadFunction> threadFunctions( i_readerThreadCount, SeqLockReader );
+		threadFunctions.push_back( SeqLockWriter );
+		threadFunctions.push_back( SeqLockWriter );
+		return RunThreads( io_data, &io_data, threadFunctions, i_timeToRun_inMilliseconds );
+	}
+
+	// Thread Functions
+	//-----------------
+
+	void RWMutexReader( void* const io_data )
+	{
+		auto& data = *static_cast<sRWMutexData*>( io_data );
+		uint64_t lockCount = 0;
+		uint64_t violationCount = 0;
+		eae6320::Concurrency::WaitForEvent( data.whenToStart );
+		for ( unsigned int i = 0; !data.shouldStop.load( std::memory_order_relaxed ); ++i )
+		{
+			// Some of the locks are only tried so that LockSharedIfPossible() is tested too
+			if ( ( i % 8 ) == 0 )
+			{
+				if ( !data.mutex.LockSharedIfPossible() )
+				{
+					continue;
+				}
+			}
+			else
+			{
+				data.mutex.LockShared();
+			}
+			{
+				data.activeReaderCount.fetch_add( 1 );
+				if ( ( data.activeWriterCount.load() != 0 ) || ( data.value != data.valueCopy ) )
+				{
+					++violationCount;
+				}
+				data.activeReaderCount.fetch_sub( 1 );
+			}
+			data.mutex.UnlockShared();
+			++lockCount;
+		}
+		data.sharedLockCount.fetch_add( lockCount, std::memory_order_relaxed );
+		data.violationCount.fetch_add( violationCount, std::memory_order_relaxed );
+	}
+
+	void RWMutexWriter( void* const io_data )
+	{
+		auto& data = *static_cast<sRWMutexData*>( io_data );
+		uint64_t lockCount = 0;
+		uint64_t violationCount = 0;
+		eae6320::Concurrency::WaitForEvent( data.whenToStart );
+		for ( unsigned int i = 0; !data.shouldStop.load( std::memory_order_relaxed ); ++i )
+		{
+			// Some of the locks are only tried so that LockIfPossible() is tested too
+			if ( ( i % 8 ) == 0 )
+			{
+				if ( !data.mutex.LockIfPossible() )
+				{
+					std::this_thread::yield();
+					continue;
+				}
+			}
+			else
+			{
+				data.mutex.Lock();
+			}
+			{
+				if ( ( data.activeWriterCount.fetch_add( 1 ) != 0 ) || ( data.activeReaderCount.load() != 0 ) )
+				{
+					++violationCount;
+				}
+				++data.value;
+				data.valueCopy = data.value;
+				data.activeWriterCount.fetch_sub( 1 );
+			}
+			data.mutex.Unlock();
+			++lockCount;
+		}
+		data.exclusiveLockCount.fetch_add( lockCount, std::memory_order_relaxed );
+		data.violationCount.fetch_add( violationCount, std::memory_order_relaxed );
+	}
+
+	void RWMutexUpgrader( void* const io_data )
+	{
+		auto& data = *static_cast<sRWMutexData*>( io_data );
+		uint64_t upgradeCount = 0;
+		uint64_t violationCount = 0;
+		eae6320::Concurrency::WaitForEvent( data.whenToStart );
+		for ( unsigned int i = 0; !data.shouldStop.load( std::memory_order_relaxed ); ++i )
+		{
+			data.mutex.LockUpgradable();
+			// The upgradable lock can be held at the same time as shared locks but not at the same time as the exclusive lock
+			if ( ( data.activeWriterCount.load() != 0 ) || ( data.value != data.valueCopy ) )
+			{
+				++violationCount;
+			}
+			const auto valueBeforeUpgrade = data.value;
+			// Some of the locks are released without upgrading
+			if ( ( i % 4 ) == 0 )
+			{
+				data.mutex.UnlockUpgradable();
+				continue;
+			}
+			// Yielding sometimes gives the writer a chance to start waiting for the exclusive lock before the upgrade
+			if ( ( i % 4 ) == 1 )
+			{
+				std::this_thread::yield();
+			}
+			data.mutex.UpgradeToExclusive();
+			{
+				// Nothing can have changed the value while the lock was being upgraded
+				if ( ( data.activeWriterCount.fetch_add( 1 ) != 0 ) || ( data.activeReaderCount.load() != 0 )
+					|| ( data.value != valueBeforeUpgrade ) )
+				{
+					++violationCount;
+				}
+				++data.value;
+				data.valueCopy = data.value;
+				data.activeWriterCount.fetch_sub( 1 );
+			}
+			data.mutex.Unlock();
+			++upgradeCount;
+		}
+		data.upgradeCount.fetch_add( upgradeCount, std::memory_order_relaxed );
+		data.violationCount.fetch_add( violationCount, std::memory_order_relaxed );
+	}
+
+	void SeqLockReader( void* const io_data )
+	{
+		auto& data = *static_cast<sSeqLockData*>( io_data );
+		uint64_t readCount = 0;
+		uint64_t violationCount = 0;
+		uint64_t previousValue = 0;
+		eae6320::Concurrency::WaitForEvent( data.whenToStart );
+		while ( !data.shouldStop.load( std::memory_order_relaxed ) )
+		{
+			const auto value = data.seqLock.Read();
+			// A torn read would have words from different writes,
+			// and a value that went backwards would mean that a stale value was returned after a newer one
+			auto isValueValid = value.words[0] >= previousValue;
+			for ( const auto word : value.words )
+			{
+				isValueValid = isValueValid && ( word == value.words[0] );
+			}
+			if ( !isValueValid )
+			{
+				++violationCount;
+			}
+			previousValue = value.words[0];
+			++readCount;
+		}
+		data.readCount.fetch_add( readCount, std::memory_order_relaxed );
+		data.violationCount.fetch_add( violationCount, std::memory_order_relaxed );
+	}
+
+	void SeqLockWriter( void* const io_data )
+	{
+		auto& data = *static_cast<sSeqLockData*>( io_data );
+		uint64_t writeCount = 0;
+		eae6320::Concurrency::WaitForEvent( data.whenToStart );
+		while ( !data.shouldStop.load( std::memory_order_relaxed ) )
+		{
+			{
+				eae6320::Concurrency::cSeqLock<sSeqLockValue>::cScopeWrite scopeWrite( data.seqLock );
+				for ( auto& word : scopeWrite.Get().words )
+				{
+					++word;
+				}
+			}
+			++writeCount;
+		}
+		data.writeCount.fetch_add( writeCount, std::memory_order_relaxed );
+	}
+}
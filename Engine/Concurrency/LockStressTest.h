@@ -0,0 +1,57 @@
+/*
+	The lock stress test runs many threads against a reader-writer mutex and a sequence lock
+	and checks that the values they protect are never seen in a state that the locks should prevent
+
+	cRWMutex:
+		* Reader threads hold shared locks and check that no writer is active and that the value isn't half-written
+		* A writer thread holds the exclusive lock and checks that no other thread holds any lock
+		* Upgrading threads read the value with the upgradable lock, upgrade to the exclusive lock while the writer races them,
+			and check that the value didn't change between the read and the write
+		* At the end the value must have been incremented once for every write and every upgrade
+	cSeqLock:
+		* Reader threads check that every value that they read was written completely by a single write
+			and that the values they read never go backwards
+		* Writer threads increment the value, and at the end it must have been incremented once for every write
+*/
+
+#ifndef EAE6320_CONCURRENCY_LOCKSTRESSTEST_H
+#define EAE6320_CONCURRENCY_LOCKSTRESSTEST_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace LockStressTest
+		{
+			struct sResults
+			{
+				// How many times each kind of lock was held
+				uint64_t sharedLockCount = 0;
+				uint64_t exclusiveLockCount = 0;
+				uint64_t upgradeCount = 0;
+				uint64_t seqLockReadCount = 0;
+				uint64_t seqLockWriteCount = 0;
+				// How many times a thread saw something that the locks should have prevented
+				uint64_t violationCount = 0;
+			};
+
+			// This fails if there were any violations
+			cResult Run( sResults& o_results,
+				const unsigned int i_readerThreadCount = 4, const unsigned int i_timeToRunEachLock_inMilliseconds = 250 );
+
+			// This runs the test and outputs the results to the log
+			cResult LogReport( const unsigned int i_readerThreadCount = 4, const unsigned int i_timeToRunEachLock_inMilliseconds = 250 );
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_LOCKSTRESSTEST_H
@@ -0,0 +1,190 @@
+// Include Files
+//==============
+
+#include "MutexProfiling.h"
+
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+
+#include "cMutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <Engine/Logging/Logging.h>
+
+// Helper Class Declaration
+//=========================
+
+struct eae6320::Concurrency::MutexProfiling::sLockRecord
+{
+	const std::string name;
+	// Every mutex with the same name updates the same record,
+	// and so the values are atomic even though each mutex only updates them while it is locked
+	std::atomic<uint64_t> acquisitionCount{ 0 };
+	std::atomic<uint64_t> contendedAcquisitionCount{ 0 };
+	std::atomic<uint64_t> totalWaitTime_inTicks{ 0 };
+	std::atomic<uint64_t> maxWaitTime_inTicks{ 0 };
+	std::atomic<uint64_t> holdTimeHistogram[HoldTimeHistogramBucketCount] = {};
+
+	sLockRecord( const char* const i_name ) : name( i_name ) {}
+};
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sRecords
+	{
+		// This mutex doesn't have a name and so it isn't profiled itself
+		eae6320::Concurrency::cMutex mutex;
+		std::vector<eae6320::Concurrency::MutexProfiling::sLockRecord*> records;
+	};
+
+	// Mutexes with static storage duration can be constructed before (and destroyed after) anything else,
+	// and so the records are created the first time that they are needed and are never destroyed
+	sRecords& GetRecords()
+	{
+		static auto* const s_records = new sRecords;
+		return *s_records;
+	}
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	void UpdateMaximum( std::atomic<uint64_t>& io_maximum, const uint64_t i_value );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+void eae6320::Concurrency::MutexProfiling::GetStatistics( std::vector<sLockStatistics>& o_statistics )
+{
+	o_statistics.clear();
+	auto& records = GetRecords();
+	cMutex::cScopeLock autoLock( records.mutex );
+	o_statistics.resize( records.records.size() );
+	for ( size_t i = 0; i < records.records.size(); ++i )
+	{
+		const auto& record = *records.records[i];
+		auto& statistics = o_statistics[i];
+		statistics.name = record.name;
+		statistics.acquisitionCount = record.acquisitionCount.load( std::memory_order_relaxed );
+		statistics.contendedAcquisitionCount = record.contendedAcquisitionCount.load( std::memory_order_relaxed );
+		statistics.totalWaitTime_inSeconds = ConvertTicksToSeconds( record.totalWaitTime_inTicks.load( std::memory_order_relaxed ) );
+		statistics.maxWaitTime_inSeconds = ConvertTicksToSeconds( record.maxWaitTime_inTicks.load( std::memory_order_relaxed ) );
+		for ( size_t j = 0; j < HoldTimeHistogramBucketCount; ++j )
+		{
+			statistics.holdTimeHistogram[j] = record.holdTimeHistogram[j].load( std::memory_order_relaxed );
+		}
+	}
+}
+
+void eae6320::Concurrency::MutexProfiling::LogReport()
+{
+	std::vector<sLockStatistics> statisticsList;
+	GetStatistics( statisticsList );
+	if ( statisticsList.empty() )
+	{
+		return;
+	}
+	// The locks that threads spent the most time waiting for are listed first
+	std::sort( statisticsList.begin(), statisticsList.end(),
+		[]( const sLockStatistics& i_lhs, const sLockStatistics& i_rhs )
+		{
+			return i_lhs.totalWaitTime_inSeconds > i_rhs.totalWaitTime_inSeconds;
+		} );
+	Logging::OutputMessage( "Mutex contention (%u named locks):", static_cast<unsigned int>( statisticsList.size() ) );
+	for ( const auto& statistics : statisticsList )
+	{
+		const auto contendedPercentage = ( statistics.acquisitionCount > 0 )
+			? ( 100.0 * static_cast<double>( statistics.contendedAcquisitionCount ) / static_cast<double>( statistics.acquisitionCount ) )
+			: 0.0;
+		Logging::OutputMessage( "\t%s: %llu acquisitions, %llu contended (%.1f%%), %.3f ms total wait, %.3f ms longest wait",
+			statistics.name.c_str(),
+			static_cast<unsigned long long>( statistics.acquisitionCount ),
+			static_cast<unsigned long long>( statistics.contendedAcquisitionCount ), contendedPercentage,
+			statistics.totalWaitTime_inSeconds * 1000.0, statistics.maxWaitTime_inSeconds * 1000.0 );
+		// Only the buckets that have hold times in them are listed
+		std::string histogram;
+		for ( size_t i = 0; i < HoldTimeHistogramBucketCount; ++i )
+		{
+			if ( statistics.holdTimeHistogram[i] > 0 )
+			{
+				const auto limit_inMicroseconds = 1ull << i;
+				histogram += ( i < ( HoldTimeHistogramBucketCount - 1 ) )
+					? ( " <" + std::to_string( limit_inMicroseconds ) )
+					: ( " >=" + std::to_string( limit_inMicroseconds / 2 ) );
+				histogram += "us:" + std::to_string( statistics.holdTimeHistogram[i] );
+			}
+		}
+		if ( !histogram.empty() )
+		{
+			Logging::OutputMessage( "\t\tHold times:%s", histogram.c_str() );
+		}
+	}
+}
+
+// Implementation
+//===============
+
+eae6320::Concurrency::MutexProfiling::sLockRecord* eae6320::Concurrency::MutexProfiling::GetLockRecord( const char* const i_name )
+{
+	auto& records = GetRecords();
+	cMutex::cScopeLock autoLock( records.mutex );
+	for ( auto* const record : records.records )
+	{
+		if ( record->name == i_name )
+		{
+			return record;
+		}
+	}
+	auto* const newRecord = new sLockRecord( i_name );
+	records.records.push_back( newRecord );
+	return newRecord;
+}
+
+void eae6320::Concurrency::MutexProfiling::RecordAcquisition( sLockRecord& io_record, const uint64_t i_waitTime_inTicks, const bool i_wasContended )
+{
+	io_record.acquisitionCount.fetch_add( 1, std::memory_order_relaxed );
+	if ( i_wasContended )
+	{
+		io_record.contendedAcquisitionCount.fetch_add( 1, std::memory_order_relaxed );
+		io_record.totalWaitTime_inTicks.fetch_add( i_waitTime_inTicks, std::memory_order_relaxed );
+		UpdateMaximum( io_record.maxWaitTime_inTicks, i_waitTime_inTicks );
+	}
+}
+
+void eae6320::Concurrency::MutexProfiling::RecordRelease( sLockRecord& io_record, const uint64_t i_holdTime_inTicks )
+{
+	const auto holdTime_inMicroseconds = ConvertTicksToSeconds( i_holdTime_inTicks ) * 1000000.0;
+	size_t bucketIndex = 0;
+	{
+		auto limit_inMicroseconds = 1.0;
+		while ( ( bucketIndex < ( HoldTimeHistogramBucketCount - 1 ) ) && ( holdTime_inMicroseconds >= limit_inMicroseconds ) )
+		{
+			++bucketIndex;
+			limit_inMicroseconds *= 2.0;
+		}
+	}
+	io_record.holdTimeHistogram[bucketIndex].fetch_add( 1, std::memory_order_relaxed );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void UpdateMaximum( std::atomic<uint64_t>& io_maximum, const uint64_t i_value )
+	{
+		auto maximum = io_maximum.load( std::memory_order_relaxed );
+		while ( ( i_value > maximum ) && !io_maximum.compare_exchange_weak( maximum, i_value, std::memory_order_relaxed ) ) {}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED
@@ -0,0 +1,92 @@
+/*
+	Mutex profiling records how named mutexes are used
+	so that it is possible to tell which locks are contended
+
+	For every name the following is recorded:
+		* How many times a lock was acquired
+		* How many of those acquisitions had to wait for a different thread to release the lock
+		* How long threads waited in total, and the longest single wait
+		* A histogram of how long the lock was held
+	Mutexes that share a name are recorded together
+	(e.g. every asset manager's mutex is recorded under the same name).
+
+	Profiling only happens when EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED is defined (see Configuration.h);
+	otherwise the statistics are always empty and mutexes don't do anything extra.
+*/
+
+#ifndef EAE6320_CONCURRENCY_MUTEXPROFILING_H
+#define EAE6320_CONCURRENCY_MUTEXPROFILING_H
+
+// Include Files
+//==============
+
+#include "Configuration.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace MutexProfiling
+		{
+			// Hold times are recorded in buckets whose limits are powers of two microseconds:
+			// Bucket 0 is for hold times less than 1 µs, bucket 1 for less than 2 µs, bucket 2 for less than 4 µs, etc.,
+			// and the last bucket is for every hold time that is longer than that
+			constexpr size_t HoldTimeHistogramBucketCount = 16;
+
+			struct sLockStatistics
+			{
+				std::string name;
+				uint64_t acquisitionCount = 0;
+				uint64_t contendedAcquisitionCount = 0;
+				double totalWaitTime_inSeconds = 0.0;
+				double maxWaitTime_inSeconds = 0.0;
+				uint64_t holdTimeHistogram[HoldTimeHistogramBucketCount] = {};
+			};
+
+			// Access
+			//-------
+
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+
+			// This can be called at any time from any thread
+			// (the statistics of a lock that is being used while this is called might be slightly out of date)
+			void GetStatistics( std::vector<sLockStatistics>& o_statistics );
+
+			// This outputs the statistics of every named lock to the log
+			void LogReport();
+
+			// Implementation
+			//===============
+
+			// These are only used by the mutex implementations
+
+			struct sLockRecord;
+
+			// This returns the record for the given name
+			// (records are never destroyed, and so the returned pointer is always valid)
+			sLockRecord* GetLockRecord( const char* const i_name );
+
+			uint64_t GetCurrentTickCount();
+			double ConvertTicksToSeconds( const uint64_t i_tickCount );
+			void RecordAcquisition( sLockRecord& io_record, const uint64_t i_waitTime_inTicks, const bool i_wasContended );
+			void RecordRelease( sLockRecord& io_record, const uint64_t i_holdTime_inTicks );
+
+#else
+
+			inline void GetStatistics( std::vector<sLockStatistics>& o_statistics ) { o_statistics.clear(); }
+			inline void LogReport() {}
+
+#endif
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_MUTEXPROFILING_H
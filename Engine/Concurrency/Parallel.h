@@ -0,0 +1,54 @@
+/*
+	Parallel loops split a range of indices into chunks that are run by the job system
+
+	The chunks only depend on the size of the range and the grain size
+	(and not on how many worker threads there are or which worker runs which chunk),
+	and ParallelReduce() combines the chunks' results in order,
+	and so the results are the same every time even for operations like floating-point addition.
+	A range that fits in a single chunk is run directly on the calling thread
+	without creating any jobs.
+*/
+
+#ifndef EAE6320_CONCURRENCY_PARALLEL_H
+#define EAE6320_CONCURRENCY_PARALLEL_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// If a grain size of zero is provided the range is split into (at most) this many chunks
+		// (of at least s_minAutomaticGrainSize indices each)
+		constexpr size_t s_automaticChunkCount = 64;
+		constexpr size_t s_minAutomaticGrainSize = 16;
+
+		// This returns the number of indices in each chunk (the last chunk can be smaller)
+		size_t CalculateChunkSize( const size_t i_indexCount, const size_t i_grainSize );
+
+		// The body is called with a half-open range of indices, [i_chunkBegin, i_chunkEnd):
+		//	void i_body( const size_t i_chunkBegin, const size_t i_chunkEnd )
+		// and different chunks can be run concurrently.
+		// This returns once every chunk has been run.
+		template <typename fBody>
+			void ParallelFor( const size_t i_begin, const size_t i_end, const size_t i_grainSize, const fBody& i_body );
+
+		// The map function calculates the result of a chunk:
+		//	tValue i_map( const size_t i_chunkBegin, const size_t i_chunkEnd )
+		// and then the results of every chunk are combined in order, starting with the identity:
+		//	tValue i_combine( const tValue& i_lhs, const tValue& i_rhs )
+		template <typename tValue, typename fMap, typename fCombine>
+			tValue ParallelReduce( const size_t i_begin, const size_t i_end, const size_t i_grainSize,
+				const tValue& i_identity, const fMap& i_map, const fCombine& i_combine );
+	}
+}
+
+#include "Parallel.inl"
+
+#endif	// EAE6320_CONCURRENCY_PARALLEL_H
@@ -0,0 +1,103 @@
+#ifndef EAE6320_CONCURRENCY_PARALLEL_INL
+#define EAE6320_CONCURRENCY_PARALLEL_INL
+
+// Include Files
+//==============
+
+#include "Parallel.h"
+
+#include "JobSystem.h"
+
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+inline size_t eae6320::Concurrency::CalculateChunkSize( const size_t i_indexCount, const size_t i_grainSize )
+{
+	if ( i_grainSize > 0 )
+	{
+		return i_grainSize;
+	}
+	// The automatic size only depends on the number of indices
+	// so that the chunks are the same regardless of how many worker threads there are
+	const auto chunkSize = ( i_indexCount + ( s_automaticChunkCount - 1 ) ) / s_automaticChunkCount;
+	return ( chunkSize > s_minAutomaticGrainSize ) ? chunkSize : s_minAutomaticGrainSize;
+}
+
+template <typename fBody>
+	void eae6320::Concurrency::ParallelFor( const size_t i_begin, const size_t i_end, const size_t i_grainSize, const fBody& i_body )
+{
+	if ( i_end <= i_begin )
+	{
+		return;
+	}
+	const auto indexCount = i_end - i_begin;
+	const auto chunkSize = CalculateChunkSize( indexCount, i_grainSize );
+	// Small ranges (and any range when there are no worker threads) are run directly
+	if ( ( indexCount <= chunkSize ) || ( JobSystem::GetWorkerThreadCount() == 0 ) )
+	{
+		for ( auto chunkBegin = i_begin; chunkBegin < i_end; chunkBegin += chunkSize )
+		{
+			const auto chunkEnd = ( ( i_end - chunkBegin ) > chunkSize ) ? ( chunkBegin + chunkSize ) : i_end;
+			i_body( chunkBegin, chunkEnd );
+		}
+		return;
+	}
+	// Every chunk except for the first is run as a job,
+	// and the calling thread runs the first chunk itself while it would otherwise be waiting
+	JobSystem::cJobCounter counter;
+	for ( auto chunkBegin = i_begin + chunkSize; chunkBegin < i_end; chunkBegin += chunkSize )
+	{
+		const auto chunkEnd = ( ( i_end - chunkBegin ) > chunkSize ) ? ( chunkBegin + chunkSize ) : i_end;
+		JobSystem::Run( [&i_body, chunkBegin, chunkEnd]() { i_body( chunkBegin, chunkEnd ); }, &counter );
+	}
+	i_body( i_begin, i_begin + chunkSize );
+	JobSystem::WaitForCounter( counter );
+}
+
+template <typename tValue, typename fMap, typename fCombine>
+	tValue eae6320::Concurrency::ParallelReduce( const size_t i_begin, const size_t i_end, const size_t i_grainSize,
+		const tValue& i_identity, const fMap& i_map, const fCombine& i_combine )
+{
+	if ( i_end <= i_begin )
+	{
+		return i_identity;
+	}
+	const auto indexCount = i_end - i_begin;
+	const auto chunkSize = CalculateChunkSize( indexCount, i_grainSize );
+	if ( indexCount <= chunkSize )
+	{
+		return i_combine( i_identity, i_map( i_begin, i_end ) );
+	}
+	// Each chunk's result is stored separately
+	// so that they can be combined in the same order every time.
+	// The results are wrapped so that a std::vector<bool> (which packs its values into shared words) is never used,
+	// and padded so that workers writing neighboring results don't share a cache line.
+	struct sChunkResult
+	{
+		tValue value;
+		uint8_t padding[64];
+	};
+	const auto chunkCount = ( indexCount + ( chunkSize - 1 ) ) / chunkSize;
+	std::vector<sChunkResult> chunkResults( chunkCount, sChunkResult{ i_identity } );
+	ParallelFor( 0, chunkCount, 1,
+		[&]( const size_t i_chunkIndexBegin, const size_t i_chunkIndexEnd )
+		{
+			for ( auto chunkIndex = i_chunkIndexBegin; chunkIndex < i_chunkIndexEnd; ++chunkIndex )
+			{
+				const auto chunkBegin = i_begin + ( chunkIndex * chunkSize );
+				const auto chunkEnd = ( ( i_end - chunkBegin ) > chunkSize ) ? ( chunkBegin + chunkSize ) : i_end;
+				chunkResults[chunkIndex].value = i_map( chunkBegin, chunkEnd );
+			}
+		} );
+	auto result = i_identity;
+	for ( const auto& chunkResult : chunkResults )
+	{
+		result = i_combine( result, chunkResult.value );
+	}
+	return result;
+}
+
+#endif	// EAE6320_CONCURRENCY_PARALLEL_INL
@@ -0,0 +1,175 @@
+// Include Files
+//==============
+
+#include "ParallelReduceCheck.h"
+
+#include "JobSystem.h"
+#include "Parallel.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Running without the job system is what every worker thread count is compared to
+	constexpr unsigned int s_workerThreadCounts[] = { 1, 2, 4, 8 };
+
+	constexpr size_t s_valueCount = 100000;
+	// These are the grain sizes that the sum is calculated with
+	// (zero lets ParallelReduce() choose, and the other is small and doesn't divide the value count evenly)
+	constexpr size_t s_sumGrainSizeCount = 2;
+	constexpr size_t s_sumGrainSizes[s_sumGrainSizeCount] = { 0, 7 };
+
+	// Every chunk of the bool reductions has a single index
+	constexpr size_t s_boolChunkCount = 256;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This returns how many of the reductions didn't match
+	unsigned int CheckReductions( const std::vector<float>& i_values, const float ( &i_expectedSums )[s_sumGrainSizeCount] );
+	float CalculateSum( const std::vector<float>& i_values, const size_t i_grainSize );
+	bool AreFloatsIdentical( const float i_lhs, const float i_rhs );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::ParallelReduceCheck::Run( sResults& o_results, const sThreadOptions& i_workerThreadOptions )
+{
+	auto result = Results::Success;
+
+	o_results = sResults();
+	if ( JobSystem::GetWorkerThreadCount() != 0 )
+	{
+		EAE6320_ASSERTF( false, "The ParallelReduce() check can't be run while the job system is initialized" );
+		return Results::Failure;
+	}
+
+	// The values have very different magnitudes
+	// so that adding them in a different order would give a different sum
+	std::vector<float> values( s_valueCount );
+	for ( size_t i = 0; i < s_valueCount; ++i )
+	{
+		values[i] = ( ( i % 97 ) == 0 ) ? 1.0e7f : ( 0.001f * static_cast<float>( ( i * 7919 ) % 1000 ) );
+	}
+	// The expected sums are calculated before the job system is initialized,
+	// and so every chunk is run on this thread in order
+	float expectedSums[s_sumGrainSizeCount];
+	for ( size_t i = 0; i < s_sumGrainSizeCount; ++i )
+	{
+		expectedSums[i] = CalculateSum( values, s_sumGrainSizes[i] );
+	}
+	o_results.sum = expectedSums[0];
+	o_results.mismatchCount += CheckReductions( values, expectedSums );
+
+	for ( const auto workerThreadCount : s_workerThreadCounts )
+	{
+		if ( !( result = JobSystem::Initialize( workerThreadCount, i_workerThreadOptions ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the job system with %u worker threads", workerThreadCount );
+			return result;
+		}
+		o_results.mismatchCount += CheckReductions( values, expectedSums );
+		if ( !( result = JobSystem::CleanUp() ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't clean up the job system" );
+			return result;
+		}
+		++o_results.workerThreadCountsCheckedCount;
+	}
+	if ( o_results.mismatchCount > 0 )
+	{
+		EAE6320_ASSERTF( false, "ParallelReduce() returned a different result than it should have" );
+		result = Results::Failure;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::ParallelReduceCheck::LogReport( const sThreadOptions& i_workerThreadOptions )
+{
+	sResults results;
+	const auto result = Run( results, i_workerThreadOptions );
+	if ( result )
+	{
+		Logging::OutputMessage( "ParallelReduce() returned the same results with %u different worker thread counts (the sum was %.9g)",
+			results.workerThreadCountsCheckedCount, results.sum );
+	}
+	else if ( results.mismatchCount > 0 )
+	{
+		Logging::OutputError( "ParallelReduce() returned %u results that were different than they should have been",
+			results.mismatchCount );
+	}
+	else
+	{
+		Logging::OutputError( "The ParallelReduce() check couldn't be run" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	unsigned int CheckReductions( const std::vector<float>& i_values, const float ( &i_expectedSums )[s_sumGrainSizeCount] )
+	{
+		unsigned int mismatchCount = 0;
+
+		for ( size_t i = 0; i < s_sumGrainSizeCount; ++i )
+		{
+			if ( !AreFloatsIdentical( CalculateSum( i_values, s_sumGrainSizes[i] ), i_expectedSums[i] ) )
+			{
+				++mismatchCount;
+			}
+		}
+		// Only one chunk's result is different from the identity,
+		// and so if it were lost (e.g. because a neighboring chunk's result was written at the same time)
+		// the reduction would return the identity
+		for ( size_t differentChunkIndex = 0; differentChunkIndex < s_boolChunkCount; ++differentChunkIndex )
+		{
+			const auto isAnyTrue = eae6320::Concurrency::ParallelReduce( 0, s_boolChunkCount, 1, false,
+				[differentChunkIndex]( const size_t i_chunkBegin, const size_t ) { return i_chunkBegin == differentChunkIndex; },
+				[]( const bool i_lhs, const bool i_rhs ) { return i_lhs || i_rhs; } );
+			const auto areAllTrue = eae6320::Concurrency::ParallelReduce( 0, s_boolChunkCount, 1, true,
+				[differentChunkIndex]( const size_t i_chunkBegin, const size_t ) { return i_chunkBegin != differentChunkIndex; },
+				[]( const bool i_lhs, const bool i_rhs ) { return i_lhs && i_rhs; } );
+			if ( !isAnyTrue || areAllTrue )
+			{
+				++mismatchCount;
+			}
+		}
+
+		return mismatchCount;
+	}
+
+	float CalculateSum( const std::vector<float>& i_values, const size_t i_grainSize )
+	{
+		return eae6320::Concurrency::ParallelReduce( 0, i_values.size(), i_grainSize, 0.0f,
+			[&i_values]( const size_t i_chunkBegin, const size_t i_chunkEnd )
+			{
+				auto sum = 0.0f;
+				for ( auto i = i_chunkBegin; i < i_chunkEnd; ++i )
+				{
+					sum += i_values[i];
+				}
+				return sum;
+			},
+			[]( const float i_lhs, const float i_rhs ) { return i_lhs + i_rhs; } );
+	}
+
+	// The sums must be exactly the same, and so their bits are compared
+	bool AreFloatsIdentical( const float i_lhs, const float i_rhs )
+	{
+		return std::memcmp( &i_lhs, &i_rhs, sizeof( float ) ) == 0;
+	}
+}
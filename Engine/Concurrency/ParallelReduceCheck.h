@@ -0,0 +1,54 @@
+/*
+	The parallel reduce check makes sure that ParallelReduce() returns the same results
+	no matter how many worker threads the job system has
+
+	Two things are checked:
+		* A floating-point sum (which depends on the order that values are added in)
+			must have exactly the same bits with every worker thread count
+			as it does when every chunk is run on the calling thread
+		* Reductions of bools with a single index in every chunk must never lose a chunk's result
+			(neighboring chunk results are written by different workers at the same time)
+*/
+
+#ifndef EAE6320_CONCURRENCY_PARALLELREDUCECHECK_H
+#define EAE6320_CONCURRENCY_PARALLELREDUCECHECK_H
+
+// Include Files
+//==============
+
+#include "cThread.h"
+
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace ParallelReduceCheck
+		{
+			struct sResults
+			{
+				// The sum that every worker thread count must match
+				float sum = 0.0f;
+				// How many worker thread counts were checked (not counting running without the job system)
+				unsigned int workerThreadCountsCheckedCount = 0;
+				// How many reductions returned a different result than they should have
+				unsigned int mismatchCount = 0;
+			};
+
+			// The job system must not be initialized when this is called:
+			// The check initializes the job system with each worker thread count in turn
+			// (using the provided thread options) and cleans it up again.
+			// This fails if any result was different.
+			cResult Run( sResults& o_results, const sThreadOptions& i_workerThreadOptions = sThreadOptions() );
+
+			// This runs the check and outputs the results to the log
+			cResult LogReport( const sThreadOptions& i_workerThreadOptions = sThreadOptions() );
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_PARALLELREDUCECHECK_H
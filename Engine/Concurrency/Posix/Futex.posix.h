@@ -0,0 +1,163 @@
+/*
+	A futex ("fast user-space mutex") is a 32-bit word that threads can sleep on in the kernel
+
+	The kernel is only involved when a thread actually has to sleep or be woken:
+		* A thread that waits only sleeps if the word still has the value that it expected
+			(so a change that happens just before it goes to sleep can't be missed)
+		* A thread that changes the word only wakes sleeping threads if it knows that there are some
+	This file has the futex functions that the POSIX implementations of the concurrency classes share.
+	Futexes are a Linux system call,
+	and so Linux is the only POSIX platform that the concurrency classes currently support.
+*/
+
+#ifndef EAE6320_CONCURRENCY_FUTEX_POSIX_H
+#define EAE6320_CONCURRENCY_FUTEX_POSIX_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+	#include <immintrin.h>
+#endif
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace Futex
+		{
+			static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "A futex word must be a plain 32-bit integer" );
+
+			// Sleeping and Waking
+			//--------------------
+
+			// This returns when another thread wakes it, when the time-out period elapses,
+			// or immediately if the word doesn't have the expected value.
+			// Spurious wake-ups are possible, and so the caller must always check the word again.
+			// A null time-out waits forever.
+			inline void Wait( std::atomic<uint32_t>& io_word, const uint32_t i_expectedValue, const timespec* const i_timeToWait )
+			{
+				syscall( SYS_futex, reinterpret_cast<uint32_t*>( &io_word ), FUTEX_WAIT_PRIVATE, i_expectedValue, i_timeToWait, nullptr, 0 );
+			}
+			// This only uses the address of the word and never reads or writes it,
+			// and so it is safe to call even if a woken thread might have already destroyed the object that the word is in
+			inline void Wake( std::atomic<uint32_t>& io_word, const int i_threadCount )
+			{
+				syscall( SYS_futex, reinterpret_cast<uint32_t*>( &io_word ), FUTEX_WAKE_PRIVATE, i_threadCount, nullptr, nullptr, 0 );
+			}
+			inline void WakeAll( std::atomic<uint32_t>& io_word )
+			{
+				Wake( io_word, INT_MAX );
+			}
+
+			// Time
+			//-----
+
+			// The futex time-out is relative, and so a thread that is woken before its deadline
+			// calculates how much time is left before it waits again
+			inline timespec GetDeadline( const unsigned int i_timeToWait_inMilliseconds )
+			{
+				timespec deadline;
+				clock_gettime( CLOCK_MONOTONIC, &deadline );
+				deadline.tv_sec += static_cast<time_t>( i_timeToWait_inMilliseconds / 1000 );
+				deadline.tv_nsec += static_cast<long>( i_timeToWait_inMilliseconds % 1000 ) * 1000000L;
+				if ( deadline.tv_nsec >= 1000000000L )
+				{
+					++deadline.tv_sec;
+					deadline.tv_nsec -= 1000000000L;
+				}
+				return deadline;
+			}
+			// This returns false if the deadline has already passed
+			inline bool GetTimeUntilDeadline( const timespec& i_deadline, timespec& o_timeToWait )
+			{
+				timespec currentTime;
+				clock_gettime( CLOCK_MONOTONIC, &currentTime );
+				o_timeToWait.tv_sec = i_deadline.tv_sec - currentTime.tv_sec;
+				o_timeToWait.tv_nsec = i_deadline.tv_nsec - currentTime.tv_nsec;
+				if ( o_timeToWait.tv_nsec < 0 )
+				{
+					--o_timeToWait.tv_sec;
+					o_timeToWait.tv_nsec += 1000000000L;
+				}
+				return ( o_timeToWait.tv_sec > 0 ) || ( ( o_timeToWait.tv_sec == 0 ) && ( o_timeToWait.tv_nsec > 0 ) );
+			}
+
+			// Spinning
+			//---------
+
+			// This tells the processor that the thread is spinning
+			// (which saves power and lets another hardware thread on the same core run)
+			inline void PauseProcessor()
+			{
+#if defined( __x86_64__ ) || defined( __i386__ )
+				_mm_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+				__asm__ __volatile__( "yield" );
+#endif
+			}
+
+			// Mutexes
+			//--------
+
+			// A futex mutex is a word with three states
+			// (the third state is what lets an unlocking thread skip the system call when nobody is sleeping)
+			constexpr uint32_t s_unlocked = 0;
+			constexpr uint32_t s_locked = 1;
+			constexpr uint32_t s_lockedWithSleepingThreads = 2;
+			// A thread that finds a mutex locked spins this many times before it goes to sleep
+			// (the mutexes that the engine uses are only held for short periods)
+			constexpr unsigned int s_mutexSpinCount = 128;
+
+			inline bool TryToLock( std::atomic<uint32_t>& io_state )
+			{
+				auto expectedState = s_unlocked;
+				return io_state.compare_exchange_strong( expectedState, s_locked, std::memory_order_acquire, std::memory_order_relaxed );
+			}
+			inline void Lock( std::atomic<uint32_t>& io_state )
+			{
+				if ( TryToLock( io_state ) )
+				{
+					return;
+				}
+				// Spin for a short time in case the lock is about to be released
+				// (the state is only read while spinning so that the cache line isn't taken away from the thread holding the lock)
+				for ( unsigned int i = 0; i < s_mutexSpinCount; ++i )
+				{
+					PauseProcessor();
+					if ( ( io_state.load( std::memory_order_relaxed ) == s_unlocked ) && TryToLock( io_state ) )
+					{
+						return;
+					}
+				}
+				// Once a thread has gone to sleep it can't know whether there are other sleeping threads,
+				// and so it always leaves the state as locked with sleeping threads
+				// (which at worst causes one unnecessary system call when the lock is released)
+				while ( io_state.exchange( s_lockedWithSleepingThreads, std::memory_order_acquire ) != s_unlocked )
+				{
+					Wait( io_state, s_lockedWithSleepingThreads, nullptr );
+				}
+			}
+			inline void Unlock( std::atomic<uint32_t>& io_state )
+			{
+				if ( io_state.exchange( s_unlocked, std::memory_order_release ) == s_lockedWithSleepingThreads )
+				{
+					Wake( io_state, 1 );
+				}
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_FUTEX_POSIX_H
@@ -0,0 +1,29 @@
+// Include Files
+//==============
+
+#include "../MutexProfiling.h"
+
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+
+#include <ctime>
+
+// Implementation
+//===============
+
+// The engine's Time system isn't used because it depends on being initialized
+// and mutexes with static storage duration can be locked before that happens
+
+uint64_t eae6320::Concurrency::MutexProfiling::GetCurrentTickCount()
+{
+	// A tick is a nanosecond
+	timespec currentTime;
+	clock_gettime( CLOCK_MONOTONIC, &currentTime );
+	return ( static_cast<uint64_t>( currentTime.tv_sec ) * 1000000000u ) + static_cast<uint64_t>( currentTime.tv_nsec );
+}
+
+double eae6320::Concurrency::MutexProfiling::ConvertTicksToSeconds( const uint64_t i_tickCount )
+{
+	return static_cast<double>( i_tickCount ) * 1.0e-9;
+}
+
+#endif	// EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED
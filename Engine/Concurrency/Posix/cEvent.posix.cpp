@@ -0,0 +1,208 @@
+// Include Files
+//==============
+
+#include "../cEvent.h"
+
+#include "Futex.posix.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// The event's state is a futex word with three values
+	// (the third value is what lets Signal() skip the system call when nobody is sleeping)
+	constexpr uint32_t s_unsignaled = 0;
+	constexpr uint32_t s_signaled = 1;
+	constexpr uint32_t s_unsignaledWithSleepingThreads = 2;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This returns true if the event is signaled
+	// (and, if it resets automatically, resets it so that no other thread also gets the signal).
+	// A thread that has slept can't know whether there are other sleeping threads,
+	// and so it leaves the state as if there still are
+	// (which at worst causes one unnecessary system call the next time that the event is signaled).
+	bool TryToTakeSignal( std::atomic<uint32_t>& io_state, const eae6320::Concurrency::EventType i_type, const bool i_hasSlept );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::WaitForEvent( const eae6320::Concurrency::cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds )
+{
+	if ( i_event.m_isInitialized )
+	{
+		// Unlike with a kernel event checking the state doesn't require a system call
+		if ( TryToTakeSignal( i_event.m_state, i_event.m_type, false ) )
+		{
+			return eae6320::Results::Success;
+		}
+		if ( i_timeToWait_inMilliseconds == 0 )
+		{
+			return eae6320::Results::TimeOut;
+		}
+		if ( eae6320::Concurrency::cEvent::IsSpinningEnabled() && i_event.SpinUntilSignaled() )
+		{
+			return eae6320::Results::Success;
+		}
+		// Sleep in the kernel until the event is signaled
+		const auto shouldTimeOut = i_timeToWait_inMilliseconds != eae6320::Concurrency::Constants::DontTimeOut;
+		const auto deadline = shouldTimeOut ? Futex::GetDeadline( i_timeToWait_inMilliseconds ) : timespec();
+		auto hasSlept = false;
+		while ( true )
+		{
+			// The state must show that there is a sleeping thread before this thread goes to sleep
+			// so that Signal() knows to wake it
+			{
+				auto expectedState = s_unsignaled;
+				if ( !i_event.m_state.compare_exchange_strong( expectedState, s_unsignaledWithSleepingThreads,
+					std::memory_order_relaxed, std::memory_order_relaxed ) && ( expectedState == s_signaled ) )
+				{
+					if ( TryToTakeSignal( i_event.m_state, i_event.m_type, hasSlept ) )
+					{
+						return eae6320::Results::Success;
+					}
+					// A different thread took the signal
+					continue;
+				}
+			}
+			timespec timeToWait;
+			if ( shouldTimeOut && !Futex::GetTimeUntilDeadline( deadline, timeToWait ) )
+			{
+				return eae6320::Results::TimeOut;
+			}
+			Futex::Wait( i_event.m_state, s_unsignaledWithSleepingThreads, shouldTimeOut ? &timeToWait : nullptr );
+			hasSlept = true;
+			if ( TryToTakeSignal( i_event.m_state, i_event.m_type, hasSlept ) )
+			{
+				return eae6320::Results::Success;
+			}
+		}
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "An event can't be waited for until it has been initialized" );
+		eae6320::Logging::OutputError( "An attempt was made to wait for an event that hadn't been initialized" );
+		return eae6320::Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::Signal()
+{
+	EAE6320_ASSERTF( m_isInitialized, "An event can't be signaled until it has been initialized" );
+	if ( m_isInitialized )
+	{
+		const auto type = m_type;
+		// A waiting thread is allowed to destroy the event as soon as it has been set,
+		// and so after this the event's memory is only used as the futex address (which is never read or written)
+		const auto previousState = m_state.exchange( s_signaled, std::memory_order_acq_rel );
+		if ( previousState == s_unsignaledWithSleepingThreads )
+		{
+			if ( type == EventType::RemainSignaledUntilReset )
+			{
+				Futex::WakeAll( m_state );
+			}
+			else
+			{
+				Futex::Wake( m_state, 1 );
+			}
+		}
+		return Results::Success;
+	}
+	else
+	{
+		Logging::OutputError( "An attempt was made to signal an event that hadn't been initialized" );
+		return Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::ResetToUnsignaled()
+{
+	EAE6320_ASSERTF( m_isInitialized, "An event can't be reset until it has been initialized" );
+	if ( m_isInitialized )
+	{
+		// If the event is signaled it becomes unsignaled
+		// (if there are sleeping threads it is already unsignaled and must stay marked as having them)
+		auto expectedState = s_signaled;
+		m_state.compare_exchange_strong( expectedState, s_unsignaled, std::memory_order_relaxed, std::memory_order_relaxed );
+		return Results::Success;
+	}
+	else
+	{
+		Logging::OutputError( "An attempt was made to reset an event that hadn't been initialized" );
+		return Results::Failure;
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::cEvent::Initialize( const EventType i_type, const EventState i_initialState )
+{
+	m_type = i_type;
+	m_state.store( ( i_initialState == EventState::Signaled ) ? s_signaled : s_unsignaled, std::memory_order_release );
+	m_isInitialized = true;
+	return Results::Success;
+}
+
+eae6320::Concurrency::cEvent::cEvent()
+{
+
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::CleanUp()
+{
+	m_isInitialized = false;
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+bool eae6320::Concurrency::cEvent::SpinUntilSignaled() const
+{
+	const auto spinLimit = m_spinLimit.load( std::memory_order_relaxed );
+	// Checking the state is cheap,
+	// and so unlike on Windows there is no separate signal count to watch
+	for ( uint32_t spinCount = 0; spinCount < spinLimit; ++spinCount )
+	{
+		Futex::PauseProcessor();
+		if ( TryToTakeSignal( m_state, m_type, false ) )
+		{
+			UpdateSpinLimit( spinLimit, spinCount, true );
+			return true;
+		}
+	}
+	UpdateSpinLimit( spinLimit, spinLimit, false );
+	return false;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	bool TryToTakeSignal( std::atomic<uint32_t>& io_state, const eae6320::Concurrency::EventType i_type, const bool i_hasSlept )
+	{
+		// The state is only read first so that a spinning thread doesn't take the cache line away from the thread that will signal
+		if ( io_state.load( std::memory_order_acquire ) != s_signaled )
+		{
+			return false;
+		}
+		if ( i_type == eae6320::Concurrency::EventType::RemainSignaledUntilReset )
+		{
+			return true;
+		}
+		auto expectedState = s_signaled;
+		return io_state.compare_exchange_strong( expectedState, i_hasSlept ? s_unsignaledWithSleepingThreads : s_unsignaled,
+			std::memory_order_acquire, std::memory_order_relaxed );
+	}
+}
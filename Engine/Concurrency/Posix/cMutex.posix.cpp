@@ -0,0 +1,91 @@
+// Include Files
+//==============
+
+#include "../cMutex.h"
+
+#include "Futex.posix.h"
+
+// Interface
+//==========
+
+void eae6320::Concurrency::cMutex::Lock()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		// Trying to acquire the lock first shows whether it is contended
+		// without having to measure how long uncontended acquisitions take
+		const auto wasContended = !Futex::TryToLock( m_state );
+		uint64_t waitTime_inTicks = 0;
+		if ( wasContended )
+		{
+			const auto waitStartTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			Futex::Lock( m_state );
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			waitTime_inTicks = m_lockTime_inTicks - waitStartTime_inTicks;
+		}
+		else
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+		}
+		MutexProfiling::RecordAcquisition( *m_profilingRecord, waitTime_inTicks, wasContended );
+		return;
+	}
+#endif
+	Futex::Lock( m_state );
+}
+
+eae6320::cResult eae6320::Concurrency::cMutex::LockIfPossible()
+{
+	if ( Futex::TryToLock( m_state ) )
+	{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord )
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			MutexProfiling::RecordAcquisition( *m_profilingRecord, 0, false );
+		}
+#endif
+		return Results::Success;
+	}
+	else
+	{
+		return Results::Failure;
+	}
+}
+
+void eae6320::Concurrency::cMutex::Unlock()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		MutexProfiling::RecordRelease( *m_profilingRecord, MutexProfiling::GetCurrentTickCount() - m_lockTime_inTicks );
+	}
+#endif
+	Futex::Unlock( m_state );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cMutex::cMutex()
+{
+	// A futex doesn't need to be initialized beyond setting its word to unlocked
+}
+
+eae6320::Concurrency::cMutex::cMutex( const char* const i_name )
+	:
+	cMutex()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	m_profilingRecord = MutexProfiling::GetLockRecord( i_name );
+#else
+	// The name is only used for profiling
+	static_cast<void>( i_name );
+#endif
+}
+
+eae6320::Concurrency::cMutex::~cMutex()
+{
+
+}
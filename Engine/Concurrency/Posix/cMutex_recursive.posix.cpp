@@ -0,0 +1,129 @@
+// Include Files
+//==============
+
+#include "../cMutex_recursive.h"
+
+#include "Futex.posix.h"
+
+// Interface
+//==========
+
+void eae6320::Concurrency::cMutex_recursive::Lock()
+{
+	// A thread that already holds the lock only has to count how many times it has been locked
+	const auto currentThreadId = std::this_thread::get_id();
+	if ( m_owner.load( std::memory_order_relaxed ) == currentThreadId )
+	{
+		++m_recursionCount;
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord )
+		{
+			++m_lockDepth;
+		}
+#endif
+		return;
+	}
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		// Trying to acquire the lock first shows whether it is contended
+		// without having to measure how long uncontended acquisitions take
+		const auto wasContended = !Futex::TryToLock( m_state );
+		uint64_t waitTime_inTicks = 0;
+		if ( wasContended )
+		{
+			const auto waitStartTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			Futex::Lock( m_state );
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			waitTime_inTicks = m_lockTime_inTicks - waitStartTime_inTicks;
+		}
+		else
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+		}
+		m_owner.store( currentThreadId, std::memory_order_relaxed );
+		m_recursionCount = 1;
+		m_lockDepth = 1;
+		MutexProfiling::RecordAcquisition( *m_profilingRecord, waitTime_inTicks, wasContended );
+		return;
+	}
+#endif
+	Futex::Lock( m_state );
+	m_owner.store( currentThreadId, std::memory_order_relaxed );
+	m_recursionCount = 1;
+}
+
+eae6320::cResult eae6320::Concurrency::cMutex_recursive::LockIfPossible()
+{
+	const auto currentThreadId = std::this_thread::get_id();
+	if ( m_owner.load( std::memory_order_relaxed ) == currentThreadId )
+	{
+		++m_recursionCount;
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord )
+		{
+			++m_lockDepth;
+		}
+#endif
+		return Results::Success;
+	}
+	if ( Futex::TryToLock( m_state ) )
+	{
+		m_owner.store( currentThreadId, std::memory_order_relaxed );
+		m_recursionCount = 1;
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord && ( ++m_lockDepth == 1 ) )
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			MutexProfiling::RecordAcquisition( *m_profilingRecord, 0, false );
+		}
+#endif
+		return Results::Success;
+	}
+	else
+	{
+		return Results::Failure;
+	}
+}
+
+void eae6320::Concurrency::cMutex_recursive::Unlock()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord && ( --m_lockDepth == 0 ) )
+	{
+		MutexProfiling::RecordRelease( *m_profilingRecord, MutexProfiling::GetCurrentTickCount() - m_lockTime_inTicks );
+	}
+#endif
+	if ( --m_recursionCount == 0 )
+	{
+		// The owner is cleared before the lock is released
+		// so that the next thread to acquire the lock never sees this thread as the owner
+		m_owner.store( std::thread::id(), std::memory_order_relaxed );
+		Futex::Unlock( m_state );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cMutex_recursive::cMutex_recursive()
+{
+	// A futex doesn't need to be initialized beyond setting its word to unlocked
+}
+
+eae6320::Concurrency::cMutex_recursive::cMutex_recursive( const char* const i_name )
+	:
+	cMutex_recursive()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	m_profilingRecord = MutexProfiling::GetLockRecord( i_name );
+#else
+	// The name is only used for profiling
+	static_cast<void>( i_name );
+#endif
+}
+
+eae6320::Concurrency::cMutex_recursive::~cMutex_recursive()
+{
+
+}
@@ -0,0 +1,222 @@
+// Include Files
+//==============
+
+#include "../cRWMutex.h"
+
+#include "Futex.posix.h"
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// These must only be called while the state lock is held
+	void SleepConditionVariable( std::atomic<uint32_t>& io_conditionVariable, std::atomic<uint32_t>& io_stateLock );
+	void WakeConditionVariable( std::atomic<uint32_t>& io_conditionVariable );
+	void WakeAllConditionVariable( std::atomic<uint32_t>& io_conditionVariable );
+}
+
+// Interface
+//==========
+
+// Exclusive
+//----------
+
+void eae6320::Concurrency::cRWMutex::Lock()
+{
+	Futex::Lock( m_stateLock );
+	{
+		// Waiting writers stop any new shared or upgradable locks from being acquired
+		++m_waitingWriterCount;
+		while ( m_isWriterActive || ( m_readerCount > 0 ) || m_isUpgradableLockHeld )
+		{
+			SleepConditionVariable( m_whenWriterCanLock, m_stateLock );
+		}
+		--m_waitingWriterCount;
+		m_isWriterActive = true;
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+eae6320::cResult eae6320::Concurrency::cRWMutex::LockIfPossible()
+{
+	auto result = Results::Failure;
+	Futex::Lock( m_stateLock );
+	{
+		if ( !m_isWriterActive && ( m_readerCount == 0 ) && !m_isUpgradableLockHeld )
+		{
+			m_isWriterActive = true;
+			result = Results::Success;
+		}
+	}
+	Futex::Unlock( m_stateLock );
+	return result;
+}
+
+void eae6320::Concurrency::cRWMutex::Unlock()
+{
+	Futex::Lock( m_stateLock );
+	{
+		m_isWriterActive = false;
+		// Another writer gets the lock before any readers
+		if ( m_waitingWriterCount > 0 )
+		{
+			WakeConditionVariable( m_whenWriterCanLock );
+		}
+		else
+		{
+			WakeAllConditionVariable( m_whenReadersCanLock );
+		}
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+// Shared
+//-------
+
+void eae6320::Concurrency::cRWMutex::LockShared()
+{
+	Futex::Lock( m_stateLock );
+	{
+		while ( m_isWriterActive || ( m_waitingWriterCount > 0 ) || m_isUpgraderWaiting )
+		{
+			SleepConditionVariable( m_whenReadersCanLock, m_stateLock );
+		}
+		++m_readerCount;
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+eae6320::cResult eae6320::Concurrency::cRWMutex::LockSharedIfPossible()
+{
+	auto result = Results::Failure;
+	Futex::Lock( m_stateLock );
+	{
+		if ( !m_isWriterActive && ( m_waitingWriterCount == 0 ) && !m_isUpgraderWaiting )
+		{
+			++m_readerCount;
+			result = Results::Success;
+		}
+	}
+	Futex::Unlock( m_stateLock );
+	return result;
+}
+
+void eae6320::Concurrency::cRWMutex::UnlockShared()
+{
+	Futex::Lock( m_stateLock );
+	{
+		if ( --m_readerCount == 0 )
+		{
+			// A thread that is upgrading already holds the upgradable lock,
+			// and so it must be woken before any writer
+			if ( m_isUpgraderWaiting )
+			{
+				WakeConditionVariable( m_whenUpgraderCanUpgrade );
+			}
+			else if ( m_waitingWriterCount > 0 )
+			{
+				WakeConditionVariable( m_whenWriterCanLock );
+			}
+		}
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+// Upgradable
+//-----------
+
+void eae6320::Concurrency::cRWMutex::LockUpgradable()
+{
+	Futex::Lock( m_stateLock );
+	{
+		while ( m_isWriterActive || ( m_waitingWriterCount > 0 ) || m_isUpgradableLockHeld )
+		{
+			SleepConditionVariable( m_whenReadersCanLock, m_stateLock );
+		}
+		m_isUpgradableLockHeld = true;
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+void eae6320::Concurrency::cRWMutex::UpgradeToExclusive()
+{
+	Futex::Lock( m_stateLock );
+	{
+		// Waiting to upgrade stops any new shared locks from being acquired
+		m_isUpgraderWaiting = true;
+		while ( m_readerCount > 0 )
+		{
+			SleepConditionVariable( m_whenUpgraderCanUpgrade, m_stateLock );
+		}
+		m_isUpgraderWaiting = false;
+		m_isUpgradableLockHeld = false;
+		m_isWriterActive = true;
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+void eae6320::Concurrency::cRWMutex::UnlockUpgradable()
+{
+	Futex::Lock( m_stateLock );
+	{
+		m_isUpgradableLockHeld = false;
+		if ( m_waitingWriterCount > 0 )
+		{
+			// If there are still readers then the last one to unlock will wake the writer
+			if ( m_readerCount == 0 )
+			{
+				WakeConditionVariable( m_whenWriterCanLock );
+			}
+		}
+		else
+		{
+			// Other threads waiting for the upgradable lock wait with the readers
+			WakeAllConditionVariable( m_whenReadersCanLock );
+		}
+	}
+	Futex::Unlock( m_stateLock );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cRWMutex::cRWMutex()
+{
+	// Futexes don't need to be initialized beyond setting their words to zero
+}
+
+eae6320::Concurrency::cRWMutex::~cRWMutex()
+{
+
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void SleepConditionVariable( std::atomic<uint32_t>& io_conditionVariable, std::atomic<uint32_t>& io_stateLock )
+	{
+		// The count is read while the state lock is still held,
+		// and so if another thread wakes the condition variable after the state lock is released
+		// the count will have changed and the futex won't go to sleep
+		// (spurious wake-ups are fine because every caller checks its condition again in a loop)
+		const auto wakeCount = io_conditionVariable.load( std::memory_order_relaxed );
+		eae6320::Concurrency::Futex::Unlock( io_stateLock );
+		eae6320::Concurrency::Futex::Wait( io_conditionVariable, wakeCount, nullptr );
+		eae6320::Concurrency::Futex::Lock( io_stateLock );
+	}
+
+	void WakeConditionVariable( std::atomic<uint32_t>& io_conditionVariable )
+	{
+		io_conditionVariable.fetch_add( 1, std::memory_order_relaxed );
+		eae6320::Concurrency::Futex::Wake( io_conditionVariable, 1 );
+	}
+
+	void WakeAllConditionVariable( std::atomic<uint32_t>& io_conditionVariable )
+	{
+		io_conditionVariable.fetch_add( 1, std::memory_order_relaxed );
+		eae6320::Concurrency::Futex::WakeAll( io_conditionVariable );
+	}
+}
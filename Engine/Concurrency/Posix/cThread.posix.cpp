@@ -0,0 +1,401 @@
+// Include Files
+//==============
+
+#include "../cThread.h"
+
+#include "../cEvent.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/UserOutput/UserOutput.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// POSIX threads can't be created suspended,
+	// and so a new thread applies its own options before it runs any user code.
+	// Problems applying the options are reported but aren't fatal
+	// (the thread can still run, just not exactly the way that was requested)
+	void ApplyOptionsToThisThread( const eae6320::Concurrency::sThreadOptions& i_options );
+	// This returns the mask of every logical processor of every physical core
+	// (only the first 64 logical processors are used)
+	const std::vector<uint64_t>& GetPhysicalCoreAffinityMasks();
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_threadFunction, void* const io_userData, const sThreadOptions& i_options )
+{
+	auto result = Results::Success;
+
+	if ( !m_isRunning )
+	{
+		// POSIX requires a different function signature for its thread functions,
+		// and so the user-provided data is passed to a generic POSIX-appropriate function
+		struct sThreadData
+		{
+			fThreadFunction const threadFunction;
+			void* const userData;
+			const sThreadOptions& options;
+			cEvent whenThreadDataHasBeenExtracted;
+		} threadData = { i_threadFunction, io_userData, i_options, {} };
+		result = threadData.whenThreadDataHasBeenExtracted.Initialize( EventType::RemainSignaledUntilReset );
+		if ( result )
+		{
+			// Start the new thread
+			{
+				pthread_attr_t attributes;
+				auto errorCode = pthread_attr_init( &attributes );
+				if ( errorCode != 0 )
+				{
+					EAE6320_ASSERTF( false, "Couldn't initialize a thread's attributes: %s", std::strerror( errorCode ) );
+					Logging::OutputError( "POSIX failed to initialize the attributes of a new thread: %s", std::strerror( errorCode ) );
+					result = Results::Failure;
+					goto OnExit;
+				}
+				if ( i_options.stackSize_inBytes != 0 )
+				{
+					// A stack size that is too small fails, in which case the default size is used
+					errorCode = pthread_attr_setstacksize( &attributes, i_options.stackSize_inBytes );
+					if ( errorCode != 0 )
+					{
+						Logging::OutputError( "POSIX failed to set the stack size of the thread \"%s\" to %zu bytes"
+							" (it uses the default size instead): %s",
+							i_options.name ? i_options.name : "", i_options.stackSize_inBytes, std::strerror( errorCode ) );
+					}
+				}
+				errorCode = pthread_create( &m_thread, &attributes,
+					[]( void* io_threadData ) -> void*
+					{
+						// Extract the user-provided data
+						auto* threadData = static_cast<sThreadData*>( io_threadData );
+						auto const threadFunction = threadData->threadFunction;
+						auto* const userData = threadData->userData;
+						ApplyOptionsToThisThread( threadData->options );
+						// Signal that the data is extracted
+						// (which means that the sThreadData struct can go away)
+						const auto result = threadData->whenThreadDataHasBeenExtracted.Signal();
+						if ( result )
+						{
+							threadData = nullptr;
+
+							// Call the user-provided function with the user-provided data
+							threadFunction( userData );
+						}
+						else
+						{
+							// This is bad, but unlike on Windows a POSIX thread can't be forcibly terminated,
+							// and so the calling thread will wait for the event forever
+							EAE6320_ASSERTF( false, "Couldn't signal that a new thread's data was extracted" );
+							Logging::OutputError( "POSIX failed to signal that a new thread had extracted its thread data" );
+						}
+						// When the user-provided function returns the thread can exit
+						return nullptr;
+					},
+					&threadData );
+				{
+					// The thread has already been created (or not), and so this failing only leaks the attributes
+					const auto localErrorCode = pthread_attr_destroy( &attributes );
+					if ( localErrorCode != 0 )
+					{
+						EAE6320_ASSERTF( false, "Couldn't destroy a thread's attributes: %s", std::strerror( localErrorCode ) );
+						Logging::OutputError( "POSIX failed to destroy the attributes of a new thread: %s", std::strerror( localErrorCode ) );
+					}
+				}
+				if ( errorCode != 0 )
+				{
+					EAE6320_ASSERTF( false, "Couldn't start a thread: %s", std::strerror( errorCode ) );
+					Logging::OutputError( "POSIX failed to start a thread: %s", std::strerror( errorCode ) );
+					result = Results::Failure;
+					goto OnExit;
+				}
+				m_isRunning = true;
+			}
+			// The new thread needs to access the threadData variable that is local to this calling function,
+			// and so this calling function must wait to let threadData go out of scope
+			// until the new thread has extracted all of the information from it
+			if ( !( result = WaitForEvent( threadData.whenThreadDataHasBeenExtracted ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't wait for a new thread to extract thread data" );
+				Logging::OutputError( "Failed to wait for a new thread to extract thread data" );
+				UserOutput::Print( "Something unexpected went wrong when creating a new thread, "
+					" and the application is now in an unstable state and may crash or show unpredictable behavior." );
+				goto OnExit;
+			}
+		}
+		else
+		{
+			EAE6320_ASSERTF( false, "A thread can't be started with no thread data extraction event" );
+			Logging::OutputError( "A thread couldn't be started because its thread data extraction event couldn't be initialized" );
+			goto OnExit;
+		}
+	}
+	else
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "A thread can't be started if it is already running" );
+		eae6320::Logging::OutputError( "An attempt was made to start a thread that was already running" );
+		goto OnExit;
+	}
+
+OnExit:
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds )
+{
+	if ( io_thread.m_isRunning )
+	{
+		int errorCode;
+		if ( i_timeToWait_inMilliseconds == eae6320::Concurrency::Constants::DontTimeOut )
+		{
+			errorCode = pthread_join( io_thread.m_thread, nullptr );
+		}
+		else if ( i_timeToWait_inMilliseconds == 0 )
+		{
+			errorCode = pthread_tryjoin_np( io_thread.m_thread, nullptr );
+		}
+		else
+		{
+			// The time-out is an absolute time on the real-time clock
+			timespec deadline;
+			clock_gettime( CLOCK_REALTIME, &deadline );
+			deadline.tv_sec += static_cast<time_t>( i_timeToWait_inMilliseconds / 1000 );
+			deadline.tv_nsec += static_cast<long>( i_timeToWait_inMilliseconds % 1000 ) * 1000000L;
+			if ( deadline.tv_nsec >= 1000000000L )
+			{
+				++deadline.tv_sec;
+				deadline.tv_nsec -= 1000000000L;
+			}
+			errorCode = pthread_timedjoin_np( io_thread.m_thread, nullptr, &deadline );
+		}
+		switch ( errorCode )
+		{
+		// The thread exited
+		case 0:
+			// A joined thread can't be joined again,
+			// and so it is marked as not running so that this thread object could be reused if desired
+			io_thread.m_isRunning = false;
+			return eae6320::Results::Success;
+		// The time-out period elapsed before the thread exited
+		case EBUSY:
+		case ETIMEDOUT:
+			return eae6320::Results::TimeOut;
+		// An error prevented the wait
+		default:
+			EAE6320_ASSERTF( false, "Failed to wait for a thread to exit: %s", std::strerror( errorCode ) );
+			eae6320::Logging::OutputError( "POSIX failed waiting for a thread to exit: %s", std::strerror( errorCode ) );
+		}
+		return eae6320::Results::Failure;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "A thread can't be waited on to exit if it hasn't been started" );
+		// Even calling the function with a thread that isn't running is probably a user error,
+		// the thread isn't running and so success is returned
+		return eae6320::Results::Success;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::ApplyOptionsToCurrentThread( const sThreadOptions& i_options )
+{
+	ApplyOptionsToThisThread( i_options );
+	return Results::Success;
+}
+
+// Processor Topology
+//-------------------
+
+unsigned int eae6320::Concurrency::GetPhysicalCoreCount()
+{
+	return static_cast<unsigned int>( GetPhysicalCoreAffinityMasks().size() );
+}
+
+uint64_t eae6320::Concurrency::GetPhysicalCoreAffinityMask( const unsigned int i_coreIndex )
+{
+	const auto& affinityMasks = GetPhysicalCoreAffinityMasks();
+	EAE6320_ASSERTF( i_coreIndex < affinityMasks.size(), "There are only %u physical cores", static_cast<unsigned int>( affinityMasks.size() ) );
+	return ( i_coreIndex < affinityMasks.size() ) ? affinityMasks[i_coreIndex] : 0;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cThread::cThread()
+{
+
+}
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::cThread::CleanUp()
+{
+	cResult result = eae6320::Results::Success;
+
+	if ( m_isRunning )
+	{
+		// A thread that is never joined must be detached so that its resources are freed when it exits
+		const auto errorCode = pthread_detach( m_thread );
+		if ( errorCode != 0 )
+		{
+			{
+				EAE6320_ASSERTF( false, "Couldn't detach a thread: %s", std::strerror( errorCode ) );
+				Logging::OutputError( "POSIX failed to detach a thread: %s", std::strerror( errorCode ) );
+			}
+			if ( result )
+			{
+				result = eae6320::Results::Failure;
+			}
+		}
+		m_isRunning = false;
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void ApplyOptionsToThisThread( const eae6320::Concurrency::sThreadOptions& i_options )
+	{
+		// Name
+		if ( i_options.name )
+		{
+			// Linux only allows 15 characters (plus the terminating NULL),
+			// and so longer names are truncated rather than rejected
+			char name[16];
+			std::snprintf( name, sizeof( name ), "%s", i_options.name );
+			const auto errorCode = pthread_setname_np( pthread_self(), name );
+			if ( errorCode != 0 )
+			{
+				eae6320::Logging::OutputError( "POSIX failed to name the thread \"%s\": %s", i_options.name, std::strerror( errorCode ) );
+			}
+		}
+		// Priority
+		{
+			// On Linux each thread has its own nice value,
+			// and so the priority is relative to the nice value of the process
+			int niceValueOffset = 0;
+			switch ( i_options.priority )
+			{
+			case eae6320::Concurrency::eThreadPriority::Lowest: niceValueOffset = 10; break;
+			case eae6320::Concurrency::eThreadPriority::BelowNormal: niceValueOffset = 5; break;
+			case eae6320::Concurrency::eThreadPriority::Normal: niceValueOffset = 0; break;
+			case eae6320::Concurrency::eThreadPriority::AboveNormal: niceValueOffset = -5; break;
+			case eae6320::Concurrency::eThreadPriority::Highest: niceValueOffset = -10; break;
+			default:
+				EAE6320_ASSERTF( false, "Invalid thread priority" );
+			}
+			const auto threadId = static_cast<id_t>( syscall( SYS_gettid ) );
+			errno = 0;
+			const auto processNiceValue = getpriority( PRIO_PROCESS, static_cast<id_t>( getpid() ) );
+			// A negative nice value can be valid, and so errno is the only way to know whether this failed
+			const auto niceValue = ( errno == 0 ) ? ( processNiceValue + niceValueOffset ) : niceValueOffset;
+			// A priority that is higher than the process's usually requires special permissions,
+			// in which case the thread keeps its current priority
+			if ( ( niceValue != getpriority( PRIO_PROCESS, threadId ) ) && ( setpriority( PRIO_PROCESS, threadId, niceValue ) != 0 ) )
+			{
+				const auto errorCode = errno;
+				eae6320::Logging::OutputError( "POSIX failed to set the priority of the thread \"%s\" to a nice value of %i: %s",
+					i_options.name ? i_options.name : "", niceValue, std::strerror( errorCode ) );
+			}
+		}
+		// Affinity
+		if ( i_options.affinityMask != 0 )
+		{
+			cpu_set_t processors;
+			CPU_ZERO( &processors );
+			for ( unsigned int i = 0; i < 64; ++i )
+			{
+				if ( ( i_options.affinityMask & ( uint64_t( 1 ) << i ) ) != 0 )
+				{
+					CPU_SET( i, &processors );
+				}
+			}
+			// A mask that doesn't include any of the processors that the process can use fails
+			// (e.g. if the user settings were written for a computer with more cores)
+			const auto errorCode = pthread_setaffinity_np( pthread_self(), sizeof( processors ), &processors );
+			if ( errorCode != 0 )
+			{
+				eae6320::Logging::OutputError( "POSIX failed to set the affinity mask of the thread \"%s\" to 0x%llx"
+					" (it can run on any processor instead): %s",
+					i_options.name ? i_options.name : "", static_cast<unsigned long long>( i_options.affinityMask ), std::strerror( errorCode ) );
+			}
+		}
+	}
+
+	const std::vector<uint64_t>& GetPhysicalCoreAffinityMasks()
+	{
+		// The topology doesn't change while the application is running
+		static const auto s_affinityMasks = []()
+		{
+			std::vector<uint64_t> affinityMasks;
+			// Logical processors that have the same package and core IDs share a physical core
+			std::vector<std::pair<int, int>> coreIds;
+			const auto processorCount = sysconf( _SC_NPROCESSORS_CONF );
+			for ( long processorIndex = 0; ( processorIndex < processorCount ) && ( processorIndex < 64 ); ++processorIndex )
+			{
+				const auto ReadTopologyId = [processorIndex]( const char* const i_fileName, int& o_id )
+				{
+					char path[128];
+					std::snprintf( path, sizeof( path ), "/sys/devices/system/cpu/cpu%li/topology/%s", processorIndex, i_fileName );
+					auto* const file = std::fopen( path, "r" );
+					if ( !file )
+					{
+						return false;
+					}
+					const auto wasRead = std::fscanf( file, "%i", &o_id ) == 1;
+					std::fclose( file );
+					return wasRead;
+				};
+				std::pair<int, int> coreId;
+				if ( !ReadTopologyId( "physical_package_id", coreId.first ) || !ReadTopologyId( "core_id", coreId.second ) )
+				{
+					// Processors that are offline don't have topology information
+					continue;
+				}
+				const auto processorMask = uint64_t( 1 ) << processorIndex;
+				size_t coreIndex = 0;
+				while ( ( coreIndex < coreIds.size() ) && ( coreIds[coreIndex] != coreId ) )
+				{
+					++coreIndex;
+				}
+				if ( coreIndex < coreIds.size() )
+				{
+					affinityMasks[coreIndex] |= processorMask;
+				}
+				else
+				{
+					coreIds.push_back( coreId );
+					affinityMasks.push_back( processorMask );
+				}
+			}
+			if ( affinityMasks.empty() )
+			{
+				eae6320::Logging::OutputError( "Failed to get the processor topology" );
+			}
+			return affinityMasks;
+		}();
+		return s_affinityMasks;
+	}
+}
@@ -0,0 +1,260 @@
+// Include Files
+//==============
+
+#include "QueueThroughputBenchmark.h"
+
+#include "cEvent.h"
+#include "cMpscQueue.h"
+#include "cMutex.h"
+#include "cSpscQueue.h"
+#include "cThread.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	constexpr size_t s_queueCapacity = 1024;
+
+	// This is the baseline that the lock-free queues are compared to:
+	// It has the same interface as them, but every call locks a mutex
+	class cMutexDequeQueue
+	{
+		// Interface
+		//==========
+
+	public:
+
+		bool Push( const uint64_t i_item )
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+			if ( m_items.size() >= s_queueCapacity )
+			{
+				return false;
+			}
+			m_items.push_back( i_item );
+			return true;
+		}
+		bool Pop( uint64_t& o_item )
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+			if ( m_items.empty() )
+			{
+				return false;
+			}
+			o_item = m_items.front();
+			m_items.pop_front();
+			return true;
+		}
+
+		// Data
+		//=====
+
+	private:
+
+		eae6320::Concurrency::cMutex m_mutex;
+		std::deque<uint64_t> m_items;
+	};
+
+	using cSpscQueue_benchmark = eae6320::Concurrency::cSpscQueue<uint64_t, s_queueCapacity>;
+	using cMpscQueue_benchmark = eae6320::Concurrency::cMpscQueue<uint64_t, s_queueCapacity>;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Every item is a producer index in the high bits and that producer's item index in the low bits
+	constexpr unsigned int s_producerIndexShift = 40;
+
+	template <class tQueue>
+		eae6320::cResult MeasureThroughput( const unsigned int i_producerThreadCount, const unsigned int i_itemCountPerProducer,
+			double& o_itemsPerSecond );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::QueueThroughputBenchmark::Measure( sResults& o_results,
+	const unsigned int i_itemCountPerProducer, const unsigned int i_producerThreadCount_mpsc )
+{
+	auto result = Results::Success;
+
+	if ( !( result = MeasureThroughput<cSpscQueue_benchmark>( 1, i_itemCountPerProducer, o_results.itemsPerSecond_spsc_lockFree ) ) )
+	{
+		return result;
+	}
+	if ( !( result = MeasureThroughput<cMutexDequeQueue>( 1, i_itemCountPerProducer, o_results.itemsPerSecond_spsc_mutex ) ) )
+	{
+		return result;
+	}
+	if ( !( result = MeasureThroughput<cMpscQueue_benchmark>( i_producerThreadCount_mpsc, i_itemCountPerProducer,
+		o_results.itemsPerSecond_mpsc_lockFree ) ) )
+	{
+		return result;
+	}
+	if ( !( result = MeasureThroughput<cMutexDequeQueue>( i_producerThreadCount_mpsc, i_itemCountPerProducer,
+		o_results.itemsPerSecond_mpsc_mutex ) ) )
+	{
+		return result;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::QueueThroughputBenchmark::LogReport( const unsigned int i_itemCountPerProducer,
+	const unsigned int i_producerThreadCount_mpsc )
+{
+	sResults results;
+	const auto result = Measure( results, i_itemCountPerProducer, i_producerThreadCount_mpsc );
+	if ( result )
+	{
+		Logging::OutputMessage( "Queue throughput (%u items per producer):"
+			" 1 producer: %.2f million items per second lock-free, %.2f million items per second with a mutex;"
+			" %u producers: %.2f million items per second lock-free, %.2f million items per second with a mutex",
+			i_itemCountPerProducer,
+			results.itemsPerSecond_spsc_lockFree * 1.0e-6, results.itemsPerSecond_spsc_mutex * 1.0e-6,
+			i_producerThreadCount_mpsc,
+			results.itemsPerSecond_mpsc_lockFree * 1.0e-6, results.itemsPerSecond_mpsc_mutex * 1.0e-6 );
+	}
+	else
+	{
+		Logging::OutputError( "The queue throughput couldn't be measured" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	template <class tQueue>
+		eae6320::cResult MeasureThroughput( const unsigned int i_producerThreadCount, const unsigned int i_itemCountPerProducer,
+			double& o_itemsPerSecond )
+	{
+		auto result = eae6320::Results::Success;
+
+		struct sSharedData
+		{
+			tQueue queue;
+			eae6320::Concurrency::cEvent whenToStart;
+			unsigned int itemCountPerProducer;
+		};
+		// The lock-free queues are too big to put on the stack
+		const auto sharedData = std::make_unique<sSharedData>();
+		sharedData->itemCountPerProducer = i_itemCountPerProducer;
+		struct sProducerData
+		{
+			sSharedData* sharedData;
+			uint64_t producerIndex;
+		};
+		std::vector<sProducerData> producerData( i_producerThreadCount );
+		std::vector<eae6320::Concurrency::cThread> producerThreads( i_producerThreadCount );
+		auto startedThreadCount = 0u;
+		// The consumer keeps track of the next item that it expects from each producer
+		std::vector<uint64_t> nextItemIndices( i_producerThreadCount, 0 );
+		uint64_t unexpectedItemCount = 0;
+
+		if ( !( result = sharedData->whenToStart.Initialize( eae6320::Concurrency::EventType::RemainSignaledUntilReset ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the queue throughput benchmark's start event" );
+			return result;
+		}
+		for ( ; startedThreadCount < i_producerThreadCount; ++startedThreadCount )
+		{
+			producerData[startedThreadCount] = { sharedData.get(), startedThreadCount };
+			eae6320::Concurrency::sThreadOptions threadOptions;
+			threadOptions.name = "Queue Throughput";
+			if ( !( result = producerThreads[startedThreadCount].Start(
+				[]( void* const io_producerData )
+				{
+					const auto& producerData = *static_cast<sProducerData*>( io_producerData );
+					auto& sharedData = *producerData.sharedData;
+					eae6320::Concurrency::WaitForEvent( sharedData.whenToStart );
+					const auto firstItem = producerData.producerIndex << s_producerIndexShift;
+					for ( uint64_t i = 0; i < sharedData.itemCountPerProducer; ++i )
+					{
+						// If the queue is full the producer waits for the consumer
+						while ( !sharedData.queue.Push( firstItem + i ) )
+						{
+							std::this_thread::yield();
+						}
+					}
+				},
+				&producerData[startedThreadCount], threadOptions ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start a queue throughput benchmark producer thread" );
+				break;
+			}
+		}
+		{
+			using clock = std::chrono::steady_clock;
+			const auto startTime = clock::now();
+			// Signaling only fails if the event isn't initialized (which was already checked),
+			// and so the producers always start
+			{
+				const auto localResult = sharedData->whenToStart.Signal();
+				EAE6320_ASSERTF( localResult, "Couldn't start the queue throughput benchmark" );
+			}
+			// This thread is the consumer
+			const auto itemCount = static_cast<uint64_t>( startedThreadCount ) * i_itemCountPerProducer;
+			for ( uint64_t i = 0; i < itemCount; )
+			{
+				uint64_t item;
+				if ( sharedData->queue.Pop( item ) )
+				{
+					const auto producerIndex = item >> s_producerIndexShift;
+					const auto itemIndex = item & ( ( uint64_t( 1 ) << s_producerIndexShift ) - 1 );
+					if ( ( producerIndex < startedThreadCount ) && ( itemIndex == nextItemIndices[producerIndex] ) )
+					{
+						++nextItemIndices[producerIndex];
+					}
+					else
+					{
+						++unexpectedItemCount;
+					}
+					++i;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+			const std::chrono::duration<double> elapsedTime = clock::now() - startTime;
+			o_itemsPerSecond = static_cast<double>( itemCount ) / elapsedTime.count();
+		}
+		// The consumer removed every item, and so every producer has finished
+		for ( unsigned int i = 0; i < startedThreadCount; ++i )
+		{
+			const auto localResult = eae6320::Concurrency::WaitForThreadToStop( producerThreads[i] );
+			EAE6320_ASSERT( localResult );
+			if ( result && !localResult )
+			{
+				result = localResult;
+			}
+		}
+		if ( unexpectedItemCount > 0 )
+		{
+			EAE6320_ASSERTF( false, "A queue delivered an item that was missing, duplicated, or out of order" );
+			eae6320::Logging::OutputError( "A queue delivered %llu items that were missing, duplicated, or out of order",
+				static_cast<unsigned long long>( unexpectedItemCount ) );
+			if ( result )
+			{
+				result = eae6320::Results::Failure;
+			}
+		}
+
+		return result;
+	}
+}
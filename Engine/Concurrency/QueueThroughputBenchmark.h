@@ -0,0 +1,49 @@
+/*
+	The queue throughput benchmark measures how many items per second can be passed between threads
+	using the lock-free queues compared to a std::deque that is protected by a mutex
+
+	Two cases are measured:
+		* One producer thread and one consumer thread (cSpscQueue)
+		* Several producer threads and one consumer thread (cMpscQueue)
+	The mutex-protected deque has the same capacity as the lock-free queues
+	so that producers have to wait for the consumer in the same way.
+	The consumer checks that every producer's items arrive once and in order.
+*/
+
+#ifndef EAE6320_CONCURRENCY_QUEUETHROUGHPUTBENCHMARK_H
+#define EAE6320_CONCURRENCY_QUEUETHROUGHPUTBENCHMARK_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace QueueThroughputBenchmark
+		{
+			struct sResults
+			{
+				// The number of items that the consumer removed per second
+				double itemsPerSecond_spsc_lockFree = 0.0;
+				double itemsPerSecond_spsc_mutex = 0.0;
+				double itemsPerSecond_mpsc_lockFree = 0.0;
+				double itemsPerSecond_mpsc_mutex = 0.0;
+			};
+
+			// This fails if the consumer ever receives an item that is missing, duplicated, or out of order
+			cResult Measure( sResults& o_results,
+				const unsigned int i_itemCountPerProducer = 200000, const unsigned int i_producerThreadCount_mpsc = 4 );
+
+			// This measures and outputs the results to the log
+			cResult LogReport( const unsigned int i_itemCountPerProducer = 200000, const unsigned int i_producerThreadCount_mpsc = 4 );
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_QUEUETHROUGHPUTBENCHMARK_H
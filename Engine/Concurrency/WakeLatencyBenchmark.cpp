@@ -0,0 +1,158 @@
+// Include Files
+//==============
+
+#include "WakeLatencyBenchmark.h"
+
+#include "cEvent.h"
+#include "cThread.h"
+
+#include <chrono>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This returns the average time of one hand-off
+	// (a hand-off is one thread signaling an event and the other thread returning from waiting for it)
+	eae6320::cResult MeasureHandOffs( const unsigned int i_handOffCount, double& o_averageWakeLatency_inSeconds );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::WakeLatencyBenchmark::Measure( sResults& o_results, const unsigned int i_handOffCount )
+{
+	auto result = Results::Success;
+
+	const auto wasSpinningEnabled = cEvent::IsSpinningEnabled();
+	{
+		cEvent::SetIsSpinningEnabled( false );
+		if ( !( result = MeasureHandOffs( i_handOffCount, o_results.averageWakeLatency_kernelOnly_inSeconds ) ) )
+		{
+			goto OnExit;
+		}
+	}
+	{
+		cEvent::SetIsSpinningEnabled( true );
+		if ( !( result = MeasureHandOffs( i_handOffCount, o_results.averageWakeLatency_adaptive_inSeconds ) ) )
+		{
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	cEvent::SetIsSpinningEnabled( wasSpinningEnabled );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::WakeLatencyBenchmark::LogReport( const unsigned int i_handOffCount )
+{
+	const auto isSpinningEnabled = cEvent::IsSpinningEnabled();
+	sResults results;
+	const auto result = Measure( results, i_handOffCount );
+	if ( result )
+	{
+		Logging::OutputMessage( "Event wake latency (%u hand-offs): %.2f microseconds kernel-only, %.2f microseconds adaptive spinning%s",
+			i_handOffCount,
+			results.averageWakeLatency_kernelOnly_inSeconds * 1.0e6, results.averageWakeLatency_adaptive_inSeconds * 1.0e6,
+			isSpinningEnabled ? "" : " (spinning is disabled in the engine)" );
+	}
+	else
+	{
+		Logging::OutputError( "The event wake latency couldn't be measured" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult MeasureHandOffs( const unsigned int i_handOffCount, double& o_averageWakeLatency_inSeconds )
+	{
+		auto result = eae6320::Results::Success;
+
+		// The main thread signals the "ping" event and the other thread answers by signaling the "pong" event
+		struct sHandOffData
+		{
+			eae6320::Concurrency::cEvent ping;
+			eae6320::Concurrency::cEvent pong;
+			unsigned int handOffCount;
+		} handOffData;
+		eae6320::Concurrency::cThread thread;
+		// A few hand-offs happen before timing starts so that the spin limits have adapted
+		constexpr unsigned int warmUpHandOffCount = 100;
+		const auto roundTripCount = warmUpHandOffCount + ( ( i_handOffCount + 1 ) / 2 );
+		handOffData.handOffCount = roundTripCount;
+		if ( !( result = handOffData.ping.Initialize( eae6320::Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the wake latency benchmark's ping event" );
+			return result;
+		}
+		if ( !( result = handOffData.pong.Initialize( eae6320::Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't initialize the wake latency benchmark's pong event" );
+			return result;
+		}
+		{
+			eae6320::Concurrency::sThreadOptions threadOptions;
+			threadOptions.name = "Wake Latency";
+			if ( !( result = thread.Start(
+				[]( void* const io_handOffData )
+				{
+					auto& handOffData = *static_cast<sHandOffData*>( io_handOffData );
+					for ( unsigned int i = 0; i < handOffData.handOffCount; ++i )
+					{
+						if ( !eae6320::Concurrency::WaitForEvent( handOffData.ping ) || !handOffData.pong.Signal() )
+						{
+							EAE6320_ASSERTF( false, "The wake latency benchmark's thread couldn't hand off an event" );
+							return;
+						}
+					}
+				},
+				&handOffData, threadOptions ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start the wake latency benchmark's thread" );
+				return result;
+			}
+		}
+		{
+			using clock = std::chrono::steady_clock;
+			auto startTime = clock::now();
+			for ( unsigned int i = 0; i < roundTripCount; ++i )
+			{
+				if ( i == warmUpHandOffCount )
+				{
+					startTime = clock::now();
+				}
+				if ( !( result = handOffData.ping.Signal() ) || !( result = eae6320::Concurrency::WaitForEvent( handOffData.pong ) ) )
+				{
+					EAE6320_ASSERTF( false, "The wake latency benchmark couldn't hand off an event" );
+					break;
+				}
+			}
+			const std::chrono::duration<double> elapsedTime = clock::now() - startTime;
+			// Each round trip is two hand-offs
+			const auto timedHandOffCount = 2 * ( roundTripCount - warmUpHandOffCount );
+			o_averageWakeLatency_inSeconds = elapsedTime.count() / static_cast<double>( timedHandOffCount );
+		}
+		// Handing off an event only fails if the event isn't initialized (which was already checked),
+		// and so the other thread always finishes
+		{
+			const auto localResult = eae6320::Concurrency::WaitForThreadToStop( thread );
+			EAE6320_ASSERT( localResult );
+			if ( result && !localResult )
+			{
+				result = localResult;
+			}
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,47 @@
+/*
+	The wake latency benchmark measures how long it takes a thread that is waiting for an event
+	to start running again after a different thread signals the event
+
+	Two threads hand an event back and forth (like the application and render threads do every frame),
+	once with every wait going straight to the kernel
+	and once with waits spinning adaptively before they go to sleep (see cEvent.h).
+	Comparing the two shows how much spinning saves on the current computer.
+*/
+
+#ifndef EAE6320_CONCURRENCY_WAKELATENCYBENCHMARK_H
+#define EAE6320_CONCURRENCY_WAKELATENCYBENCHMARK_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace WakeLatencyBenchmark
+		{
+			struct sResults
+			{
+				// The average time from an event being signaled until the waiting thread returns
+				double averageWakeLatency_kernelOnly_inSeconds = 0.0;
+				double averageWakeLatency_adaptive_inSeconds = 0.0;
+			};
+
+			// Whether events spin is a global setting,
+			// and so this should only be called when no other threads are waiting for events
+			// (e.g. while the application is starting).
+			// The setting is restored when the benchmark is done.
+			cResult Measure( sResults& o_results, const unsigned int i_handOffCount = 10000 );
+
+			// This measures and outputs the results to the log
+			cResult LogReport( const unsigned int i_handOffCount = 10000 );
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_WAKELATENCYBENCHMARK_H
@@ -0,0 +1,34 @@
+// Include Files
+//==============
+
+#include "../MutexProfiling.h"
+
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+
+#include <Engine/Windows/Includes.h>
+
+// Implementation
+//===============
+
+// The engine's Time system isn't used because it depends on being initialized
+// and mutexes with static storage duration can be locked before that happens
+
+uint64_t eae6320::Concurrency::MutexProfiling::GetCurrentTickCount()
+{
+	LARGE_INTEGER tickCount;
+	QueryPerformanceCounter( &tickCount );
+	return static_cast<uint64_t>( tickCount.QuadPart );
+}
+
+double eae6320::Concurrency::MutexProfiling::ConvertTicksToSeconds( const uint64_t i_tickCount )
+{
+	static const auto s_secondsPerTick = []()
+	{
+		LARGE_INTEGER ticksPerSecond;
+		QueryPerformanceFrequency( &ticksPerSecond );
+		return 1.0 / static_cast<double>( ticksPerSecond.QuadPart );
+	}();
+	return static_cast<double>( i_tickCount ) * s_secondsPerTick;
+}
+
+#endif	// EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED
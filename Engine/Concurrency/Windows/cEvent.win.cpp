@@ -14,6 +14,10 @@ eae6320::cResult eae6320::Concurrency::WaitForEvent( const eae6320::Concurrency:
 {
 	if ( i_event.m_handle )
 	{
+		if ( ( i_timeToWait_inMilliseconds != 0 ) && eae6320::Concurrency::cEvent::IsSpinningEnabled() && i_event.SpinUntilSignaled() )
+		{
+			return eae6320::Results::Success;
+		}
 		const auto result = WaitForSingleObject( i_event.m_handle,
 			( i_timeToWait_inMilliseconds == eae6320::Concurrency::Constants::DontTimeOut ) ? INFINITE : static_cast<DWORD>( i_timeToWait_inMilliseconds ) );
 		switch ( result )
@@ -50,6 +54,10 @@ eae6320::cResult eae6320::Concurrency::WaitForEvent( const eae6320::Concurrency:
 eae6320::cResult eae6320::Concurrency::cEvent::Signal()
 {
 	EAE6320_ASSERTF( m_handle, "An event can't be signaled until it has been initialized" );
+	// This must happen before the event is set
+	// because a waiting thread is allowed to destroy the event as soon as it has been set
+	// (a spinning thread that notices the change before the event is set keeps checking until it is)
+	m_signalCount.fetch_add( 1, std::memory_order_release );
 	if ( SetEvent( m_handle ) != FALSE )
 	{
 		return Results::Success;
@@ -121,3 +129,45 @@ eae6320::cResult eae6320::Concurrency::cEvent::CleanUp()
 
 	return result;
 }
+
+// Implementation
+//===============
+
+bool eae6320::Concurrency::cEvent::SpinUntilSignaled() const
+{
+	const auto spinLimit = m_spinLimit.load( std::memory_order_relaxed );
+	auto signalCount = m_signalCount.load( std::memory_order_acquire );
+	// Checking the event itself requires a call into the kernel
+	// (which is still much cheaper than sleeping there),
+	// and so after the initial check it is only checked again when it has been signaled
+	if ( WaitForEvent( *this, 0 ) )
+	{
+		return true;
+	}
+	uint32_t eventCheckCount = 0;
+	for ( uint32_t spinCount = 0; spinCount < spinLimit; ++spinCount )
+	{
+		YieldProcessor();
+		const auto newSignalCount = m_signalCount.load( std::memory_order_acquire );
+		if ( newSignalCount != signalCount )
+		{
+			// The signal count changes just before the event is actually set,
+			// and so the event is checked more than once after each change
+			if ( WaitForEvent( *this, 0 ) )
+			{
+				UpdateSpinLimit( spinLimit, spinCount, true );
+				return true;
+			}
+			// If the event resets automatically a different waiting thread might have gotten the signal,
+			// in which case this thread goes back to only checking the signal count
+			// (and keeps spinning until the event is signaled again)
+			if ( ++eventCheckCount >= s_maxEventChecksPerSignal )
+			{
+				signalCount = newSignalCount;
+				eventCheckCount = 0;
+			}
+		}
+	}
+	UpdateSpinLimit( spinLimit, spinLimit, false );
+	return false;
+}
@@ -8,16 +8,58 @@
 
 void eae6320::Concurrency::cMutex::Lock()
 {
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		// Trying to acquire the lock first shows whether it is contended
+		// without having to measure how long uncontended acquisitions take
+		const auto wasContended = TryAcquireSRWLockExclusive( &m_srwLock ) == FALSE;
+		uint64_t waitTime_inTicks = 0;
+		if ( wasContended )
+		{
+			const auto waitStartTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			AcquireSRWLockExclusive( &m_srwLock );
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			waitTime_inTicks = m_lockTime_inTicks - waitStartTime_inTicks;
+		}
+		else
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+		}
+		MutexProfiling::RecordAcquisition( *m_profilingRecord, waitTime_inTicks, wasContended );
+		return;
+	}
+#endif
 	AcquireSRWLockExclusive( &m_srwLock );
 }
 
 eae6320::cResult eae6320::Concurrency::cMutex::LockIfPossible()
 {
-	return ( TryAcquireSRWLockExclusive( &m_srwLock ) != FALSE ) ? Results::Success : Results::Failure;
+	if ( TryAcquireSRWLockExclusive( &m_srwLock ) != FALSE )
+	{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord )
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			MutexProfiling::RecordAcquisition( *m_profilingRecord, 0, false );
+		}
+#endif
+		return Results::Success;
+	}
+	else
+	{
+		return Results::Failure;
+	}
 }
 
 void eae6320::Concurrency::cMutex::Unlock()
 {
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		MutexProfiling::RecordRelease( *m_profilingRecord, MutexProfiling::GetCurrentTickCount() - m_lockTime_inTicks );
+	}
+#endif
 	ReleaseSRWLockExclusive( &m_srwLock );
 }
 
@@ -33,6 +75,15 @@ eae6320::Concurrency::cMutex::cMutex()
 	// InitializeSRWLock( &m_srwLock );
 }
 
+eae6320::Concurrency::cMutex::cMutex( const char* const i_name )
+	:
+	cMutex()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	m_profilingRecord = MutexProfiling::GetLockRecord( i_name );
+#endif
+}
+
 eae6320::Concurrency::cMutex::~cMutex()
 {
 
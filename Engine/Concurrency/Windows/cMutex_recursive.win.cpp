@@ -8,16 +8,65 @@
 
 void eae6320::Concurrency::cMutex_recursive::Lock()
 {
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord )
+	{
+		// Trying to enter the critical section first shows whether it is contended
+		// without having to measure how long uncontended acquisitions take
+		// (a thread that already holds the lock always succeeds)
+		const auto wasContended = TryEnterCriticalSection( &m_criticalSection ) == FALSE;
+		uint64_t waitTime_inTicks = 0;
+		uint64_t lockTime_inTicks;
+		if ( wasContended )
+		{
+			const auto waitStartTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			EnterCriticalSection( &m_criticalSection );
+			lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			waitTime_inTicks = lockTime_inTicks - waitStartTime_inTicks;
+		}
+		else
+		{
+			lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+		}
+		// Only the outermost lock is recorded
+		if ( ++m_lockDepth == 1 )
+		{
+			m_lockTime_inTicks = lockTime_inTicks;
+			MutexProfiling::RecordAcquisition( *m_profilingRecord, waitTime_inTicks, wasContended );
+		}
+		return;
+	}
+#endif
 	EnterCriticalSection( &m_criticalSection );
 }
 
 eae6320::cResult eae6320::Concurrency::cMutex_recursive::LockIfPossible()
 {
-	return ( TryEnterCriticalSection( &m_criticalSection ) != FALSE ) ? Results::Success : Results::Failure;
+	if ( TryEnterCriticalSection( &m_criticalSection ) != FALSE )
+	{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+		if ( m_profilingRecord && ( ++m_lockDepth == 1 ) )
+		{
+			m_lockTime_inTicks = MutexProfiling::GetCurrentTickCount();
+			MutexProfiling::RecordAcquisition( *m_profilingRecord, 0, false );
+		}
+#endif
+		return Results::Success;
+	}
+	else
+	{
+		return Results::Failure;
+	}
 }
 
 void eae6320::Concurrency::cMutex_recursive::Unlock()
 {
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	if ( m_profilingRecord && ( --m_lockDepth == 0 ) )
+	{
+		MutexProfiling::RecordRelease( *m_profilingRecord, MutexProfiling::GetCurrentTickCount() - m_lockTime_inTicks );
+	}
+#endif
 	LeaveCriticalSection( &m_criticalSection );
 }
 
@@ -26,7 +75,19 @@ void eae6320::Concurrency::cMutex_recursive::Unlock()
 
 eae6320::Concurrency::cMutex_recursive::cMutex_recursive()
 {
-	InitializeCriticalSection( &m_criticalSection );
+	// A thread that finds the critical section locked spins for a short time before sleeping in the kernel
+	// (the critical sections that the engine uses are only held for short periods)
+	constexpr DWORD spinCount = 4000;
+	InitializeCriticalSectionAndSpinCount( &m_criticalSection, spinCount );
+}
+
+eae6320::Concurrency::cMutex_recursive::cMutex_recursive( const char* const i_name )
+	:
+	cMutex_recursive()
+{
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	m_profilingRecord = MutexProfiling::GetLockRecord( i_name );
+#endif
 }
 
 eae6320::Concurrency::cMutex_recursive::~cMutex_recursive()
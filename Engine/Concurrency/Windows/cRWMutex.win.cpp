@@ -0,0 +1,182 @@
+// Include Files
+//==============
+
+#include "../cRWMutex.h"
+
+// Interface
+//==========
+
+// Exclusive
+//----------
+
+void eae6320::Concurrency::cRWMutex::Lock()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		// Waiting writers stop any new shared or upgradable locks from being acquired
+		++m_waitingWriterCount;
+		while ( m_isWriterActive || ( m_readerCount > 0 ) || m_isUpgradableLockHeld )
+		{
+			SleepConditionVariableSRW( &m_whenWriterCanLock, &m_stateLock, INFINITE, 0 );
+		}
+		--m_waitingWriterCount;
+		m_isWriterActive = true;
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+eae6320::cResult eae6320::Concurrency::cRWMutex::LockIfPossible()
+{
+	auto result = Results::Failure;
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		if ( !m_isWriterActive && ( m_readerCount == 0 ) && !m_isUpgradableLockHeld )
+		{
+			m_isWriterActive = true;
+			result = Results::Success;
+		}
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+	return result;
+}
+
+void eae6320::Concurrency::cRWMutex::Unlock()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		m_isWriterActive = false;
+		// Another writer gets the lock before any readers
+		if ( m_waitingWriterCount > 0 )
+		{
+			WakeConditionVariable( &m_whenWriterCanLock );
+		}
+		else
+		{
+			WakeAllConditionVariable( &m_whenReadersCanLock );
+		}
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+// Shared
+//-------
+
+void eae6320::Concurrency::cRWMutex::LockShared()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		while ( m_isWriterActive || ( m_waitingWriterCount > 0 ) || m_isUpgraderWaiting )
+		{
+			SleepConditionVariableSRW( &m_whenReadersCanLock, &m_stateLock, INFINITE, 0 );
+		}
+		++m_readerCount;
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+eae6320::cResult eae6320::Concurrency::cRWMutex::LockSharedIfPossible()
+{
+	auto result = Results::Failure;
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		if ( !m_isWriterActive && ( m_waitingWriterCount == 0 ) && !m_isUpgraderWaiting )
+		{
+			++m_readerCount;
+			result = Results::Success;
+		}
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+	return result;
+}
+
+void eae6320::Concurrency::cRWMutex::UnlockShared()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		if ( --m_readerCount == 0 )
+		{
+			// A thread that is upgrading already holds the upgradable lock,
+			// and so it must be woken before any writer
+			if ( m_isUpgraderWaiting )
+			{
+				WakeConditionVariable( &m_whenUpgraderCanUpgrade );
+			}
+			else if ( m_waitingWriterCount > 0 )
+			{
+				WakeConditionVariable( &m_whenWriterCanLock );
+			}
+		}
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+// Upgradable
+//-----------
+
+void eae6320::Concurrency::cRWMutex::LockUpgradable()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		while ( m_isWriterActive || ( m_waitingWriterCount > 0 ) || m_isUpgradableLockHeld )
+		{
+			SleepConditionVariableSRW( &m_whenReadersCanLock, &m_stateLock, INFINITE, 0 );
+		}
+		m_isUpgradableLockHeld = true;
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+void eae6320::Concurrency::cRWMutex::UpgradeToExclusive()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		// Waiting to upgrade stops any new shared locks from being acquired
+		m_isUpgraderWaiting = true;
+		while ( m_readerCount > 0 )
+		{
+			SleepConditionVariableSRW( &m_whenUpgraderCanUpgrade, &m_stateLock, INFINITE, 0 );
+		}
+		m_isUpgraderWaiting = false;
+		m_isUpgradableLockHeld = false;
+		m_isWriterActive = true;
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+void eae6320::Concurrency::cRWMutex::UnlockUpgradable()
+{
+	AcquireSRWLockExclusive( &m_stateLock );
+	{
+		m_isUpgradableLockHeld = false;
+		if ( m_waitingWriterCount > 0 )
+		{
+			// If there are still readers then the last one to unlock will wake the writer
+			if ( m_readerCount == 0 )
+			{
+				WakeConditionVariable( &m_whenWriterCanLock );
+			}
+		}
+		else
+		{
+			// Other threads waiting for the upgradable lock wait with the readers
+			WakeAllConditionVariable( &m_whenReadersCanLock );
+		}
+	}
+	ReleaseSRWLockExclusive( &m_stateLock );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cRWMutex::cRWMutex()
+	:
+	m_stateLock( SRWLOCK_INIT ), m_whenReadersCanLock( CONDITION_VARIABLE_INIT ),
+	m_whenWriterCanLock( CONDITION_VARIABLE_INIT ), m_whenUpgraderCanUpgrade( CONDITION_VARIABLE_INIT )
+{
+
+}
+
+eae6320::Concurrency::cRWMutex::~cRWMutex()
+{
+
+}
@@ -11,11 +11,26 @@
 #include <Engine/UserOutput/UserOutput.h>
 #include <Engine/Windows/Functions.h>
 #include <process.h>
+#include <string>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Problems applying the options are reported but aren't fatal
+	// (the thread can still run, just not exactly the way that was requested)
+	void ApplyOptions( const HANDLE i_thread, const eae6320::Concurrency::sThreadOptions& i_options );
+	// This returns the mask of every logical processor of every physical core
+	// (only the first processor group is used, which is enough for up to 64 logical processors)
+	const std::vector<uint64_t>& GetPhysicalCoreAffinityMasks();
+}
 
 // Interface
 //==========
 
-eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_threadFunction, void* const io_userData )
+eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_threadFunction, void* const io_userData, const sThreadOptions& i_options )
 {
 	auto result = Results::Success;
 
@@ -34,8 +49,8 @@ eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_t
 			// Start the new thread
 			{
 				constexpr SECURITY_ATTRIBUTES* const useDefaultSecurityAttributes = nullptr;
-				constexpr unsigned int useDefaultStackSize = 0;
-				constexpr unsigned int startExecutingImmediately = 0;
+				// The thread is created suspended so that its options are applied before it runs any code
+				constexpr unsigned int waitUntilOptionsHaveBeenApplied = CREATE_SUSPENDED;
 				unsigned int threadId;
 				// Reset the global error variable before calling the next function
 				// so that if starting the thread fails
@@ -44,7 +59,7 @@ eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_t
 					const auto localResult = _set_doserrno( ERROR_SUCCESS );
 					EAE6320_ASSERT( localResult == 0 );
 				}
-				m_handle = reinterpret_cast<HANDLE>( _beginthreadex( useDefaultSecurityAttributes, useDefaultStackSize,
+				m_handle = reinterpret_cast<HANDLE>( _beginthreadex( useDefaultSecurityAttributes, static_cast<unsigned int>( i_options.stackSize_inBytes ),
 					[]( void* io_threadData ) -> unsigned int
 					{
 						// Extract the user-provided data
@@ -79,7 +94,7 @@ eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_t
 						// This code won't be reached because _endthreadex() exits the thread
 						return result;
 					},
-					&threadData, startExecutingImmediately, &threadId ) );
+					&threadData, waitUntilOptionsHaveBeenApplied, &threadId ) );
 				if ( !m_handle )
 				{
 					DWORD errorCode;
@@ -97,6 +112,18 @@ eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_t
 					result = Results::Failure;
 					goto OnExit;
 				}
+				ApplyOptions( m_handle, i_options );
+				if ( ResumeThread( m_handle ) == static_cast<DWORD>( -1 ) )
+				{
+					const auto errorMessage = Windows::GetLastSystemError();
+					EAE6320_ASSERTF( false, "Couldn't resume a new thread: %s", errorMessage.c_str() );
+					Logging::OutputError( "Windows failed to resume a new thread: %s", errorMessage.c_str() );
+					// The thread hasn't run any code and so it can safely be terminated
+					TerminateThread( m_handle, EXIT_FAILURE );
+					CleanUp();
+					result = Results::Failure;
+					goto OnExit;
+				}
 			}
 			// The new thread needs to access the threadData variable that is local to this calling function,
 			// and so this calling function must wait to let threadData go out of scope
@@ -182,6 +209,27 @@ eae6320::cResult eae6320::Concurrency::WaitForThreadToStop( cThread& io_thread,
 	}
 }
 
+eae6320::cResult eae6320::Concurrency::ApplyOptionsToCurrentThread( const sThreadOptions& i_options )
+{
+	ApplyOptions( GetCurrentThread(), i_options );
+	return Results::Success;
+}
+
+// Processor Topology
+//-------------------
+
+unsigned int eae6320::Concurrency::GetPhysicalCoreCount()
+{
+	return static_cast<unsigned int>( GetPhysicalCoreAffinityMasks().size() );
+}
+
+uint64_t eae6320::Concurrency::GetPhysicalCoreAffinityMask( const unsigned int i_coreIndex )
+{
+	const auto& affinityMasks = GetPhysicalCoreAffinityMasks();
+	EAE6320_ASSERTF( i_coreIndex < affinityMasks.size(), "There are only %u physical cores", static_cast<unsigned int>( affinityMasks.size() ) );
+	return ( i_coreIndex < affinityMasks.size() ) ? affinityMasks[i_coreIndex] : 0;
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -219,3 +267,101 @@ eae6320::cResult eae6320::Concurrency::cThread::CleanUp()
 
 	return result;
 }
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void ApplyOptions( const HANDLE i_thread, const eae6320::Concurrency::sThreadOptions& i_options )
+	{
+		// Name
+		if ( i_options.name )
+		{
+			// SetThreadDescription() only exists in Windows 10 (version 1607) and later,
+			// and so it is looked up instead of being linked to
+			using fSetThreadDescription = HRESULT ( WINAPI* )( HANDLE, PCWSTR );
+			static const auto setThreadDescription = reinterpret_cast<fSetThreadDescription>(
+				GetProcAddress( GetModuleHandleW( L"Kernel32.dll" ), "SetThreadDescription" ) );
+			if ( setThreadDescription )
+			{
+				std::wstring name;
+				{
+					const auto characterCount = MultiByteToWideChar( CP_UTF8, 0, i_options.name, -1, nullptr, 0 );
+					if ( characterCount > 0 )
+					{
+						name.resize( static_cast<size_t>( characterCount ) );
+						MultiByteToWideChar( CP_UTF8, 0, i_options.name, -1, &name[0], characterCount );
+					}
+				}
+				if ( FAILED( setThreadDescription( i_thread, name.c_str() ) ) )
+				{
+					eae6320::Logging::OutputError( "Windows failed to name the thread \"%s\"", i_options.name );
+				}
+			}
+		}
+		// Priority
+		{
+			int priority = THREAD_PRIORITY_NORMAL;
+			switch ( i_options.priority )
+			{
+			case eae6320::Concurrency::eThreadPriority::Lowest: priority = THREAD_PRIORITY_LOWEST; break;
+			case eae6320::Concurrency::eThreadPriority::BelowNormal: priority = THREAD_PRIORITY_BELOW_NORMAL; break;
+			case eae6320::Concurrency::eThreadPriority::Normal: priority = THREAD_PRIORITY_NORMAL; break;
+			case eae6320::Concurrency::eThreadPriority::AboveNormal: priority = THREAD_PRIORITY_ABOVE_NORMAL; break;
+			case eae6320::Concurrency::eThreadPriority::Highest: priority = THREAD_PRIORITY_HIGHEST; break;
+			default:
+				EAE6320_ASSERTF( false, "Invalid thread priority" );
+			}
+			if ( SetThreadPriority( i_thread, priority ) == FALSE )
+			{
+				const auto errorMessage = eae6320::Windows::GetLastSystemError();
+				EAE6320_ASSERTF( false, "Couldn't set a thread's priority: %s", errorMessage.c_str() );
+				eae6320::Logging::OutputError( "Windows failed to set the priority of the thread \"%s\": %s",
+					i_options.name ? i_options.name : "", errorMessage.c_str() );
+			}
+		}
+		// Affinity
+		if ( i_options.affinityMask != 0 )
+		{
+			// A mask that doesn't include any of the processors that the process can use fails
+			// (e.g. if the user settings were written for a computer with more cores)
+			if ( SetThreadAffinityMask( i_thread, static_cast<DWORD_PTR>( i_options.affinityMask ) ) == 0 )
+			{
+				const auto errorMessage = eae6320::Windows::GetLastSystemError();
+				eae6320::Logging::OutputError( "Windows failed to set the affinity mask of the thread \"%s\" to 0x%llx"
+					" (it can run on any processor instead): %s",
+					i_options.name ? i_options.name : "", static_cast<unsigned long long>( i_options.affinityMask ), errorMessage.c_str() );
+			}
+		}
+	}
+
+	const std::vector<uint64_t>& GetPhysicalCoreAffinityMasks()
+	{
+		// The topology doesn't change while the application is running
+		static const auto s_affinityMasks = []()
+		{
+			std::vector<uint64_t> affinityMasks;
+			DWORD bufferSize = 0;
+			GetLogicalProcessorInformation( nullptr, &bufferSize );
+			std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> processorInformation( bufferSize / sizeof( SYSTEM_LOGICAL_PROCESSOR_INFORMATION ) );
+			if ( !processorInformation.empty() && ( GetLogicalProcessorInformation( processorInformation.data(), &bufferSize ) != FALSE ) )
+			{
+				for ( const auto& information : processorInformation )
+				{
+					if ( information.Relationship == RelationProcessorCore )
+					{
+						affinityMasks.push_back( static_cast<uint64_t>( information.ProcessorMask ) );
+					}
+				}
+			}
+			else
+			{
+				const auto errorMessage = eae6320::Windows::GetLastSystemError();
+				eae6320::Logging::OutputError( "Windows failed to get the processor topology: %s", errorMessage.c_str() );
+			}
+			return affinityMasks;
+		}();
+		return s_affinityMasks;
+	}
+}
@@ -4,10 +4,33 @@
 #include "cEvent.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <thread>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Spinning only helps if the thread that will signal the event can run at the same time as the waiting thread
+	std::atomic<bool> s_isSpinningEnabled( std::thread::hardware_concurrency() > 1 );
+}
 
 // Interface
 //==========
 
+// Spinning
+//---------
+
+void eae6320::Concurrency::cEvent::SetIsSpinningEnabled( const bool i_isSpinningEnabled )
+{
+	s_isSpinningEnabled.store( i_isSpinningEnabled, std::memory_order_relaxed );
+}
+
+bool eae6320::Concurrency::cEvent::IsSpinningEnabled()
+{
+	return s_isSpinningEnabled.load( std::memory_order_relaxed );
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -16,3 +39,27 @@ eae6320::Concurrency::cEvent::~cEvent()
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
 }
+
+// Implementation
+//===============
+
+void eae6320::Concurrency::cEvent::UpdateSpinLimit( const uint32_t i_spinLimit, const uint32_t i_spinCount, const bool i_wasSignaled ) const
+{
+	// Races between threads updating the limit are harmless
+	if ( i_wasSignaled )
+	{
+		// The limit moves gradually toward twice the number of spins that were needed this time
+		const auto targetSpinLimit = ( i_spinCount * 2 ) + s_minSpinLimit;
+		auto newSpinLimit = static_cast<uint32_t>( static_cast<int64_t>( i_spinLimit )
+			+ ( ( static_cast<int64_t>( targetSpinLimit ) - static_cast<int64_t>( i_spinLimit ) ) / 8 ) );
+		newSpinLimit = ( newSpinLimit < s_maxSpinLimit ) ? newSpinLimit : s_maxSpinLimit;
+		m_spinLimit.store( newSpinLimit, std::memory_order_relaxed );
+	}
+	else
+	{
+		// If the event wasn't signaled in time the limit is reduced
+		// so that events that usually take a long time don't waste time spinning
+		const auto newSpinLimit = i_spinLimit / 2;
+		m_spinLimit.store( ( newSpinLimit > s_minSpinLimit ) ? newSpinLimit : s_minSpinLimit, std::memory_order_relaxed );
+	}
+}
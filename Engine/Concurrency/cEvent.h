@@ -16,6 +16,8 @@
 
 #include "Constants.h"
 
+#include <atomic>
+#include <cstdint>
 #include <Engine/Results/Results.h>
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
@@ -30,6 +32,10 @@ namespace eae6320
 	namespace Concurrency
 	{
 		class cEvent;
+
+		// This is declared here so that it can have a default argument
+		// (a friend declaration can't, and so the class only names it as a friend)
+		cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
 	}
 }
 
@@ -78,7 +84,7 @@ namespace eae6320
 			//	* The specified time-out period elapses
 			//		* If the caller doesn't specify a time-out period then the function will never return until the event happens
 			//		* If the caller specifies a time-out period of zero then the function will return immediately
-			friend cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+			friend cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds );
 
 			// This function should be called when an event happens
 			// (which "signals" the event happening to any waiting threads)
@@ -87,6 +93,19 @@ namespace eae6320
 			// (it resets the event as if it had never happened)
 			cResult ResetToUnsignaled();
 
+			// Spinning
+			//---------
+
+			// A thread that waits for an event spins for a short time before it goes to sleep in the kernel
+			// in case the event is about to be signaled
+			// (waking a sleeping thread costs much more than a signal that is only a few microseconds away,
+			// which is common when threads hand work back and forth every frame).
+			// How long a thread spins adapts to how long each event has recently taken to be signaled.
+			// Spinning can be disabled so that every wait goes straight to the kernel
+			// (it is disabled by default if there is only one processor core).
+			static void SetIsSpinningEnabled( const bool i_isSpinningEnabled );
+			static bool IsSpinningEnabled();
+
 			// Initialization / Clean Up
 			//--------------------------
 
@@ -103,7 +122,33 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HANDLE m_handle = NULL;
+			// This is incremented every time that the event is signaled
+			// so that a spinning thread only has to check the event itself when it might have changed
+			mutable std::atomic<uint32_t> m_signalCount{ 0 };
+			// If the event resets automatically a different waiting thread might get the signal,
+			// and so a spinning thread only checks the event this many times after each change
+			static constexpr uint32_t s_maxEventChecksPerSignal = 8;
+#elif defined( EAE6320_PLATFORM_POSIX )
+			// This is a futex word (see cEvent.posix.cpp)
+			mutable std::atomic<uint32_t> m_state{ 0 };
+			EventType m_type = EventType::ResetAutomaticallyAfterBeingSignaled;
+			bool m_isInitialized = false;
 #endif
+			// The number of times that a waiting thread will spin before going to sleep
+			static constexpr uint32_t s_minSpinLimit = 64;
+			static constexpr uint32_t s_maxSpinLimit = 4096;
+			mutable std::atomic<uint32_t> m_spinLimit{ 256 };
+
+			// Implementation
+			//===============
+
+		private:
+
+			// This returns true if the event was signaled while spinning
+			// (and, if it resets automatically, the caller is the one that reset it)
+			bool SpinUntilSignaled() const;
+			// The spin limit moves toward the number of spins that were recently needed
+			void UpdateSpinLimit( const uint32_t i_spinLimit, const uint32_t i_spinCount, const bool i_wasSignaled ) const;
 		};
 	}
 }
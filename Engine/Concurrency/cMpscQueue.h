@@ -0,0 +1,127 @@
+/*
+	A multi-producer/single-consumer queue is a fixed-size ring buffer
+	that any number of threads add items to and one thread removes items from
+
+	Neither side takes a lock:
+		* Every slot has a sequence number that says whether it is free or full for the current trip around the ring
+		* A producer reserves a slot by advancing the shared tail with a compare-and-swap,
+			fills it, and then publishes it by updating its sequence number
+		* The consumer is the only thread that changes the head,
+			and so it just waits for the next slot's sequence number to say that it is full
+	The head and tail are on different cache lines so that the consumer and producers don't slow each other down.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CMPSCQUEUE_H
+#define EAE6320_CONCURRENCY_CMPSCQUEUE_H
+
+// Include Files
+//==============
+
+#include "cQueueWaiter.h"
+#include "Constants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// The items must be default-constructible and move-assignable
+		// (every slot holds an item, and items are moved in and out of the slots)
+		template <typename tItem, size_t tCapacity>
+		class cMpscQueue
+		{
+			static_assert( ( tCapacity > 1 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Producers
+			//----------
+
+			// These can be called by any thread.
+			// Push() returns false if the queue is full,
+			// and PushBatch() returns how many of the items were added
+			// (the items in a batch are kept in order, but items from other producers can be between them).
+			bool Push( tItem&& i_item );
+			bool Push( const tItem& i_item );
+			size_t PushBatch( tItem* const i_items, const size_t i_itemCount );
+
+			// Consumer
+			//---------
+
+			// These must only be called by the consumer thread.
+			// Pop() returns false if the queue is empty,
+			// and PopBatch() returns how many items were removed.
+			bool Pop( tItem& o_item );
+			size_t PopBatch( tItem* const o_items, const size_t i_maxItemCount );
+			// This requires the queue to have been initialized
+			// (see cQueueWaiter::Wait() for the results)
+			cResult WaitUntilNotEmpty( const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+
+			// Access
+			//-------
+
+			// This is only an estimate when called by a thread other than the consumer
+			bool IsEmpty() const;
+			static constexpr size_t GetCapacity() { return tCapacity; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// A queue can be used without being initialized
+			// except that the consumer can't wait for items
+			cResult Initialize() { return m_waiter.Initialize(); }
+			cResult CleanUp() { return m_waiter.CleanUp(); }
+
+			cMpscQueue();
+
+			cMpscQueue( const cMpscQueue& ) = delete;
+			cMpscQueue& operator =( const cMpscQueue& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr size_t s_indexMask = tCapacity - 1;
+
+			struct sSlot
+			{
+				// A slot is free for the producer that reserves index i when this is i,
+				// and full for the consumer when this is i + 1
+				std::atomic<size_t> sequence;
+				tItem item;
+			};
+
+			// Consumer
+			alignas( 64 ) std::atomic<size_t> m_head{ 0 };
+			// Producers
+			alignas( 64 ) std::atomic<size_t> m_tail{ 0 };
+
+			alignas( 64 ) sSlot m_slots[tCapacity];
+
+			cQueueWaiter m_waiter;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// This reserves up to the requested number of contiguous slots
+			// and returns how many were reserved (starting at o_firstIndex)
+			size_t ReserveSlots( const size_t i_wantedSlotCount, size_t& o_firstIndex );
+		};
+	}
+}
+
+#include "cMpscQueue.inl"
+
+#endif	// EAE6320_CONCURRENCY_CMPSCQUEUE_H
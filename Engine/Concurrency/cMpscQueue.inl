@@ -0,0 +1,173 @@
+#ifndef EAE6320_CONCURRENCY_CMPSCQUEUE_INL
+#define EAE6320_CONCURRENCY_CMPSCQUEUE_INL
+
+// Include Files
+//==============
+
+#include "cMpscQueue.h"
+
+#include <utility>
+
+// Interface
+//==========
+
+// Producers
+//----------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::Push( tItem&& i_item )
+{
+	size_t index;
+	if ( ReserveSlots( 1, index ) == 0 )
+	{
+		return false;
+	}
+	auto& slot = m_slots[index & s_indexMask];
+	slot.item = std::move( i_item );
+	slot.sequence.store( index + 1, std::memory_order_release );
+	m_waiter.NotifyIfWaiting();
+	return true;
+}
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::Push( const tItem& i_item )
+{
+	auto item = i_item;
+	return Push( std::move( item ) );
+}
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::PushBatch( tItem* const i_items, const size_t i_itemCount )
+{
+	if ( i_itemCount == 0 )
+	{
+		return 0;
+	}
+	size_t firstIndex;
+	const auto itemCount = ReserveSlots( i_itemCount, firstIndex );
+	for ( size_t i = 0; i < itemCount; ++i )
+	{
+		auto& slot = m_slots[( firstIndex + i ) & s_indexMask];
+		slot.item = std::move( i_items[i] );
+		slot.sequence.store( firstIndex + i + 1, std::memory_order_release );
+	}
+	if ( itemCount > 0 )
+	{
+		m_waiter.NotifyIfWaiting();
+	}
+	return itemCount;
+}
+
+// Consumer
+//---------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::Pop( tItem& o_item )
+{
+	const auto head = m_head.load( std::memory_order_relaxed );
+	auto& slot = m_slots[head & s_indexMask];
+	if ( slot.sequence.load( std::memory_order_acquire ) != ( head + 1 ) )
+	{
+		// The queue is empty
+		// (or the producer that reserved the next slot hasn't finished filling it)
+		return false;
+	}
+	o_item = std::move( slot.item );
+	// The slot is made free for the producer that will reserve it on the next trip around the ring
+	slot.sequence.store( head + tCapacity, std::memory_order_release );
+	m_head.store( head + 1, std::memory_order_relaxed );
+	return true;
+}
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::PopBatch( tItem* const o_items, const size_t i_maxItemCount )
+{
+	size_t itemCount = 0;
+	while ( ( itemCount < i_maxItemCount ) && Pop( o_items[itemCount] ) )
+	{
+		++itemCount;
+	}
+	return itemCount;
+}
+
+template <typename tItem, size_t tCapacity>
+	eae6320::cResult eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::WaitUntilNotEmpty( const unsigned int i_timeToWait_inMilliseconds )
+{
+	return m_waiter.Wait( [this]() { return !IsEmpty(); }, i_timeToWait_inMilliseconds );
+}
+
+// Access
+//-------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::IsEmpty() const
+{
+	const auto head = m_head.load( std::memory_order_relaxed );
+	return m_slots[head & s_indexMask].sequence.load( std::memory_order_acquire ) != ( head + 1 );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template <typename tItem, size_t tCapacity>
+	eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::cMpscQueue()
+{
+	for ( size_t i = 0; i < tCapacity; ++i )
+	{
+		m_slots[i].sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+// Implementation
+//===============
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cMpscQueue<tItem, tCapacity>::ReserveSlots( const size_t i_wantedSlotCount, size_t& o_firstIndex )
+{
+	auto tail = m_tail.load( std::memory_order_relaxed );
+	while ( true )
+	{
+		const auto sequence = m_slots[tail & s_indexMask].sequence.load( std::memory_order_acquire );
+		const auto difference = static_cast<ptrdiff_t>( sequence - tail );
+		if ( difference < 0 )
+		{
+			// The slot at the tail still has an item from the previous trip around the ring
+			return 0;
+		}
+		else if ( difference > 0 )
+		{
+			// Another producer has already reserved this slot
+			tail = m_tail.load( std::memory_order_relaxed );
+			continue;
+		}
+		// The consumer frees slots in order,
+		// and so if a slot is free then every slot before it is also free
+		// (which means that the number of free slots can be found with a binary search)
+		size_t freeSlotCount = 1;
+		{
+			auto maxSlotCount = ( i_wantedSlotCount < tCapacity ) ? i_wantedSlotCount : tCapacity;
+			while ( freeSlotCount < maxSlotCount )
+			{
+				const auto slotCount = freeSlotCount + ( ( maxSlotCount - freeSlotCount + 1 ) / 2 );
+				const auto lastIndex = tail + slotCount - 1;
+				if ( m_slots[lastIndex & s_indexMask].sequence.load( std::memory_order_acquire ) == lastIndex )
+				{
+					freeSlotCount = slotCount;
+				}
+				else
+				{
+					maxSlotCount = slotCount - 1;
+				}
+			}
+		}
+		// If the tail has moved the slots might not be free after all,
+		// in which case the compare-and-swap fails and everything is checked again
+		if ( m_tail.compare_exchange_weak( tail, tail + freeSlotCount, std::memory_order_relaxed, std::memory_order_relaxed ) )
+		{
+			o_firstIndex = tail;
+			return freeSlotCount;
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CMPSCQUEUE_INL
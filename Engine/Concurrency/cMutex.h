@@ -12,10 +12,19 @@
 // Include Files
 //==============
 
+#include "Configuration.h"
+
 #include <Engine/Results/Results.h>
 
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	#include "MutexProfiling.h"
+#endif
+
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_POSIX )
+	#include <atomic>
+	#include <cstdint>
 #endif
 
 // Class Declaration
@@ -62,6 +71,9 @@ namespace eae6320
 			//--------------------------
 
 			cMutex();
+			// A mutex with a name has its use recorded when mutex profiling is enabled
+			// (see MutexProfiling.h; the name is ignored otherwise)
+			explicit cMutex( const char* const i_name );
 			~cMutex();
 
 			// Data
@@ -71,6 +83,14 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			SRWLOCK m_srwLock;
+#elif defined( EAE6320_PLATFORM_POSIX )
+			// This is a futex word (see Futex.posix.h)
+			std::atomic<uint32_t> m_state{ 0 };
+#endif
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+			MutexProfiling::sLockRecord* m_profilingRecord = nullptr;
+			// These are only accessed by the thread that holds the lock
+			uint64_t m_lockTime_inTicks = 0;
 #endif
 		};
 	}
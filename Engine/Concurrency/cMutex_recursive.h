@@ -15,10 +15,20 @@
 // Include Files
 //==============
 
+#include "Configuration.h"
+
 #include <Engine/Results/Results.h>
 
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+	#include "MutexProfiling.h"
+#endif
+
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_POSIX )
+	#include <atomic>
+	#include <cstdint>
+	#include <thread>
 #endif
 
 // Class Declaration
@@ -65,6 +75,9 @@ namespace eae6320
 			//--------------------------
 
 			cMutex_recursive();
+			// A mutex with a name has its use recorded when mutex profiling is enabled
+			// (see MutexProfiling.h; the name is ignored otherwise)
+			explicit cMutex_recursive( const char* const i_name );
 			~cMutex_recursive();
 
 			// Data
@@ -74,6 +87,19 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			CRITICAL_SECTION m_criticalSection;
+#elif defined( EAE6320_PLATFORM_POSIX )
+			// This is a futex word (see Futex.posix.h)
+			std::atomic<uint32_t> m_state{ 0 };
+			// The owner is only changed by the thread that holds the lock,
+			// but it is read by other threads to find out whether they are the owner
+			std::atomic<std::thread::id> m_owner;
+			unsigned int m_recursionCount = 0;
+#endif
+#if defined( EAE6320_CONCURRENCY_ISMUTEXPROFILINGENABLED )
+			MutexProfiling::sLockRecord* m_profilingRecord = nullptr;
+			// These are only accessed by the thread that holds the lock
+			uint64_t m_lockTime_inTicks = 0;
+			unsigned int m_lockDepth = 0;
 #endif
 		};
 	}
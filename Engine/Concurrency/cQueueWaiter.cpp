@@ -0,0 +1,54 @@
+// Include Files
+//==============
+
+#include "cQueueWaiter.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Producer
+//---------
+
+void eae6320::Concurrency::cQueueWaiter::NotifyIfWaiting()
+{
+	// The item must be visible before the consumer is checked
+	// (and the consumer sets its flag before checking the queue)
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( m_isInitialized && m_isConsumerWaiting.load( std::memory_order_relaxed ) )
+	{
+		const auto result = m_whenItemsHaveBeenAdded.Signal();
+		EAE6320_ASSERT( result );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::cQueueWaiter::Initialize()
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !m_isInitialized, "A queue waiter can only be initialized once" );
+	if ( !( result = m_whenItemsHaveBeenAdded.Initialize( EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the event that a queue's consumer waits for" );
+		return result;
+	}
+	m_isInitialized = true;
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::cQueueWaiter::CleanUp()
+{
+	m_isInitialized = false;
+	return m_whenItemsHaveBeenAdded.CleanUp();
+}
+
+eae6320::Concurrency::cQueueWaiter::~cQueueWaiter()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
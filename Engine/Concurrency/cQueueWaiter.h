@@ -0,0 +1,76 @@
+/*
+	A queue waiter lets the consumer of a lock-free queue sleep while the queue is empty
+
+	Producers only signal the waiter when the consumer is actually waiting,
+	and so a queue that is never waited on doesn't pay for the event.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CQUEUEWAITER_H
+#define EAE6320_CONCURRENCY_CQUEUEWAITER_H
+
+// Include Files
+//==============
+
+#include "cEvent.h"
+#include "Constants.h"
+
+#include <atomic>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		class cQueueWaiter
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Producer
+			//---------
+
+			// This must be called after an item has been added to the queue
+			void NotifyIfWaiting();
+
+			// Consumer
+			//---------
+
+			// The function returns true when the queue isn't empty.
+			// This returns Results::TimeOut if the queue was still empty after the specified time
+			// (if the caller doesn't specify a time-out period this doesn't return until the queue isn't empty).
+			template <typename fIsNotEmpty>
+				cResult Wait( const fIsNotEmpty& i_isNotEmpty, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// This must be called before Wait() can be used
+			cResult Initialize();
+			cResult CleanUp();
+
+			cQueueWaiter() = default;
+			~cQueueWaiter();
+
+			cQueueWaiter( const cQueueWaiter& ) = delete;
+			cQueueWaiter& operator =( const cQueueWaiter& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			cEvent m_whenItemsHaveBeenAdded;
+			std::atomic<bool> m_isConsumerWaiting{ false };
+			bool m_isInitialized = false;
+		};
+	}
+}
+
+#include "cQueueWaiter.inl"
+
+#endif	// EAE6320_CONCURRENCY_CQUEUEWAITER_H
@@ -0,0 +1,49 @@
+#ifndef EAE6320_CONCURRENCY_CQUEUEWAITER_INL
+#define EAE6320_CONCURRENCY_CQUEUEWAITER_INL
+
+// Include Files
+//==============
+
+#include "cQueueWaiter.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Consumer
+//---------
+
+template <typename fIsNotEmpty>
+	eae6320::cResult eae6320::Concurrency::cQueueWaiter::Wait( const fIsNotEmpty& i_isNotEmpty, const unsigned int i_timeToWait_inMilliseconds )
+{
+	if ( i_isNotEmpty() )
+	{
+		return Results::Success;
+	}
+	EAE6320_ASSERTF( m_isInitialized, "A queue can't be waited on until its waiter has been initialized" );
+	auto result = Results::TimeOut;
+	// The consumer announces that it is waiting before checking again
+	// so that an item that is added in between will signal the event
+	m_isConsumerWaiting.store( true, std::memory_order_seq_cst );
+	while ( !i_isNotEmpty() )
+	{
+		const auto waitResult = WaitForEvent( m_whenItemsHaveBeenAdded, i_timeToWait_inMilliseconds );
+		if ( !waitResult )
+		{
+			result = waitResult;
+			break;
+		}
+		// An item that was added before the consumer started waiting can leave the event signaled,
+		// and so the queue is checked again
+		// (unless there is a time-out, in which case the event is only waited for once)
+		if ( i_timeToWait_inMilliseconds != Constants::DontTimeOut )
+		{
+			break;
+		}
+	}
+	m_isConsumerWaiting.store( false, std::memory_order_relaxed );
+	return i_isNotEmpty() ? Results::Success : result;
+}
+
+#endif	// EAE6320_CONCURRENCY_CQUEUEWAITER_INL
@@ -0,0 +1,174 @@
+/*
+	A reader-writer mutex is used to protect resources
+	that are read often but only written rarely
+
+	Any number of threads can hold a shared (read) lock at the same time,
+	but only a single thread can hold the exclusive (write) lock,
+	and while it does no other thread can hold any kind of lock.
+
+	The mutex prefers writers:
+	Once a thread is waiting for the exclusive lock no new shared locks are given out,
+	and so a constant stream of readers can't keep a writer waiting forever.
+
+	A thread that reads and then maybe needs to write can acquire an upgradable lock:
+	An upgradable lock can be held at the same time as shared locks (but not at the same time as another upgradable lock)
+	and can be upgraded to the exclusive lock without first releasing it
+	(which means that nothing can change between the read and the write).
+
+	None of the locks are recursive.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CRWMUTEX_H
+#define EAE6320_CONCURRENCY_CRWMUTEX_H
+
+// Include Files
+//==============
+
+#include <Engine/Results/Results.h>
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_POSIX )
+	#include <atomic>
+	#include <cstdint>
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		class cRWMutex
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// These are convenience classes that automatically handle acquiring and releasing a lock at scope level
+			// (after an instance has been constructed the lock will be acquired,
+			// and the lock will automatically be released once the instance goes out of scope and is destructed)
+			class cScopeLock
+			{
+			public:
+
+				cScopeLock( cRWMutex& io_mutex ) : m_mutex( io_mutex ) { m_mutex.Lock(); }
+				~cScopeLock() { m_mutex.Unlock(); }
+
+			private:
+
+				cRWMutex& m_mutex;
+			};
+			class cSharedScopeLock
+			{
+			public:
+
+				cSharedScopeLock( cRWMutex& io_mutex ) : m_mutex( io_mutex ) { m_mutex.LockShared(); }
+				~cSharedScopeLock() { m_mutex.UnlockShared(); }
+
+			private:
+
+				cRWMutex& m_mutex;
+			};
+			class cUpgradableScopeLock
+			{
+			public:
+
+				cUpgradableScopeLock( cRWMutex& io_mutex ) : m_mutex( io_mutex ) { m_mutex.LockUpgradable(); }
+				~cUpgradableScopeLock() { if ( m_isExclusive ) { m_mutex.Unlock(); } else { m_mutex.UnlockUpgradable(); } }
+
+				// After this is called the scope lock holds the exclusive lock
+				void UpgradeToExclusive() { if ( !m_isExclusive ) { m_mutex.UpgradeToExclusive(); m_isExclusive = true; } }
+
+			private:
+
+				cRWMutex& m_mutex;
+				bool m_isExclusive = false;
+			};
+
+			// Exclusive
+			//----------
+
+			// Calling this function will block the thread until the exclusive lock is acquired
+			void Lock();
+			// Calling this function returns immediately.
+			// If the return value succeeds then the exclusive lock was acquired
+			// but if the return value fails then the lock wasn't acquired
+			// (because another thread holds a lock)
+			cResult LockIfPossible();
+			// This releases a held exclusive lock
+			// (including one that was upgraded).
+			// The results are undefined if this is called when the exclusive lock isn't held.
+			void Unlock();
+
+			// Shared
+			//-------
+
+			// Calling this function will block the thread until a shared lock is acquired
+			void LockShared();
+			// Calling this function returns immediately.
+			// If the return value succeeds then a shared lock was acquired
+			// but if the return value fails then the lock wasn't acquired
+			// (because another thread holds or is waiting for the exclusive lock)
+			cResult LockSharedIfPossible();
+			// This releases a held shared lock.
+			// The results are undefined if this is called when a shared lock isn't held.
+			void UnlockShared();
+
+			// Upgradable
+			//-----------
+
+			// Calling this function will block the thread until the upgradable lock is acquired
+			void LockUpgradable();
+			// Calling this function will block the thread until every shared lock has been released,
+			// after which the thread holds the exclusive lock instead of the upgradable one
+			// (which must then be released with Unlock()).
+			// The results are undefined if this is called when the upgradable lock isn't held.
+			void UpgradeToExclusive();
+			// This releases a held upgradable lock that wasn't upgraded.
+			// The results are undefined if this is called when the upgradable lock isn't held.
+			void UnlockUpgradable();
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cRWMutex();
+			~cRWMutex();
+
+			cRWMutex( const cRWMutex& ) = delete;
+			cRWMutex& operator =( const cRWMutex& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+			// This protects the state below
+			// (it is only held briefly while the state is checked and changed, never while a lock is held)
+			SRWLOCK m_stateLock;
+			CONDITION_VARIABLE m_whenReadersCanLock;
+			CONDITION_VARIABLE m_whenWriterCanLock;
+			CONDITION_VARIABLE m_whenUpgraderCanUpgrade;
+#elif defined( EAE6320_PLATFORM_POSIX )
+			// These are futex words (see Futex.posix.h):
+			// The state lock is a futex mutex,
+			// and each condition variable is a count of how many times it has been woken
+			// (a thread that is waiting only goes to sleep if the count hasn't changed since it released the state lock)
+			std::atomic<uint32_t> m_stateLock{ 0 };
+			std::atomic<uint32_t> m_whenReadersCanLock{ 0 };
+			std::atomic<uint32_t> m_whenWriterCanLock{ 0 };
+			std::atomic<uint32_t> m_whenUpgraderCanUpgrade{ 0 };
+#endif
+			unsigned int m_readerCount = 0;
+			unsigned int m_waitingWriterCount = 0;
+			bool m_isWriterActive = false;
+			bool m_isUpgradableLockHeld = false;
+			bool m_isUpgraderWaiting = false;
+		};
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CRWMUTEX_H
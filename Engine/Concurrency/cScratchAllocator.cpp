@@ -0,0 +1,268 @@
+// Include Files
+//==============
+
+#include "cScratchAllocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Most per-frame temporary data fits in a single block,
+	// but a bigger block is reserved if a single allocation needs it
+	constexpr size_t s_defaultBlockSize_inBytes = 256 * 1024;
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	// Freed memory is filled with this so that anything that still uses it is easier to notice
+	constexpr uint8_t s_freedMemoryPattern = 0xCD;
+#endif
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This returns null if the allocation doesn't fit in the block after the given offset
+	uint8_t* FitInBlock( uint8_t* const i_blockMemory, const size_t i_blockSize, const size_t i_offset,
+		const size_t i_size, const size_t i_alignment, const size_t i_headerSize );
+}
+
+// Interface
+//==========
+
+eae6320::Concurrency::cScratchAllocator& eae6320::Concurrency::cScratchAllocator::GetForCurrentThread()
+{
+	thread_local cScratchAllocator s_scratchAllocator;
+	return s_scratchAllocator;
+}
+
+// Allocation
+//-----------
+
+void* eae6320::Concurrency::cScratchAllocator::Allocate( const size_t i_size, const size_t i_alignment )
+{
+	EAE6320_ASSERTF( ( i_alignment > 0 ) && ( ( i_alignment & ( i_alignment - 1 ) ) == 0 ), "Alignment must be a power of two" );
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	EAE6320_ASSERTF( std::this_thread::get_id() == m_threadId, "A scratch allocator can only be used by its own thread" );
+	EAE6320_ASSERTF( m_scopeDepth > 0, "Scratch memory can only be allocated inside of a scratch scope" );
+	constexpr auto headerSize = sizeof( sAllocationHeader );
+	const auto alignment = std::max( i_alignment, alignof( sAllocationHeader ) );
+#else
+	constexpr size_t headerSize = 0;
+	const auto alignment = i_alignment;
+#endif
+
+	// The allocation is made in the current block if it fits
+	uint8_t* memory = nullptr;
+	if ( m_blockIndex < m_blocks.size() )
+	{
+		const auto& block = m_blocks[m_blockIndex];
+		memory = FitInBlock( block.memory, block.size, m_offset, i_size, alignment, headerSize );
+	}
+	// Otherwise it is made in the next free block that it fits in
+	if ( !memory )
+	{
+		auto blockIndex = m_blocks.empty() ? 0 : ( m_blockIndex + 1 );
+		for ( ; blockIndex < m_blocks.size(); ++blockIndex )
+		{
+			const auto& block = m_blocks[blockIndex];
+			memory = FitInBlock( block.memory, block.size, 0, i_size, alignment, headerSize );
+			if ( memory )
+			{
+				break;
+			}
+		}
+		// Otherwise a new block is reserved for it
+		if ( !memory )
+		{
+			if ( !ReserveBlock( i_size + alignment + headerSize ) )
+			{
+				return nullptr;
+			}
+			blockIndex = m_blocks.size() - 1;
+			const auto& block = m_blocks[blockIndex];
+			memory = FitInBlock( block.memory, block.size, 0, i_size, alignment, headerSize );
+			EAE6320_ASSERT( memory );
+		}
+		m_blockIndex = blockIndex;
+		m_offset = 0;
+	}
+
+	m_lastAllocation = memory;
+	m_offset_beforeLastAllocation = m_offset;
+	m_offset = static_cast<size_t>( ( memory + i_size ) - m_blocks[m_blockIndex].memory );
+
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	{
+		const auto scopeIndex = m_scopeDepth - 1;
+		const sAllocationHeader header{ static_cast<uint32_t>( scopeIndex ), s_magicNumber };
+		std::memcpy( memory - headerSize, &header, headerSize );
+		++m_allocationCounts[scopeIndex];
+	}
+#endif
+
+	return memory;
+}
+
+void eae6320::Concurrency::cScratchAllocator::Deallocate( void* const i_memory, const size_t i_size )
+{
+	if ( !i_memory )
+	{
+		return;
+	}
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	EAE6320_ASSERTF( std::this_thread::get_id() == m_threadId, "A scratch allocator can only be used by its own thread" );
+	{
+		auto* const headerMemory = static_cast<uint8_t*>( i_memory ) - sizeof( sAllocationHeader );
+		sAllocationHeader header;
+		std::memcpy( &header, headerMemory, sizeof( header ) );
+		EAE6320_ASSERTF( header.magicNumber == s_magicNumber,
+			"Memory that wasn't allocated by this scratch allocator (or that was already freed) is being freed" );
+		if ( header.magicNumber == s_magicNumber )
+		{
+			EAE6320_ASSERTF( ( header.scopeDepth < m_scopeDepth ) && ( m_allocationCounts[header.scopeDepth] > 0 ),
+				"Scratch memory is being freed after its scope has ended" );
+			if ( header.scopeDepth < m_scopeDepth )
+			{
+				--m_allocationCounts[header.scopeDepth];
+			}
+			// The header is cleared so that freeing the same memory twice can be detected
+			header.magicNumber = 0;
+			std::memcpy( headerMemory, &header, sizeof( header ) );
+		}
+		std::memset( i_memory, s_freedMemoryPattern, i_size );
+	}
+#else	// The size is only used to verify allocations
+	static_cast<void>( i_size );
+#endif
+	// Only the most recent allocation can be freed before its scope ends
+	// (the memory of any others stays reserved until then)
+	if ( i_memory == m_lastAllocation )
+	{
+		m_offset = m_offset_beforeLastAllocation;
+		m_lastAllocation = nullptr;
+	}
+}
+
+// Access
+//-------
+
+size_t eae6320::Concurrency::cScratchAllocator::GetReservedByteCount() const
+{
+	size_t byteCount = 0;
+	for ( const auto& block : m_blocks )
+	{
+		byteCount += block.size;
+	}
+	return byteCount;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Concurrency::cScratchAllocator::cScratchAllocator()
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	:
+	m_threadId( std::this_thread::get_id() )
+#endif
+{
+
+}
+
+eae6320::Concurrency::cScratchAllocator::~cScratchAllocator()
+{
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	EAE6320_ASSERTF( m_scopeDepth == 0, "A scratch allocator is being destroyed while a scratch scope is still active" );
+#endif
+	for ( auto& block : m_blocks )
+	{
+		delete [] block.memory;
+	}
+	m_blocks.clear();
+}
+
+// Implementation
+//===============
+
+eae6320::Concurrency::cScratchAllocator::sMarker eae6320::Concurrency::cScratchAllocator::BeginScope()
+{
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	EAE6320_ASSERTF( std::this_thread::get_id() == m_threadId, "A scratch allocator can only be used by its own thread" );
+	EAE6320_ASSERTF( m_scopeDepth < s_maxVerifiedScopeDepth, "Scratch scopes are nested too deeply to be verified" );
+	m_allocationCounts[m_scopeDepth] = 0;
+	++m_scopeDepth;
+#endif
+	// Anything allocated before the scope began can't be freed until the scope ends
+	m_lastAllocation = nullptr;
+	return sMarker{ m_blockIndex, m_offset };
+}
+
+void eae6320::Concurrency::cScratchAllocator::EndScope( const sMarker i_marker )
+{
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	EAE6320_ASSERTF( std::this_thread::get_id() == m_threadId, "A scratch allocator can only be used by its own thread" );
+	EAE6320_ASSERTF( m_scopeDepth > 0, "A scratch scope is being ended without having begun" );
+	if ( m_scopeDepth > 0 )
+	{
+		--m_scopeDepth;
+		EAE6320_ASSERTF( m_allocationCounts[m_scopeDepth] == 0,
+			"A scratch scope is ending while %u allocations that were made inside of it are still in use",
+			m_allocationCounts[m_scopeDepth] );
+	}
+	// Everything allocated since the scope began is filled so that anything that still uses it is easier to notice
+	for ( auto blockIndex = i_marker.blockIndex; ( blockIndex <= m_blockIndex ) && ( blockIndex < m_blocks.size() ); ++blockIndex )
+	{
+		const auto& block = m_blocks[blockIndex];
+		const auto beginOffset = ( blockIndex == i_marker.blockIndex ) ? i_marker.offset : 0;
+		const auto endOffset = ( blockIndex == m_blockIndex ) ? m_offset : block.size;
+		if ( endOffset > beginOffset )
+		{
+			std::memset( block.memory + beginOffset, s_freedMemoryPattern, endOffset - beginOffset );
+		}
+	}
+#endif
+	m_blockIndex = i_marker.blockIndex;
+	m_offset = i_marker.offset;
+	m_lastAllocation = nullptr;
+}
+
+bool eae6320::Concurrency::cScratchAllocator::ReserveBlock( const size_t i_minSize )
+{
+	const auto size = std::max( s_defaultBlockSize_inBytes, i_minSize );
+	auto* const memory = new ( std::nothrow ) uint8_t[size];
+	if ( !memory )
+	{
+		EAE6320_ASSERTF( false, "Couldn't reserve a block for scratch memory" );
+		Logging::OutputError( "Failed to reserve %zu bytes for a thread's scratch memory", size );
+		return false;
+	}
+	m_blocks.push_back( sBlock{ memory, size } );
+	return true;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint8_t* FitInBlock( uint8_t* const i_blockMemory, const size_t i_blockSize, const size_t i_offset,
+		const size_t i_size, const size_t i_alignment, const size_t i_headerSize )
+	{
+		// The alignment is calculated from the address rather than the offset
+		// because the block itself might not be aligned as strictly as the allocation
+		const auto address_begin = reinterpret_cast<uintptr_t>( i_blockMemory ) + i_offset + i_headerSize;
+		const auto address_aligned = ( address_begin + ( i_alignment - 1 ) ) & ~static_cast<uintptr_t>( i_alignment - 1 );
+		const auto offset_aligned = static_cast<size_t>( address_aligned - reinterpret_cast<uintptr_t>( i_blockMemory ) );
+		if ( ( offset_aligned > i_blockSize ) || ( i_size > ( i_blockSize - offset_aligned ) ) )
+		{
+			return nullptr;
+		}
+		return i_blockMemory + offset_aligned;
+	}
+}
@@ -0,0 +1,200 @@
+/*
+	A scratch allocator is a linear allocator for temporary memory that is only used by a single thread
+
+	Every thread has its own scratch allocator, and so allocating never takes a lock:
+		* Allocating just moves an offset forward in a block of memory
+		* A scratch scope remembers the offset when it begins and moves it back when it ends,
+			which frees everything that was allocated inside of it at once
+		* Blocks are kept after the memory in them has been freed,
+			and so once a thread's scratch memory has grown big enough it doesn't use the heap again
+	ScratchVector<T> is a std::vector that uses the current thread's scratch allocator
+	and is meant for temporary data (e.g. per-frame arrays in hot paths).
+	It must only be used by the thread that created it, and must be destroyed before the scratch scope that it was created in ends.
+
+	When EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED is defined (see Configuration.h)
+	the allocator asserts if memory is allocated outside of a scope,
+	if a scope ends while memory allocated inside of it is still in use,
+	or if memory is used by a thread other than the one that allocated it.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_H
+#define EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_H
+
+// Include Files
+//==============
+
+#include "Configuration.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+	#include <thread>
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		class cScratchAllocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// A marker is a position in the allocator
+			struct sMarker
+			{
+				size_t blockIndex;
+				size_t offset;
+			};
+
+			// This is a convenience class that automatically handles beginning and ending a scratch scope
+			// (after an instance has been constructed the current thread's scratch allocator will remember its position,
+			// and everything allocated since then will automatically be freed once the instance goes out of scope and is destructed)
+			class cScope
+			{
+			public:
+
+				cScope() : m_allocator( GetForCurrentThread() ), m_marker( m_allocator.BeginScope() ) {}
+				~cScope() { m_allocator.EndScope( m_marker ); }
+
+				cScope( const cScope& ) = delete;
+				cScope& operator =( const cScope& ) = delete;
+
+			private:
+
+				cScratchAllocator& m_allocator;
+				const sMarker m_marker;
+			};
+
+			// Every thread has its own scratch allocator
+			static cScratchAllocator& GetForCurrentThread();
+
+			// Allocation
+			//-----------
+
+			// This returns null if there isn't enough memory.
+			// The memory is only valid until the scope that it was allocated in ends.
+			void* Allocate( const size_t i_size, const size_t i_alignment = alignof( std::max_align_t ) );
+			// Scratch memory is freed when its scope ends,
+			// and so this only does something when it is called with the most recent allocation
+			// (and when allocations are verified, in which case it records that the memory is no longer in use)
+			void Deallocate( void* const i_memory, const size_t i_size );
+
+			// Access
+			//-------
+
+			// This is how much memory the allocator has reserved from the heap (whether it is being used or not)
+			size_t GetReservedByteCount() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cScratchAllocator();
+			~cScratchAllocator();
+
+			cScratchAllocator( const cScratchAllocator& ) = delete;
+			cScratchAllocator& operator =( const cScratchAllocator& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			struct sBlock
+			{
+				uint8_t* memory;
+				size_t size;
+			};
+			// The blocks are kept in the order that they were reserved,
+			// and the current position is an offset in one of them
+			// (any blocks after the current one are free)
+			std::vector<sBlock> m_blocks;
+			size_t m_blockIndex = 0;
+			size_t m_offset = 0;
+			// The most recent allocation can be freed immediately
+			// (e.g. a temporary buffer in a loop that is freed before anything else is allocated;
+			// a growing vector doesn't benefit because it frees its old buffer after allocating the new one),
+			// and so this remembers where it is and where the current block's offset was before it was allocated
+			void* m_lastAllocation = nullptr;
+			size_t m_offset_beforeLastAllocation = 0;
+
+#if defined( EAE6320_CONCURRENCY_ARESCRATCHALLOCATIONSVERIFIED )
+			struct sAllocationHeader
+			{
+				uint32_t scopeDepth;
+				uint32_t magicNumber;
+			};
+			static constexpr uint32_t s_magicNumber = 0x5C7A7C4u;
+			static constexpr size_t s_maxVerifiedScopeDepth = 64;
+			// This is how many allocations in each scope are still in use
+			uint32_t m_allocationCounts[s_maxVerifiedScopeDepth] = {};
+			size_t m_scopeDepth = 0;
+			const std::thread::id m_threadId;
+#endif
+
+			// Implementation
+			//===============
+
+		private:
+
+			sMarker BeginScope();
+			void EndScope( const sMarker i_marker );
+
+			// This returns false if there isn't enough memory for a new block
+			bool ReserveBlock( const size_t i_minSize );
+		};
+
+		// This lets STL containers use the current thread's scratch allocator
+		template <typename tValue>
+		class cScratchStlAllocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			using value_type = tValue;
+
+			tValue* allocate( const size_t i_count );
+			void deallocate( tValue* const i_memory, const size_t i_count );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// The allocator belongs to the thread that it was constructed on
+			cScratchStlAllocator() : m_allocator( &cScratchAllocator::GetForCurrentThread() ) {}
+			template <typename tOtherValue>
+				cScratchStlAllocator( const cScratchStlAllocator<tOtherValue>& i_other ) : m_allocator( i_other.m_allocator ) {}
+
+			// Data
+			//=====
+
+		private:
+
+			cScratchAllocator* m_allocator;
+
+			template <typename tOtherValue> friend class cScratchStlAllocator;
+			template <typename tValue_lhs, typename tValue_rhs>
+				friend bool operator ==( const cScratchStlAllocator<tValue_lhs>& i_lhs, const cScratchStlAllocator<tValue_rhs>& i_rhs );
+		};
+
+		template <typename tValue_lhs, typename tValue_rhs>
+			bool operator ==( const cScratchStlAllocator<tValue_lhs>& i_lhs, const cScratchStlAllocator<tValue_rhs>& i_rhs );
+		template <typename tValue_lhs, typename tValue_rhs>
+			bool operator !=( const cScratchStlAllocator<tValue_lhs>& i_lhs, const cScratchStlAllocator<tValue_rhs>& i_rhs );
+
+		template <typename tValue>
+			using ScratchVector = std::vector<tValue, cScratchStlAllocator<tValue>>;
+	}
+}
+
+#include "cScratchAllocator.inl"
+
+#endif	// EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_H
@@ -0,0 +1,44 @@
+#ifndef EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_INL
+#define EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_INL
+
+// Include Files
+//==============
+
+#include "cScratchAllocator.h"
+
+#include <new>
+
+// Interface
+//==========
+
+template <typename tValue>
+	tValue* eae6320::Concurrency::cScratchStlAllocator<tValue>::allocate( const size_t i_count )
+{
+	auto* const memory = m_allocator->Allocate( sizeof( tValue ) * i_count, alignof( tValue ) );
+	if ( !memory )
+	{
+		// STL containers require allocators to throw when they can't allocate
+		throw std::bad_alloc();
+	}
+	return static_cast<tValue*>( memory );
+}
+
+template <typename tValue>
+	void eae6320::Concurrency::cScratchStlAllocator<tValue>::deallocate( tValue* const i_memory, const size_t i_count )
+{
+	m_allocator->Deallocate( i_memory, sizeof( tValue ) * i_count );
+}
+
+template <typename tValue_lhs, typename tValue_rhs>
+	bool eae6320::Concurrency::operator ==( const cScratchStlAllocator<tValue_lhs>& i_lhs, const cScratchStlAllocator<tValue_rhs>& i_rhs )
+{
+	return i_lhs.m_allocator == i_rhs.m_allocator;
+}
+
+template <typename tValue_lhs, typename tValue_rhs>
+	bool eae6320::Concurrency::operator !=( const cScratchStlAllocator<tValue_lhs>& i_lhs, const cScratchStlAllocator<tValue_rhs>& i_rhs )
+{
+	return !( i_lhs == i_rhs );
+}
+
+#endif	// EAE6320_CONCURRENCY_CSCRATCHALLOCATOR_INL
@@ -0,0 +1,112 @@
+/*
+	A sequence lock protects a small value that is read often but only written rarely
+	(e.g. a camera or a rigid body's state that one thread updates and other threads take snapshots of)
+
+	Readers never block writers and never write to shared memory:
+	The sequence number is odd while the value is being written,
+	and so a reader copies the value and then checks that the sequence number was even and didn't change
+	(if it did the copy could be torn and the reader tries again).
+	Writers are serialized with each other.
+
+	The value is kept as an array of atomic words
+	so that a reader copying it while it is written isn't undefined behavior.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CSEQLOCK_H
+#define EAE6320_CONCURRENCY_CSEQLOCK_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// The value is copied word by word
+		// and so it should be small (e.g. a few vectors)
+		template <typename tValue>
+		class cSeqLock
+		{
+			static_assert( std::is_trivially_copyable<tValue>::value, "The value must be trivially copyable" );
+			static_assert( std::is_default_constructible<tValue>::value, "The value must be default-constructible" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// This is a convenience class that automatically handles writing at scope level
+			// (after an instance has been constructed it holds a copy of the current value that can be changed,
+			// and the changed value will automatically be written once the instance goes out of scope and is destructed)
+			class cScopeWrite
+			{
+			public:
+
+				cScopeWrite( cSeqLock& io_seqLock ) : m_seqLock( io_seqLock ), m_sequence( m_seqLock.BeginWrite( m_value ) ) {}
+				~cScopeWrite() { m_seqLock.EndWrite( m_value, m_sequence ); }
+
+				tValue& Get() { return m_value; }
+
+			private:
+
+				cSeqLock& m_seqLock;
+				tValue m_value;
+				const uint64_t m_sequence;
+			};
+
+			// This can be called by any thread.
+			// It returns a copy of the value that was written completely by a single write
+			// (it only waits if a write is happening at the same time).
+			tValue Read() const;
+			// This can be called by any thread.
+			// It blocks if another thread is writing at the same time.
+			void Write( const tValue& i_value );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cSeqLock();
+			explicit cSeqLock( const tValue& i_initialValue );
+
+			cSeqLock( const cSeqLock& ) = delete;
+			cSeqLock& operator =( const cSeqLock& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr size_t s_wordCount = ( sizeof( tValue ) + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+
+			// The sequence number and the value are usually read together,
+			// and so they are kept on the same cache line
+			alignas( 64 ) std::atomic<uint64_t> m_sequence{ 0 };
+			std::atomic<uint64_t> m_words[s_wordCount];
+
+			// Implementation
+			//===============
+
+		private:
+
+			// BeginWrite() waits for any other writer to finish,
+			// copies the current value, and returns the odd sequence number to pass to EndWrite()
+			uint64_t BeginWrite( tValue& o_currentValue );
+			void EndWrite( const tValue& i_newValue, const uint64_t i_sequence );
+
+			void LoadWords( uint64_t ( &o_words )[s_wordCount] ) const;
+			void StoreWords( const tValue& i_value );
+		};
+	}
+}
+
+#include "cSeqLock.inl"
+
+#endif	// EAE6320_CONCURRENCY_CSEQLOCK_H
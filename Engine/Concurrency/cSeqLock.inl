@@ -0,0 +1,132 @@
+#ifndef EAE6320_CONCURRENCY_CSEQLOCK_INL
+#define EAE6320_CONCURRENCY_CSEQLOCK_INL
+
+// Include Files
+//==============
+
+#include "cSeqLock.h"
+
+#include <cstring>
+#include <thread>
+
+// Interface
+//==========
+
+template <typename tValue>
+	tValue eae6320::Concurrency::cSeqLock<tValue>::Read() const
+{
+	uint64_t words[s_wordCount];
+	while ( true )
+	{
+		const auto sequence = m_sequence.load( std::memory_order_acquire );
+		if ( ( sequence & 1 ) == 0 )
+		{
+			LoadWords( words );
+			// The words must be loaded before the sequence number is checked again
+			std::atomic_thread_fence( std::memory_order_acquire );
+			if ( m_sequence.load( std::memory_order_relaxed ) == sequence )
+			{
+				tValue value;
+				std::memcpy( &value, words, sizeof( tValue ) );
+				return value;
+			}
+		}
+		else
+		{
+			// A write is happening
+			std::this_thread::yield();
+		}
+	}
+}
+
+template <typename tValue>
+	void eae6320::Concurrency::cSeqLock<tValue>::Write( const tValue& i_value )
+{
+	tValue currentValue;
+	const auto sequence = BeginWrite( currentValue );
+	EndWrite( i_value, sequence );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template <typename tValue>
+	eae6320::Concurrency::cSeqLock<tValue>::cSeqLock()
+{
+	for ( auto& word : m_words )
+	{
+		word.store( 0, std::memory_order_relaxed );
+	}
+}
+
+template <typename tValue>
+	eae6320::Concurrency::cSeqLock<tValue>::cSeqLock( const tValue& i_initialValue )
+{
+	m_words[s_wordCount - 1].store( 0, std::memory_order_relaxed );
+	StoreWords( i_initialValue );
+}
+
+// Implementation
+//===============
+
+template <typename tValue>
+	uint64_t eae6320::Concurrency::cSeqLock<tValue>::BeginWrite( tValue& o_currentValue )
+{
+	// Making the sequence number odd both tells readers that a write is happening
+	// and stops other writers from starting
+	auto sequence = m_sequence.load( std::memory_order_relaxed );
+	while ( true )
+	{
+		if ( ( sequence & 1 ) == 0 )
+		{
+			if ( m_sequence.compare_exchange_weak( sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed ) )
+			{
+				break;
+			}
+		}
+		else
+		{
+			std::this_thread::yield();
+			sequence = m_sequence.load( std::memory_order_relaxed );
+		}
+	}
+	// The odd sequence number must be visible before any of the words change
+	std::atomic_thread_fence( std::memory_order_release );
+	{
+		uint64_t words[s_wordCount];
+		LoadWords( words );
+		std::memcpy( &o_currentValue, words, sizeof( tValue ) );
+	}
+	return sequence + 1;
+}
+
+template <typename tValue>
+	void eae6320::Concurrency::cSeqLock<tValue>::EndWrite( const tValue& i_newValue, const uint64_t i_sequence )
+{
+	StoreWords( i_newValue );
+	m_sequence.store( i_sequence + 1, std::memory_order_release );
+}
+
+template <typename tValue>
+	void eae6320::Concurrency::cSeqLock<tValue>::LoadWords( uint64_t ( &o_words )[s_wordCount] ) const
+{
+	for ( size_t i = 0; i < s_wordCount; ++i )
+	{
+		o_words[i] = m_words[i].load( std::memory_order_relaxed );
+	}
+}
+
+template <typename tValue>
+	void eae6320::Concurrency::cSeqLock<tValue>::StoreWords( const tValue& i_value )
+{
+	// If the value's size isn't a multiple of the word size the end of the last word is left as it was
+	uint64_t words[s_wordCount];
+	words[s_wordCount - 1] = m_words[s_wordCount - 1].load( std::memory_order_relaxed );
+	std::memcpy( words, &i_value, sizeof( tValue ) );
+	for ( size_t i = 0; i < s_wordCount; ++i )
+	{
+		m_words[i].store( words[i], std::memory_order_relaxed );
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CSEQLOCK_INL
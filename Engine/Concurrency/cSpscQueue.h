@@ -0,0 +1,121 @@
+/*
+	A single-producer/single-consumer queue is a fixed-size ring buffer
+	that one thread adds items to and one (other) thread removes items from
+
+	Neither thread takes a lock:
+	Each thread only writes its own index,
+	and each keeps a cached copy of the other thread's index
+	so that the shared index is only read when the cached one says that the queue is full (or empty).
+	The two indices are on different cache lines so that the threads don't slow each other down.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CSPSCQUEUE_H
+#define EAE6320_CONCURRENCY_CSPSCQUEUE_H
+
+// Include Files
+//==============
+
+#include "cQueueWaiter.h"
+#include "Constants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// The items must be default-constructible and move-assignable
+		// (every slot holds an item, and items are moved in and out of the slots)
+		template <typename tItem, size_t tCapacity>
+		class cSpscQueue
+		{
+			static_assert( ( tCapacity > 0 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Producer
+			//---------
+
+			// These must only be called by the producer thread.
+			// Push() returns false if the queue is full,
+			// and PushBatch() returns how many of the items were added (in order).
+			bool Push( tItem&& i_item );
+			bool Push( const tItem& i_item );
+			size_t PushBatch( tItem* const i_items, const size_t i_itemCount );
+
+			// Consumer
+			//---------
+
+			// These must only be called by the consumer thread.
+			// Pop() returns false if the queue is empty,
+			// and PopBatch() returns how many items were removed.
+			bool Pop( tItem& o_item );
+			size_t PopBatch( tItem* const o_items, const size_t i_maxItemCount );
+			// This requires the queue to have been initialized
+			// (see cQueueWaiter::Wait() for the results)
+			cResult WaitUntilNotEmpty( const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+
+			// Access
+			//-------
+
+			// This is only an estimate when called by a thread other than the consumer
+			bool IsEmpty() const;
+			static constexpr size_t GetCapacity() { return tCapacity; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// A queue can be used without being initialized
+			// except that the consumer can't wait for items
+			cResult Initialize() { return m_waiter.Initialize(); }
+			cResult CleanUp() { return m_waiter.CleanUp(); }
+
+			cSpscQueue() = default;
+
+			cSpscQueue( const cSpscQueue& ) = delete;
+			cSpscQueue& operator =( const cSpscQueue& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr size_t s_indexMask = tCapacity - 1;
+
+			// The indices only ever increase, and wrap around the ring by being masked
+			// (the queue is full when they are tCapacity apart)
+
+			// Consumer
+			alignas( 64 ) std::atomic<size_t> m_head{ 0 };
+			size_t m_cachedTail = 0;
+			// Producer
+			alignas( 64 ) std::atomic<size_t> m_tail{ 0 };
+			size_t m_cachedHead = 0;
+
+			alignas( 64 ) tItem m_items[tCapacity];
+
+			cQueueWaiter m_waiter;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// This returns how many slots the producer can fill
+			// (the consumer's index is only read if there are fewer than the wanted number)
+			size_t GetFreeSlotCount( const size_t i_tail, const size_t i_wantedSlotCount );
+		};
+	}
+}
+
+#include "cSpscQueue.inl"
+
+#endif	// EAE6320_CONCURRENCY_CSPSCQUEUE_H
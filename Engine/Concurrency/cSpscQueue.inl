@@ -0,0 +1,122 @@
+#ifndef EAE6320_CONCURRENCY_CSPSCQUEUE_INL
+#define EAE6320_CONCURRENCY_CSPSCQUEUE_INL
+
+// Include Files
+//==============
+
+#include "cSpscQueue.h"
+
+#include <utility>
+
+// Interface
+//==========
+
+// Producer
+//---------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::Push( tItem&& i_item )
+{
+	const auto tail = m_tail.load( std::memory_order_relaxed );
+	if ( GetFreeSlotCount( tail, 1 ) == 0 )
+	{
+		return false;
+	}
+	m_items[tail & s_indexMask] = std::move( i_item );
+	m_tail.store( tail + 1, std::memory_order_release );
+	m_waiter.NotifyIfWaiting();
+	return true;
+}
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::Push( const tItem& i_item )
+{
+	auto item = i_item;
+	return Push( std::move( item ) );
+}
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::PushBatch( tItem* const i_items, const size_t i_itemCount )
+{
+	const auto tail = m_tail.load( std::memory_order_relaxed );
+	const auto freeSlotCount = GetFreeSlotCount( tail, i_itemCount );
+	const auto itemCount = ( i_itemCount < freeSlotCount ) ? i_itemCount : freeSlotCount;
+	if ( itemCount == 0 )
+	{
+		return 0;
+	}
+	for ( size_t i = 0; i < itemCount; ++i )
+	{
+		m_items[( tail + i ) & s_indexMask] = std::move( i_items[i] );
+	}
+	// The whole batch is published at once
+	m_tail.store( tail + itemCount, std::memory_order_release );
+	m_waiter.NotifyIfWaiting();
+	return itemCount;
+}
+
+// Consumer
+//---------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::Pop( tItem& o_item )
+{
+	return PopBatch( &o_item, 1 ) == 1;
+}
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::PopBatch( tItem* const o_items, const size_t i_maxItemCount )
+{
+	const auto head = m_head.load( std::memory_order_relaxed );
+	if ( ( m_cachedTail - head ) < i_maxItemCount )
+	{
+		// The producer's index is only read when the cached one doesn't have enough items
+		m_cachedTail = m_tail.load( std::memory_order_acquire );
+	}
+	const auto availableItemCount = m_cachedTail - head;
+	const auto itemCount = ( i_maxItemCount < availableItemCount ) ? i_maxItemCount : availableItemCount;
+	if ( itemCount == 0 )
+	{
+		return 0;
+	}
+	for ( size_t i = 0; i < itemCount; ++i )
+	{
+		o_items[i] = std::move( m_items[( head + i ) & s_indexMask] );
+	}
+	// The slots are only given back to the producer after the items have been moved out
+	m_head.store( head + itemCount, std::memory_order_release );
+	return itemCount;
+}
+
+template <typename tItem, size_t tCapacity>
+	eae6320::cResult eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::WaitUntilNotEmpty( const unsigned int i_timeToWait_inMilliseconds )
+{
+	return m_waiter.Wait( [this]() { return !IsEmpty(); }, i_timeToWait_inMilliseconds );
+}
+
+// Access
+//-------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::IsEmpty() const
+{
+	return m_head.load( std::memory_order_relaxed ) == m_tail.load( std::memory_order_acquire );
+}
+
+// Implementation
+//===============
+
+template <typename tItem, size_t tCapacity>
+	size_t eae6320::Concurrency::cSpscQueue<tItem, tCapacity>::GetFreeSlotCount( const size_t i_tail, const size_t i_wantedSlotCount )
+{
+	auto freeSlotCount = tCapacity - ( i_tail - m_cachedHead );
+	if ( freeSlotCount < i_wantedSlotCount )
+	{
+		// The consumer's index is only read when the cached one doesn't have enough free slots
+		m_cachedHead = m_head.load( std::memory_order_acquire );
+		freeSlotCount = tCapacity - ( i_tail - m_cachedHead );
+	}
+	return freeSlotCount;
+}
+
+#endif	// EAE6320_CONCURRENCY_CSPSCQUEUE_INL
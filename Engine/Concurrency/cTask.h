@@ -0,0 +1,176 @@
+/*
+	A task is a coroutine that eventually produces a result
+
+	Tasks let a chain of asynchronous steps (e.g. read a file, parse it, create GPU objects, notify the game)
+	be written as straight-line code that never blocks a thread:
+	Every step that would have waited co_awaits instead,
+	and the coroutine is resumed by whichever thread finishes the step.
+
+	A task doesn't start until it is awaited (or started with StartTask() or WaitForTask()),
+	and a task that awaits another task is resumed once that task has finished.
+	The result can be any default-constructible, movable type,
+	and most tasks return a cResult so that the usual error handling still works:
+		cTask<cResult> LoadSomething()
+		{
+			auto result = Results::Success;
+			if ( !( result = co_await LoadSomethingElse() ) )
+			{
+				goto OnExit;
+			}
+			...
+		OnExit:
+			co_return result;
+		}
+
+	Coroutines must be enabled for every file that includes this header
+	(with Visual Studio 2017 that means compiling with /await).
+*/
+
+#ifndef EAE6320_CONCURRENCY_CTASK_H
+#define EAE6320_CONCURRENCY_CTASK_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <Engine/Results/Results.h>
+#include <utility>
+
+#if defined( __cpp_impl_coroutine )
+	#include <coroutine>
+
+	namespace eae6320 { namespace Concurrency { namespace CoroutineLibrary = ::std; } }
+#elif defined( __cpp_coroutines ) || defined( _RESUMABLE_FUNCTIONS_SUPPORTED )
+	#include <experimental/coroutine>
+
+	namespace eae6320 { namespace Concurrency { namespace CoroutineLibrary = ::std::experimental; } }
+#else
+	#error "Coroutines must be enabled to use tasks (e.g. by compiling with /await)"
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		template <typename tResult = cResult>
+		class cTask
+		{
+			// Interface
+			//==========
+
+		public:
+
+			class cPromise;
+			using promise_type = cPromise;
+
+			// Awaiting
+			//---------
+
+			// These are called by co_await
+			// (a task can only be awaited once, and the result is moved out)
+			bool await_ready() const noexcept;
+			bool await_suspend( CoroutineLibrary::coroutine_handle<> i_awaitingCoroutine );
+			tResult await_resume();
+
+			// Access
+			//-------
+
+			bool IsValid() const { return static_cast<bool>( m_coroutine ); }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cTask( cTask&& io_task ) noexcept;
+			cTask& operator =( cTask&& io_task ) noexcept;
+			~cTask();
+
+			cTask( const cTask& ) = delete;
+			cTask& operator =( const cTask& ) = delete;
+
+			// Promise
+			//========
+
+			// The promise is the part of the coroutine's state that the task uses
+			// to store its result and to resume whatever was awaiting it
+			class cPromise
+			{
+			public:
+
+				struct sFinalAwaiter
+				{
+					bool await_ready() const noexcept { return false; }
+					void await_suspend( CoroutineLibrary::coroutine_handle<cPromise> i_coroutine ) noexcept;
+					void await_resume() const noexcept {}
+				};
+
+				cTask get_return_object();
+				CoroutineLibrary::suspend_always initial_suspend() noexcept { return {}; }
+				sFinalAwaiter final_suspend() noexcept { return {}; }
+				void return_value( tResult i_result ) { m_result = std::move( i_result ); }
+				// Engine code doesn't use exceptions
+				void unhandled_exception();
+
+			private:
+
+				friend class cTask;
+
+				tResult m_result;
+				CoroutineLibrary::coroutine_handle<> m_awaitingCoroutine;
+				// Whichever of the awaiting coroutine suspending and the task finishing happens second sets this
+				// (if the task finishes first the awaiting coroutine doesn't suspend at all,
+				// and otherwise the task resumes it)
+				std::atomic<bool> m_hasOtherSideFinished{ false };
+			};
+
+			// Data
+			//=====
+
+		private:
+
+			CoroutineLibrary::coroutine_handle<cPromise> m_coroutine;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+		private:
+
+			explicit cTask( const CoroutineLibrary::coroutine_handle<cPromise> i_coroutine ) : m_coroutine( i_coroutine ) {}
+		};
+
+		// Starting
+		//---------
+
+		// The task is started on the calling thread and nothing waits for it.
+		// The callback (if there is one) is called with the result by whichever thread finishes the task.
+		template <typename tResult, typename fOnCompletion>
+			void StartTask( cTask<tResult>&& i_task, fOnCompletion&& i_onCompletion );
+		template <typename tResult>
+			void StartTask( cTask<tResult>&& i_task );
+
+		// The task is started on the calling thread, and the calling thread is blocked until the task finishes.
+		// This is meant for code that isn't a coroutine itself (e.g. the top level of a loading screen),
+		// and it must not be called from a job (because the task might need that worker to finish).
+		template <typename tResult>
+			tResult WaitForTask( cTask<tResult>&& i_task );
+
+		// Switching Threads
+		//------------------
+
+		// Awaiting this resumes the coroutine on one of the job system's worker threads
+		// (or immediately if the job system hasn't been initialized)
+		struct sResumeOnJobSystem
+		{
+			bool await_ready() const noexcept { return false; }
+			void await_suspend( CoroutineLibrary::coroutine_handle<> i_coroutine );
+			void await_resume() const noexcept {}
+		};
+		inline sResumeOnJobSystem ResumeOnJobSystem() { return {}; }
+	}
+}
+
+#include "cTask.inl"
+
+#endif	// EAE6320_CONCURRENCY_CTASK_H
@@ -0,0 +1,190 @@
+#ifndef EAE6320_CONCURRENCY_CTASK_INL
+#define EAE6320_CONCURRENCY_CTASK_INL
+
+// Include Files
+//==============
+
+#include "cTask.h"
+
+#include "cEvent.h"
+#include "JobSystem.h"
+
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <type_traits>
+
+// Helper Class Declaration
+//=========================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace TaskImplementation
+		{
+			// A detached coroutine starts immediately and destroys itself when it finishes
+			// (it is what lets a task be started without anything awaiting it)
+			struct sDetachedCoroutine
+			{
+				struct promise_type
+				{
+					sDetachedCoroutine get_return_object() { return {}; }
+					CoroutineLibrary::suspend_never initial_suspend() noexcept { return {}; }
+					CoroutineLibrary::suspend_never final_suspend() noexcept { return {}; }
+					void return_void() {}
+					void unhandled_exception() { std::abort(); }
+				};
+			};
+
+			template <typename tResult, typename fOnCompletion>
+				sDetachedCoroutine RunDetached( cTask<tResult> i_task, fOnCompletion i_onCompletion )
+			{
+				i_onCompletion( co_await i_task );
+			}
+		}
+	}
+}
+
+// Interface
+//==========
+
+// Awaiting
+//---------
+
+template <typename tResult>
+	bool eae6320::Concurrency::cTask<tResult>::await_ready() const noexcept
+{
+	EAE6320_ASSERTF( m_coroutine, "An invalid task can't be awaited" );
+	return m_coroutine.done();
+}
+
+template <typename tResult>
+	bool eae6320::Concurrency::cTask<tResult>::await_suspend( CoroutineLibrary::coroutine_handle<> i_awaitingCoroutine )
+{
+	auto& promise = m_coroutine.promise();
+	promise.m_awaitingCoroutine = i_awaitingCoroutine;
+	// Tasks don't start until they are awaited
+	m_coroutine.resume();
+	// If the task has already finished the awaiting coroutine continues without suspending
+	// (and otherwise the task will resume it when it finishes)
+	return !promise.m_hasOtherSideFinished.exchange( true, std::memory_order_acq_rel );
+}
+
+template <typename tResult>
+	tResult eae6320::Concurrency::cTask<tResult>::await_resume()
+{
+	return std::move( m_coroutine.promise().m_result );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template <typename tResult>
+	eae6320::Concurrency::cTask<tResult>::cTask( cTask&& io_task ) noexcept
+	:
+	m_coroutine( io_task.m_coroutine )
+{
+	io_task.m_coroutine = nullptr;
+}
+
+template <typename tResult>
+	eae6320::Concurrency::cTask<tResult>& eae6320::Concurrency::cTask<tResult>::operator =( cTask&& io_task ) noexcept
+{
+	if ( this != &io_task )
+	{
+		if ( m_coroutine )
+		{
+			m_coroutine.destroy();
+		}
+		m_coroutine = io_task.m_coroutine;
+		io_task.m_coroutine = nullptr;
+	}
+	return *this;
+}
+
+template <typename tResult>
+	eae6320::Concurrency::cTask<tResult>::~cTask()
+{
+	// A task that was started must have finished before it is destroyed
+	// (which is always true when the task is destroyed by the coroutine that awaited it)
+	if ( m_coroutine )
+	{
+		m_coroutine.destroy();
+	}
+}
+
+// Promise
+//--------
+
+template <typename tResult>
+	eae6320::Concurrency::cTask<tResult> eae6320::Concurrency::cTask<tResult>::cPromise::get_return_object()
+{
+	return cTask( CoroutineLibrary::coroutine_handle<cPromise>::from_promise( *this ) );
+}
+
+template <typename tResult>
+	void eae6320::Concurrency::cTask<tResult>::cPromise::unhandled_exception()
+{
+	EAE6320_ASSERTF( false, "An exception escaped from a task" );
+	std::abort();
+}
+
+template <typename tResult>
+	void eae6320::Concurrency::cTask<tResult>::cPromise::sFinalAwaiter::await_suspend( CoroutineLibrary::coroutine_handle<cPromise> i_coroutine ) noexcept
+{
+	auto& promise = i_coroutine.promise();
+	// If the awaiting coroutine has already suspended it must be resumed
+	// (and otherwise it will see that the task has finished and won't suspend)
+	if ( promise.m_hasOtherSideFinished.exchange( true, std::memory_order_acq_rel ) )
+	{
+		promise.m_awaitingCoroutine.resume();
+	}
+}
+
+// Starting
+//---------
+
+template <typename tResult, typename fOnCompletion>
+	void eae6320::Concurrency::StartTask( cTask<tResult>&& i_task, fOnCompletion&& i_onCompletion )
+{
+	TaskImplementation::RunDetached( std::move( i_task ), std::forward<fOnCompletion>( i_onCompletion ) );
+}
+
+template <typename tResult>
+	void eae6320::Concurrency::StartTask( cTask<tResult>&& i_task )
+{
+	StartTask( std::move( i_task ), []( tResult ) {} );
+}
+
+template <typename tResult>
+	tResult eae6320::Concurrency::WaitForTask( cTask<tResult>&& i_task )
+{
+	EAE6320_ASSERTF( !JobSystem::IsWorkerThread(), "A job can't block waiting for a task" );
+	tResult result;
+	cEvent whenTaskHasFinished;
+	{
+		const auto localResult = whenTaskHasFinished.Initialize( EventType::RemainSignaledUntilReset );
+		EAE6320_ASSERT( localResult );
+	}
+	StartTask( std::move( i_task ),
+		[&result, &whenTaskHasFinished]( tResult i_result )
+		{
+			result = std::move( i_result );
+			whenTaskHasFinished.Signal();
+		} );
+	{
+		const auto localResult = WaitForEvent( whenTaskHasFinished );
+		EAE6320_ASSERT( localResult );
+	}
+	return result;
+}
+
+// Switching Threads
+//------------------
+
+inline void eae6320::Concurrency::sResumeOnJobSystem::await_suspend( CoroutineLibrary::coroutine_handle<> i_coroutine )
+{
+	JobSystem::Run( [i_coroutine]() { i_coroutine.resume(); } );
+}
+
+#endif	// EAE6320_CONCURRENCY_CTASK_INL
@@ -12,11 +12,15 @@
 
 #include "Constants.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <Engine/Results/Results.h>
 #include <functional>
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_POSIX )
+	#include <pthread.h>
 #endif
 
 // Forward Declarations
@@ -27,6 +31,51 @@ namespace eae6320
 	namespace Concurrency
 	{
 		class cThread;
+
+		// This is declared here so that it can have a default argument
+		// (a friend declaration can't, and so the class only names it as a friend)
+		cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+	}
+}
+
+// Constants
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// A thread's priority is relative to the other threads in the process
+		enum class eThreadPriority : uint8_t
+		{
+			Lowest,
+			BelowNormal,
+			Normal,
+			AboveNormal,
+			Highest
+		};
+	}
+}
+
+// Options
+//========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		struct sThreadOptions
+		{
+			// The name is shown in debuggers and profilers
+			// (it is copied, and so it only has to be valid while the thread is being started)
+			const char* name = nullptr;
+			eThreadPriority priority = eThreadPriority::Normal;
+			// Each bit is a logical processor that the thread is allowed to run on
+			// (zero lets the operating system choose)
+			uint64_t affinityMask = 0;
+			// Zero uses the platform's default stack size
+			size_t stackSize_inBytes = 0;
+		};
 	}
 }
 
@@ -51,7 +100,8 @@ namespace eae6320
 		public:
 
 			// Calling this function will cause the specified function to be called in a new thread with the specified user data as input
-			cResult Start( fThreadFunction const i_threadFunction, void* const io_userData = nullptr );
+			// (the options are applied before the function is called)
+			cResult Start( fThreadFunction const i_threadFunction, void* const io_userData = nullptr, const sThreadOptions& i_options = sThreadOptions() );
 
 			// This function will return as soon as any one of the following happens:
 			//	* The thread stops
@@ -60,7 +110,7 @@ namespace eae6320
 			//	* The specified time-out period elapses
 			//		* If the caller doesn't specify a time-out period then the function will never return until the thread stops
 			//		* If the caller specifies a time-out period of zero then the function will return immediately
-			friend cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+			friend cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds );
 
 			// Initialization / Clean Up
 			//--------------------------
@@ -75,6 +125,9 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HANDLE m_handle = NULL;
+#elif defined( EAE6320_PLATFORM_POSIX )
+			pthread_t m_thread;
+			bool m_isRunning = false;
 #endif
 
 			// Implementation
@@ -88,4 +141,26 @@ namespace eae6320
 	}
 }
 
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// Threads that weren't started by a cThread (e.g. the main thread) can be given options this way
+		// (the stack size can't be changed and is ignored)
+		cResult ApplyOptionsToCurrentThread( const sThreadOptions& i_options );
+
+		// Processor Topology
+		//-------------------
+
+		// Logical processors that share a physical core (e.g. with hyper-threading) are only counted once
+		unsigned int GetPhysicalCoreCount();
+		// This returns the mask of every logical processor that belongs to the physical core
+		// (which can be used as a thread's affinity mask)
+		uint64_t GetPhysicalCoreAffinityMask( const unsigned int i_coreIndex );
+	}
+}
+
 #endif	// EAE6320_CONCURRENCY_CTHREAD_H
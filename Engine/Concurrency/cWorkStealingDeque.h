@@ -0,0 +1,90 @@
+/*
+	A work-stealing deque is a fixed-size double-ended queue with a single owner
+
+	This is the Chase-Lev deque:
+		* The thread that owns the deque pushes and pops items at the bottom (last in, first out)
+		* Any other thread can steal items from the top (first in, first out)
+	Neither end takes a lock:
+	The owner only has to synchronize with thieves when there is a single item left,
+	and so the common case of a thread pushing and popping its own work is cheap.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_H
+#define EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// The items are copied in and out of atomics
+		// and so they should be small (e.g. pointers to jobs)
+		template <typename tItem, size_t tCapacity>
+		class cWorkStealingDeque
+		{
+			static_assert( ( tCapacity > 0 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two" );
+			static_assert( std::is_trivially_copyable<tItem>::value, "The items must be trivially copyable" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Owner
+			//------
+
+			// These must only be called by the thread that owns the deque.
+			// Push() returns false if the deque is full.
+			bool Push( const tItem i_item );
+			bool Pop( tItem& o_item );
+
+			// Thieves
+			//--------
+
+			// This can be called by any thread.
+			// It returns false if the deque was empty or if another thread took the item first.
+			bool Steal( tItem& o_item );
+
+			// Access
+			//-------
+
+			// This is only an estimate when other threads are using the deque
+			bool IsEmpty() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cWorkStealingDeque() = default;
+
+			cWorkStealingDeque( const cWorkStealingDeque& ) = delete;
+			cWorkStealingDeque& operator =( const cWorkStealingDeque& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr int64_t s_indexMask = static_cast<int64_t>( tCapacity - 1 );
+
+			// The top and the bottom are changed by different threads
+			// and so they are kept on different cache lines
+			alignas( 64 ) std::atomic<int64_t> m_top{ 0 };
+			alignas( 64 ) std::atomic<int64_t> m_bottom{ 0 };
+			alignas( 64 ) std::atomic<tItem> m_items[tCapacity];
+		};
+	}
+}
+
+#include "cWorkStealingDeque.inl"
+
+#endif	// EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_H
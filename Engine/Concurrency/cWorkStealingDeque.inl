@@ -0,0 +1,84 @@
+#ifndef EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_INL
+#define EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_INL
+
+// Include Files
+//==============
+
+#include "cWorkStealingDeque.h"
+
+// Interface
+//==========
+
+// Owner
+//------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cWorkStealingDeque<tItem, tCapacity>::Push( const tItem i_item )
+{
+	const auto bottom = m_bottom.load( std::memory_order_relaxed );
+	const auto top = m_top.load( std::memory_order_acquire );
+	if ( ( bottom - top ) >= static_cast<int64_t>( tCapacity ) )
+	{
+		return false;
+	}
+	m_items[bottom & s_indexMask].store( i_item, std::memory_order_relaxed );
+	// The item must be visible before a thief can see the new bottom
+	m_bottom.store( bottom + 1, std::memory_order_release );
+	return true;
+}
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cWorkStealingDeque<tItem, tCapacity>::Pop( tItem& o_item )
+{
+	// The bottom is reserved before the top is read
+	// so that a thief can't take the same item without noticing
+	const auto bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+	m_bottom.store( bottom, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	auto top = m_top.load( std::memory_order_relaxed );
+	if ( top > bottom )
+	{
+		// The deque was empty
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return false;
+	}
+	o_item = m_items[bottom & s_indexMask].load( std::memory_order_relaxed );
+	if ( top < bottom )
+	{
+		// There was more than one item and so no thief can be taking this one
+		return true;
+	}
+	// This was the last item, and so a thief might be trying to steal it
+	// (whoever moves the top first gets it)
+	const auto didPopItem = m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+	m_bottom.store( bottom + 1, std::memory_order_relaxed );
+	return didPopItem;
+}
+
+// Thieves
+//--------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cWorkStealingDeque<tItem, tCapacity>::Steal( tItem& o_item )
+{
+	auto top = m_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	const auto bottom = m_bottom.load( std::memory_order_acquire );
+	if ( top >= bottom )
+	{
+		return false;
+	}
+	o_item = m_items[top & s_indexMask].load( std::memory_order_relaxed );
+	return m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+}
+
+// Access
+//-------
+
+template <typename tItem, size_t tCapacity>
+	bool eae6320::Concurrency::cWorkStealingDeque<tItem, tCapacity>::IsEmpty() const
+{
+	return m_bottom.load( std::memory_order_relaxed ) <= m_top.load( std::memory_order_relaxed );
+}
+
+#endif	// EAE6320_CONCURRENCY_CWORKSTEALINGDEQUE_INL
@@ -41,7 +41,8 @@ void eae6320::Graphics::cTexture::Bind( const unsigned int i_id ) const
 // Initialization / Clean Up
 //--------------------------
 
-eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_path, const void* const i_textureData, const size_t i_textureDataSize )
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_path, const void* const i_textureData, const size_t i_textureDataSize,
+	const uint_fast8_t i_mostDetailedMipLevel )
 {
 	auto result = Results::Success;
 
@@ -50,64 +51,61 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 
 	ID3D11Texture2D* resource = nullptr;
 	D3D11_SUBRESOURCE_DATA* subResourceData = nullptr;
+	// A new view is created rather than changing the existing one
+	// so that the existing one can still be used if anything goes wrong
+	ID3D11ShaderResourceView* textureView = nullptr;
 
-	// Allocate data for a "subresource" for each MIP level
+	// Allocate data for a "subresource" for each resident MIP level
 	// (Subresources are the way that Direct3D deals with textures that act like a single resource
 	// but that actually have multiple textures associated with that single resource
 	// (e.g. MIP maps, volume textures, texture arrays))
 	const auto mipMapCount = static_cast<uint_fast8_t>( m_info.mipMapCount );
+	const auto residentMipMapCount = static_cast<uint_fast8_t>( mipMapCount - i_mostDetailedMipLevel );
 	{
-		subResourceData = new (std::nothrow) D3D11_SUBRESOURCE_DATA[mipMapCount];
+		subResourceData = new (std::nothrow) D3D11_SUBRESOURCE_DATA[residentMipMapCount];
 		if ( !subResourceData )
 		{
 			result = Results::OutOfMemory;
-			EAE6320_ASSERTF( false, "Couldn't allocate an array of %u subresource data structs", mipMapCount );
+			EAE6320_ASSERTF( false, "Couldn't allocate an array of %u subresource data structs", residentMipMapCount );
 			Logging::OutputError( "Failed to allocate an array of %u subresource data structs for the texture %s",
-				mipMapCount, i_path );
+				residentMipMapCount, i_path );
 			goto OnExit;
 		}
 	}
 	// Fill in the data for each MIP level
-	const auto width = static_cast<uint_fast16_t>( m_info.width );
-	const auto height = static_cast<uint_fast16_t>( m_info.height );
+	// (the data is stored from the least detailed MIP level to the most detailed,
+	// and the most detailed resident MIP level becomes subresource 0 of the new texture)
+	const auto width = std::max( static_cast<uint_fast16_t>( m_info.width >> i_mostDetailedMipLevel ), static_cast<uint_fast16_t>( 1u ) );
+	const auto height = std::max( static_cast<uint_fast16_t>( m_info.height >> i_mostDetailedMipLevel ), static_cast<uint_fast16_t>( 1u ) );
 	{
-		auto currentWidth = width;
-		auto currentHeight = height;
 		auto currentOffset = reinterpret_cast<uintptr_t>( i_textureData );
 		const auto finalOffset = currentOffset + i_textureDataSize;
 		const auto blockSize = TextureFormats::Compression::GetSizeOfBlock( m_info.compressionType );
-		for ( uint_fast8_t i = 0; i < mipMapCount; ++i )
+		for ( auto i = mipMapCount; i > i_mostDetailedMipLevel; --i )
 		{
+			const auto mipLevel = static_cast<uint_fast8_t>( i - 1 );
+			const auto currentWidth = std::max( static_cast<uint_fast16_t>( m_info.width >> mipLevel ), static_cast<uint_fast16_t>( 1u ) );
 			// Calculate how much memory this MIP level uses
 			const auto blockCount_singleRow = ( currentWidth + 3 ) / 4;
 			const auto byteCount_singleRow = blockCount_singleRow * blockSize;
-			const auto rowCount = ( currentHeight + 3 ) / 4;
-			const auto byteCount_currentMipLevel = byteCount_singleRow * rowCount;
+			const auto byteCount_currentMipLevel = TextureFormats::GetSizeOfMipMap( m_info, mipLevel );
+			if ( ( currentOffset + byteCount_currentMipLevel ) > finalOffset )
+			{
+				result = Results::InvalidFile;
+				EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%u",
+					i_path, mipLevel );
+				Logging::OutputError( "The texture file %s is too small to contain MIP map #%u",
+					i_path, mipLevel );
+				goto OnExit;
+			}
 			// Set the data into the subresource
 			{
-				auto& currentSubResourceData = subResourceData[i];
+				auto& currentSubResourceData = subResourceData[mipLevel - i_mostDetailedMipLevel];
 				currentSubResourceData.pSysMem = reinterpret_cast<void*>( currentOffset );
 				currentSubResourceData.SysMemPitch = static_cast<unsigned int>( byteCount_singleRow );
 				currentSubResourceData.SysMemSlicePitch = static_cast<unsigned int>( byteCount_currentMipLevel );
 			}
-			// Update current data for next iteration
-			{
-				currentOffset += byteCount_currentMipLevel;
-				if ( currentOffset <= finalOffset )
-				{
-					currentWidth = std::max( currentWidth / 2, 1u );
-					currentHeight = std::max( currentHeight / 2, 1u );
-				}
-				else
-				{
-					result = Results::InvalidFile;
-					EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%u",
-						i_path, i );
-					Logging::OutputError( "The texture file %s is too small to contain MIP map #%u",
-						i_path, i );
-					goto OnExit;
-				}
-			}
+			currentOffset += byteCount_currentMipLevel;
 		}
 		EAE6320_ASSERTF( currentOffset == finalOffset, "The texture file %s has more texture data (%u) than it should (%u)",
 			i_path, finalOffset, currentOffset );
@@ -119,7 +117,7 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 		{
 			textureDescription.Width = static_cast<unsigned int>( width );
 			textureDescription.Height = static_cast<unsigned int>( height );
-			textureDescription.MipLevels = static_cast<unsigned int>( mipMapCount );
+			textureDescription.MipLevels = static_cast<unsigned int>( residentMipMapCount );
 			textureDescription.ArraySize = 1;
 			textureDescription.Format = dxgiFormat;
 			{
@@ -127,7 +125,10 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 				sampleDescription.Count = 1;	// No multisampling
 				sampleDescription.Quality = 0;	// Doesn't matter when Count is 1
 			}
-			textureDescription.Usage = D3D11_USAGE_IMMUTABLE;	// The texture will never change once it's been created
+			// The resource never changes once it's been created
+			// (when different MIP levels become resident a new resource is created
+			// so that the memory of evicted MIP levels is actually freed)
+			textureDescription.Usage = D3D11_USAGE_IMMUTABLE;
 			textureDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 			textureDescription.CPUAccessFlags = 0;	// No CPU access is necessary
 			textureDescription.MiscFlags = 0;
@@ -153,7 +154,7 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 				shaderResourceView2dDescription.MipLevels = -1;	// Use all MIP levels
 			}
 		}
-		const auto d3dResult = direct3dDevice->CreateShaderResourceView( resource, &shaderResourceViewDescription, &m_textureView );
+		const auto d3dResult = direct3dDevice->CreateShaderResourceView( resource, &shaderResourceViewDescription, &textureView );
 		if ( FAILED( d3dResult ) )
 		{
 			result = Results::Failure;
@@ -162,9 +163,24 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 			goto OnExit;
 		}
 	}
+	// Replace the existing view
+	{
+		if ( !( result = CleanUpTexture() ) )
+		{
+			goto OnExit;
+		}
+		m_textureView = textureView;
+		textureView = nullptr;
+		m_mostDetailedResidentMipLevel = static_cast<uint8_t>( i_mostDetailedMipLevel );
+	}
 
 OnExit:
 
+	if ( textureView )
+	{
+		textureView->Release();
+		textureView = nullptr;
+	}
 	// The texture resource is always released, even on success
 	// (the view will hold its own reference to the resource)
 	if ( resource )
@@ -205,6 +221,9 @@ namespace
 		{
 			case eae6320::Graphics::TextureFormats::Compression::BC1: return DXGI_FORMAT_BC1_UNORM;
 			case eae6320::Graphics::TextureFormats::Compression::BC3: return DXGI_FORMAT_BC3_UNORM;
+			case eae6320::Graphics::TextureFormats::Compression::BC4: return DXGI_FORMAT_BC4_UNORM;
+			case eae6320::Graphics::TextureFormats::Compression::BC5: return DXGI_FORMAT_BC5_UNORM;
+			case eae6320::Graphics::TextureFormats::Compression::BC7: return DXGI_FORMAT_BC7_UNORM;
 		}
 
 		// Other formats are possible, but not for our class
@@ -4,8 +4,45 @@
 #include "Effect.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cPathId.h>
+#include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <new> // This library is needed for std::nothrow
+#include <unordered_map>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Loaded effects are identified by their interned shader file names and their render state bits
+	// (the vertex and fragment shaders are in different directories,
+	// and so the file names are enough to identify the shaders)
+	struct sEffectKey
+	{
+		eae6320::Assets::cPathId vertexShader;
+		eae6320::Assets::cPathId fragmentShader;
+		uint8_t renderStateBits;
+
+		bool operator ==(const sEffectKey& i_other) const
+		{
+			return (vertexShader == i_other.vertexShader) && (fragmentShader == i_other.fragmentShader)
+				&& (renderStateBits == i_other.renderStateBits);
+		}
+	};
+	struct sEffectKeyHasher
+	{
+		size_t operator ()(const sEffectKey& i_key) const
+		{
+			// The paths were hashed when they were interned
+			return static_cast<size_t>((i_key.vertexShader.GetHash() * 0x100000001b3) ^ i_key.fragmentShader.GetHash() ^ i_key.renderStateBits);
+		}
+	};
+	std::unordered_map<sEffectKey, eae6320::Graphics::Effect*, sEffectKeyHasher> s_loadedEffects;
+	// The mutex is held while an effect is being created or destroyed
+	// so that two threads can't both create the same effect
+	eae6320::Concurrency::cMutex s_loadedEffectsMutex{ "Graphics::Effect" };
+}
 
 eae6320::Graphics::Effect::Effect()
 {
@@ -22,6 +59,21 @@ eae6320::cResult eae6320::Graphics::Effect::Load(const char * i_vertexShaderFile
 	cResult result = Results::Success;
 	Effect * effect = nullptr;
 
+	const sEffectKey key{ Assets::cPathId::Intern(i_vertexShaderFileName), Assets::cPathId::Intern(i_fragmentShaderFileName), i_RenderState };
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedEffectsMutex);
+
+	// Share an effect that has already been loaded
+	{
+		const auto iterator = s_loadedEffects.find(key);
+		if (iterator != s_loadedEffects.end())
+		{
+			effect = iterator->second;
+			effect->IncrementReferenceCount();
+			o_effect = effect;
+			return result;
+		}
+	}
+
 	effect = new (std::nothrow) Effect();
 
 	// Allocate a new Effect
@@ -46,12 +98,15 @@ OnExit:
 	if (result)
 	{
 		EAE6320_ASSERT(effect);
+		s_loadedEffects.insert(std::make_pair(key, effect));
 		o_effect = effect;
 	}
 	else
 	{
 		if (effect)
 		{
+			// Release any shaders and render state that were loaded before the failure
+			effect->CleanUpShadingData();
 			effect->DecrementReferenceCount();
 			effect = nullptr;
 		}
@@ -63,6 +118,27 @@ OnExit:
 eae6320::cResult eae6320::Graphics::Effect::CleanUp()
 {
 	cResult result = Results::Success;
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedEffectsMutex);
+	// The shading data is only cleaned up when the last reference to a shared effect is released
+	if (m_referenceCount > 1)
+	{
+		this->DecrementReferenceCount();
+		return result;
+	}
+	// There are only ever a few effects loaded,
+	// and so searching for this one is cheaper than storing its key
+	{
+		auto iterator = s_loadedEffects.begin();
+		while ((iterator != s_loadedEffects.end()) && (iterator->second != this))
+		{
+			++iterator;
+		}
+		EAE6320_ASSERT(iterator != s_loadedEffects.end());
+		if (iterator != s_loadedEffects.end())
+		{
+			s_loadedEffects.erase(iterator);
+		}
+	}
 	if (result = CleanUpShadingData())
 		this->DecrementReferenceCount();
 	else
@@ -71,4 +147,10 @@ eae6320::cResult eae6320::Graphics::Effect::CleanUp()
 		Logging::OutputError("Failed to clean up shading data");
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+unsigned int eae6320::Graphics::Effect::GetLoadedEffectCount()
+{
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedEffectsMutex);
+	return static_cast<unsigned int>(s_loadedEffects.size());
+}
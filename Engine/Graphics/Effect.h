@@ -30,8 +30,15 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
+			// Effects are shared:
+			// Loading an effect with the same shaders and render state as an effect that is already loaded
+			// returns the existing effect (with its reference count incremented)
+			// instead of compiling and linking the same shaders again.
+			// Every successful call to Load() must be matched by a call to CleanUp().
 			static cResult Load(const char * i_vertexShaderFileName, const char * i_fragmentShaderFileName, const uint8_t i_RenderState, Effect *& o_effect);
 			cResult CleanUp();
+			// This returns the number of distinct effects that are currently loaded
+			static unsigned int GetLoadedEffectCount();
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(Effect)
 
@@ -70,7 +77,8 @@ namespace eae6320
 			GLuint s_programId = 0;
 #endif
 
-			Graphics::cRenderState s_renderState;
+			// Render states are shared between every effect that uses the same bits
+			const Graphics::cRenderState * s_renderState = nullptr;
 
 			// Reference counting
 			//===================
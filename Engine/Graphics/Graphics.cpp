@@ -16,9 +16,14 @@
 #include "Mesh.h"
 #include "GraphicsHandler.h"
 #include "Graphics.h"
+#include "TextureStreaming.h"
 
+#include <cmath>
+#include <Engine/Assets/AsyncLoading.h>
+#include <Engine/Concurrency/BackgroundThrottling.h>
 #include <Engine/Concurrency/cEvent.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
 #include <Engine/UserOutput/UserOutput.h>
 
 namespace
@@ -60,6 +65,18 @@ namespace
 	// and the application loop thread can start submitting data for the following frame
 	// (the application loop thread waits for the signal)
 	eae6320::Concurrency::cEvent s_whenDataForANewFrameCanBeSubmittedFromApplicationThread;
+
+	// The resolution height is used to estimate how big things will be on screen
+	uint16_t s_resolutionHeight = 0;
+
+	// Returns approximately how many pixels a mesh will cover vertically on screen
+	// (this is used to decide which MIP levels of its texture need to be resident)
+	float CalculateProjectedSizeInPixels(const eae6320::Graphics::DataSetForRenderingMesh & i_meshData);
+
+	// Unloads every asset that a manager's retention cache is keeping
+	// and reports how often the cache was able to avoid loading an asset again
+	template <class tAsset>
+	eae6320::cResult FlushRetentionCache(eae6320::Assets::cManager<tAsset> & io_manager, const char * const i_assetTypeName);
 }
 
 void eae6320::Graphics::SubmitElapsedTime(const float i_elapsedSecondCount_systemTime, const float i_elapsedSecondCount_simulationTime)
@@ -174,6 +191,8 @@ void eae6320::Graphics::RenderFrame()
 	}
 
 	EAE6320_ASSERT(s_dataBeingRenderedByRenderThread);
+	// The time spent waiting for the application loop isn't part of the render thread's work
+	const auto tickCount_whenWorkStarted = Time::GetCurrentSystemTimeTickCount();
 	// Update color for next frame
 	{
 		const Color cachedColor = s_dataBeingRenderedByRenderThread->cachedColorForRenderingInNextFrame;
@@ -200,7 +219,7 @@ void eae6320::Graphics::RenderFrame()
 	constexpr unsigned int defaultTextureID = 0;
 
 	// Sort objects with translucent effect based on camera distance
-	s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame = SelectionSortMeshForRenderingBasedOnDistanceToCamera(s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame);
+	SelectionSortMeshForRenderingBasedOnDistanceToCamera(s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame);
 
 	// Bind shading data and draw opaque mesh
 	{
@@ -211,6 +230,8 @@ void eae6320::Graphics::RenderFrame()
 			s_constantBuffer_perDrawCall.Update(&constantData_perDrawCall);
 
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->BindShadingData();
+			TextureStreaming::RequestMipLevels(*s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].texture,
+				CalculateProjectedSizeInPixels(s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i]));
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].texture->Bind(defaultTextureID);
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].mesh->DrawMesh();
 		}
@@ -225,6 +246,8 @@ void eae6320::Graphics::RenderFrame()
 			s_constantBuffer_perDrawCall.Update(&constantData_perDrawCall);
 
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->BindShadingData();
+			TextureStreaming::RequestMipLevels(*s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].texture,
+				CalculateProjectedSizeInPixels(s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i]));
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].texture->Bind(defaultTextureID);
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].mesh->DrawMesh();
 		}
@@ -235,11 +258,21 @@ void eae6320::Graphics::RenderFrame()
 		for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame.size(); i++)
 		{
 			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->BindShadingData();
+			// Sprites are drawn in screen space, and so they conservatively request enough detail to cover the whole screen
+			TextureStreaming::RequestMipLevels(*s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].texture,
+				static_cast<float>(s_resolutionHeight));
 			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].texture->Bind(defaultTextureID);
 			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->DrawGeometry();
 		}
 	}
 
+	// Queue the upload of any texture MIP levels that have been streamed in
+	// and request the ones that the draw calls in this frame needed
+	TextureStreaming::Update();
+	// Create any assets that have finished loading in the background
+	// and run as many queued uploads as this frame's budget allows
+	Assets::AsyncLoading::RunRenderThreadJobs();
+
 	// Once everything has been drawn the data that was submitted for this frame
 	// should be cleaned up and cleared.
 	// so that the struct can be re-used (i.e. so that data for a new frame can be submitted to it)
@@ -247,8 +280,8 @@ void eae6320::Graphics::RenderFrame()
 		{
 			for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame.size(); i++)
 			{
-				s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
-				s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->DecrementReferenceCount();
+				s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->CleanUp();
+				s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->CleanUp();
 				s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 			}
 		}
@@ -262,7 +295,7 @@ void eae6320::Graphics::RenderFrame()
 		{
 			for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame.size(); i++)
 			{
-				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->CleanUp();
 				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 			}
@@ -277,7 +310,7 @@ void eae6320::Graphics::RenderFrame()
 		{
 			for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame.size(); i++)
 			{
-				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->CleanUp();
 				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 				s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 			}
@@ -285,6 +318,11 @@ void eae6320::Graphics::RenderFrame()
 		s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame.clear();
 	}
 
+	// Report how long this frame's work took
+	// (before presenting it, which can wait for the display)
+	Concurrency::BackgroundThrottling::ReportFrameWorkTime(Concurrency::BackgroundThrottling::eFrameThread::Render,
+		Time::ConvertTicksToSeconds(Time::GetCurrentSystemTimeTickCount() - tickCount_whenWorkStarted));
+
 	SwapRender();
 }
 
@@ -294,38 +332,40 @@ float eae6320::Graphics::ConvertDegreeToRadian(const float i_degree)
 	return (i_degree * PI) / 180.0f;
 }
 
-std::vector<eae6320::Graphics::DataSetForRenderingMesh> eae6320::Graphics::SelectionSortMeshForRenderingBasedOnDistanceToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh> i_meshData)
+void eae6320::Graphics::SelectionSortMeshForRenderingBasedOnDistanceToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh>& io_meshData)
 {
-	auto result = i_meshData;
-	for (size_t i = 0; i < result.size(); i++)
+	// The camera space z values are only needed while sorting,
+	// and so they are kept in the render thread's scratch memory instead of being allocated from the heap every frame
+	Concurrency::cScratchAllocator::cScope scratchScope;
+	Concurrency::ScratchVector<float> cameraSpaceDepths;
+	cameraSpaceDepths.reserve(io_meshData.size());
+	// Transform each position from world space to camera space once (rather than once per comparison)
+	const auto& transform_worldToCamera = s_dataBeingRenderedByRenderThread->constantData_perFrame.g_transform_worldToCamera;
+	for (const auto& meshData : io_meshData)
+		cameraSpaceDepths.push_back((transform_worldToCamera * meshData.rigidBody.position).z);
+
+	for (size_t i = 0; i < io_meshData.size(); i++)
 	{
-		size_t minIndex = FindIndexOfObjectFarthestToCamera(result, i);
+		size_t minIndex = FindIndexOfObjectFarthestToCamera(cameraSpaceDepths, i);
 		if (i != minIndex)
-			std::swap(result[i], result[minIndex]);
+		{
+			std::swap(io_meshData[i], io_meshData[minIndex]);
+			std::swap(cameraSpaceDepths[i], cameraSpaceDepths[minIndex]);
+		}
 	}
-	return result;
 }
 
-size_t eae6320::Graphics::FindIndexOfObjectFarthestToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh> i_meshData, size_t i_startIndex)
+size_t eae6320::Graphics::FindIndexOfObjectFarthestToCamera(const Concurrency::ScratchVector<float>& i_cameraSpaceDepths, size_t i_startIndex)
 {
 	size_t currentMaxIndex = 0;
 	// Since the forward direction for the camera is -z, we thus need to find the farthest by getting the smallest z value.
-	if (i_meshData.size() > 0)
+	if (i_cameraSpaceDepths.size() > 0)
 	{
-		// Grab position info from each element and put them into a vector
-		std::vector<eae6320::Math::sVector> positionInfo;
-		for (auto item : i_meshData)
-			positionInfo.push_back(item.rigidBody.position);
-
-		// Transform them from world space to camera space
-		for (auto item : positionInfo)
-			item = s_dataBeingRenderedByRenderThread->constantData_perFrame.g_transform_worldToCamera * item;
-
 		// Find smallest from the range determined and get the index
 		currentMaxIndex = i_startIndex;
-		for (size_t i = i_startIndex; i < positionInfo.size(); i++)
+		for (size_t i = i_startIndex; i < i_cameraSpaceDepths.size(); i++)
 		{
-			if (positionInfo[i].z < positionInfo[currentMaxIndex].z)
+			if (i_cameraSpaceDepths[i] < i_cameraSpaceDepths[currentMaxIndex])
 				currentMaxIndex = i;
 		}
 	}
@@ -351,6 +391,54 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
 			EAE6320_ASSERT(false);
 			goto OnExit;
 		}
+		// Each kind of asset gets its own retention cache with the same budget
+		if (i_initializationParameters.assetCacheBudget > 0)
+		{
+			if (!(result = cShader::s_manager.SetRetentionBudget(i_initializationParameters.assetCacheBudget)))
+			{
+				EAE6320_ASSERT(false);
+				goto OnExit;
+			}
+			if (!(result = cTexture::s_manager.SetRetentionBudget(i_initializationParameters.assetCacheBudget)))
+			{
+				EAE6320_ASSERT(false);
+				goto OnExit;
+			}
+			if (!(result = Mesh::s_manager.SetRetentionBudget(i_initializationParameters.assetCacheBudget)))
+			{
+				EAE6320_ASSERT(false);
+				goto OnExit;
+			}
+			Logging::OutputMessage("Asset retention caches were initialized with a budget of %u MB each",
+				static_cast<unsigned int>(i_initializationParameters.assetCacheBudget / (1024 * 1024)));
+		}
+		// Textures and meshes that are byte-identical under different paths are only loaded once
+		// (shaders are small and are always loaded by their own paths)
+		if (!(result = cTexture::s_manager.EnableContentDeduplication(TEXTURE_FILE_DIRECTORY)))
+		{
+			EAE6320_ASSERT(false);
+			goto OnExit;
+		}
+		if (!(result = Mesh::s_manager.EnableContentDeduplication(MESH_FILE_DIRECTORY)))
+		{
+			EAE6320_ASSERT(false);
+			goto OnExit;
+		}
+	}
+
+	// Initialize texture streaming
+	{
+		s_resolutionHeight = i_initializationParameters.resolutionHeight;
+		if (!(result = TextureStreaming::Initialize(i_initializationParameters.textureMemoryBudget, i_initializationParameters.textureStagingMemorySize)))
+		{
+			EAE6320_ASSERT(false);
+			goto OnExit;
+		}
+	}
+
+	// Limit how much is uploaded every frame
+	{
+		Assets::AsyncLoading::GetUploadQueue().SetByteBudgetPerService(i_initializationParameters.uploadBudgetPerFrame);
 	}
 
 	// Initialize the platform-independent graphics objects
@@ -431,8 +519,8 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
-			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->DecrementReferenceCount();
+			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->CleanUp();
+			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->CleanUp();
 			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
 			s_dataBeingRenderedByRenderThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect = nullptr;
@@ -446,7 +534,7 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->CleanUp();
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
@@ -461,7 +549,7 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->CleanUp();
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 			s_dataBeingRenderedByRenderThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
@@ -476,8 +564,8 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
-			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->DecrementReferenceCount();
+			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect->CleanUp();
+			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].sprite->CleanUp();
 			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
 			s_dataBeingSubmittedByApplicationThread->cachedEffectSpritePairForRenderingInNextFrame[i].effect = nullptr;
@@ -491,7 +579,7 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairForRenderingInNextFrame[i].effect->CleanUp();
 			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
@@ -506,7 +594,7 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	{
 		for (size_t i = 0; i < s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame.size(); i++)
 		{
-			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->DecrementReferenceCount();
+			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].effect->CleanUp();
 			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].mesh->DecrementReferenceCount();
 			s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame[i].texture->DecrementReferenceCount();
 
@@ -517,6 +605,68 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 	}
 	s_dataBeingSubmittedByApplicationThread->cachedEffectMeshPairWithTranslucentForRenderingInNextFrame.clear();
 
+	// The assets that retention caches are keeping must be unloaded
+	// while their graphics objects (and texture streaming) still exist
+	{
+		const auto localResult = FlushRetentionCache(Mesh::s_manager, "mesh");
+		if (!localResult)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = localResult;
+			}
+		}
+	}
+	{
+		const auto localResult = FlushRetentionCache(cTexture::s_manager, "texture");
+		if (!localResult)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = localResult;
+			}
+		}
+	}
+	{
+		const auto localResult = FlushRetentionCache(cShader::s_manager, "shader");
+		if (!localResult)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	// Every effect and sprite should have been released by now
+	// (their platform objects must be destroyed before the context is)
+	{
+		const auto effectCount = Effect::GetLoadedEffectCount();
+		const auto spriteCount = Sprite::GetLoadedSpriteCount();
+		const auto renderStateCount = cRenderState::GetSharedRenderStateCount();
+		if ((effectCount != 0) || (spriteCount != 0) || (renderStateCount != 0))
+		{
+			EAE6320_ASSERTF(false, "Effects, sprites, or render states were never released");
+			Logging::OutputError("%u effects, %u sprites, and %u shared render states were never released",
+				effectCount, spriteCount, renderStateCount);
+		}
+	}
+
+	{
+		const auto localResult = TextureStreaming::CleanUp();
+		if (!localResult)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = localResult;
+			}
+		}
+	}
+
 	CleanUpGraphics();
 
 	{
@@ -581,3 +731,38 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 
 	return result;
 }
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	float CalculateProjectedSizeInPixels(const eae6320::Graphics::DataSetForRenderingMesh & i_meshData)
+	{
+		const auto & camera = s_dataBeingRenderedByRenderThread->cameraForView;
+		const auto position_camera = s_dataBeingRenderedByRenderThread->constantData_perFrame.g_transform_worldToCamera * i_meshData.rigidBody.position;
+		// The camera looks down -z
+		const auto distance = -position_camera.z;
+		if (distance <= camera.nearPlaneDistance)
+		{
+			// Anything this close could cover the whole screen
+			return static_cast<float>(s_resolutionHeight);
+		}
+		// The bounding sphere's diameter divided by the height of the view frustum at the sphere's distance
+		const auto viewHeightAtDistance = 2.0f * distance * std::tan(camera.fieldOfView * 0.5f);
+		return (2.0f * i_meshData.mesh->GetBoundingRadius() / viewHeightAtDistance) * static_cast<float>(s_resolutionHeight);
+	}
+
+	template <class tAsset>
+	eae6320::cResult FlushRetentionCache(eae6320::Assets::cManager<tAsset> & io_manager, const char * const i_assetTypeName)
+	{
+		const auto cacheStatistics = io_manager.GetCacheStatistics();
+		if (cacheStatistics.budget_inBytes > 0)
+		{
+			eae6320::Logging::OutputMessage("The %s retention cache had %llu hits and %llu misses and was keeping %u assets (%u KB)",
+				i_assetTypeName, static_cast<unsigned long long>(cacheStatistics.hitCount), static_cast<unsigned long long>(cacheStatistics.missCount),
+				static_cast<unsigned int>(cacheStatistics.retainedAssetCount), static_cast<unsigned int>(cacheStatistics.retainedByteCount / 1024));
+		}
+		return io_manager.SetRetentionBudget(0);
+	}
+}
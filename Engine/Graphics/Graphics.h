@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <vector>
+#include <Engine/Concurrency/cScratchAllocator.h>
 #include <Engine/Results/Results.h>
 #include <Engine/Math/sVector.h>
 #include <Engine/Physics/sRigidBodyState.h>
@@ -132,12 +133,21 @@ namespace eae6320
 		{
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HWND mainWindow = NULL;
-	#if defined( EAE6320_PLATFORM_D3D )
-			uint16_t resolutionWidth, resolutionHeight;
-	#elif defined( EAE6320_PLATFORM_GL )
+	#if defined( EAE6320_PLATFORM_GL )
 			HINSTANCE thisInstanceOfTheApplication = NULL;
 	#endif
 #endif
+			uint16_t resolutionWidth, resolutionHeight;
+			// The maximum number of bytes that the resident MIP levels of streamed textures can use
+			size_t textureMemoryBudget = 64 * 1024 * 1024;
+			// The maximum number of bytes that streamed MIP levels can use while they wait to be uploaded
+			size_t textureStagingMemorySize = 32 * 1024 * 1024;
+			// The number of bytes that the render thread uploads every frame when assets finish loading
+			// (at least one asset or MIP level is always uploaded)
+			size_t uploadBudgetPerFrame = 8 * 1024 * 1024;
+			// The maximum number of bytes that each asset manager can keep loaded after the assets have been released
+			// (zero means that assets are unloaded as soon as they are released)
+			size_t assetCacheBudget = 0;
 		};
 
 		cResult Initialize( const sInitializationParameters& i_initializationParameters );
@@ -152,11 +162,11 @@ namespace eae6320
 		//-----------------
 		float ConvertDegreeToRadian(const float i_degree);
 
-		// Sort mesh data based on their z distances to the camera in camera space
-		std::vector<eae6320::Graphics::DataSetForRenderingMesh> SelectionSortMeshForRenderingBasedOnDistanceToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh> i_meshData);
+		// Sort mesh data in place based on their z distances to the camera in camera space
+		void SelectionSortMeshForRenderingBasedOnDistanceToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh>& io_meshData);
 
-		// Search through the vector from i_startIndex to the end of the vector and get the index of object with farthest distance
-		size_t FindIndexOfObjectFarthestToCamera(std::vector<eae6320::Graphics::DataSetForRenderingMesh> i_meshData, size_t i_startIndex);
+		// Search through the camera space z values from i_startIndex to the end and get the index of object with farthest distance
+		size_t FindIndexOfObjectFarthestToCamera(const Concurrency::ScratchVector<float>& i_cameraSpaceDepths, size_t i_startIndex);
 	}
 }
 
@@ -3,6 +3,8 @@
 
 #include "Mesh.h"
 
+#include <algorithm>
+#include <cmath>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
@@ -37,58 +39,103 @@ eae6320::Graphics::Mesh::~Mesh()
 //--------------------------
 
 eae6320::cResult eae6320::Graphics::Mesh::Load(const char * i_meshFileName, Mesh *& o_mesh)
+{
+	cResult result = Results::Success;
+
+	sFileData fileData;
+	if (!(result = ReadFile(i_meshFileName, fileData)))
+	{
+		o_mesh = nullptr;
+		return result;
+	}
+	return CreateFromFileData(fileData, o_mesh);
+}
+
+eae6320::cResult eae6320::Graphics::Mesh::ReadFile(const char * i_meshFileName, sFileData & o_fileData)
 {
 	// Input array data should always be counterclockwise (CCW)
 	// (We could make it either always clockwise or counterclockwise)
 
 	cResult result = Results::Success;
 
-	eae6320::Platform::sDataFromFile dataFromFile;
-	Mesh * mesh = nullptr;
-
 	// Automate the file path since compiled files will have to go into this folder
-	char completeFilePath[MAX_MESH_PATH_LENGTH] = "data/Meshes/";
+	char completeFilePath[MAX_MESH_PATH_LENGTH] = MESH_FILE_DIRECTORY;
 	strcat(completeFilePath, i_meshFileName);
 
-	mesh = new (std::nothrow) Mesh();
-
 	// Load the binary data
 	std::string errorMessage;
-	if (!(result = eae6320::Platform::LoadBinaryFile(completeFilePath, dataFromFile, &errorMessage)))
+	if (!(result = eae6320::Platform::LoadBinaryFile(completeFilePath, o_fileData.dataFromFile, &errorMessage)))
 	{
 		EAE6320_ASSERTF(false, errorMessage.c_str());
 		Logging::OutputError("Failed to load mesh data from file %s: %s", completeFilePath, errorMessage.c_str());
-		goto OnExit;
+		return result;
 	}
 
 	// Get the start of the block and the end of the block
-	auto currentOffset = reinterpret_cast<uintptr_t>(dataFromFile.data);
-	const auto finalOffset = currentOffset + dataFromFile.size;
+	auto currentOffset = reinterpret_cast<uintptr_t>(o_fileData.dataFromFile.data);
+	const auto finalOffset = currentOffset + o_fileData.dataFromFile.size;
+
+	// Make sure that the counts are in the file before reading them
+	if ((currentOffset + sizeof(o_fileData.vertexCount) + sizeof(o_fileData.indexCount)) > finalOffset)
+	{
+		EAE6320_ASSERTF(false, "The mesh file %s is too small", completeFilePath);
+		Logging::OutputError("The mesh file %s is too small to contain the vertex and index counts", completeFilePath);
+		return Results::InvalidFile;
+	}
 
 	// Use current pointer of data and get number of vertices from data chunk
 	uint16_t * p_vertexCount = reinterpret_cast<uint16_t *>(currentOffset);
-	mesh->s_vertexCount = *p_vertexCount;
+	o_fileData.vertexCount = *p_vertexCount;
 
 	// Increment current pointer of data and get number of indices from data chunk
-	currentOffset += sizeof(mesh->s_vertexCount);
+	currentOffset += sizeof(o_fileData.vertexCount);
 	uint16_t * p_indexCount = reinterpret_cast<uint16_t *>(currentOffset);
-	mesh->s_indexCount = *p_indexCount;
+	o_fileData.indexCount = *p_indexCount;
 
-	// Increment current pointer of data and get vertex data pointer from data chunk
-	currentOffset += sizeof(mesh->s_indexCount);
+	// Make sure that the vertices and indices are in the file before using them
+	currentOffset += sizeof(o_fileData.indexCount);
+	if ((currentOffset + (sizeof(eae6320::Graphics::VertexFormats::sMesh) * o_fileData.vertexCount) + (sizeof(uint16_t) * o_fileData.indexCount)) > finalOffset)
+	{
+		EAE6320_ASSERTF(false, "The mesh file %s is too small", completeFilePath);
+		Logging::OutputError("The mesh file %s is too small to contain %u vertices and %u indices",
+			completeFilePath, o_fileData.vertexCount, o_fileData.indexCount);
+		return Results::InvalidFile;
+	}
+
+	// Get vertex data pointer from data chunk
 	eae6320::Graphics::VertexFormats::sMesh * p_vertexData = reinterpret_cast<eae6320::Graphics::VertexFormats::sMesh *>(currentOffset);
-	mesh->s_vertexData = p_vertexData;
+	o_fileData.vertexData = p_vertexData;
 
 	// Increment current pointer of data and get index data pointer from data chunk
-	currentOffset += sizeof(eae6320::Graphics::VertexFormats::sMesh) * mesh->s_vertexCount;
+	currentOffset += sizeof(eae6320::Graphics::VertexFormats::sMesh) * o_fileData.vertexCount;
 	uint16_t * p_indexData = reinterpret_cast<uint16_t *>(currentOffset);
-	mesh->s_indexData = p_indexData;
+	o_fileData.indexData = p_indexData;
 
 	// The size of the index array should always be a multiple of 3
 	constexpr unsigned int vertexPerTriangle = 3;
-	EAE6320_ASSERTF(mesh->s_indexCount % vertexPerTriangle == 0, "Invalid array size for indices, it has to be a multiple of 3");
+	EAE6320_ASSERTF(o_fileData.indexCount % vertexPerTriangle == 0, "Invalid array size for indices, it has to be a multiple of 3");
+
+	// Find the bounding radius from the vertex positions
+	// (the renderer uses it to estimate how big the mesh will be on screen)
+	{
+		float boundingRadiusSquared = 0.0f;
+		for (uint16_t i = 0; i < o_fileData.vertexCount; i++)
+		{
+			const auto & vertex = o_fileData.vertexData[i];
+			boundingRadiusSquared = std::max(boundingRadiusSquared, (vertex.x * vertex.x) + (vertex.y * vertex.y) + (vertex.z * vertex.z));
+		}
+		o_fileData.boundingRadius = std::sqrt(boundingRadiusSquared);
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::Mesh::CreateFromFileData(sFileData & io_fileData, Mesh *& o_mesh)
+{
+	cResult result = Results::Success;
 
 	// Allocate a new Mesh
+	Mesh * mesh = new (std::nothrow) Mesh();
 	{
 		if (!mesh)
 		{
@@ -99,14 +146,22 @@ eae6320::cResult eae6320::Graphics::Mesh::Load(const char * i_meshFileName, Mesh
 		}
 	}
 
+	mesh->s_vertexCount = io_fileData.vertexCount;
+	mesh->s_indexCount = io_fileData.indexCount;
+	mesh->s_vertexData = io_fileData.vertexData;
+	mesh->s_indexData = io_fileData.indexData;
+	mesh->s_boundingRadius = io_fileData.boundingRadius;
+
 	if (!(result = mesh->InitializeMesh(mesh->s_vertexData, mesh->s_indexData)))
 	{
 		EAE6320_ASSERTF(false, "Initialization of new mesh failed");
 		goto OnExit;
 	}
 
-	// Free data chunk from binary file after extracting data from it
-	dataFromFile.Free();
+	// The data from the file isn't needed once it has been uploaded
+	io_fileData.dataFromFile.Free();
+	mesh->s_vertexData = nullptr;
+	mesh->s_indexData = nullptr;
 
 OnExit:
 
@@ -136,4 +191,18 @@ eae6320::cResult eae6320::Graphics::Mesh::CleanUp()
 		Logging::OutputError("Failed to clean up mesh");
 	}
 	return result;
+}
+
+// Access
+//-------
+
+float eae6320::Graphics::Mesh::GetBoundingRadius() const
+{
+	return s_boundingRadius;
+}
+
+size_t eae6320::Graphics::Mesh::GetMemorySize() const
+{
+	// The vertex and index data is only kept in the GPU's buffers
+	return sizeof(*this) + (static_cast<size_t>(s_vertexCount) * sizeof(VertexFormats::sMesh)) + (static_cast<size_t>(s_indexCount) * sizeof(uint16_t));
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ These are code snippets that represent meshes that are separated from Graphics s
 #include <Engine/Graphics/VertexFormats.h>
 #include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/cManager.h>
+#include <Engine/Platform/Platform.h>
 
 #include <vector>
 
@@ -23,6 +24,8 @@ These are code snippets that represent meshes that are separated from Graphics s
 #endif
 
 #define MAX_MESH_PATH_LENGTH 100
+// Mesh file names are relative to this directory
+#define MESH_FILE_DIRECTORY "data/Meshes/"
 
 namespace eae6320
 {
@@ -38,6 +41,32 @@ namespace eae6320
 			static cResult Load(const char * i_meshFileName, Mesh *& o_mesh);
 			cResult CleanUp();
 
+			// Asynchronous Loading
+			//---------------------
+
+			// Load() is ReadFile() followed by CreateFromFileData(),
+			// and they are separate so that Mesh::s_manager.LoadAsync() can read the file on a background thread
+			struct sFileData
+			{
+				Platform::sDataFromFile dataFromFile;
+				uint16_t vertexCount = 0;
+				uint16_t indexCount = 0;
+				VertexFormats::sMesh * vertexData = nullptr;
+				uint16_t * indexData = nullptr;
+				float boundingRadius = 0.0f;
+
+				sFileData() = default;
+				sFileData(const sFileData &) = delete;
+				sFileData & operator =(const sFileData &) = delete;
+				~sFileData() { dataFromFile.Free(); }
+
+				// Creating the mesh uploads the vertex and index buffers
+				size_t GetUploadByteCount() const { return (vertexCount * sizeof(VertexFormats::sMesh)) + (indexCount * sizeof(uint16_t)); }
+			};
+			static cResult ReadFile(const char * i_meshFileName, sFileData & o_fileData);
+			// This must be called from the render thread
+			static cResult CreateFromFileData(sFileData & io_fileData, Mesh *& o_mesh);
+
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(Mesh)
 
 			// Reference Counting
@@ -56,6 +85,13 @@ namespace eae6320
 			using Handle = Assets::cHandle<Mesh>;
 			static Assets::cManager<Mesh> s_manager;
 
+			// The radius of a sphere centered at the mesh's origin that contains every vertex
+			float GetBoundingRadius() const;
+
+			// The number of bytes of CPU and GPU memory that the mesh uses
+			// (this is how the asset manager's retention cache measures it)
+			size_t GetMemorySize() const;
+
 		private:
 
 			Mesh();
@@ -102,6 +138,8 @@ namespace eae6320
 
 			uint16_t * s_indexData;
 
+			float s_boundingRadius = 0.0f;
+
 			// Reference counting
 			//===================
 
@@ -33,7 +33,7 @@ eae6320::cResult eae6320::Graphics::Effect::InitializeShadingData(const char * v
 	}
 	{
 		// Default Render State is set to 0
-		if (!(result = s_renderState.Initialize(i_RenderState)))
+		if (!(result = cRenderState::Acquire(i_RenderState, s_renderState)))
 		{
 			EAE6320_ASSERT(false);
 			goto OnExit;
@@ -236,8 +236,9 @@ eae6320::cResult eae6320::Graphics::Effect::CleanUpShadingData()
 			}
 		}
 	}
+	if (s_renderState)
 	{
-		const auto localResult = s_renderState.CleanUp();
+		const auto localResult = cRenderState::Release(s_renderState);
 		if (!localResult)
 		{
 			EAE6320_ASSERT(false);
@@ -259,6 +260,7 @@ void eae6320::Graphics::Effect::BindShadingData()
 			glUseProgram(s_programId);
 			EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
 		}
-		s_renderState.Bind();
+		EAE6320_ASSERT(s_renderState);
+		s_renderState->Bind();
 	}
 }
\ No newline at end of file
@@ -45,27 +45,32 @@ void eae6320::Graphics::cTexture::Bind( const unsigned int i_id ) const
 // Initialization / Clean Up
 //--------------------------
 
-eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_path, const void* const i_textureData, const size_t i_textureDataSize )
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_path, const void* const i_textureData, const size_t i_textureDataSize,
+	const uint_fast8_t i_mostDetailedMipLevel )
 {
 	auto result = Results::Success;
 
+	// A new texture is created rather than changing the existing one
+	// so that the existing one can still be used if anything goes wrong
+	GLuint textureId = 0;
+
 	// Create a new texture and make it active
 	{
 		constexpr GLsizei textureCount = 1;
-		glGenTextures( textureCount, &m_textureId );
+		glGenTextures( textureCount, &textureId );
 		const auto errorCode = glGetError();
 		if ( errorCode == GL_NO_ERROR )
 		{
-			if ( m_textureId != 0 )
+			if ( textureId != 0 )
 			{
-				glBindTexture( GL_TEXTURE_2D, m_textureId );
+				glBindTexture( GL_TEXTURE_2D, textureId );
 				const auto errorCode = glGetError();
 				if ( errorCode != GL_NO_ERROR )
 				{
 					result = Results::Failure;
 					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					eae6320::Logging::OutputError( "OpenGL failed to bind the new texture %u for %s: %s",
-						m_textureId, i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+						textureId, i_path, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					goto OnExit;
 				}
 			}
@@ -87,47 +92,37 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 		}
 	}
 	// Fill in the data for each MIP level
+	// (the data is stored from the least detailed MIP level to the most detailed,
+	// and the most detailed resident MIP level becomes level 0 of the new texture)
 	{
-		auto currentWidth = static_cast<GLsizei>( m_info.width );
-		auto currentHeight = static_cast<GLsizei>( m_info.height );
 		auto currentOffset = reinterpret_cast<uintptr_t>( i_textureData );
 		const auto finalOffset = currentOffset + i_textureDataSize;
-		const auto compressionType = m_info.compressionType;
-		const auto blockSize = TextureFormats::Compression::GetSizeOfBlock( compressionType );
-		const auto glFormat = GetGlFormat( compressionType );
+		const auto glFormat = GetGlFormat( m_info.compressionType );
 		constexpr GLint borderWidth = 0;
 		const auto mipMapCount = static_cast<GLint>( m_info.mipMapCount );
-		for ( GLint i = 0; i < mipMapCount; ++i )
+		const auto mostDetailedMipLevel = static_cast<GLint>( i_mostDetailedMipLevel );
+		for ( GLint i = mipMapCount - 1; i >= mostDetailedMipLevel; --i )
 		{
+			const auto currentWidth = std::max( static_cast<GLsizei>( m_info.width ) >> i, 1 );
+			const auto currentHeight = std::max( static_cast<GLsizei>( m_info.height ) >> i, 1 );
 			// Calculate how much memory this MIP level uses
-			const auto blockCount_singleRow = ( currentWidth + 3 ) / 4;
-			const auto byteCount_singleRow = blockCount_singleRow * blockSize;
-			const auto rowCount = ( currentHeight + 3 ) / 4;
-			const auto byteCount_currentMipLevel = byteCount_singleRow * rowCount;
+			const auto byteCount_currentMipLevel = static_cast<GLsizei>( TextureFormats::GetSizeOfMipMap( m_info, static_cast<uint_fast8_t>( i ) ) );
+			if ( ( currentOffset + byteCount_currentMipLevel ) > finalOffset )
+			{
+				result = Results::InvalidFile;
+				EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%i",
+					i_path, i );
+				Logging::OutputError( "The texture file %s is too small to contain MIP map #%i",
+					i_path, i );
+				goto OnExit;
+			}
 			// Set the data into the texture
-			glCompressedTexImage2D( GL_TEXTURE_2D, i, glFormat, currentWidth, currentHeight,
+			glCompressedTexImage2D( GL_TEXTURE_2D, i - mostDetailedMipLevel, glFormat, currentWidth, currentHeight,
 				borderWidth, byteCount_currentMipLevel, reinterpret_cast<void*>( currentOffset ) );
 			const auto errorCode = glGetError();
 			if ( errorCode == GL_NO_ERROR )
 			{
-				// Update current data for next iteration
-				{
-					currentOffset += byteCount_currentMipLevel;
-					if ( currentOffset <= finalOffset )
-					{
-						currentWidth = std::max( currentWidth / 2, 1 );
-						currentHeight = std::max( currentHeight / 2, 1 );
-					}
-					else
-					{
-						result = Results::InvalidFile;
-						EAE6320_ASSERTF( false, "Texture file %s is too small to contain MIP map #%i",
-							i_path, i );
-						Logging::OutputError( "The texture file %s is too small to contain MIP map #%i",
-							i_path, i );
-						goto OnExit;
-					}
-				}
+				currentOffset += byteCount_currentMipLevel;
 			}
 			else
 			{
@@ -140,16 +135,30 @@ eae6320::cResult eae6320::Graphics::cTexture::Initialize( const char* const i_pa
 		}
 		EAE6320_ASSERTF( currentOffset == finalOffset, "The texture file %s has more texture data (%u) than it should (%u)",
 			i_path, finalOffset, currentOffset );
+		// Only the uploaded MIP levels can be sampled
+		// (otherwise the texture would be incomplete if the MIP chain doesn't go all the way down to 1x1)
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipMapCount - 1 - mostDetailedMipLevel );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	}
+	// Replace the existing texture
+	{
+		if ( !( result = CleanUpTexture() ) )
+		{
+			goto OnExit;
+		}
+		m_textureId = textureId;
+		textureId = 0;
+		m_mostDetailedResidentMipLevel = static_cast<uint8_t>( i_mostDetailedMipLevel );
 	}
 
 OnExit:
 
-	if ( !result && ( m_textureId != 0 ) )
+	if ( textureId != 0 )
 	{
 		constexpr GLsizei textureCount = 1;
-		glDeleteTextures( textureCount, &m_textureId );
-		EAE6320_ASSERT( glGetError == GL_NO_ERROR );
-		m_textureId = 0;
+		glDeleteTextures( textureCount, &textureId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		textureId = 0;
 	}
 	
 	return result;
@@ -191,6 +200,9 @@ namespace
 		{
 			case eae6320::Graphics::TextureFormats::Compression::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
 			case eae6320::Graphics::TextureFormats::Compression::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			case eae6320::Graphics::TextureFormats::Compression::BC4: return GL_COMPRESSED_RED_RGTC1;
+			case eae6320::Graphics::TextureFormats::Compression::BC5: return GL_COMPRESSED_RG_RGTC2;
+			case eae6320::Graphics::TextureFormats::Compression::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
 		}
 
 		// Other formats are possible, but not for our class
@@ -4,8 +4,44 @@
 #include "Sprite.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
+#include <functional>
 #include <new> // This library is needed for std::nothrow
+#include <unordered_map>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Loaded sprites are identified by the rectangle that they cover
+	struct sSpriteKey
+	{
+		float tr_X, tr_Y, sideH, sideV;
+
+		bool operator ==(const sSpriteKey& i_other) const
+		{
+			return (tr_X == i_other.tr_X) && (tr_Y == i_other.tr_Y) && (sideH == i_other.sideH) && (sideV == i_other.sideV);
+		}
+	};
+	struct sSpriteKeyHasher
+	{
+		size_t operator ()(const sSpriteKey& i_key) const
+		{
+			const std::hash<float> hasher;
+			size_t hash = hasher(i_key.tr_X);
+			hash = (hash * 31) + hasher(i_key.tr_Y);
+			hash = (hash * 31) + hasher(i_key.sideH);
+			hash = (hash * 31) + hasher(i_key.sideV);
+			return hash;
+		}
+	};
+	std::unordered_map<sSpriteKey, eae6320::Graphics::Sprite*, sSpriteKeyHasher> s_loadedSprites;
+	// The mutex is held while a sprite is being created or destroyed
+	// so that two threads can't both create the same sprite
+	eae6320::Concurrency::cMutex s_loadedSpritesMutex{ "Graphics::Sprite" };
+}
 
 eae6320::Graphics::Sprite::Sprite()
 {
@@ -22,6 +58,21 @@ eae6320::cResult eae6320::Graphics::Sprite::Load(float tr_X, float tr_Y, float s
 	cResult result = Results::Success;
 	Sprite * sprite = nullptr;
 
+	const sSpriteKey key{ tr_X, tr_Y, sideH, sideV };
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedSpritesMutex);
+
+	// Share a sprite that has already been loaded
+	{
+		const auto iterator = s_loadedSprites.find(key);
+		if (iterator != s_loadedSprites.end())
+		{
+			sprite = iterator->second;
+			sprite->IncrementReferenceCount();
+			o_sprite = sprite;
+			return result;
+		}
+	}
+
 	sprite = new (std::nothrow) Sprite();
 
 	// Allocate a new Sprite
@@ -46,6 +97,7 @@ OnExit:
 	if (result)
 	{
 		EAE6320_ASSERT(sprite);
+		s_loadedSprites.insert(std::make_pair(key, sprite));
 		o_sprite = sprite;
 	}
 	else
@@ -63,6 +115,27 @@ OnExit:
 eae6320::cResult eae6320::Graphics::Sprite::CleanUp()
 {
 	cResult result = Results::Success;
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedSpritesMutex);
+	// The geometry is only cleaned up when the last reference to a shared sprite is released
+	if (m_referenceCount > 1)
+	{
+		this->DecrementReferenceCount();
+		return result;
+	}
+	// There are only ever a few sprites loaded,
+	// and so searching for this one is cheaper than storing its key
+	{
+		auto iterator = s_loadedSprites.begin();
+		while ((iterator != s_loadedSprites.end()) && (iterator->second != this))
+		{
+			++iterator;
+		}
+		EAE6320_ASSERT(iterator != s_loadedSprites.end());
+		if (iterator != s_loadedSprites.end())
+		{
+			s_loadedSprites.erase(iterator);
+		}
+	}
 	if (result = CleanUpGeometry())
 		this->DecrementReferenceCount();
 	else
@@ -71,4 +144,10 @@ eae6320::cResult eae6320::Graphics::Sprite::CleanUp()
 		Logging::OutputError("Failed to clean up geometry");
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+unsigned int eae6320::Graphics::Sprite::GetLoadedSpriteCount()
+{
+	Concurrency::cMutex::cScopeLock autoLock(s_loadedSpritesMutex);
+	return static_cast<unsigned int>(s_loadedSprites.size());
+}
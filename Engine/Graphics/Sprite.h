@@ -28,8 +28,15 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
+			// Sprites are shared:
+			// Loading a sprite with the same rectangle as a sprite that is already loaded
+			// returns the existing sprite (with its reference count incremented)
+			// instead of creating another vertex buffer.
+			// Every successful call to Load() must be matched by a call to CleanUp().
 			static cResult Load(float tr_X, float tr_Y, float sideH, float sideV, Sprite *& o_sprite);
 			cResult CleanUp();
+			// This returns the number of distinct sprites that are currently loaded
+			static unsigned int GetLoadedSpriteCount();
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(Sprite)
 
@@ -11,6 +11,7 @@
 
 #include "Configuration.h"
 
+#include <cstddef>
 #include <cstdint>
 
 // Texture Formats
@@ -67,14 +68,50 @@ namespace eae6320
 				}
 			}
 
+			// Every texture file starts with the signature and the version of the format that it was built with
+			// (the version must be changed whenever the layout of a texture file changes
+			// so that files built by an older TextureBuilder are rejected instead of being displayed as garbage)
+			constexpr uint32_t s_signature = 0x52585445;	// "ETXR" when read as bytes
+			// Version 2 stores the MIP maps from the smallest to the largest
+			constexpr uint16_t s_version = 2;
+
 			// This struct is a binary description of the texture that is stored in a texture file
-			// and loaded and used at run-time
+			// and loaded and used at run-time.
+			// It is followed in the file by the data for each MIP map,
+			// stored from the smallest to the largest
+			// (so that the smallest MIP maps can be read without having to read the largest ones)
 			struct sTextureInfo
 			{
+				uint32_t signature;
+				uint16_t version;
 				uint16_t width, height;
 				uint8_t mipMapCount;
 				Compression::eType compressionType;
 			};
+			static_assert( sizeof( sTextureInfo ) == 12, "The texture information is read directly from the file and must be tightly packed" );
+
+			// Returns the size in bytes of a single MIP map
+			// (MIP level 0 is the largest)
+			inline constexpr size_t GetSizeOfMipMap( const sTextureInfo& i_info, const uint_fast8_t i_mipLevel )
+			{
+				const uint_fast32_t width = ( i_info.width >> i_mipLevel ) > 0 ? ( i_info.width >> i_mipLevel ) : 1;
+				const uint_fast32_t height = ( i_info.height >> i_mipLevel ) > 0 ? ( i_info.height >> i_mipLevel ) : 1;
+				const uint_fast32_t blockCount_singleRow = ( width + 3 ) / 4;
+				const uint_fast32_t rowCount = ( height + 3 ) / 4;
+				return static_cast<size_t>( blockCount_singleRow * rowCount ) * Compression::GetSizeOfBlock( i_info.compressionType );
+			}
+			// Returns the size in bytes of every MIP map from the specified one to the smallest
+			// (because of the order that MIP maps are stored in this is how many bytes must be read after the sTextureInfo
+			// in order to use the specified MIP level)
+			inline constexpr size_t GetSizeOfMipChain( const sTextureInfo& i_info, const uint_fast8_t i_mostDetailedMipLevel )
+			{
+				size_t byteCount = 0;
+				for ( uint_fast8_t i = i_mostDetailedMipLevel; i < i_info.mipMapCount; ++i )
+				{
+					byteCount += GetSizeOfMipMap( i_info, i );
+				}
+				return byteCount;
+			}
 		}
 	}
 }
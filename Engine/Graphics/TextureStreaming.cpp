@@ -0,0 +1,457 @@
+// Include Files
+//==============
+
+#include "TextureStreaming.h"
+
+#include "cTexture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/AsyncLoading.h>
+#include <Engine/Assets/cStagingRing.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/AsyncFileIo.h>
+#include <Engine/Platform/Platform.h>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every texture that has been loaded has a streaming record
+	struct sStreamingRecord
+	{
+		// The last frame that the texture was drawn in
+		uint64_t frameLastSeen = 0;
+		// The most detailed MIP level that was needed by any draw call this frame
+		// and how big the texture was on screen
+		// (these are reset every frame)
+		uint_fast8_t mostDetailedMipLevel_desired = 0;
+		float projectedSizeInPixels = 0.0f;
+		// The most detailed MIP level that will be resident once any outstanding request finishes
+		// (the memory budget is based on this rather than what is currently resident)
+		uint_fast8_t mostDetailedMipLevel_committed = 0;
+		bool isRequestOutstanding = false;
+		// If reading or uploading ever fails the texture stops being streamed
+		// (it is still usable with whatever MIP levels are resident)
+		bool hasStreamingFailed = false;
+	};
+	// The streaming records are only accessed by the render thread
+	// except when a texture is destroyed on another thread
+	std::map<const eae6320::Graphics::cTexture*, sStreamingRecord> s_streamingRecords;
+	eae6320::Concurrency::cMutex s_streamingRecordsMutex{ "Graphics::TextureStreaming" };
+
+	// A request reads every MIP level from the requested one to the least detailed
+	// (because of the texture file layout this is a single contiguous read)
+	struct sRequest
+	{
+		// The request holds a reference to the texture until it has been processed by the render thread
+		eae6320::Graphics::cTexture* texture = nullptr;
+		uint_fast8_t mostDetailedMipLevel = 0;
+		// The MIP levels are read directly into this staging memory
+		// and it is freed once they have been uploaded
+		void* stagingMemory = nullptr;
+		size_t size = 0;
+		eae6320::Platform::AsyncFileIo::sRequestHandle ioRequest;
+		eae6320::cResult result;
+		std::string errorMessage;
+	};
+	// Requests that are being read by asynchronous file I/O
+	// (the requests are only accessed by the render thread).
+	// Once a request has been read it is uploaded by the asynchronous loading upload queue,
+	// which limits how much is uploaded every frame.
+	std::vector<sRequest> s_outstandingRequests;
+	// MIP levels are staged in a fixed amount of memory between being read and being uploaded,
+	// and a request isn't issued until there is room for it
+	// (a request that is bigger than the whole ring is staged in memory that is allocated for it)
+	eae6320::Assets::cStagingRing s_stagingRing;
+
+	size_t s_memoryBudget = 0;
+	// The number of bytes that every texture will use once every outstanding request has finished
+	size_t s_committedByteCount = 0;
+	uint64_t s_frameIndex = 0;
+
+	// Limiting the number of outstanding requests lets priorities be re-evaluated every frame
+	// instead of having the I/O thread work through an old backlog
+	constexpr size_t s_maxOutstandingRequestCount = 4;
+	// A texture must not have been drawn for this many frames before its detailed MIP levels can be evicted
+	constexpr uint64_t s_frameCountBeforeEviction = 60;
+	// Evicting frees memory and so it is done before any other kind of request
+	constexpr auto s_evictionPriority = std::numeric_limits<float>::max();
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	bool EvictUntilBudgetAllows( const size_t i_byteCountToAllocate );
+	// This returns false if the request couldn't be issued
+	bool IssueRequest( eae6320::Graphics::cTexture& io_texture, sStreamingRecord& io_record,
+		const uint_fast8_t i_mostDetailedMipLevel, const float i_priority );
+	void UploadRequest( sRequest& io_request );
+
+	void* AllocateStagingMemory( const size_t i_size );
+	void FreeStagingMemory( void* const i_memory );
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::TextureStreaming::RequestMipLevels( cTexture& io_texture, const float i_projectedSizeInPixels )
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+	auto iterator = s_streamingRecords.find( &io_texture );
+	if ( iterator == s_streamingRecords.end() )
+	{
+		return;
+	}
+	auto& record = iterator->second;
+	// Find the least detailed MIP level that still has at least one texel per pixel
+	uint_fast8_t mostDetailedMipLevel = 0;
+	if ( ( i_projectedSizeInPixels > 0.0f ) && std::isfinite( i_projectedSizeInPixels ) )
+	{
+		const auto texelsPerPixel = static_cast<float>( std::max( io_texture.GetWidth(), io_texture.GetHeight() ) ) / i_projectedSizeInPixels;
+		if ( texelsPerPixel > 1.0f )
+		{
+			mostDetailedMipLevel = static_cast<uint_fast8_t>( std::min( std::floor( std::log2( texelsPerPixel ) ), 255.0f ) );
+		}
+	}
+	mostDetailedMipLevel = std::min( mostDetailedMipLevel, io_texture.GetMipTailLevel() );
+	if ( record.frameLastSeen != s_frameIndex )
+	{
+		record.frameLastSeen = s_frameIndex;
+		record.mostDetailedMipLevel_desired = mostDetailedMipLevel;
+		record.projectedSizeInPixels = i_projectedSizeInPixels;
+	}
+	else
+	{
+		record.mostDetailedMipLevel_desired = std::min( record.mostDetailedMipLevel_desired, mostDetailedMipLevel );
+		record.projectedSizeInPixels = std::max( record.projectedSizeInPixels, i_projectedSizeInPixels );
+	}
+}
+
+void eae6320::Graphics::TextureStreaming::Update()
+{
+	// The requests that have finished being read are queued to be uploaded
+	for ( auto iterator = s_outstandingRequests.begin(); iterator != s_outstandingRequests.end(); )
+	{
+		if ( Platform::AsyncFileIo::IsRequestComplete( iterator->ioRequest ) )
+		{
+			iterator->result = Platform::AsyncFileIo::WaitForRequest( iterator->ioRequest, nullptr, &iterator->errorMessage );
+			const auto request = std::make_shared<sRequest>( std::move( *iterator ) );
+			iterator = s_outstandingRequests.erase( iterator );
+			const auto uploadByteCount = request->result ? request->size : 0;
+			Assets::AsyncLoading::GetUploadQueue().Enqueue( uploadByteCount, [request]()
+				{
+					UploadRequest( *request );
+				} );
+		}
+		else
+		{
+			++iterator;
+		}
+	}
+	// Request more detailed MIP levels for the textures that need them
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+
+		size_t outstandingRequestCount = 0;
+		std::vector<std::pair<cTexture*, sStreamingRecord*>> candidates;
+		for ( auto& streamingRecord : s_streamingRecords )
+		{
+			auto& record = streamingRecord.second;
+			if ( record.isRequestOutstanding )
+			{
+				++outstandingRequestCount;
+			}
+			else if ( !record.hasStreamingFailed && ( record.frameLastSeen == s_frameIndex )
+				&& ( record.mostDetailedMipLevel_desired < record.mostDetailedMipLevel_committed ) )
+			{
+				candidates.push_back( std::make_pair( const_cast<cTexture*>( streamingRecord.first ), &record ) );
+			}
+		}
+		// The textures that are biggest on screen are requested first
+		std::sort( candidates.begin(), candidates.end(),
+			[]( const std::pair<cTexture*, sStreamingRecord*>& i_lhs, const std::pair<cTexture*, sStreamingRecord*>& i_rhs )
+			{
+				return i_lhs.second->projectedSizeInPixels > i_rhs.second->projectedSizeInPixels;
+			} );
+		for ( auto& candidate : candidates )
+		{
+			if ( outstandingRequestCount >= s_maxOutstandingRequestCount )
+			{
+				break;
+			}
+			auto& texture = *candidate.first;
+			auto& record = *candidate.second;
+			const auto& info = texture.GetInfo();
+			const auto byteCount_committed = TextureFormats::GetSizeOfMipChain( info, record.mostDetailedMipLevel_committed );
+			// If the desired MIP level doesn't fit in the budget a less detailed one might
+			for ( auto mostDetailedMipLevel = record.mostDetailedMipLevel_desired;
+				mostDetailedMipLevel < record.mostDetailedMipLevel_committed; ++mostDetailedMipLevel )
+			{
+				const auto byteCountToAllocate = TextureFormats::GetSizeOfMipChain( info, mostDetailedMipLevel ) - byteCount_committed;
+				if ( EvictUntilBudgetAllows( byteCountToAllocate ) )
+				{
+					if ( IssueRequest( texture, record, mostDetailedMipLevel, record.projectedSizeInPixels ) )
+					{
+						++outstandingRequestCount;
+					}
+					break;
+				}
+			}
+		}
+		++s_frameIndex;
+	}
+}
+
+// Registration
+//-------------
+
+void eae6320::Graphics::TextureStreaming::RegisterTexture( cTexture& io_texture )
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+	EAE6320_ASSERT( s_streamingRecords.find( &io_texture ) == s_streamingRecords.end() );
+	auto& record = s_streamingRecords[&io_texture];
+	record.mostDetailedMipLevel_committed = io_texture.GetMostDetailedResidentMipLevel();
+	record.mostDetailedMipLevel_desired = record.mostDetailedMipLevel_committed;
+	s_committedByteCount += TextureFormats::GetSizeOfMipChain( io_texture.GetInfo(), record.mostDetailedMipLevel_committed );
+}
+
+void eae6320::Graphics::TextureStreaming::UnregisterTexture( const cTexture& i_texture )
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+	auto iterator = s_streamingRecords.find( &i_texture );
+	if ( iterator != s_streamingRecords.end() )
+	{
+		// An outstanding request holds a reference to the texture
+		EAE6320_ASSERT( !iterator->second.isRequestOutstanding );
+		s_committedByteCount -= TextureFormats::GetSizeOfMipChain( i_texture.GetInfo(), iterator->second.mostDetailedMipLevel_committed );
+		s_streamingRecords.erase( iterator );
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::TextureStreaming::Initialize( const size_t i_memoryBudget, const size_t i_stagingMemorySize )
+{
+	auto result = Results::Success;
+
+	s_memoryBudget = i_memoryBudget;
+	if ( !( result = s_stagingRing.Initialize( i_stagingMemorySize ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the texture streaming staging memory" );
+		Logging::OutputError( "Failed to initialize %u MB of staging memory for texture streaming",
+			static_cast<unsigned int>( i_stagingMemorySize / ( 1024 * 1024 ) ) );
+		return result;
+	}
+	Logging::OutputMessage( "Texture streaming was initialized with a budget of %u MB and %u MB of staging memory",
+		static_cast<unsigned int>( s_memoryBudget / ( 1024 * 1024 ) ), static_cast<unsigned int>( s_stagingRing.GetCapacity() / ( 1024 * 1024 ) ) );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::TextureStreaming::CleanUp()
+{
+	auto result = Results::Success;
+
+	// Discard any requests that haven't been read
+	// (requests that had been read were queued to be uploaded,
+	// and asynchronous loading runs every queued upload when it is cleaned up before graphics is)
+	{
+		std::vector<sRequest> requests;
+		std::swap( requests, s_outstandingRequests );
+		for ( auto& request : requests )
+		{
+			// Cancelling a request guarantees that nothing more will be read into its memory
+			Platform::AsyncFileIo::CancelRequest( request.ioRequest );
+			FreeStagingMemory( request.stagingMemory );
+			{
+				Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+				auto iterator = s_streamingRecords.find( request.texture );
+				if ( iterator != s_streamingRecords.end() )
+				{
+					iterator->second.isRequestOutstanding = false;
+				}
+			}
+			request.texture->DecrementReferenceCount();
+		}
+	}
+	{
+		const auto localResult = s_stagingRing.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// This must be called with the streaming records locked.
+	// It returns true if the bytes can be allocated without exceeding the budget
+	// (possibly after evicting the detailed MIP levels of textures that haven't been drawn recently)
+	bool EvictUntilBudgetAllows( const size_t i_byteCountToAllocate )
+	{
+		if ( ( s_committedByteCount + i_byteCountToAllocate ) <= s_memoryBudget )
+		{
+			return true;
+		}
+		// Find every texture that could be evicted
+		std::vector<std::pair<eae6320::Graphics::cTexture*, sStreamingRecord*>> candidates;
+		for ( auto& streamingRecord : s_streamingRecords )
+		{
+			auto& texture = *const_cast<eae6320::Graphics::cTexture*>( streamingRecord.first );
+			auto& record = streamingRecord.second;
+			if ( !record.isRequestOutstanding && !record.hasStreamingFailed
+				&& ( ( record.frameLastSeen + s_frameCountBeforeEviction ) < s_frameIndex )
+				&& ( record.mostDetailedMipLevel_committed < texture.GetMipTailLevel() ) )
+			{
+				candidates.push_back( std::make_pair( &texture, &record ) );
+			}
+		}
+		// Evict the least recently seen textures first
+		std::sort( candidates.begin(), candidates.end(),
+			[]( const std::pair<eae6320::Graphics::cTexture*, sStreamingRecord*>& i_lhs,
+				const std::pair<eae6320::Graphics::cTexture*, sStreamingRecord*>& i_rhs )
+			{
+				return i_lhs.second->frameLastSeen < i_rhs.second->frameLastSeen;
+			} );
+		for ( auto& candidate : candidates )
+		{
+			// Evicting doesn't count against the number of outstanding requests
+			// because the MIP tail is small and the request frees memory
+			IssueRequest( *candidate.first, *candidate.second, candidate.first->GetMipTailLevel(), s_evictionPriority );
+			if ( ( s_committedByteCount + i_byteCountToAllocate ) <= s_memoryBudget )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// This must be called with the streaming records locked
+	bool IssueRequest( eae6320::Graphics::cTexture& io_texture, sStreamingRecord& io_record,
+		const uint_fast8_t i_mostDetailedMipLevel, const float i_priority )
+	{
+		EAE6320_ASSERT( !io_record.isRequestOutstanding );
+		const auto& info = io_texture.GetInfo();
+		// Every MIP level from the requested one to the least detailed is read directly into staging memory
+		// (because of the texture file layout this is a single contiguous read)
+		const auto size = eae6320::Graphics::TextureFormats::GetSizeOfMipChain( info, i_mostDetailedMipLevel );
+		auto* const stagingMemory = AllocateStagingMemory( size );
+		if ( !stagingMemory )
+		{
+			if ( size > s_stagingRing.GetCapacity() )
+			{
+				// Memory couldn't be allocated for a request that doesn't fit in the ring,
+				// and so the texture stops being streamed
+				eae6320::Logging::OutputError( "Failed to allocate memory to stream MIP level #%u of the texture %s",
+					i_mostDetailedMipLevel, io_texture.GetPath() );
+				io_record.hasStreamingFailed = true;
+			}
+			// Otherwise the ring is full until earlier requests have been uploaded,
+			// and the request will be issued in a later frame if it is still needed
+			return false;
+		}
+
+		s_committedByteCount -= eae6320::Graphics::TextureFormats::GetSizeOfMipChain( info, io_record.mostDetailedMipLevel_committed );
+		io_record.mostDetailedMipLevel_committed = i_mostDetailedMipLevel;
+		s_committedByteCount += eae6320::Graphics::TextureFormats::GetSizeOfMipChain( info, io_record.mostDetailedMipLevel_committed );
+		io_record.isRequestOutstanding = true;
+
+		sRequest request;
+		{
+			io_texture.IncrementReferenceCount();
+			request.texture = &io_texture;
+			request.mostDetailedMipLevel = i_mostDetailedMipLevel;
+			request.stagingMemory = stagingMemory;
+			request.size = size;
+		}
+		// Evicting frees memory, and so it is read before anything else
+		const auto ioPriority = ( i_priority == s_evictionPriority )
+			? eae6320::Platform::AsyncFileIo::ePriority::High : eae6320::Platform::AsyncFileIo::ePriority::Normal;
+		request.ioRequest = eae6320::Platform::AsyncFileIo::QueueRead( io_texture.GetPath(),
+			sizeof( eae6320::Graphics::TextureFormats::sTextureInfo ), size, request.stagingMemory, ioPriority );
+		s_outstandingRequests.push_back( std::move( request ) );
+		return true;
+	}
+
+	// This is run by the upload queue on the render thread
+	void UploadRequest( sRequest& io_request )
+	{
+		auto& texture = *io_request.texture;
+		auto result = io_request.result;
+		if ( result )
+		{
+			result = texture.UpdateResidentMipLevels( io_request.stagingMemory, io_request.size, io_request.mostDetailedMipLevel );
+		}
+		else
+		{
+			eae6320::Logging::OutputError( "Failed to stream MIP level #%u of the texture %s: %s",
+				io_request.mostDetailedMipLevel, texture.GetPath(), io_request.errorMessage.c_str() );
+		}
+		FreeStagingMemory( io_request.stagingMemory );
+		io_request.stagingMemory = nullptr;
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( s_streamingRecordsMutex );
+			auto iterator = s_streamingRecords.find( &texture );
+			EAE6320_ASSERT( iterator != s_streamingRecords.end() );
+			auto& record = iterator->second;
+			record.isRequestOutstanding = false;
+			if ( !result )
+			{
+				// Whatever is currently resident is what will stay resident
+				const auto& info = texture.GetInfo();
+				s_committedByteCount -= eae6320::Graphics::TextureFormats::GetSizeOfMipChain( info, record.mostDetailedMipLevel_committed );
+				record.mostDetailedMipLevel_committed = texture.GetMostDetailedResidentMipLevel();
+				s_committedByteCount += eae6320::Graphics::TextureFormats::GetSizeOfMipChain( info, record.mostDetailedMipLevel_committed );
+				record.hasStreamingFailed = true;
+			}
+		}
+		// The texture can only be released once no lock is held
+		// (releasing the last reference destroys a texture, which unregisters it)
+		texture.DecrementReferenceCount();
+		io_request.texture = nullptr;
+	}
+
+	void* AllocateStagingMemory( const size_t i_size )
+	{
+		return ( i_size <= s_stagingRing.GetCapacity() ) ? s_stagingRing.Allocate( i_size ) : malloc( i_size );
+	}
+
+	void FreeStagingMemory( void* const i_memory )
+	{
+		if ( s_stagingRing.Contains( i_memory ) )
+		{
+			s_stagingRing.Free( i_memory );
+		}
+		else
+		{
+			free( i_memory );
+		}
+	}
+}
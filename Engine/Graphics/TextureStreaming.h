@@ -0,0 +1,74 @@
+/*
+	Texture streaming keeps only the MIP levels that are actually needed resident in GPU memory
+
+	A texture can be used as soon as its MIP tail (its smallest MIP levels) has been loaded.
+	Every frame the renderer reports how big each texture that it draws is on screen,
+	and more detailed MIP levels are read from disk by asynchronous file I/O
+	(the ones that are biggest on screen first, several at a time)
+	into a fixed amount of staging memory
+	and are then uploaded by the render thread (within the asynchronous loading upload queue's per-frame budget).
+	The resident MIP levels of every texture must fit in a memory budget,
+	and when they don't the detailed MIP levels of textures that haven't been drawn recently are evicted.
+*/
+
+#ifndef EAE6320_GRAPHICS_TEXTURESTREAMING_H
+#define EAE6320_GRAPHICS_TEXTURESTREAMING_H
+
+// Include Files
+//==============
+
+#include "Configuration.h"
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cTexture;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace TextureStreaming
+		{
+			// Render
+			//-------
+
+			// These functions must be called from the render thread
+
+			// This should be called for every draw call that uses a texture
+			// with the approximate number of pixels that the texture covers on screen vertically
+			void RequestMipLevels( cTexture& io_texture, const float i_projectedSizeInPixels );
+			// This should be called once every frame after every draw call has been made.
+			// It uploads MIP levels that have finished loading and requests new ones.
+			void Update();
+
+			// Registration
+			//-------------
+
+			// These are called by cTexture itself
+			void RegisterTexture( cTexture& io_texture );
+			void UnregisterTexture( const cTexture& i_texture );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// The staging memory holds MIP levels between when they are read and when they are uploaded
+			cResult Initialize( const size_t i_memoryBudget, const size_t i_stagingMemorySize );
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_TEXTURESTREAMING_H
@@ -0,0 +1,221 @@
+// Include Files
+//==============
+
+#include "cPreloadManifest.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/BackgroundThrottling.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
+#include <string>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// This is the path that the asset's file is loaded from
+	std::string GetFilePath( const eae6320::Graphics::cPreloadManifest::eAssetType i_type, const char* const i_path );
+}
+
+// Interface
+//==========
+
+// Building
+//---------
+
+eae6320::cResult eae6320::Graphics::cPreloadManifest::Add( const eAssetType i_type, const char* const i_path )
+{
+	return Add( i_type, Assets::cPathId::Intern( i_path ) );
+}
+
+eae6320::cResult eae6320::Graphics::cPreloadManifest::Add( const eAssetType i_type, const Assets::cPathId i_pathId )
+{
+	if ( m_hasLoadStarted )
+	{
+		EAE6320_ASSERTF( false, "Assets can't be added to a preload manifest after it has started loading" );
+		Logging::OutputError( "The asset %s couldn't be added to a preload manifest that had already started loading", i_pathId.GetPath() );
+		return Results::Failure;
+	}
+	sEntry entry;
+	{
+		entry.type = i_type;
+		entry.pathId = i_pathId;
+	}
+	m_entries.push_back( entry );
+	return Results::Success;
+}
+
+// Loading
+//--------
+
+eae6320::cResult eae6320::Graphics::cPreloadManifest::Load()
+{
+	auto result = Results::Success;
+
+	if ( m_hasLoadStarted )
+	{
+		EAE6320_ASSERTF( false, "A preload manifest can only be loaded once" );
+		return Results::Failure;
+	}
+	m_hasLoadStarted = true;
+	m_loadStartTickCount = Time::GetCurrentSystemTimeTickCount();
+
+	// Find out where every file will be read from
+	// so that the reads can be requested in the order that they are stored
+	for ( auto& entry : m_entries )
+	{
+		const auto filePath = GetFilePath( entry.type, entry.pathId.GetPath() );
+		std::string errorMessage;
+		if ( !Platform::GetFileLocation( filePath.c_str(), entry.location, &errorMessage ) )
+		{
+			// The load will fail and report the error itself,
+			// and so the file is just requested last
+			Logging::OutputMessage( "The location of the preloaded file %s couldn't be found: %s", filePath.c_str(), errorMessage.c_str() );
+		}
+	}
+	std::stable_sort( m_entries.begin(), m_entries.end(),
+		[]( const sEntry& i_lhs, const sEntry& i_rhs ) { return i_lhs.location < i_rhs.location; } );
+
+	// Every load is started before waiting for any of them
+	// so that the worker threads can read and parse them in parallel
+	for ( auto& entry : m_entries )
+	{
+		switch ( entry.type )
+		{
+		case eAssetType::Mesh:
+			result = Mesh::s_manager.LoadAsync( entry.pathId, entry.mesh );
+			break;
+		case eAssetType::Texture:
+			result = cTexture::s_manager.LoadAsync( entry.pathId, entry.texture );
+			break;
+		default:
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Invalid preloaded asset type: %u", static_cast<unsigned int>( entry.type ) );
+		}
+		if ( !result )
+		{
+			EAE6320_ASSERTF( false, "Preloading %s couldn't be started", entry.pathId.GetPath() );
+			Logging::OutputError( "Preloading %s couldn't be started", entry.pathId.GetPath() );
+			return result;
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cPreloadManifest::WaitUntilLoaded( sStatistics* const o_statistics )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( m_hasLoadStarted, "A preload manifest must be loaded before it can be waited for" );
+	// Nothing else happens while a preload is waited for,
+	// and so the loads shouldn't be throttled
+	Concurrency::BackgroundThrottling::cScopeLoadingScreen autoLoadingScreen;
+
+	sStatistics statistics;
+	for ( const auto& entry : m_entries )
+	{
+		++statistics.assetCount;
+		statistics.storedByteCount += entry.location.storedSize;
+		size_t loadedByteCount = 0;
+		auto localResult = Results::Failure;
+		switch ( entry.type )
+		{
+		case eAssetType::Mesh:
+			if ( entry.mesh && ( localResult = Mesh::s_manager.WaitUntilLoaded( entry.mesh ) ) )
+			{
+				loadedByteCount = Mesh::s_manager.Get( entry.mesh )->GetMemorySize();
+			}
+			break;
+		case eAssetType::Texture:
+			if ( entry.texture && ( localResult = cTexture::s_manager.WaitUntilLoaded( entry.texture ) ) )
+			{
+				loadedByteCount = cTexture::s_manager.Get( entry.texture )->GetMemorySize();
+			}
+			break;
+		}
+		if ( localResult )
+		{
+			statistics.loadedByteCount += loadedByteCount;
+		}
+		else
+		{
+			++statistics.failedAssetCount;
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	statistics.elapsedSecondCount = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - m_loadStartTickCount );
+
+	Logging::OutputMessage( "Preloaded %u assets (%u failed) by reading %u KB into %u KB in %.3f seconds",
+		statistics.assetCount, statistics.failedAssetCount,
+		static_cast<unsigned int>( statistics.storedByteCount / 1024 ), static_cast<unsigned int>( statistics.loadedByteCount / 1024 ),
+		statistics.elapsedSecondCount );
+	if ( o_statistics )
+	{
+		*o_statistics = statistics;
+	}
+
+	return result;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cPreloadManifest::CleanUp()
+{
+	auto result = Results::Success;
+
+	for ( auto& entry : m_entries )
+	{
+		auto localResult = Results::Success;
+		if ( entry.mesh )
+		{
+			localResult = Mesh::s_manager.Release( entry.mesh );
+		}
+		if ( entry.texture )
+		{
+			localResult = cTexture::s_manager.Release( entry.texture );
+		}
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	m_entries.clear();
+	m_hasLoadStarted = false;
+
+	return result;
+}
+
+eae6320::Graphics::cPreloadManifest::~cPreloadManifest()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::string GetFilePath( const eae6320::Graphics::cPreloadManifest::eAssetType i_type, const char* const i_path )
+	{
+		switch ( i_type )
+		{
+		case eae6320::Graphics::cPreloadManifest::eAssetType::Mesh:
+			return std::string( MESH_FILE_DIRECTORY ) + i_path;
+		case eae6320::Graphics::cPreloadManifest::eAssetType::Texture:
+			return std::string( TEXTURE_FILE_DIRECTORY ) + i_path;
+		}
+		return i_path;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+	A preload manifest loads a list of assets together
+
+	Every asset in the manifest is loaded asynchronously at the same time:
+		* The files are read in parallel by the asynchronous loading worker threads,
+			and files that are in packages are requested in package order
+			(so that each package is read from beginning to end)
+		* The files are parsed by the same worker threads
+		* The render thread creates the graphics objects in batches
+			(every asset that has finished being read when it checks)
+	WaitUntilLoaded() is a single completion barrier for the whole manifest.
+
+	The manifest holds a reference to every one of its assets until it is cleaned up,
+	and so loading one of them through its asset manager in the meantime doesn't read the file again.
+*/
+
+#ifndef EAE6320_GRAPHICS_CPRELOADMANIFEST_H
+#define EAE6320_GRAPHICS_CPRELOADMANIFEST_H
+
+// Include Files
+//==============
+
+#include "cTexture.h"
+#include "Mesh.h"
+
+#include <cstdint>
+#include <Engine/Assets/cPathId.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cPreloadManifest
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Only assets that can be loaded asynchronously can be preloaded
+			enum class eAssetType : uint8_t
+			{
+				Mesh,
+				Texture,
+			};
+
+			struct sStatistics
+			{
+				uint32_t assetCount = 0;
+				uint32_t failedAssetCount = 0;
+				// The number of bytes in the files that were read
+				uint64_t storedByteCount = 0;
+				// The number of bytes of CPU and GPU memory that the loaded assets use
+				uint64_t loadedByteCount = 0;
+				// From when Load() was called until every asset had either loaded or failed to load
+				double elapsedSecondCount = 0.0;
+			};
+
+			// Building
+			//---------
+
+			// The path is the same one that would be passed to the asset's manager
+			cResult Add( const eAssetType i_type, const char* const i_path );
+			cResult Add( const eAssetType i_type, const Assets::cPathId i_pathId );
+
+			// Loading
+			//--------
+
+			// Starts loading every asset in the manifest
+			// (this can only be called once)
+			cResult Load();
+			// Blocks until every asset has either loaded or failed to load,
+			// and returns a failure if any of them failed.
+			// Like cManager::WaitUntilLoaded() this must be called from the render thread
+			// and not from the application loop thread.
+			cResult WaitUntilLoaded( sStatistics* const o_statistics = nullptr );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// The manifest's references to its assets are released
+			cResult CleanUp();
+
+			cPreloadManifest() = default;
+			~cPreloadManifest();
+
+			cPreloadManifest( const cPreloadManifest& ) = delete;
+			cPreloadManifest& operator =( const cPreloadManifest& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			struct sEntry
+			{
+				eAssetType type;
+				Assets::cPathId pathId;
+				Platform::sFileLocation location;
+				Mesh::Handle mesh;
+				cTexture::Handle texture;
+			};
+			std::vector<sEntry> m_entries;
+			uint64_t m_loadStartTickCount = 0;
+			bool m_hasLoadStarted = false;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CPRELOADMANIFEST_H
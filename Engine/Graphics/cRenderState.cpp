@@ -3,9 +3,124 @@
 
 #include "cRenderState.h"
 
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Logging/Logging.h>
+#include <limits>
+#include <new>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// Every possible combination of bits has its own slot
+	struct sSharedRenderState
+	{
+		eae6320::Graphics::cRenderState* renderState = nullptr;
+		uint16_t referenceCount = 0;
+	};
+	sSharedRenderState s_sharedRenderStates[std::numeric_limits<uint8_t>::max() + 1];
+	eae6320::Concurrency::cMutex s_sharedRenderStatesMutex{ "Graphics::cRenderState" };
+}
+
 // Interface
 //==========
 
+// Sharing
+//--------
+
+eae6320::cResult eae6320::Graphics::cRenderState::Acquire( const uint8_t i_renderStateBits, const cRenderState*& o_renderState )
+{
+	auto result = Results::Success;
+
+	Concurrency::cMutex::cScopeLock autoLock( s_sharedRenderStatesMutex );
+	auto& sharedRenderState = s_sharedRenderStates[i_renderStateBits];
+	if ( sharedRenderState.renderState )
+	{
+		EAE6320_ASSERT( sharedRenderState.referenceCount > 0 );
+		EAE6320_ASSERT( sharedRenderState.referenceCount < std::numeric_limits<decltype( sharedRenderState.referenceCount )>::max() );
+		++sharedRenderState.referenceCount;
+		o_renderState = sharedRenderState.renderState;
+		return result;
+	}
+	// The first reference to these bits creates the platform state objects
+	auto* const renderState = new ( std::nothrow ) cRenderState();
+	if ( !renderState )
+	{
+		result = Results::OutOfMemory;
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the render state" );
+		Logging::OutputError( "Failed to allocate memory for the render state" );
+		goto OnExit;
+	}
+	if ( !( result = renderState->Initialize( i_renderStateBits ) ) )
+	{
+		EAE6320_ASSERTF( false, "Initialization of the shared render state %u failed", static_cast<unsigned int>( i_renderStateBits ) );
+		goto OnExit;
+	}
+
+OnExit:
+
+	if ( result )
+	{
+		sharedRenderState.renderState = renderState;
+		sharedRenderState.referenceCount = 1;
+		o_renderState = renderState;
+	}
+	else
+	{
+		delete renderState;
+		o_renderState = nullptr;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cRenderState::Release( const cRenderState*& io_renderState )
+{
+	auto result = Results::Success;
+
+	if ( !io_renderState )
+	{
+		return result;
+	}
+	cRenderState* renderStateToDelete = nullptr;
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_sharedRenderStatesMutex );
+		auto& sharedRenderState = s_sharedRenderStates[io_renderState->GetRenderStateBits()];
+		EAE6320_ASSERTF( sharedRenderState.renderState == io_renderState, "A render state that wasn't acquired is being released" );
+		EAE6320_ASSERT( sharedRenderState.referenceCount > 0 );
+		if ( --sharedRenderState.referenceCount == 0 )
+		{
+			renderStateToDelete = sharedRenderState.renderState;
+			sharedRenderState.renderState = nullptr;
+		}
+	}
+	io_renderState = nullptr;
+	if ( renderStateToDelete )
+	{
+		result = renderStateToDelete->CleanUp();
+		EAE6320_ASSERT( result );
+		delete renderStateToDelete;
+	}
+
+	return result;
+}
+
+unsigned int eae6320::Graphics::cRenderState::GetSharedRenderStateCount()
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_sharedRenderStatesMutex );
+	unsigned int count = 0;
+	for ( const auto& sharedRenderState : s_sharedRenderStates )
+	{
+		if ( sharedRenderState.renderState )
+		{
+			++count;
+		}
+	}
+	return count;
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -91,6 +91,20 @@ namespace eae6320
 
 			uint8_t GetRenderStateBits() const;
 
+			// Sharing
+			//--------
+
+			// There are only 256 possible combinations of render state bits,
+			// and so every render state with the same bits can share the same platform state objects.
+			// Acquire() returns the shared render state for the bits (creating it if it doesn't exist yet)
+			// and every successful call must be matched by a call to Release()
+			// (the shared render state is cleaned up when its last reference is released).
+			// These are thread-safe.
+			static cResult Acquire( const uint8_t i_renderStateBits, const cRenderState*& o_renderState );
+			static cResult Release( const cRenderState*& io_renderState );
+			// This returns the number of shared render states that currently exist
+			static unsigned int GetSharedRenderStateCount();
+
 			// Initialization / Clean Up
 			//--------------------------
 
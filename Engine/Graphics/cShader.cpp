@@ -16,6 +16,14 @@ eae6320::Assets::cManager<eae6320::Graphics::cShader> eae6320::Graphics::cShader
 // Interface
 //==========
 
+// Access
+//-------
+
+size_t eae6320::Graphics::cShader::GetMemorySize() const
+{
+	return sizeof( *this ) + m_programSize;
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -67,6 +75,7 @@ eae6320::cResult eae6320::Graphics::cShader::Load( const char* const i_path, cSh
 		EAE6320_ASSERTF( false, "Initialization of new shader failed" );
 		goto OnExit;
 	}
+	newShader->m_programSize = dataFromFile.size;
 
 OnExit:
 
@@ -88,6 +88,13 @@ namespace eae6320
 			using Handle = Assets::cHandle<cShader>;
 			static Assets::cManager<cShader> s_manager;
 
+			// Access
+			//-------
+
+			// The number of bytes of CPU and GPU memory that the shader uses
+			// (this is how the asset manager's retention cache measures it)
+			size_t GetMemorySize() const;
+
 			// Initialization / Clean Up
 			//--------------------------
 
@@ -119,6 +126,8 @@ namespace eae6320
 #endif
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT()
 			const ShaderTypes::eType m_type = ShaderTypes::Unknown;
+			// The size of the compiled program that the shader was created from
+			size_t m_programSize = 0;
 
 			// Implementation
 			//===============
@@ -3,6 +3,9 @@
 
 #include "cTexture.h"
 
+#include "TextureStreaming.h"
+
+#include <algorithm>
 #include <cstring>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
@@ -14,6 +17,20 @@
 
 eae6320::Assets::cManager<eae6320::Graphics::cTexture> eae6320::Graphics::cTexture::s_manager;
 
+namespace
+{
+	// MIP levels that are this size or smaller are always resident
+	constexpr uint16_t s_mipTailMaxDimension = 64;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint_fast8_t CalculateMipTailLevel(const eae6320::Graphics::TextureFormats::sTextureInfo & i_info);
+}
+
 // Interface
 //==========
 
@@ -30,6 +47,40 @@ uint16_t eae6320::Graphics::cTexture::GetHeight() const
 	return m_info.height;
 }
 
+const eae6320::Graphics::TextureFormats::sTextureInfo & eae6320::Graphics::cTexture::GetInfo() const
+{
+	return m_info;
+}
+
+const char * eae6320::Graphics::cTexture::GetPath() const
+{
+	return m_path;
+}
+
+uint_fast8_t eae6320::Graphics::cTexture::GetMipTailLevel() const
+{
+	return CalculateMipTailLevel(m_info);
+}
+
+uint_fast8_t eae6320::Graphics::cTexture::GetMostDetailedResidentMipLevel() const
+{
+	return m_mostDetailedResidentMipLevel;
+}
+
+size_t eae6320::Graphics::cTexture::GetMemorySize() const
+{
+	return sizeof(*this) + TextureFormats::GetSizeOfMipChain(m_info, m_mostDetailedResidentMipLevel);
+}
+
+// Streaming
+//----------
+
+eae6320::cResult eae6320::Graphics::cTexture::UpdateResidentMipLevels(const void * const i_textureData, const size_t i_textureDataSize, const uint_fast8_t i_mostDetailedMipLevel)
+{
+	EAE6320_ASSERT(i_mostDetailedMipLevel < m_info.mipMapCount);
+	return Initialize(m_path, i_textureData, i_textureDataSize, i_mostDetailedMipLevel);
+}
+
 // Initialization / Clean Up
 //--------------------------
 
@@ -37,68 +88,107 @@ eae6320::cResult eae6320::Graphics::cTexture::Load(const char * const i_textureF
 {
 	auto result = Results::Success;
 
+	sFileData fileData;
+	if (!(result = ReadFile(i_textureFileName, fileData)))
+	{
+		o_texture = nullptr;
+		return result;
+	}
+	return CreateFromFileData(fileData, o_texture);
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::ReadFile(const char * const i_textureFileName, sFileData & o_fileData)
+{
+	auto result = Results::Success;
+
 	Platform::sDataFromFile dataFromFile;
-	cTexture * newTexture = nullptr;
 
 	// Automate the file path since compiled files will have to go into this folder
-	char completeFilePath[MAX_TEXTURE_PATH_LENGTH] = "data/Textures/";
-	strcat(completeFilePath, i_textureFileName);
+	char * const completeFilePath = o_fileData.path;
+	strcpy(completeFilePath, TEXTURE_FILE_DIRECTORY);
+	strncat(completeFilePath, i_textureFileName, MAX_TEXTURE_PATH_LENGTH - strlen(completeFilePath) - 1);
 
-	// Load the binary data
+	// The file starts with information about the texture
 	{
 		std::string errorMessage;
-		if (!(result = Platform::LoadBinaryFile(completeFilePath, dataFromFile, &errorMessage)))
+		if (!(result = Platform::LoadPartOfBinaryFile(completeFilePath, 0, sizeof(TextureFormats::sTextureInfo), dataFromFile, &errorMessage)))
 		{
 			EAE6320_ASSERTF(false, errorMessage.c_str());
-			Logging::OutputError("Failed to load texture data from file %s: %s", completeFilePath, errorMessage.c_str());
+			Logging::OutputError("Failed to load texture information from file %s: %s", completeFilePath, errorMessage.c_str());
 			goto OnExit;
 		}
-	}
-
-	// Extract data from the file
-	auto currentOffset = reinterpret_cast<uintptr_t>(dataFromFile.data);
-	const auto finalOffset = currentOffset + dataFromFile.size;
-
-	// The file starts with information about the texture
-	{
-		const auto newOffset = currentOffset + sizeof(TextureFormats::sTextureInfo);
-		if (newOffset <= finalOffset)
+		const auto * const textureInfo = reinterpret_cast<TextureFormats::sTextureInfo *>(dataFromFile.data);
+		// A file built with a different layout can't be read correctly
+		if (textureInfo->signature != TextureFormats::s_signature)
 		{
-			const auto * const textureInfo = reinterpret_cast<TextureFormats::sTextureInfo *>(currentOffset);
-			EAE6320_ASSERT((textureInfo->width % 4u) == 0u);
-			EAE6320_ASSERT((textureInfo->height % 4u) == 0u);
-			currentOffset = newOffset;
-			// Allocate a new texture with the information
-			newTexture = new (std::nothrow) cTexture(*textureInfo);
-			if (!newTexture)
-			{
-				result = Results::OutOfMemory;
-				EAE6320_ASSERTF(false, "Couldn't allocate memory for the texture %s", completeFilePath);
-				Logging::OutputError("Failed to allocate memory for the texture %s", completeFilePath);
-				goto OnExit;
-			}
+			result = Results::InvalidFile;
+			EAE6320_ASSERTF(false, "The texture file %s isn't in the current texture format and must be rebuilt", completeFilePath);
+			Logging::OutputError("The texture file %s isn't in the current texture format"
+				" (it was probably built by an older TextureBuilder) and must be rebuilt", completeFilePath);
+			goto OnExit;
+		}
+		if (textureInfo->version != TextureFormats::s_version)
+		{
+			result = Results::InvalidFile;
+			EAE6320_ASSERTF(false, "The texture file %s has version %u instead of %u and must be rebuilt",
+				completeFilePath, static_cast<unsigned int>(textureInfo->version), static_cast<unsigned int>(TextureFormats::s_version));
+			Logging::OutputError("The texture file %s was built with version %u of the texture format instead of version %u and must be rebuilt",
+				completeFilePath, static_cast<unsigned int>(textureInfo->version), static_cast<unsigned int>(TextureFormats::s_version));
+			goto OnExit;
 		}
-		else
+		EAE6320_ASSERT((textureInfo->width % 4u) == 0u);
+		EAE6320_ASSERT((textureInfo->height % 4u) == 0u);
+		if (textureInfo->mipMapCount == 0)
 		{
 			result = Results::InvalidFile;
-			EAE6320_ASSERTF(false, "The texture file %s is too small (%u) to include texture information (%u)",
-				completeFilePath, dataFromFile.size, sizeof(TextureFormats::sTextureInfo));
-			Logging::OutputError("The texture file %s is too small (%u) to include texture information (%u)",
-				completeFilePath, dataFromFile.size, sizeof(TextureFormats::sTextureInfo));
+			EAE6320_ASSERTF(false, "The texture file %s doesn't have any MIP maps", completeFilePath);
+			Logging::OutputError("The texture file %s doesn't have any MIP maps", completeFilePath);
 			goto OnExit;
 		}
+		memcpy(&o_fileData.info, textureInfo, sizeof(o_fileData.info));
 	}
-	// The rest of the data is pixel information that is used to create platform-specific textures
+	// Only the MIP tail is loaded now
+	// (the MIP maps are stored from smallest to largest, and so the tail is at the beginning of the pixel data)
+	// and the more detailed MIP levels are streamed in once the texture is drawn
 	{
-		const auto * const textureData = reinterpret_cast<void *>(currentOffset);
-		const auto textureDataSize = static_cast<size_t>(finalOffset - currentOffset);
-		if (!(result = newTexture->Initialize(completeFilePath, textureData, textureDataSize)))
+		o_fileData.mipTailLevel = CalculateMipTailLevel(o_fileData.info);
+		const auto textureDataSize = TextureFormats::GetSizeOfMipChain(o_fileData.info, o_fileData.mipTailLevel);
+		std::string errorMessage;
+		if (!(result = Platform::LoadPartOfBinaryFile(completeFilePath, sizeof(TextureFormats::sTextureInfo), textureDataSize, o_fileData.mipTail, &errorMessage)))
 		{
-			EAE6320_ASSERTF(false, "Initialization of new texture failed");
+			EAE6320_ASSERTF(false, errorMessage.c_str());
+			Logging::OutputError("Failed to load the MIP tail from texture file %s: %s", completeFilePath, errorMessage.c_str());
 			goto OnExit;
 		}
 	}
 
+OnExit:
+
+	dataFromFile.Free();
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::CreateFromFileData(sFileData & io_fileData, cTexture *& o_texture)
+{
+	auto result = Results::Success;
+
+	// Allocate a new texture with the information
+	cTexture * newTexture = new (std::nothrow) cTexture(io_fileData.info, io_fileData.path);
+	if (!newTexture)
+	{
+		result = Results::OutOfMemory;
+		EAE6320_ASSERTF(false, "Couldn't allocate memory for the texture %s", io_fileData.path);
+		Logging::OutputError("Failed to allocate memory for the texture %s", io_fileData.path);
+		goto OnExit;
+	}
+	if (!(result = newTexture->Initialize(io_fileData.path, io_fileData.mipTail.data, io_fileData.mipTail.size, io_fileData.mipTailLevel)))
+	{
+		EAE6320_ASSERTF(false, "Initialization of new texture failed");
+		goto OnExit;
+	}
+	TextureStreaming::RegisterTexture(*newTexture);
+
 OnExit:
 
 	if (result)
@@ -115,7 +205,7 @@ OnExit:
 		}
 		o_texture = nullptr;
 	}
-	dataFromFile.Free();
+	io_fileData.mipTail.Free();
 
 	return result;
 }
@@ -137,13 +227,34 @@ eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
 // Initialization / Clean Up
 //--------------------------
 
-eae6320::Graphics::cTexture::cTexture(const TextureFormats::sTextureInfo & i_info)
+eae6320::Graphics::cTexture::cTexture(const TextureFormats::sTextureInfo & i_info, const char * const i_path)
 {
 	// Copy the information from the file
 	memcpy(&m_info, &i_info, sizeof(m_info));
+	strncpy(m_path, i_path, MAX_TEXTURE_PATH_LENGTH - 1);
 }
 
 eae6320::Graphics::cTexture::~cTexture()
 {
+	TextureStreaming::UnregisterTexture(*this);
 	CleanUp();
 }
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint_fast8_t CalculateMipTailLevel(const eae6320::Graphics::TextureFormats::sTextureInfo & i_info)
+	{
+		const auto mipMapCount = static_cast<uint_fast8_t>(i_info.mipMapCount);
+		for (uint_fast8_t i = 0; i < mipMapCount; ++i)
+		{
+			if ((std::max(i_info.width, i_info.height) >> i) <= s_mipTailMaxDimension)
+			{
+				return i;
+			}
+		}
+		return static_cast<uint_fast8_t>(mipMapCount - 1);
+	}
+}
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/cManager.h>
+#include <Engine/Platform/Platform.h>
 #include <Engine/Results/Results.h>
 
 #ifdef EAE6320_PLATFORM_GL
@@ -26,6 +27,8 @@
 #endif
 
 #define MAX_TEXTURE_PATH_LENGTH 100
+// Texture file names are relative to this directory
+#define TEXTURE_FILE_DIRECTORY "data/Textures/"
 
 // Forward Declarations
 //=====================
@@ -66,6 +69,27 @@ namespace eae6320
 
 			uint16_t GetWidth() const;
 			uint16_t GetHeight() const;
+			const TextureFormats::sTextureInfo& GetInfo() const;
+			const char* GetPath() const;
+
+			// Only some of a texture's MIP levels are resident at any one time.
+			// The least detailed ones (the "MIP tail") are always resident,
+			// and the more detailed ones are streamed in and out by TextureStreaming
+			// (MIP level 0 is the most detailed)
+			uint_fast8_t GetMipTailLevel() const;
+			uint_fast8_t GetMostDetailedResidentMipLevel() const;
+
+			// The number of bytes of CPU and GPU memory that the texture currently uses
+			// (only the resident MIP levels are counted)
+			size_t GetMemorySize() const;
+
+			// Streaming
+			//----------
+
+			// This replaces the resident MIP levels with the specified one and every less detailed one.
+			// The data must be in the same order as the texture file (from the least detailed to the most detailed).
+			// This must be called from the render thread.
+			cResult UpdateResidentMipLevels(const void * const i_textureData, const size_t i_textureDataSize, const uint_fast8_t i_mostDetailedMipLevel);
 
 			// Initialization / Clean Up
 			//--------------------------
@@ -73,6 +97,31 @@ namespace eae6320
 			static cResult Load(const char * const i_textureFileName, cTexture *& o_texture);
 			cResult CleanUp();
 
+			// Asynchronous Loading
+			//---------------------
+
+			// Load() is ReadFile() followed by CreateFromFileData(),
+			// and they are separate so that cTexture::s_manager.LoadAsync() can read the file on a background thread
+			struct sFileData
+			{
+				TextureFormats::sTextureInfo info;
+				char path[MAX_TEXTURE_PATH_LENGTH] = {};
+				uint_fast8_t mipTailLevel = 0;
+				Platform::sDataFromFile mipTail;
+
+				sFileData() = default;
+				sFileData(const sFileData &) = delete;
+				sFileData & operator =(const sFileData &) = delete;
+				~sFileData() { mipTail.Free(); }
+
+				// Creating the texture uploads only the MIP tail
+				// (more detailed MIP levels are streamed later)
+				size_t GetUploadByteCount() const { return mipTail.size; }
+			};
+			static cResult ReadFile(const char * const i_textureFileName, sFileData & o_fileData);
+			// This must be called from the render thread
+			static cResult CreateFromFileData(sFileData & io_fileData, cTexture *& o_texture);
+
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cTexture)
 
 			// Reference Counting
@@ -97,6 +146,8 @@ namespace eae6320
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT()
 
 			TextureFormats::sTextureInfo m_info;
+			char m_path[MAX_TEXTURE_PATH_LENGTH] = {};
+			uint8_t m_mostDetailedResidentMipLevel = 0;
 
 			// Implementation
 			//===============
@@ -106,10 +157,12 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
-			cResult Initialize(const char * const i_path, const void * const i_textureData, const size_t i_textureDataSize);
+			// This creates a new platform-specific texture with the specified MIP levels
+			// and only releases the existing one if that succeeds
+			cResult Initialize(const char * const i_path, const void * const i_textureData, const size_t i_textureDataSize, const uint_fast8_t i_mostDetailedMipLevel);
 			cResult CleanUpTexture();
 
-			cTexture(const TextureFormats::sTextureInfo & i_info);
+			cTexture(const TextureFormats::sTextureInfo & i_info, const char * const i_path);
 			~cTexture();
 		};
 	}
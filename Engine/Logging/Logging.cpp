@@ -5,6 +5,7 @@
 
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <Engine/Asserts/Asserts.h>
 #include <fstream>
 #include <sstream>
@@ -0,0 +1,484 @@
+// Include Files
+//==============
+
+#include "AsyncFileIo.h"
+
+#include <algorithm>
+#include <deque>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/BackgroundThrottling.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sRequest
+	{
+		enum class eState : uint8_t
+		{
+			Pending,
+			BeingRead,
+			Complete,
+		};
+
+		std::string path;
+		uint64_t offset = 0;
+		size_t size = 0;
+		// If this is null the entire file is loaded into allocated memory
+		void* destination = nullptr;
+		eae6320::Platform::sDataFromFile data;
+		std::string errorMessage;
+		eae6320::cResult result;
+		eae6320::Platform::AsyncFileIo::fOnCompletion onCompletion;
+		eState state = eState::Pending;
+	};
+	std::unordered_map<uint64_t, sRequest> s_requests;
+	// The IDs of requests waiting to be read, one queue for every priority
+	// (a cancelled request's ID is left in its queue and skipped)
+	std::deque<uint64_t> s_pendingRequestIds[static_cast<size_t>( eae6320::Platform::AsyncFileIo::ePriority::Count )];
+	uint64_t s_nextRequestId = 1;
+	eae6320::Concurrency::cMutex s_requestsMutex{ "Platform::AsyncFileIo" };
+	eae6320::Concurrency::cEvent s_whenRequestsArePending;
+	// This is signaled every time that a request finishes
+	// so that threads waiting for a request can check again
+	eae6320::Concurrency::cEvent s_whenRequestsHaveFinished;
+
+	constexpr unsigned int s_maxIoThreadCount = 16;
+	eae6320::Concurrency::cThread s_ioThreads[s_maxIoThreadCount];
+	unsigned int s_ioThreadCount = 0;
+	bool s_shouldIoThreadsExit = false;
+	bool s_isInitialized = false;
+
+	// Waiting for a request times out periodically
+	// in case the event was signaled for a different waiting thread
+	constexpr unsigned int s_maxTimeToWaitForRequest_inMilliseconds = 5;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	void EntryPoint_ioThread( void* const io_userData );
+	eae6320::Platform::AsyncFileIo::sRequestHandle QueueRequest( sRequest&& i_request, const eae6320::Platform::AsyncFileIo::ePriority i_priority );
+	// The request must have been removed from the pending queues
+	void ReadRequest( sRequest& io_request );
+	eae6320::Concurrency::BackgroundThrottling::ePriority ConvertToBackgroundPriority( const eae6320::Platform::AsyncFileIo::ePriority i_priority );
+}
+
+// Interface
+//==========
+
+// Requests
+//---------
+
+eae6320::Platform::AsyncFileIo::sRequestHandle eae6320::Platform::AsyncFileIo::QueueLoad( const char* const i_path, const ePriority i_priority )
+{
+	sRequest request;
+	{
+		request.path = i_path;
+	}
+	return QueueRequest( std::move( request ), i_priority );
+}
+
+eae6320::Platform::AsyncFileIo::sRequestHandle eae6320::Platform::AsyncFileIo::QueueRead( const char* const i_path,
+	const uint64_t i_offset, const size_t i_size, void* const o_destination, const ePriority i_priority )
+{
+	EAE6320_ASSERT( o_destination || ( i_size == 0 ) );
+	sRequest request;
+	{
+		request.path = i_path;
+		request.offset = i_offset;
+		request.size = i_size;
+		request.destination = o_destination;
+	}
+	return QueueRequest( std::move( request ), i_priority );
+}
+
+bool eae6320::Platform::AsyncFileIo::IsRequestComplete( const sRequestHandle i_request )
+{
+	Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+	const auto iterator = s_requests.find( i_request.id );
+	EAE6320_ASSERTF( iterator != s_requests.end(), "Invalid asynchronous file I/O request" );
+	return ( iterator != s_requests.end() ) && ( iterator->second.state == sRequest::eState::Complete );
+}
+
+void eae6320::Platform::AsyncFileIo::WhenRequestCompletes( const sRequestHandle i_request, const fOnCompletion& i_onCompletion )
+{
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+		const auto iterator = s_requests.find( i_request.id );
+		if ( iterator == s_requests.end() )
+		{
+			EAE6320_ASSERTF( false, "Invalid asynchronous file I/O request" );
+			return;
+		}
+		auto& request = iterator->second;
+		EAE6320_ASSERTF( !request.onCompletion, "A request can only have one completion callback" );
+		if ( request.state != sRequest::eState::Complete )
+		{
+			request.onCompletion = i_onCompletion;
+			return;
+		}
+	}
+	// The callback is never called while the lock is held
+	// (so that it can use the request)
+	i_onCompletion();
+}
+
+eae6320::cResult eae6320::Platform::AsyncFileIo::WaitForRequest( sRequestHandle& io_request, sDataFromFile* const o_data, std::string* const o_errorMessage )
+{
+	sRequest request;
+	while ( true )
+	{
+		{
+			Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+			const auto iterator = s_requests.find( io_request.id );
+			if ( iterator == s_requests.end() )
+			{
+				EAE6320_ASSERTF( false, "Invalid asynchronous file I/O request" );
+				io_request = sRequestHandle();
+				return Results::Failure;
+			}
+			if ( iterator->second.state == sRequest::eState::Complete )
+			{
+				request = std::move( iterator->second );
+				s_requests.erase( iterator );
+				break;
+			}
+		}
+		Concurrency::WaitForEvent( s_whenRequestsHaveFinished, s_maxTimeToWaitForRequest_inMilliseconds );
+	}
+	io_request = sRequestHandle();
+
+	if ( o_data )
+	{
+		*o_data = request.data;
+	}
+	else if ( !request.destination )
+	{
+		request.data.Free();
+	}
+	if ( o_errorMessage )
+	{
+		*o_errorMessage = std::move( request.errorMessage );
+	}
+	return request.result;
+}
+
+void eae6320::Platform::AsyncFileIo::CancelRequest( sRequestHandle& io_request )
+{
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+		const auto iterator = s_requests.find( io_request.id );
+		if ( iterator == s_requests.end() )
+		{
+			EAE6320_ASSERTF( false, "Invalid asynchronous file I/O request" );
+			io_request = sRequestHandle();
+			return;
+		}
+		if ( iterator->second.state == sRequest::eState::Pending )
+		{
+			s_requests.erase( iterator );
+			io_request = sRequestHandle();
+			return;
+		}
+	}
+	// A request that is being read can't be stopped,
+	// and so it is waited for to guarantee that nothing else is written to its destination
+	WaitForRequest( io_request );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Platform::AsyncFileIo::Initialize( const unsigned int i_ioThreadCount, const Concurrency::sThreadOptions& i_threadOptions )
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERTF( !s_isInitialized, "Asynchronous file I/O has already been initialized" );
+	s_shouldIoThreadsExit = false;
+
+	if ( !( result = s_whenRequestsArePending.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the asynchronous file I/O event" );
+		goto OnExit;
+	}
+	if ( !( result = s_whenRequestsHaveFinished.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't initialize the asynchronous file I/O event" );
+		goto OnExit;
+	}
+	{
+		const auto ioThreadCount = std::min( std::max( i_ioThreadCount, 1u ), s_maxIoThreadCount );
+		for ( s_ioThreadCount = 0; s_ioThreadCount < ioThreadCount; ++s_ioThreadCount )
+		{
+			const auto threadName = std::string( i_threadOptions.name ? i_threadOptions.name : "File I/O" ) + " " + std::to_string( s_ioThreadCount + 1 );
+			auto threadOptions = i_threadOptions;
+			threadOptions.name = threadName.c_str();
+			if ( !( result = s_ioThreads[s_ioThreadCount].Start( EntryPoint_ioThread, nullptr, threadOptions ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start an asynchronous file I/O thread" );
+				goto OnExit;
+			}
+		}
+	}
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+		s_isInitialized = true;
+	}
+
+OnExit:
+
+	if ( !result )
+	{
+		const auto localResult = CleanUp();
+		EAE6320_ASSERT( localResult );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::AsyncFileIo::CleanUp()
+{
+	auto result = Results::Success;
+
+	// Stop the I/O threads
+	// (each one finishes the request that it is reading)
+	{
+		Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+		s_isInitialized = false;
+		s_shouldIoThreadsExit = true;
+	}
+	if ( s_ioThreadCount > 0 )
+	{
+		if ( s_whenRequestsArePending.Signal() )
+		{
+			for ( unsigned int i = 0; i < s_ioThreadCount; ++i )
+			{
+				const auto localResult = Concurrency::WaitForThreadToStop( s_ioThreads[i] );
+				if ( !localResult )
+				{
+					EAE6320_ASSERTF( false, "Couldn't wait for an asynchronous file I/O thread to stop" );
+					if ( result )
+					{
+						result = localResult;
+					}
+				}
+			}
+		}
+		s_ioThreadCount = 0;
+	}
+	// Any requests that haven't been read are finished as cancelled
+	// so that waiting for them doesn't block forever
+	{
+		std::vector<fOnCompletion> completionCallbacks;
+		{
+			Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+			for ( auto& pendingRequestIds : s_pendingRequestIds )
+			{
+				pendingRequestIds.clear();
+			}
+			for ( auto& request : s_requests )
+			{
+				if ( request.second.state != sRequest::eState::Complete )
+				{
+					request.second.result = Results::Platform::AsyncRequestCancelled;
+					request.second.errorMessage = "The request was cancelled because asynchronous file I/O was cleaned up";
+					request.second.state = sRequest::eState::Complete;
+					if ( request.second.onCompletion )
+					{
+						completionCallbacks.push_back( std::move( request.second.onCompletion ) );
+					}
+				}
+			}
+		}
+		for ( const auto& onCompletion : completionCallbacks )
+		{
+			onCompletion();
+		}
+	}
+	{
+		const auto localResult = s_whenRequestsArePending.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+	{
+		const auto localResult = s_whenRequestsHaveFinished.CleanUp();
+		if ( !localResult )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = localResult;
+			}
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	void EntryPoint_ioThread( void* const io_userData )
+	{
+		while ( true )
+		{
+			const auto result = eae6320::Concurrency::WaitForEvent( s_whenRequestsArePending );
+			if ( !result )
+			{
+				EAE6320_ASSERTF( false, "Waiting for asynchronous file I/O requests failed" );
+				return;
+			}
+			// Read requests until there aren't any left
+			while ( true )
+			{
+				uint64_t requestId = 0;
+				sRequest request;
+				auto priority = eae6320::Platform::AsyncFileIo::ePriority::Count;
+				eae6320::Platform::AsyncFileIo::fOnCompletion onCompletion;
+				{
+					eae6320::Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+					if ( s_shouldIoThreadsExit )
+					{
+						// The event resets automatically,
+						// and so it must be signaled again for the next I/O thread to see that it should exit
+						s_whenRequestsArePending.Signal();
+						return;
+					}
+					// Find the highest priority request that hasn't been cancelled
+					auto hasRequestBeenFound = false;
+					for ( size_t i = 0; ( i < static_cast<size_t>( eae6320::Platform::AsyncFileIo::ePriority::Count ) ) && !hasRequestBeenFound; ++i )
+					{
+						auto& pendingRequestIds = s_pendingRequestIds[i];
+						while ( !pendingRequestIds.empty() && !hasRequestBeenFound )
+						{
+							requestId = pendingRequestIds.front();
+							pendingRequestIds.pop_front();
+							const auto iterator = s_requests.find( requestId );
+							if ( iterator != s_requests.end() )
+							{
+								auto& pendingRequest = iterator->second;
+								EAE6320_ASSERT( pendingRequest.state == sRequest::eState::Pending );
+								pendingRequest.state = sRequest::eState::BeingRead;
+								// The path and destination are copied
+								// so that the request can be read without holding the lock
+								request.path = pendingRequest.path;
+								request.offset = pendingRequest.offset;
+								request.size = pendingRequest.size;
+								request.destination = pendingRequest.destination;
+								priority = static_cast<eae6320::Platform::AsyncFileIo::ePriority>( i );
+								hasRequestBeenFound = true;
+							}
+						}
+					}
+					if ( !hasRequestBeenFound )
+					{
+						break;
+					}
+					// If there are more requests another I/O thread can start on them
+					if ( std::any_of( std::begin( s_pendingRequestIds ), std::end( s_pendingRequestIds ),
+						[]( const std::deque<uint64_t>& i_pendingRequestIds ) { return !i_pendingRequestIds.empty(); } ) )
+					{
+						s_whenRequestsArePending.Signal();
+					}
+				}
+				// If the frame is close to missing its deadline the read waits
+				// (cancelling the request also waits, but only for as long as the read can be throttled)
+				eae6320::Concurrency::BackgroundThrottling::WaitUntilWorkIsAllowed( ConvertToBackgroundPriority( priority ) );
+				ReadRequest( request );
+				{
+					eae6320::Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+					const auto iterator = s_requests.find( requestId );
+					EAE6320_ASSERT( iterator != s_requests.end() );
+					auto& finishedRequest = iterator->second;
+					finishedRequest.data = request.data;
+					finishedRequest.errorMessage = std::move( request.errorMessage );
+					finishedRequest.result = request.result;
+					finishedRequest.state = sRequest::eState::Complete;
+					onCompletion = std::move( finishedRequest.onCompletion );
+				}
+				s_whenRequestsHaveFinished.Signal();
+				if ( onCompletion )
+				{
+					onCompletion();
+				}
+			}
+		}
+	}
+
+	eae6320::Platform::AsyncFileIo::sRequestHandle QueueRequest( sRequest&& i_request, const eae6320::Platform::AsyncFileIo::ePriority i_priority )
+	{
+		EAE6320_ASSERT( i_priority < eae6320::Platform::AsyncFileIo::ePriority::Count );
+		eae6320::Platform::AsyncFileIo::sRequestHandle handle;
+		bool isInitialized;
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+			isInitialized = s_isInitialized;
+		}
+		// If there are no I/O threads the request is read immediately
+		if ( !isInitialized )
+		{
+			ReadRequest( i_request );
+			i_request.state = sRequest::eState::Complete;
+		}
+		{
+			eae6320::Concurrency::cMutex::cScopeLock autoLock( s_requestsMutex );
+			handle.id = s_nextRequestId++;
+			s_requests[handle.id] = std::move( i_request );
+			if ( isInitialized )
+			{
+				s_pendingRequestIds[static_cast<size_t>( i_priority )].push_back( handle.id );
+				const auto result = s_whenRequestsArePending.Signal();
+				EAE6320_ASSERT( result );
+			}
+		}
+		return handle;
+	}
+
+	void ReadRequest( sRequest& io_request )
+	{
+		if ( io_request.destination )
+		{
+			io_request.result = eae6320::Platform::ReadBinaryFile( io_request.path.c_str(), io_request.offset, io_request.size,
+				io_request.destination, &io_request.errorMessage );
+			if ( io_request.result )
+			{
+				io_request.data.data = io_request.destination;
+				io_request.data.size = io_request.size;
+			}
+		}
+		else
+		{
+			io_request.result = eae6320::Platform::LoadBinaryFile( io_request.path.c_str(), io_request.data, &io_request.errorMessage );
+		}
+	}
+
+	eae6320::Concurrency::BackgroundThrottling::ePriority ConvertToBackgroundPriority( const eae6320::Platform::AsyncFileIo::ePriority i_priority )
+	{
+		switch ( i_priority )
+		{
+		case eae6320::Platform::AsyncFileIo::ePriority::High: return eae6320::Concurrency::BackgroundThrottling::ePriority::High;
+		case eae6320::Platform::AsyncFileIo::ePriority::Normal: return eae6320::Concurrency::BackgroundThrottling::ePriority::Normal;
+		case eae6320::Platform::AsyncFileIo::ePriority::Low: return eae6320::Concurrency::BackgroundThrottling::ePriority::Low;
+		default:
+			EAE6320_ASSERTF( false, "Invalid asynchronous file I/O priority" );
+			return eae6320::Concurrency::BackgroundThrottling::ePriority::Normal;
+		}
+	}
+}
@@ -0,0 +1,109 @@
+/*
+	Asynchronous file I/O lets many files be read at the same time
+	without blocking the thread that requested them
+
+	A request is read by one of a pool of I/O threads
+	(using the same code as LoadBinaryFile() and LoadPartOfBinaryFile(),
+	and so packaged and compressed files are read the same way):
+		* Requests with a higher priority are read first,
+			and requests with the same priority are read in the order that they were queued
+		* A request that hasn't started being read can be cancelled
+		* The bytes can either be read into memory that the caller provides
+			or into memory that is allocated for the request
+	Every request that is queued must eventually be either waited for or cancelled.
+
+	The I/O threads themselves are platform-independent,
+	and each one does ordinary blocking reads through the platform's file functions
+	(SetFilePointerEx() and ReadFile() on Windows and pread() on POSIX platforms);
+	overlapped I/O and io_uring aren't used, and so how many files are read at the same time
+	is limited by the number of I/O threads.
+*/
+
+#ifndef EAE6320_PLATFORM_ASYNCFILEIO_H
+#define EAE6320_PLATFORM_ASYNCFILEIO_H
+
+// Include Files
+//==============
+
+#include "Platform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Results/Results.h>
+#include <functional>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Platform
+	{
+		namespace AsyncFileIo
+		{
+			enum class ePriority : uint8_t
+			{
+				High,
+				Normal,
+				Low,
+
+				Count
+			};
+
+			// A request handle is only valid until the request has been waited for or cancelled
+			struct sRequestHandle
+			{
+				uint64_t id = 0;
+
+				bool IsValid() const { return id != 0; }
+				operator bool() const { return IsValid(); }
+			};
+
+			// Requests
+			//---------
+
+			// The entire file is loaded into memory that is allocated for it
+			// (WaitForRequest() returns it, and it is the caller's responsibility to free it with sDataFromFile::Free())
+			sRequestHandle QueueLoad( const char* const i_path, const ePriority i_priority = ePriority::Normal );
+			// i_size bytes starting at i_offset are read into o_destination,
+			// which must stay valid until the request has been waited for or cancelled
+			sRequestHandle QueueRead( const char* const i_path, const uint64_t i_offset, const size_t i_size, void* const o_destination,
+				const ePriority i_priority = ePriority::Normal );
+
+			// This doesn't block
+			bool IsRequestComplete( const sRequestHandle i_request );
+			// The callback is called once the request has finished
+			// (by the I/O thread that read it, or immediately if the request has already finished).
+			// It should only hand the request off (e.g. by queueing a job) so that the I/O thread isn't delayed,
+			// and the request must still be waited for (which won't block once the callback has been called).
+			// Only one callback can be set for a request,
+			// and it isn't called if the request is cancelled before it is read.
+			using fOnCompletion = std::function<void()>;
+			void WhenRequestCompletes( const sRequestHandle i_request, const fOnCompletion& i_onCompletion );
+			// Blocks until the request has finished and returns its result
+			// (for QueueRead() requests o_data refers to the caller's destination memory and must not be freed).
+			// The handle is invalid after this returns.
+			cResult WaitForRequest( sRequestHandle& io_request, sDataFromFile* const o_data = nullptr, std::string* const o_errorMessage = nullptr );
+			// A request that hasn't started being read is discarded,
+			// and one that is being read is waited for and then discarded
+			// (either way nothing is written to its destination after this returns).
+			// The handle is invalid after this returns.
+			void CancelRequest( sRequestHandle& io_request );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// If asynchronous file I/O hasn't been initialized requests are read immediately when they are queued.
+			// Every I/O thread is started with the provided options
+			// (the thread's number is appended to the name).
+			cResult Initialize( const unsigned int i_ioThreadCount = 4, const Concurrency::sThreadOptions& i_threadOptions = Concurrency::sThreadOptions() );
+			// Every request that hasn't started being read is cancelled
+			// (but requests that have finished can still be waited for)
+			cResult CleanUp();
+		}
+	}
+}
+
+#endif	// EAE6320_PLATFORM_ASYNCFILEIO_H
@@ -0,0 +1,78 @@
+/*
+	These let a task (see Engine/Concurrency/cTask.h) wait for an asynchronous file I/O request
+	without blocking the thread that it is running on
+
+	Coroutines must be enabled for every file that includes this header.
+*/
+
+#ifndef EAE6320_PLATFORM_ASYNCFILEIOAWAITABLES_H
+#define EAE6320_PLATFORM_ASYNCFILEIOAWAITABLES_H
+
+// Include Files
+//==============
+
+#include "AsyncFileIo.h"
+
+#include <Engine/Concurrency/cTask.h>
+#include <Engine/Concurrency/JobSystem.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Platform
+	{
+		namespace AsyncFileIo
+		{
+			// Awaiting this is the same as calling WaitForRequest() except that the task is suspended instead of blocking:
+			//	if ( !( result = co_await AwaitRequest( request, &dataFromFile ) ) )
+			// The task is resumed on one of the job system's worker threads
+			// (rather than on the I/O thread, so that the I/O thread can start the next request).
+			class cRequestAwaitable
+			{
+				// Interface
+				//==========
+
+			public:
+
+				bool await_ready() const { return IsRequestComplete( m_request ); }
+				void await_suspend( Concurrency::CoroutineLibrary::coroutine_handle<> i_coroutine )
+				{
+					WhenRequestCompletes( m_request, [i_coroutine]()
+						{
+							Concurrency::JobSystem::Run( [i_coroutine]() { i_coroutine.resume(); } );
+						} );
+				}
+				cResult await_resume() { return WaitForRequest( m_request, m_data, m_errorMessage ); }
+
+				// Initialization / Clean Up
+				//--------------------------
+
+				cRequestAwaitable( sRequestHandle& io_request, sDataFromFile* const o_data, std::string* const o_errorMessage )
+					:
+					m_request( io_request ), m_data( o_data ), m_errorMessage( o_errorMessage )
+				{
+
+				}
+
+				// Data
+				//=====
+
+			private:
+
+				sRequestHandle& m_request;
+				sDataFromFile* const m_data;
+				std::string* const m_errorMessage;
+			};
+
+			inline cRequestAwaitable AwaitRequest( sRequestHandle& io_request,
+				sDataFromFile* const o_data = nullptr, std::string* const o_errorMessage = nullptr )
+			{
+				return cRequestAwaitable( io_request, o_data, o_errorMessage );
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_PLATFORM_ASYNCFILEIOAWAITABLES_H
@@ -0,0 +1,158 @@
+// Include Files
+//==============
+
+#include "AsyncFileIoBenchmark.h"
+
+#include "AsyncFileIo.h"
+#include "Platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	std::string GetFilePath( const unsigned int i_fileIndex );
+	uint8_t GetExpectedByte( const unsigned int i_fileIndex, const size_t i_byteIndex );
+	// The data is freed whether or not it is correct
+	bool IsDataCorrect( const unsigned int i_fileIndex, const size_t i_fileSize, eae6320::Platform::sDataFromFile& io_data );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Platform::AsyncFileIoBenchmark::Measure( sResults& o_results, const unsigned int i_fileCount, const size_t i_fileSize )
+{
+	auto result = Results::Success;
+
+	o_results = sResults();
+	EAE6320_ASSERT( i_fileCount > 0 );
+
+	unsigned int writtenFileCount = 0;
+	unsigned int incorrectFileCount = 0;
+
+	// Write the files
+	{
+		std::vector<uint8_t> contents( i_fileSize );
+		for ( ; writtenFileCount < i_fileCount; ++writtenFileCount )
+		{
+			for ( size_t i = 0; i < i_fileSize; ++i )
+			{
+				contents[i] = GetExpectedByte( writtenFileCount, i );
+			}
+			std::string errorMessage;
+			if ( !( result = WriteBinaryFile( GetFilePath( writtenFileCount ).c_str(), contents.data(), i_fileSize, &errorMessage ) ) )
+			{
+				EAE6320_ASSERTF( false, errorMessage.c_str() );
+				Logging::OutputError( "The asynchronous file I/O benchmark couldn't write a file: %s", errorMessage.c_str() );
+				goto OnExit;
+			}
+		}
+	}
+	// Load them one at a time
+	{
+		const auto time_start = std::chrono::steady_clock::now();
+		for ( unsigned int i = 0; i < i_fileCount; ++i )
+		{
+			sDataFromFile data;
+			if ( !LoadBinaryFile( GetFilePath( i ).c_str(), data ) || !IsDataCorrect( i, i_fileSize, data ) )
+			{
+				++incorrectFileCount;
+			}
+		}
+		const auto duration = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+		o_results.filesPerSecond_serial = static_cast<double>( i_fileCount ) / duration;
+	}
+	// Queue them all and then wait for them
+	{
+		std::vector<AsyncFileIo::sRequestHandle> requests( i_fileCount );
+		const auto time_start = std::chrono::steady_clock::now();
+		for ( unsigned int i = 0; i < i_fileCount; ++i )
+		{
+			requests[i] = AsyncFileIo::QueueLoad( GetFilePath( i ).c_str() );
+		}
+		for ( unsigned int i = 0; i < i_fileCount; ++i )
+		{
+			sDataFromFile data;
+			if ( !requests[i] || !AsyncFileIo::WaitForRequest( requests[i], &data ) || !IsDataCorrect( i, i_fileSize, data ) )
+			{
+				++incorrectFileCount;
+			}
+		}
+		const auto duration = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+		o_results.filesPerSecond_async = static_cast<double>( i_fileCount ) / duration;
+	}
+	if ( incorrectFileCount > 0 )
+	{
+		EAE6320_ASSERTF( false, "%u files weren't loaded correctly", incorrectFileCount );
+		Logging::OutputError( "The asynchronous file I/O benchmark loaded %u files incorrectly", incorrectFileCount );
+		result = Results::Failure;
+	}
+
+OnExit:
+
+	for ( unsigned int i = 0; i < writtenFileCount; ++i )
+	{
+		const auto path = GetFilePath( i );
+		if ( std::remove( path.c_str() ) != 0 )
+		{
+			Logging::OutputError( "The asynchronous file I/O benchmark couldn't delete the file \"%s\"", path.c_str() );
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::AsyncFileIoBenchmark::LogReport( const unsigned int i_fileCount, const size_t i_fileSize )
+{
+	sResults results;
+	const auto result = Measure( results, i_fileCount, i_fileSize );
+	if ( result )
+	{
+		Logging::OutputMessage( "Loading %u files of %zu bytes: %.0f files per second one at a time, %.0f files per second asynchronously",
+			i_fileCount, i_fileSize, results.filesPerSecond_serial, results.filesPerSecond_async );
+	}
+	else
+	{
+		Logging::OutputError( "The asynchronous file I/O benchmark couldn't be run" );
+	}
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	std::string GetFilePath( const unsigned int i_fileIndex )
+	{
+		std::ostringstream path;
+		path << "AsyncFileIoBenchmark_" << i_fileIndex << ".tmp";
+		return path.str();
+	}
+
+	uint8_t GetExpectedByte( const unsigned int i_fileIndex, const size_t i_byteIndex )
+	{
+		return static_cast<uint8_t>( ( i_fileIndex * 31u ) + i_byteIndex );
+	}
+
+	bool IsDataCorrect( const unsigned int i_fileIndex, const size_t i_fileSize, eae6320::Platform::sDataFromFile& io_data )
+	{
+		auto isDataCorrect = io_data.size == i_fileSize;
+		const auto* const bytes = static_cast<const uint8_t*>( io_data.data );
+		for ( size_t i = 0; isDataCorrect && ( i < i_fileSize ); ++i )
+		{
+			isDataCorrect = bytes[i] == GetExpectedByte( i_fileIndex, i );
+		}
+		io_data.Free();
+		return isDataCorrect;
+	}
+}
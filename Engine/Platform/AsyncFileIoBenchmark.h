@@ -0,0 +1,47 @@
+/*
+	The asynchronous file I/O benchmark measures how long it takes to load many small files
+	one at a time with LoadBinaryFile() compared to queueing them all with AsyncFileIo::QueueLoad()
+	and then waiting for them
+
+	The files are written to the current directory before they are loaded and deleted afterwards,
+	and so they will be in the operating system's cache:
+	This measures the overhead of each approach and how well the I/O threads overlap the reads
+	rather than how fast the storage device is.
+	If asynchronous file I/O hasn't been initialized every request is read when it is queued
+	and the two approaches should take about the same time.
+*/
+
+#ifndef EAE6320_PLATFORM_ASYNCFILEIOBENCHMARK_H
+#define EAE6320_PLATFORM_ASYNCFILEIOBENCHMARK_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Platform
+	{
+		namespace AsyncFileIoBenchmark
+		{
+			struct sResults
+			{
+				double filesPerSecond_serial = 0.0;
+				double filesPerSecond_async = 0.0;
+			};
+
+			// This fails if the files can't be written or if any file that is loaded has the wrong contents
+			cResult Measure( sResults& o_results, const unsigned int i_fileCount = 256, const size_t i_fileSize = 4 * 1024 );
+
+			// This measures and outputs the results to the log
+			cResult LogReport( const unsigned int i_fileCount = 256, const size_t i_fileSize = 4 * 1024 );
+		}
+	}
+}
+
+#endif	// EAE6320_PLATFORM_ASYNCFILEIOBENCHMARK_H
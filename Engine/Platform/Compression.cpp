@@ -0,0 +1,562 @@
+// Include Files
+//==============
+
+#include "Compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	// These values are defined by the LZ4 block format
+
+	// Every match is at least this long
+	constexpr size_t s_minMatchLength = 4;
+	// The last bytes of a block are always literals
+	constexpr size_t s_lastLiteralCount = 5;
+	// The last match must start at least this many bytes before the end of a block
+	constexpr size_t s_lastMatchDistanceFromEnd = 12;
+	// Offsets are stored in two bytes
+	constexpr size_t s_maxOffset = 0xffff;
+	// A length that doesn't fit in a token's four bits is continued in extra bytes
+	constexpr unsigned int s_maxTokenLength = 0xf;
+
+	// The hash table remembers the most recent position of a 4 byte sequence
+	constexpr unsigned int s_hashBitCount = 16;
+	// When compressing with eLevel::High every earlier position with the same hash is remembered
+	// (back to s_maxOffset), and up to this many of them are checked to find the longest match
+	constexpr unsigned int s_maxMatchAttemptCount = 256;
+	constexpr uint32_t s_noPosition = ~uint32_t( 0 );
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	uint8_t* CompressSequences_fast( const uint8_t* const i_input, const size_t i_size, uint8_t* io_output, size_t& o_anchor );
+	uint8_t* CompressSequences_high( const uint8_t* const i_input, const size_t i_size, uint8_t* io_output, size_t& o_anchor );
+
+	uint32_t Read32( const uint8_t* const i_position );
+	uint32_t CalculateHash( const uint32_t i_sequence );
+	uint8_t* WriteExtraLength( size_t i_length, uint8_t* io_output );
+	uint8_t* WriteSequence( const uint8_t* const i_literals, const size_t i_literalCount,
+		const size_t i_offset, const size_t i_matchLength, uint8_t* io_output );
+	eae6320::cResult ReadExtraLength( const uint8_t*& io_input, const uint8_t* const i_inputEnd, size_t& io_length );
+}
+
+// Interface
+//==========
+
+size_t eae6320::Platform::Compression::CompressBlock( const void* const i_data, const size_t i_size, void* const o_compressedData,
+	const eLevel i_level )
+{
+	const auto* const input = static_cast<const uint8_t*>( i_data );
+	auto* output = static_cast<uint8_t*>( o_compressedData );
+
+	size_t anchor = 0;
+	if ( i_size > s_lastMatchDistanceFromEnd )
+	{
+		output = ( i_level == eLevel::High ) ?
+			CompressSequences_high( input, i_size, output, anchor ) :
+			CompressSequences_fast( input, i_size, output, anchor );
+	}
+	// The last sequence only has literals
+	{
+		const auto literalCount = i_size - anchor;
+		auto* const token = output++;
+		if ( literalCount >= s_maxTokenLength )
+		{
+			*token = static_cast<uint8_t>( s_maxTokenLength << 4 );
+			output = WriteExtraLength( literalCount - s_maxTokenLength, output );
+		}
+		else
+		{
+			*token = static_cast<uint8_t>( literalCount << 4 );
+		}
+		if ( literalCount > 0 )
+		{
+			std::memcpy( output, input + anchor, literalCount );
+			output += literalCount;
+		}
+	}
+
+	const auto compressedSize = static_cast<size_t>( output - static_cast<uint8_t*>( o_compressedData ) );
+	EAE6320_ASSERT( compressedSize <= GetMaxCompressedSize( i_size ) );
+	return compressedSize;
+}
+
+eae6320::cResult eae6320::Platform::Compression::DecompressBlock( const void* const i_compressedData, const size_t i_compressedSize,
+	void* const o_data, const size_t i_size )
+{
+	const auto* input = static_cast<const uint8_t*>( i_compressedData );
+	const auto* const inputEnd = input + i_compressedSize;
+	auto* const outputBegin = static_cast<uint8_t*>( o_data );
+	auto* output = outputBegin;
+	auto* const outputEnd = outputBegin + i_size;
+
+	while ( true )
+	{
+		if ( input >= inputEnd )
+		{
+			return Results::InvalidFile;
+		}
+		const auto token = *input++;
+		// Literals
+		{
+			size_t literalCount = token >> 4;
+			if ( literalCount == s_maxTokenLength )
+			{
+				if ( !ReadExtraLength( input, inputEnd, literalCount ) )
+				{
+					return Results::InvalidFile;
+				}
+			}
+			if ( ( literalCount > static_cast<size_t>( inputEnd - input ) ) || ( literalCount > static_cast<size_t>( outputEnd - output ) ) )
+			{
+				return Results::InvalidFile;
+			}
+			if ( literalCount > 0 )
+			{
+				std::memcpy( output, input, literalCount );
+				input += literalCount;
+				output += literalCount;
+			}
+		}
+		// The last sequence doesn't have a match
+		if ( input == inputEnd )
+		{
+			break;
+		}
+		// Match
+		{
+			if ( ( inputEnd - input ) < 2 )
+			{
+				return Results::InvalidFile;
+			}
+			const size_t offset = static_cast<size_t>( input[0] ) | ( static_cast<size_t>( input[1] ) << 8 );
+			input += 2;
+			if ( ( offset == 0 ) || ( offset > static_cast<size_t>( output - outputBegin ) ) )
+			{
+				return Results::InvalidFile;
+			}
+			size_t matchLength = token & s_maxTokenLength;
+			if ( matchLength == s_maxTokenLength )
+			{
+				if ( !ReadExtraLength( input, inputEnd, matchLength ) )
+				{
+					return Results::InvalidFile;
+				}
+			}
+			matchLength += s_minMatchLength;
+			if ( matchLength > static_cast<size_t>( outputEnd - output ) )
+			{
+				return Results::InvalidFile;
+			}
+			const auto* match = output - offset;
+			if ( offset >= matchLength )
+			{
+				std::memcpy( output, match, matchLength );
+				output += matchLength;
+			}
+			else
+			{
+				// The match overlaps the bytes that it is writing
+				// (this is how repeating patterns are encoded)
+				for ( size_t i = 0; i < matchLength; ++i )
+				{
+					*output++ = *match++;
+				}
+			}
+		}
+	}
+
+	return ( output == outputEnd ) ? Results::Success : Results::InvalidFile;
+}
+
+// Files
+//------
+
+bool eae6320::Platform::Compression::IsCompressedFile( const void* const i_beginningOfFile, const size_t i_size )
+{
+	if ( i_size >= sizeof( sFileHeader ) )
+	{
+		uint32_t signature;
+		std::memcpy( &signature, i_beginningOfFile, sizeof( signature ) );
+		return signature == s_fileSignature;
+	}
+	return false;
+}
+
+eae6320::cResult eae6320::Platform::Compression::CompressFile( const void* const i_data, const size_t i_size, const eLevel i_level,
+	std::vector<uint8_t>& o_compressedFile, const uint32_t i_blockSize )
+{
+	if ( ( i_blockSize == 0 ) || ( i_blockSize > s_maxBlockSize ) )
+	{
+		EAE6320_ASSERTF( false, "Invalid block size %u", i_blockSize );
+		return Results::Failure;
+	}
+	const auto blockCount = ( static_cast<uint64_t>( i_size ) + i_blockSize - 1 ) / i_blockSize;
+	if ( blockCount > UINT32_MAX )
+	{
+		return Results::Failure;
+	}
+
+	sFileHeader header{};
+	{
+		header.signature = s_fileSignature;
+		header.codec = LZ4;
+		header.version = s_fileVersion;
+		header.blockSize = i_blockSize;
+		header.blockCount = static_cast<uint32_t>( blockCount );
+		header.uncompressedSize = i_size;
+	}
+	const auto blockTableSize = static_cast<size_t>( blockCount ) * sizeof( uint32_t );
+	o_compressedFile.resize( sizeof( header ) + blockTableSize );
+	std::memcpy( o_compressedFile.data(), &header, sizeof( header ) );
+
+	const auto* const input = static_cast<const uint8_t*>( i_data );
+	std::vector<uint8_t> compressedBlock( GetMaxCompressedSize( i_blockSize ) );
+	for ( uint32_t i = 0; i < header.blockCount; ++i )
+	{
+		const auto blockOffset = static_cast<size_t>( i ) * i_blockSize;
+		const auto blockSize = std::min( static_cast<size_t>( i_blockSize ), i_size - blockOffset );
+		const auto compressedSize = CompressBlock( input + blockOffset, blockSize, compressedBlock.data(), i_level );
+		// A block that compression doesn't make smaller is stored as-is
+		uint32_t storedSize;
+		if ( compressedSize < blockSize )
+		{
+			o_compressedFile.insert( o_compressedFile.end(), compressedBlock.data(), compressedBlock.data() + compressedSize );
+			storedSize = static_cast<uint32_t>( compressedSize );
+		}
+		else
+		{
+			o_compressedFile.insert( o_compressedFile.end(), input + blockOffset, input + blockOffset + blockSize );
+			storedSize = static_cast<uint32_t>( blockSize );
+		}
+		std::memcpy( o_compressedFile.data() + sizeof( header ) + ( i * sizeof( uint32_t ) ), &storedSize, sizeof( storedSize ) );
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Platform::Compression::DecompressFile( const sFileHeader& i_header, const fReadStoredBytes& i_readStoredBytes,
+	const uint64_t i_offset, const size_t i_size, void* const o_data )
+{
+	auto result = Results::Success;
+
+	// Validate the header
+	// (it comes from a file and so it isn't trusted)
+	{
+		const auto isCodecValid = ( i_header.codec == None ) || ( i_header.codec == LZ4 );
+		const auto isBlockSizeValid = ( i_header.blockSize > 0 ) && ( i_header.blockSize <= s_maxBlockSize );
+		if ( ( i_header.signature != s_fileSignature ) || ( i_header.version != s_fileVersion ) || !isCodecValid || !isBlockSizeValid
+			|| ( i_header.blockCount != ( ( i_header.uncompressedSize + i_header.blockSize - 1 ) / i_header.blockSize ) ) )
+		{
+			return Results::InvalidFile;
+		}
+		if ( ( i_offset > i_header.uncompressedSize ) || ( i_size > ( i_header.uncompressedSize - i_offset ) ) )
+		{
+			return Results::InvalidFile;
+		}
+	}
+	if ( i_size == 0 )
+	{
+		return Results::Success;
+	}
+
+	// Read the stored size of every block
+	std::vector<uint32_t> storedBlockSizes( i_header.blockCount );
+	if ( !( result = i_readStoredBytes( sizeof( i_header ), storedBlockSizes.size() * sizeof( uint32_t ), storedBlockSizes.data() ) ) )
+	{
+		return result;
+	}
+	// Only the blocks that overlap the requested bytes are read
+	const auto firstBlock = static_cast<uint32_t>( i_offset / i_header.blockSize );
+	const auto lastBlock = static_cast<uint32_t>( ( i_offset + i_size - 1 ) / i_header.blockSize );
+	uint64_t storedOffset = sizeof( i_header ) + ( storedBlockSizes.size() * sizeof( uint32_t ) );
+	for ( uint32_t i = 0; i < firstBlock; ++i )
+	{
+		storedOffset += storedBlockSizes[i];
+	}
+	// A compressed block is read into memory and then decompressed
+	std::vector<uint8_t> storedBlock;
+	// A block that is only partially requested must be decompressed entirely before the requested part can be copied,
+	// but every block that is entirely requested is decompressed directly into the output
+	std::vector<uint8_t> uncompressedBlock;
+	for ( auto i = firstBlock; i <= lastBlock; ++i )
+	{
+		const auto blockOffset = static_cast<uint64_t>( i ) * i_header.blockSize;
+		const auto blockSize = static_cast<size_t>( std::min( static_cast<uint64_t>( i_header.blockSize ), i_header.uncompressedSize - blockOffset ) );
+		const auto storedSize = storedBlockSizes[i];
+		const auto copyBegin = static_cast<size_t>( std::max( i_offset, blockOffset ) - blockOffset );
+		const auto copyEnd = static_cast<size_t>( std::min( i_offset + i_size, blockOffset + blockSize ) - blockOffset );
+		auto* const output = static_cast<uint8_t*>( o_data ) + ( blockOffset + copyBegin - i_offset );
+		if ( storedSize == blockSize )
+		{
+			// The block isn't compressed
+			if ( !( result = i_readStoredBytes( storedOffset + copyBegin, copyEnd - copyBegin, output ) ) )
+			{
+				return result;
+			}
+		}
+		else
+		{
+			if ( ( i_header.codec == None ) || ( storedSize > GetMaxCompressedSize( blockSize ) ) )
+			{
+				return Results::InvalidFile;
+			}
+			storedBlock.resize( storedSize );
+			if ( !( result = i_readStoredBytes( storedOffset, storedSize, storedBlock.data() ) ) )
+			{
+				return result;
+			}
+			if ( ( copyBegin == 0 ) && ( copyEnd == blockSize ) )
+			{
+				if ( !( result = DecompressBlock( storedBlock.data(), storedSize, output, blockSize ) ) )
+				{
+					return result;
+				}
+			}
+			else
+			{
+				uncompressedBlock.resize( blockSize );
+				if ( !( result = DecompressBlock( storedBlock.data(), storedSize, uncompressedBlock.data(), blockSize ) ) )
+				{
+					return result;
+				}
+				std::memcpy( output, uncompressedBlock.data() + copyBegin, copyEnd - copyBegin );
+			}
+		}
+		storedOffset += storedSize;
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	uint8_t* CompressSequences_fast( const uint8_t* const i_input, const size_t i_size, uint8_t* io_output, size_t& o_anchor )
+	{
+		// Only the most recent position of each hash is remembered,
+		// and the first match that is found is used
+		std::vector<uint32_t> hashTable( size_t( 1 ) << s_hashBitCount, 0 );
+		const auto matchEndLimit = i_size - s_lastLiteralCount;
+		const auto matchStartLimit = i_size - s_lastMatchDistanceFromEnd;
+		size_t anchor = 0;
+		size_t position = 0;
+		while ( position < matchStartLimit )
+		{
+			const auto sequence = Read32( i_input + position );
+			auto& hashTableEntry = hashTable[CalculateHash( sequence )];
+			size_t candidate = hashTableEntry;
+			hashTableEntry = static_cast<uint32_t>( position );
+			if ( ( candidate < position ) && ( ( position - candidate ) <= s_maxOffset ) && ( Read32( i_input + candidate ) == sequence ) )
+			{
+				// Extend the match backwards into the pending literals
+				while ( ( position > anchor ) && ( candidate > 0 ) && ( i_input[position - 1] == i_input[candidate - 1] ) )
+				{
+					--position;
+					--candidate;
+				}
+				// Extend the match forwards
+				auto matchLength = s_minMatchLength;
+				while ( ( ( position + matchLength ) < matchEndLimit ) && ( i_input[candidate + matchLength] == i_input[position + matchLength] ) )
+				{
+					++matchLength;
+				}
+				io_output = WriteSequence( i_input + anchor, position - anchor, position - candidate, matchLength, io_output );
+				position += matchLength;
+				anchor = position;
+				// Remember a position inside of the match so that the next search has a better chance
+				if ( position < matchStartLimit )
+				{
+					const auto positionInsideMatch = position - 2;
+					hashTable[CalculateHash( Read32( i_input + positionInsideMatch ) )] = static_cast<uint32_t>( positionInsideMatch );
+				}
+			}
+			else
+			{
+				++position;
+			}
+		}
+		o_anchor = anchor;
+		return io_output;
+	}
+
+	uint8_t* CompressSequences_high( const uint8_t* const i_input, const size_t i_size, uint8_t* io_output, size_t& o_anchor )
+	{
+		// Every position is remembered in a chain of earlier positions with the same hash
+		// (the chain is indexed by position modulo the maximum offset
+		// because positions further away than that can't be used)
+		std::vector<uint32_t> hashTable( size_t( 1 ) << s_hashBitCount, s_noPosition );
+		std::vector<uint32_t> previousPositions( s_maxOffset + 1, s_noPosition );
+		const auto matchEndLimit = i_size - s_lastLiteralCount;
+		const auto matchStartLimit = i_size - s_lastMatchDistanceFromEnd;
+		size_t nextPositionToRemember = 0;
+		const auto rememberPositionsBefore = [&]( const size_t i_position )
+		{
+			for ( ; nextPositionToRemember < i_position; ++nextPositionToRemember )
+			{
+				auto& hashTableEntry = hashTable[CalculateHash( Read32( i_input + nextPositionToRemember ) )];
+				previousPositions[nextPositionToRemember & s_maxOffset] = hashTableEntry;
+				hashTableEntry = static_cast<uint32_t>( nextPositionToRemember );
+			}
+		};
+		const auto findLongestMatch = [&]( const size_t i_position, size_t& o_candidate )
+		{
+			rememberPositionsBefore( i_position );
+			size_t longestMatchLength = 0;
+			const auto sequence = Read32( i_input + i_position );
+			auto candidate = hashTable[CalculateHash( sequence )];
+			for ( unsigned int attemptCount = 0;
+				( candidate != s_noPosition ) && ( candidate < i_position ) && ( ( i_position - candidate ) <= s_maxOffset )
+					&& ( attemptCount < s_maxMatchAttemptCount );
+				++attemptCount, candidate = previousPositions[candidate & s_maxOffset] )
+			{
+				// A candidate can only be longer if it matches at the current longest length
+				if ( ( i_input[candidate + longestMatchLength] != i_input[i_position + longestMatchLength] )
+					|| ( Read32( i_input + candidate ) != sequence ) )
+				{
+					continue;
+				}
+				auto matchLength = s_minMatchLength;
+				while ( ( ( i_position + matchLength ) < matchEndLimit ) && ( i_input[candidate + matchLength] == i_input[i_position + matchLength] ) )
+				{
+					++matchLength;
+				}
+				if ( matchLength > longestMatchLength )
+				{
+					longestMatchLength = matchLength;
+					o_candidate = candidate;
+				}
+			}
+			return longestMatchLength;
+		};
+
+		size_t anchor = 0;
+		size_t position = 0;
+		while ( position < matchStartLimit )
+		{
+			size_t candidate = 0;
+			auto matchLength = findLongestMatch( position, candidate );
+			if ( matchLength < s_minMatchLength )
+			{
+				++position;
+				continue;
+			}
+			// If a longer match starts at the next position
+			// it is better to output one more literal and use that match instead
+			while ( ( position + 1 ) < matchStartLimit )
+			{
+				size_t nextCandidate = 0;
+				const auto nextMatchLength = findLongestMatch( position + 1, nextCandidate );
+				if ( nextMatchLength > matchLength )
+				{
+					++position;
+					matchLength = nextMatchLength;
+					candidate = nextCandidate;
+				}
+				else
+				{
+					break;
+				}
+			}
+			io_output = WriteSequence( i_input + anchor, position - anchor, position - candidate, matchLength, io_output );
+			position += matchLength;
+			anchor = position;
+		}
+		o_anchor = anchor;
+		return io_output;
+	}
+
+	uint32_t Read32( const uint8_t* const i_position )
+	{
+		uint32_t value;
+		std::memcpy( &value, i_position, sizeof( value ) );
+		return value;
+	}
+
+	uint32_t CalculateHash( const uint32_t i_sequence )
+	{
+		// Knuth's multiplicative hash
+		return ( i_sequence * 2654435761u ) >> ( 32 - s_hashBitCount );
+	}
+
+	uint8_t* WriteExtraLength( size_t i_length, uint8_t* io_output )
+	{
+		while ( i_length >= 0xff )
+		{
+			*io_output++ = 0xff;
+			i_length -= 0xff;
+		}
+		*io_output++ = static_cast<uint8_t>( i_length );
+		return io_output;
+	}
+
+	uint8_t* WriteSequence( const uint8_t* const i_literals, const size_t i_literalCount,
+		const size_t i_offset, const size_t i_matchLength, uint8_t* io_output )
+	{
+		EAE6320_ASSERT( ( i_offset > 0 ) && ( i_offset <= s_maxOffset ) );
+		EAE6320_ASSERT( i_matchLength >= s_minMatchLength );
+
+		auto* const token = io_output++;
+		uint8_t tokenValue = 0;
+		// Literals
+		if ( i_literalCount >= s_maxTokenLength )
+		{
+			tokenValue = static_cast<uint8_t>( s_maxTokenLength << 4 );
+			io_output = WriteExtraLength( i_literalCount - s_maxTokenLength, io_output );
+		}
+		else
+		{
+			tokenValue = static_cast<uint8_t>( i_literalCount << 4 );
+		}
+		if ( i_literalCount > 0 )
+		{
+			std::memcpy( io_output, i_literals, i_literalCount );
+			io_output += i_literalCount;
+		}
+		// Offset
+		*io_output++ = static_cast<uint8_t>( i_offset & 0xff );
+		*io_output++ = static_cast<uint8_t>( i_offset >> 8 );
+		// Match length
+		{
+			const auto matchLength = i_matchLength - s_minMatchLength;
+			if ( matchLength >= s_maxTokenLength )
+			{
+				tokenValue |= static_cast<uint8_t>( s_maxTokenLength );
+				io_output = WriteExtraLength( matchLength - s_maxTokenLength, io_output );
+			}
+			else
+			{
+				tokenValue |= static_cast<uint8_t>( matchLength );
+			}
+		}
+		*token = tokenValue;
+
+		return io_output;
+	}
+
+	eae6320::cResult ReadExtraLength( const uint8_t*& io_input, const uint8_t* const i_inputEnd, size_t& io_length )
+	{
+		uint8_t byte;
+		do
+		{
+			if ( io_input >= i_inputEnd )
+			{
+				return eae6320::Results::InvalidFile;
+			}
+			byte = *io_input++;
+			io_length += byte;
+		} while ( byte == 0xff );
+		return eae6320::Results::Success;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+	This file contains a lossless block compressor used for built asset files
+
+	The compressed data uses the LZ4 block format:
+	it compresses less than general purpose compressors
+	but decompresses at close to the speed of a memory copy,
+	which makes it a good trade for data that is read every time the game starts.
+
+	A compressed file is split into independently compressed blocks
+	so that it can be decompressed a block at a time
+	(and so that part of it can be read without decompressing all of it).
+	The layout of a compressed file is:
+		* An sFileHeader
+		* The stored size of every block as a uint32_t
+		* The data of every block
+	A block whose stored size is the same as its uncompressed size isn't compressed.
+*/
+
+#ifndef EAE6320_PLATFORM_COMPRESSION_H
+#define EAE6320_PLATFORM_COMPRESSION_H
+
+// Include Files
+//==============
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <functional>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Platform
+	{
+		namespace Compression
+		{
+			// This is stored in files, and so existing values must not be changed
+			enum eCodec : uint8_t
+			{
+				None = 0,
+				LZ4 = 1,
+			};
+
+			// Both levels produce the same format and decompress at the same speed
+			enum class eLevel
+			{
+				// Quick to compress (for iterating on content)
+				Fast,
+				// Slower to compress but smaller (for distribution builds)
+				High,
+			};
+
+			// Blocks
+			//-------
+
+			// Returns the largest number of bytes that compressing i_size bytes can produce
+			// (incompressible data gets slightly bigger)
+			constexpr size_t GetMaxCompressedSize( const size_t i_size ) { return i_size + ( i_size / 255 ) + 16; }
+
+			// Compresses i_size bytes into o_compressedData,
+			// which must be at least GetMaxCompressedSize( i_size ) bytes.
+			// The return value is the number of compressed bytes that were written.
+			size_t CompressBlock( const void* const i_data, const size_t i_size, void* const o_compressedData,
+				const eLevel i_level = eLevel::Fast );
+			// Decompresses i_compressedSize bytes into o_data, which must be exactly i_size bytes.
+			// This returns Results::InvalidFile if the compressed data is malformed
+			// or doesn't decompress to exactly i_size bytes
+			// (the compressed data always comes from a file and so it is never trusted).
+			cResult DecompressBlock( const void* const i_compressedData, const size_t i_compressedSize, void* const o_data, const size_t i_size );
+
+			// Files
+			//------
+
+			constexpr uint32_t s_fileSignature = 0x504d4345;	// "ECMP" when read as bytes
+			constexpr uint8_t s_fileVersion = 1;
+			// Blocks are decompressed one at a time,
+			// and so this is also about how much memory decompressing a file needs
+			constexpr uint32_t s_defaultBlockSize = 64 * 1024;
+			constexpr uint32_t s_maxBlockSize = 4 * 1024 * 1024;
+
+			struct sFileHeader
+			{
+				uint32_t signature;
+				eCodec codec;
+				uint8_t version;
+				uint16_t padding;
+				// Every block except the last one decompresses to this many bytes
+				uint32_t blockSize;
+				uint32_t blockCount;
+				uint64_t uncompressedSize;
+			};
+			static_assert( sizeof( sFileHeader ) == 24, "The header is read directly from the file and must be tightly packed" );
+
+			// Returns true if the beginning of a file is the header of a compressed file
+			// (the signature was chosen so that it can't be the beginning of a valid uncompressed asset file)
+			bool IsCompressedFile( const void* const i_beginningOfFile, const size_t i_size );
+
+			// Compresses an entire file's contents
+			cResult CompressFile( const void* const i_data, const size_t i_size, const eLevel i_level, std::vector<uint8_t>& o_compressedFile,
+				const uint32_t i_blockSize = s_defaultBlockSize );
+
+			// This is how the contents of a compressed file are read
+			// (the offset is from the beginning of the stored file, including its header)
+			using fReadStoredBytes = std::function<cResult( const uint64_t i_offset, const size_t i_size, void* const o_data )>;
+			// Decompresses i_size bytes of a compressed file's contents starting at i_offset directly into o_data
+			// (only the blocks that overlap the requested bytes are read and decompressed)
+			cResult DecompressFile( const sFileHeader& i_header, const fReadStoredBytes& i_readStoredBytes,
+				const uint64_t i_offset, const size_t i_size, void* const o_data );
+		}
+	}
+}
+
+#endif	// EAE6320_PLATFORM_COMPRESSION_H
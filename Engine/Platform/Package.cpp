@@ -0,0 +1,190 @@
+// Include Files
+//==============
+
+#include "Package.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <vector>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* GetTableOfContents( const void* const i_package );
+	const char* GetPaths( const void* const i_package );
+	size_t SkipRepeatedSlashes( const char* const i_path, const size_t i_length, size_t i_index );
+}
+
+// Interface
+//==========
+
+// Paths
+//------
+
+bool eae6320::Platform::Package::ArePathsEquivalent( const char* const i_pathA, const size_t i_lengthA, const char* const i_pathB, const size_t i_lengthB )
+{
+	size_t indexA = 0, indexB = 0;
+	while ( ( indexA < i_lengthA ) && ( indexB < i_lengthB ) )
+	{
+		const auto characterA = NormalizePathCharacter( i_pathA[indexA] );
+		const auto characterB = NormalizePathCharacter( i_pathB[indexB] );
+		if ( characterA != characterB )
+		{
+			return false;
+		}
+		if ( characterA == '/' )
+		{
+			indexA = SkipRepeatedSlashes( i_pathA, i_lengthA, indexA );
+			indexB = SkipRepeatedSlashes( i_pathB, i_lengthB, indexB );
+		}
+		else
+		{
+			++indexA;
+			++indexB;
+		}
+	}
+	return ( indexA == i_lengthA ) && ( indexB == i_lengthB );
+}
+
+// Access
+//-------
+
+bool eae6320::Platform::Package::IsValid( const void* const i_package, const uint64_t i_packageSize )
+{
+	if ( i_packageSize < sizeof( sHeader ) )
+	{
+		return false;
+	}
+	const auto& header = *static_cast<const sHeader*>( i_package );
+	if ( ( header.signature != s_signature ) || ( header.version != s_version ) )
+	{
+		return false;
+	}
+	const auto pathsOffset = sizeof( sHeader ) + ( static_cast<uint64_t>( header.entryCount ) * sizeof( sEntry ) );
+	if ( ( pathsOffset + header.pathsSize ) > i_packageSize )
+	{
+		return false;
+	}
+	// Every entry must be inside of the package
+	// (this is checked once here so that it doesn't need to be checked every time a file is loaded)
+	const auto* const tableOfContents = GetTableOfContents( i_package );
+	for ( uint32_t i = 0; i < header.entryCount; ++i )
+	{
+		const auto& entry = tableOfContents[i];
+		if ( ( entry.offset > i_packageSize ) || ( entry.storedSize > ( i_packageSize - entry.offset ) )
+			|| ( ( static_cast<uint64_t>( entry.pathOffset ) + entry.pathLength ) > header.pathsSize )
+			|| ( ( i > 0 ) && ( tableOfContents[i - 1].pathHash > entry.pathHash ) ) )
+		{
+			return false;
+		}
+		switch ( entry.codec )
+		{
+		case Compression::None:
+			if ( entry.storedSize != entry.uncompressedSize )
+			{
+				return false;
+			}
+			break;
+		case Compression::LZ4:
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+const eae6320::Platform::Package::sEntry* eae6320::Platform::Package::FindEntry( const void* const i_package, const char* const i_path )
+{
+	const auto& header = *static_cast<const sHeader*>( i_package );
+	const auto* const tableOfContents = GetTableOfContents( i_package );
+	const auto* const tableOfContentsEnd = tableOfContents + header.entryCount;
+	const auto pathLength = std::strlen( i_path );
+	const auto pathHash = CalculatePathHash( i_path, pathLength );
+
+	// The table of contents is sorted by hash
+	const auto* entry = std::lower_bound( tableOfContents, tableOfContentsEnd, pathHash,
+		[]( const sEntry& i_entry, const uint64_t i_pathHash ) { return i_entry.pathHash < i_pathHash; } );
+	// Different paths can have the same hash,
+	// and so the path itself must be compared to be sure
+	const auto* const paths = GetPaths( i_package );
+	for ( ; ( entry != tableOfContentsEnd ) && ( entry->pathHash == pathHash ); ++entry )
+	{
+		if ( ArePathsEquivalent( paths + entry->pathOffset, entry->pathLength, i_path, pathLength ) )
+		{
+			return entry;
+		}
+	}
+	return nullptr;
+}
+
+eae6320::cResult eae6320::Platform::Package::ReadEntry( const void* const i_package, const sEntry& i_entry,
+	const uint64_t i_offset, const size_t i_size, void* const o_data )
+{
+	if ( ( i_offset > i_entry.uncompressedSize ) || ( i_size > ( i_entry.uncompressedSize - i_offset ) ) )
+	{
+		return Results::InvalidFile;
+	}
+	const auto* const storedData = static_cast<const uint8_t*>( i_package ) + i_entry.offset;
+	switch ( i_entry.codec )
+	{
+	case Compression::None:
+		{
+			std::memcpy( o_data, storedData + i_offset, i_size );
+			return Results::Success;
+		}
+	case Compression::LZ4:
+		{
+			if ( ( i_offset == 0 ) && ( i_size == i_entry.uncompressedSize ) )
+			{
+				return Compression::DecompressBlock( storedData, i_entry.storedSize, o_data, i_size );
+			}
+			else
+			{
+				// A compressed block can only be decompressed from its beginning,
+				// and so reading part of a compressed file requires decompressing all of it
+				// (files that are read in parts like textures shouldn't be compressed in packages)
+				std::vector<uint8_t> uncompressedData( i_entry.uncompressedSize );
+				const auto result = Compression::DecompressBlock( storedData, i_entry.storedSize, uncompressedData.data(), uncompressedData.size() );
+				if ( result )
+				{
+					std::memcpy( o_data, uncompressedData.data() + i_offset, i_size );
+				}
+				return result;
+			}
+		}
+	default:
+		EAE6320_ASSERTF( false, "IsValid() should have rejected the unknown codec %u", static_cast<unsigned int>( i_entry.codec ) );
+		return Results::InvalidFile;
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* GetTableOfContents( const void* const i_package )
+	{
+		return reinterpret_cast<const eae6320::Platform::Package::sEntry*>(
+			static_cast<const uint8_t*>( i_package ) + sizeof( eae6320::Platform::Package::sHeader ) );
+	}
+
+	const char* GetPaths( const void* const i_package )
+	{
+		const auto& header = *static_cast<const eae6320::Platform::Package::sHeader*>( i_package );
+		return reinterpret_cast<const char*>( GetTableOfContents( i_package ) + header.entryCount );
+	}
+
+	size_t SkipRepeatedSlashes( const char* const i_path, const size_t i_length, size_t i_index )
+	{
+		while ( ( i_index < i_length ) && ( eae6320::Platform::Package::NormalizePathCharacter( i_path[i_index] ) == '/' ) )
+		{
+			++i_index;
+		}
+		return i_index;
+	}
+}
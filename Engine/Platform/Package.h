@@ -0,0 +1,115 @@
+/*
+	A package is a single file that contains many built asset files
+
+	The layout of a package is:
+		* An sHeader
+		* A table of contents with one sEntry for every file, sorted by path hash
+		* The paths of every file (not null-terminated)
+		* The data of every file, each starting on a multiple of s_entryAlignment bytes
+
+	Loading a file from a package is a binary search of the table of contents
+	instead of opening a separate file,
+	and because the package is memory-mapped the operating system only reads the pages that are actually used.
+*/
+
+#ifndef EAE6320_PLATFORM_PACKAGE_H
+#define EAE6320_PLATFORM_PACKAGE_H
+
+// Include Files
+//==============
+
+#include "Compression.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Platform
+	{
+		namespace Package
+		{
+			// Format
+			//-------
+
+			constexpr uint32_t s_signature = 0x4b415045;	// "EPAK" when read as bytes
+			constexpr uint16_t s_version = 1;
+			// This is the page size on every platform that we support,
+			// which means that every file in a package starts on its own page
+			constexpr uint32_t s_entryAlignment = 4096;
+
+			struct sHeader
+			{
+				uint32_t signature;
+				uint16_t version;
+				uint16_t padding;
+				uint32_t entryCount;
+				// The size of all of the paths after the table of contents
+				uint32_t pathsSize;
+			};
+
+			struct sEntry
+			{
+				uint64_t pathHash;
+				// From the beginning of the package
+				uint64_t offset;
+				// The number of bytes in the package
+				// (this is only different from uncompressedSize if the file is compressed)
+				uint32_t storedSize;
+				uint32_t uncompressedSize;
+				// From the beginning of the paths
+				uint32_t pathOffset;
+				uint16_t pathLength;
+				Compression::eCodec codec;
+				uint8_t padding;
+			};
+			static_assert( sizeof( sEntry ) == 32, "The table of contents is read directly from the file and must be tightly packed" );
+
+			// Paths
+			//------
+
+			// Paths are compared without regard to case or to the type or number of slashes
+			// (e.g. "data/Meshes/Cube.binmsh" is the same as "data\\meshes//cube.binmsh")
+			constexpr char NormalizePathCharacter( const char i_character )
+			{
+				return ( i_character == '\\' ) ? '/' :
+					( ( i_character >= 'A' ) && ( i_character <= 'Z' ) ) ? static_cast<char>( i_character - 'A' + 'a' ) : i_character;
+			}
+
+			// This is the 64-bit FNV-1a hash of the normalized path
+			constexpr uint64_t CalculatePathHash( const char* const i_path, const size_t i_length )
+			{
+				uint64_t hash = 0xcbf29ce484222325;
+				char previousCharacter = '\0';
+				for ( size_t i = 0; i < i_length; ++i )
+				{
+					const auto character = NormalizePathCharacter( i_path[i] );
+					if ( ( character != '/' ) || ( previousCharacter != '/' ) )
+					{
+						hash = ( hash ^ static_cast<uint8_t>( character ) ) * 0x100000001b3;
+					}
+					previousCharacter = character;
+				}
+				return hash;
+			}
+			bool ArePathsEquivalent( const char* const i_pathA, const size_t i_lengthA, const char* const i_pathB, const size_t i_lengthB );
+
+			// Access
+			//-------
+
+			// Returns true if the package's header and table of contents are valid
+			// (this must be true before any of the following functions are called)
+			bool IsValid( const void* const i_package, const uint64_t i_packageSize );
+			// Returns nullptr if the package doesn't contain the path
+			const sEntry* FindEntry( const void* const i_package, const char* const i_path );
+			// Copies (and decompresses if necessary) i_size bytes of the file starting at i_offset into o_data,
+			// which must be big enough to hold them
+			cResult ReadEntry( const void* const i_package, const sEntry& i_entry, const uint64_t i_offset, const size_t i_size, void* const o_data );
+		}
+	}
+}
+
+#endif	// EAE6320_PLATFORM_PACKAGE_H
@@ -1,6 +1,8 @@
 /*
 	This file provides access to platform-specific functionality
 	with a platform-independent interface
+
+	It is implemented in Windows/Platform.win.cpp and Posix/Platform.posix.cpp
 */
 
 #ifndef EAE6320_PLATFORM_H
@@ -57,11 +59,68 @@ namespace eae6320
 		cResult GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage = nullptr );
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
+		// If the file was compressed (see Compression.h) when it was built
+		// the returned data is its decompressed contents
+		// (it is decompressed a block at a time directly into the returned memory).
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// This reads i_size bytes starting at i_offset
+		// (it is meant for file formats that are laid out so that only the beginning needs to be read)
+		cResult LoadPartOfBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, sDataFromFile& o_data,
+			std::string* const o_errorMessage = nullptr );
+		// This is the same as LoadPartOfBinaryFile() except that the bytes are written to memory that the caller provides
+		// (which must be at least i_size bytes)
+		cResult ReadBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, void* const o_destination,
+			std::string* const o_errorMessage = nullptr );
 		// This function writes an entire file in a single operation in the most efficient way possible.
 		// If you need to write out more than one smaller chunk to a file, however,
 		// you should use one of the standard library functions that does buffering.
 		cResult WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage = nullptr );
+
+		// Packages
+		//---------
+
+		// Once a package (see Package.h) has been mounted
+		// LoadBinaryFile() and LoadPartOfBinaryFile() look for files in it (and in the order that packages were mounted)
+		// before falling back to loose files.
+		// Packages must only be mounted or unmounted when no files are being loaded
+		// (i.e. during initialization and clean up).
+		cResult MountPackage( const char* const i_path, std::string* const o_errorMessage = nullptr );
+		// Every file in the directory with a .pak extension is mounted
+		cResult MountPackagesInDirectory( const char* const i_path, std::string* const o_errorMessage = nullptr );
+		void UnmountAllPackages();
+
+		// This is where LoadBinaryFile() would read a file from
+		struct sFileLocation
+		{
+			// Loose files use an index that is sorted after every mounted package
+			static constexpr uint32_t s_looseFilePackageIndex = ~uint32_t( 0 );
+			uint32_t packageIndex = s_looseFilePackageIndex;
+			// From the beginning of the package (this is always zero for loose files)
+			uint64_t offset = 0;
+			// The number of bytes that are read in order to load the entire file
+			// (this is smaller than the loaded size if the file is compressed)
+			uint64_t storedSize = 0;
+
+			bool IsPacked() const { return packageIndex != s_looseFilePackageIndex; }
+			// Reading files in this order reads each package from beginning to end
+			bool operator <( const sFileLocation& i_rhs ) const
+			{
+				return ( packageIndex != i_rhs.packageIndex ) ? ( packageIndex < i_rhs.packageIndex ) : ( offset < i_rhs.offset );
+			}
+		};
+		cResult GetFileLocation( const char* const i_path, sFileLocation& o_location, std::string* const o_errorMessage = nullptr );
+
+		// Prefetching
+		//------------
+
+		// This reads every stored byte of a file without returning them
+		// so that the operating system has the file in its cache when it is loaded later
+		// (a packaged file's pages are read into memory, and a loose file is read into a buffer that is discarded)
+		cResult PrefetchFile( const char* const i_path, uint64_t* const o_storedSize = nullptr, std::string* const o_errorMessage = nullptr );
+		// If an observer is set it is called every time that LoadBinaryFile() or LoadPartOfBinaryFile() successfully loads a file
+		// (on whichever thread loaded it, and so it must be thread-safe)
+		using fFileLoadObserver = void (*)( const char* const i_path );
+		void SetFileLoadObserver( const fFileLoadObserver i_observer );
 	}
 }
 
@@ -78,6 +137,8 @@ namespace eae6320
 			// (i.e. if GetEnvironmentVariable() fails this indicates that there were no platform-specific API errors,
 			// but that the requested environment variable doesn't exist)
 			constexpr cResult EnvironmentVariableDoesntExist( IsFailure, System::Platform, __LINE__ );
+			// This is returned when an asynchronous file I/O request was cancelled before it was read
+			constexpr cResult AsyncRequestCancelled( IsFailure, System::Platform, __LINE__ );
 		}
 	}
 }
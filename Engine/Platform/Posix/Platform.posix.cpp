@@ -0,0 +1,1059 @@
+// Include Files
+//==============
+
+#include "../Platform.h"
+
+#include "../Package.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <Engine/Asserts/Asserts.h>
+#include <fcntl.h>
+#include <memory>
+#include <spawn.h>
+#include <sstream>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+extern char** environ;
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sMountedPackage
+	{
+		int file = -1;
+		const void* data = nullptr;
+		uint64_t size = 0;
+	};
+	std::vector<sMountedPackage> s_mountedPackages;
+
+	std::atomic<eae6320::Platform::fFileLoadObserver> s_fileLoadObserver( nullptr );
+
+	// Loose files are prefetched this many bytes at a time
+	constexpr size_t s_prefetchBufferSize = 256 * 1024;
+	// Files are copied this many bytes at a time
+	constexpr size_t s_copyBufferSize = 256 * 1024;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* FindFileInMountedPackages( const char* const i_path, const void*& o_package );
+	// If i_shouldEntireFileBeLoaded is true then i_offset and i_size are ignored.
+	// If o_destination is null memory is allocated for the file,
+	// and otherwise the file is read into o_destination (which o_data then refers to).
+	eae6320::cResult LoadFile( const char* const i_path, const bool i_shouldEntireFileBeLoaded, const uint64_t i_offset, const size_t i_size,
+		void* const o_destination, eae6320::Platform::sDataFromFile& o_data, std::string* const o_errorMessage );
+	void UnmapPackage( sMountedPackage& io_package );
+
+	// These are the POSIX equivalents of the Windows functions in Engine/Windows/Functions.h
+	eae6320::cResult CloseFile( const int i_file, const char* const i_path, std::string* const o_errorMessage );
+	std::string GetLastSystemError( int* const o_optionalErrorCode = nullptr );
+	eae6320::cResult OpenFileForReading( const char* const i_path, int& o_file, uint64_t& o_fileSize, std::string* const o_errorMessage );
+	eae6320::cResult ReadFromFile( const int i_file, const char* const i_path, const uint64_t i_offset, const size_t i_size,
+		void* const o_data, std::string* const o_errorMessage );
+	eae6320::cResult WriteToFile( const int i_file, const char* const i_path, const void* const i_data, const size_t i_size,
+		std::string* const o_errorMessage );
+	// Missing files and directories are reported as not existing rather than as other failures
+	eae6320::cResult GetResultFromErrorCode( const int i_errorCode );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Platform::CopyFile( const char* const i_path_source, const char* const i_path_target,
+	const bool i_shouldFunctionFailIfTargetAlreadyExists, const bool i_shouldTargetFileTimeBeModified,
+	std::string* o_errorMessage )
+{
+	auto result = Results::Success;
+
+	int sourceFile = -1;
+	int targetFile = -1;
+	uint64_t fileSize = 0;
+
+	if ( !( result = OpenFileForReading( i_path_source, sourceFile, fileSize, o_errorMessage ) ) )
+	{
+		goto OnExit;
+	}
+	// Open the target
+	{
+		const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | ( i_shouldFunctionFailIfTargetAlreadyExists ? O_EXCL : 0 );
+		constexpr mode_t permissions = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+		targetFile = open( i_path_target, flags, permissions );
+		if ( targetFile == -1 )
+		{
+			int errorCode;
+			const auto errorMessage_system = GetLastSystemError( &errorCode );
+			result = GetResultFromErrorCode( errorCode );
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to open the file \"" << i_path_target << "\" for writing: " << errorMessage_system;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Copy the contents
+	{
+		std::unique_ptr<uint8_t[]> buffer( new uint8_t[s_copyBufferSize] );
+		for ( uint64_t offset = 0; offset < fileSize; offset += s_copyBufferSize )
+		{
+			const auto size = static_cast<size_t>( std::min<uint64_t>( fileSize - offset, s_copyBufferSize ) );
+			if ( !( result = ReadFromFile( sourceFile, i_path_source, offset, size, buffer.get(), o_errorMessage ) ) )
+			{
+				goto OnExit;
+			}
+			if ( !( result = WriteToFile( targetFile, i_path_target, buffer.get(), size, o_errorMessage ) ) )
+			{
+				goto OnExit;
+			}
+		}
+	}
+	// A copied file keeps the source's last write time (like it does on Windows)
+	// unless the caller wants it to be the current time (which a newly-written file already has)
+	if ( !i_shouldTargetFileTimeBeModified )
+	{
+		struct stat sourceStatus;
+		if ( fstat( sourceFile, &sourceStatus ) == -1 )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = GetLastSystemError();
+			}
+			goto OnExit;
+		}
+		const timespec fileTimes[] = { sourceStatus.st_atim, sourceStatus.st_mtim };
+		if ( futimens( targetFile, fileTimes ) == -1 )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = GetLastSystemError();
+			}
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( sourceFile != -1 )
+	{
+		const auto closeResult = CloseFile( sourceFile, i_path_source, result ? o_errorMessage : nullptr );
+		if ( !closeResult && result )
+		{
+			result = closeResult;
+		}
+	}
+	if ( targetFile != -1 )
+	{
+		const auto closeResult = CloseFile( targetFile, i_path_target, result ? o_errorMessage : nullptr );
+		if ( !closeResult && result )
+		{
+			result = closeResult;
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::CreateDirectoryIfItDoesntExist( const std::string& i_filePath, std::string* const o_errorMessage )
+{
+	// If the path is to a file (likely), remove it so that only the directory remains
+	std::string directory;
+	{
+		const auto pos_slash = i_filePath.find_last_of( "\\/" );
+		if ( pos_slash == i_filePath.npos )
+		{
+			// The file is in the current directory, which already exists
+			return Results::Success;
+		}
+		directory = i_filePath.substr( 0, pos_slash );
+		std::replace( directory.begin(), directory.end(), '\\', '/' );
+	}
+	// Every directory in the path is created in turn
+	for ( auto pos_slash = directory.find( '/', 1 ); ; pos_slash = directory.find( '/', pos_slash + 1 ) )
+	{
+		const auto parentDirectory = directory.substr( 0, pos_slash );
+		constexpr mode_t permissions = S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH;
+		if ( ( mkdir( parentDirectory.c_str(), permissions ) == -1 ) && ( errno != EEXIST ) )
+		{
+			if ( o_errorMessage )
+			{
+				const auto errorMessage_system = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to create the directory \"" << parentDirectory << "\": " << errorMessage_system;
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+		if ( pos_slash == directory.npos )
+		{
+			break;
+		}
+	}
+
+	return Results::Success;
+}
+
+bool eae6320::Platform::DoesFileExist( const char* const i_path, std::string* const o_errorMessage )
+{
+	struct stat fileStatus;
+	if ( stat( i_path, &fileStatus ) == 0 )
+	{
+		return true;
+	}
+	else
+	{
+		int errorCode;
+		const auto errorMessage = GetLastSystemError( &errorCode );
+		EAE6320_ASSERTF( ( errorCode == ENOENT ) || ( errorCode == ENOTDIR ),
+			"stat() failed with the unexpected error code of %d: %s", errorCode, errorMessage.c_str() );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = errorMessage;
+		}
+		return false;
+	}
+}
+
+eae6320::cResult eae6320::Platform::ExecuteCommand( const char* const i_command, int* const o_exitCode, std::string* const o_errorMessage )
+{
+	// The command is run by the shell (like it is by the command prompt on Windows)
+	pid_t processId;
+	{
+		char shellPath[] = "/bin/sh";
+		char commandOption[] = "-c";
+		std::string command( i_command );
+		char* const arguments[] = { shellPath, commandOption, &command[0], nullptr };
+		constexpr posix_spawn_file_actions_t* const dontChangeFiles = nullptr;
+		constexpr posix_spawnattr_t* const useDefaultAttributes = nullptr;
+		const auto errorCode = posix_spawn( &processId, shellPath, dontChangeFiles, useDefaultAttributes, arguments, environ );
+		if ( errorCode != 0 )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to start the command \"" << i_command << "\": " << std::error_code( errorCode, std::generic_category() ).message();
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+	}
+	// Wait for it to finish
+	{
+		int status;
+		while ( waitpid( processId, &status, 0 ) == -1 )
+		{
+			if ( errno != EINTR )
+			{
+				if ( o_errorMessage )
+				{
+					const auto errorMessage_system = GetLastSystemError();
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to wait for the command \"" << i_command << "\" to finish: " << errorMessage_system;
+					*o_errorMessage = errorMessage.str();
+				}
+				return Results::Failure;
+			}
+		}
+		if ( o_exitCode )
+		{
+			// A command that was killed by a signal reports the signal as a negative exit code
+			*o_exitCode = WIFEXITED( status ) ? WEXITSTATUS( status ) : ( WIFSIGNALED( status ) ? -WTERMSIG( status ) : -1 );
+		}
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Platform::GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage )
+{
+	if ( const auto* const value = getenv( i_key ) )
+	{
+		o_value = value;
+		return Results::Success;
+	}
+	else
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The environment variable \"" << i_key << "\" doesn't exist";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::Platform::EnvironmentVariableDoesntExist;
+	}
+}
+
+eae6320::cResult eae6320::Platform::GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
+	const bool i_shouldSubdirectoriesBeSearchedRecursively, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	// Transform the path to have a trailing slash
+	std::string path_trailingSlash = i_path;
+	if ( path_trailingSlash.empty() || ( ( path_trailingSlash.back() != '/' ) && ( path_trailingSlash.back() != '\\' ) ) )
+	{
+		path_trailingSlash += "/";
+	}
+	auto* const directory = opendir( path_trailingSlash.c_str() );
+	if ( !directory )
+	{
+		int errorCode;
+		const auto errorMessage_system = GetLastSystemError( &errorCode );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = errorMessage_system;
+		}
+		return GetResultFromErrorCode( errorCode );
+	}
+	// readdir() only returns null without changing errno once every entry has been read
+	errno = 0;
+	while ( const auto* const entry = readdir( directory ) )
+	{
+		// Hidden files and the . and .. entries are skipped (like they are on Windows)
+		if ( entry->d_name[0] != '.' )
+		{
+			const auto path = path_trailingSlash + entry->d_name;
+			// Some file systems don't report the type, in which case the file is checked
+			bool isDirectory = entry->d_type == DT_DIR;
+			if ( entry->d_type == DT_UNKNOWN )
+			{
+				struct stat fileStatus;
+				isDirectory = ( stat( path.c_str(), &fileStatus ) == 0 ) && S_ISDIR( fileStatus.st_mode );
+			}
+			if ( isDirectory )
+			{
+				if ( i_shouldSubdirectoriesBeSearchedRecursively )
+				{
+					if ( !( result = GetFilesInDirectory( path, o_paths, i_shouldSubdirectoriesBeSearchedRecursively, o_errorMessage ) ) )
+					{
+						goto OnExit;
+					}
+				}
+			}
+			else
+			{
+				o_paths.push_back( path );
+			}
+		}
+		errno = 0;
+	}
+	if ( errno != 0 )
+	{
+		result = Results::Failure;
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = GetLastSystemError();
+		}
+		goto OnExit;
+	}
+
+OnExit:
+
+	if ( closedir( directory ) == -1 )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage += "\n";
+			*o_errorMessage += GetLastSystemError();
+		}
+		if ( result )
+		{
+			result = Results::Failure;
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage )
+{
+	struct stat fileStatus;
+	if ( stat( i_path, &fileStatus ) == 0 )
+	{
+		// The time is only meant to be compared with other times from this function,
+		// and so it uses the most precise units available (nanoseconds) rather than the ones that Windows uses
+		o_lastWriteTime = ( static_cast<uint64_t>( fileStatus.st_mtim.tv_sec ) * 1000000000u ) + static_cast<uint64_t>( fileStatus.st_mtim.tv_nsec );
+		return Results::Success;
+	}
+	else
+	{
+		int errorCode;
+		const auto errorMessage_system = GetLastSystemError( &errorCode );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = errorMessage_system;
+		}
+		return GetResultFromErrorCode( errorCode );
+	}
+}
+
+eae6320::cResult eae6320::Platform::InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage )
+{
+	// The last write time is set to the same earliest possible time as on Windows (the beginning of 1980)
+	// and the last access time isn't changed
+	constexpr time_t earliestPossibleTime = 315532800;
+	const timespec fileTimes[] = { { 0, UTIME_OMIT }, { earliestPossibleTime, 0 } };
+	if ( utimensat( AT_FDCWD, i_path, fileTimes, 0 ) == 0 )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		int errorCode;
+		const auto errorMessage_system = GetLastSystemError( &errorCode );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = errorMessage_system;
+		}
+		return GetResultFromErrorCode( errorCode );
+	}
+}
+
+eae6320::cResult eae6320::Platform::LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage )
+{
+	constexpr bool loadTheEntireFile = true;
+	constexpr uint64_t ignoredOffset = 0;
+	constexpr size_t ignoredSize = 0;
+	constexpr void* const allocateMemory = nullptr;
+	return LoadFile( i_path, loadTheEntireFile, ignoredOffset, ignoredSize, allocateMemory, o_data, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::LoadPartOfBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, sDataFromFile& o_data,
+	std::string* const o_errorMessage )
+{
+	constexpr bool loadOnlyPartOfTheFile = false;
+	constexpr void* const allocateMemory = nullptr;
+	return LoadFile( i_path, loadOnlyPartOfTheFile, i_offset, i_size, allocateMemory, o_data, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::ReadBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, void* const o_destination,
+	std::string* const o_errorMessage )
+{
+	EAE6320_ASSERT( o_destination || ( i_size == 0 ) );
+	constexpr bool loadOnlyPartOfTheFile = false;
+	sDataFromFile ignoredData;
+	return LoadFile( i_path, loadOnlyPartOfTheFile, i_offset, i_size, o_destination, ignoredData, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	// Open the file
+	constexpr mode_t permissions = S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+	const auto file = open( i_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, permissions );
+	if ( file == -1 )
+	{
+		if ( o_errorMessage )
+		{
+			const auto errorMessage_system = GetLastSystemError();
+			std::ostringstream errorMessage;
+			errorMessage << "Failed to open the file \"" << i_path << "\" for writing: " << errorMessage_system;
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::Failure;
+	}
+	// Write the data
+	result = WriteToFile( file, i_path, i_data, i_size, o_errorMessage );
+	// Close the file
+	{
+		const auto closeResult = CloseFile( file, i_path, result ? o_errorMessage : nullptr );
+		if ( !closeResult && result )
+		{
+			result = closeResult;
+		}
+	}
+
+	return result;
+}
+
+// Packages
+//---------
+
+eae6320::cResult eae6320::Platform::MountPackage( const char* const i_path, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	sMountedPackage package;
+
+	// Open the file and get its size
+	if ( !( result = OpenFileForReading( i_path, package.file, package.size, o_errorMessage ) ) )
+	{
+		goto OnExit;
+	}
+	// The entire package is mapped at once,
+	// which means that it must fit in the address space
+	if ( package.size > SIZE_MAX )
+	{
+		result = Results::OutOfMemory;
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The package \"" << i_path << "\" is too big (" << package.size << " bytes) to be memory-mapped";
+			*o_errorMessage = errorMessage.str();
+		}
+		goto OnExit;
+	}
+	// An empty file can't be mapped
+	if ( package.size < sizeof( Package::sHeader ) )
+	{
+		result = Results::InvalidFile;
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The package \"" << i_path << "\" is too small (" << package.size << " bytes) to be valid";
+			*o_errorMessage = errorMessage.str();
+		}
+		goto OnExit;
+	}
+	// Map the file into memory
+	// (nothing is actually read until a page is used)
+	{
+		constexpr void* const letTheSystemChooseTheAddress = nullptr;
+		constexpr off_t startAtTheBeginning = 0;
+		auto* const data = mmap( letTheSystemChooseTheAddress, static_cast<size_t>( package.size ), PROT_READ, MAP_PRIVATE,
+			package.file, startAtTheBeginning );
+		if ( data == MAP_FAILED )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				const auto errorMessage_system = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to map the package \"" << i_path << "\" into memory: " << errorMessage_system;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		package.data = data;
+		// Files are read from all over a package
+		// (this is only a hint, and so it doesn't matter if it fails)
+		madvise( data, static_cast<size_t>( package.size ), MADV_RANDOM );
+	}
+	// Validate the table of contents
+	if ( !Package::IsValid( package.data, package.size ) )
+	{
+		result = Results::InvalidFile;
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The package \"" << i_path << "\" has an invalid header or table of contents"
+				" (it may have been built with a different version of the asset build)";
+			*o_errorMessage = errorMessage.str();
+		}
+		goto OnExit;
+	}
+
+	s_mountedPackages.push_back( package );
+
+OnExit:
+
+	if ( !result )
+	{
+		UnmapPackage( package );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::MountPackagesInDirectory( const char* const i_path, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	std::vector<std::string> paths;
+	{
+		constexpr bool dontSearchSubdirectories = false;
+		if ( !( result = GetFilesInDirectory( i_path, paths, dontSearchSubdirectories, o_errorMessage ) ) )
+		{
+			return result;
+		}
+	}
+	// The packages are mounted in a consistent order
+	// (unlike Windows, POSIX doesn't return the files in a directory sorted)
+	std::sort( paths.begin(), paths.end() );
+	for ( const auto& path : paths )
+	{
+		constexpr char extension[] = ".pak";
+		constexpr auto extensionLength = sizeof( extension ) - 1;
+		if ( ( path.length() > extensionLength ) && ( strcasecmp( path.c_str() + ( path.length() - extensionLength ), extension ) == 0 ) )
+		{
+			if ( !( result = MountPackage( path.c_str(), o_errorMessage ) ) )
+			{
+				return result;
+			}
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::GetFileLocation( const char* const i_path, sFileLocation& o_location, std::string* const o_errorMessage )
+{
+	o_location = sFileLocation();
+	// Packages are searched in the same order as when a file is loaded
+	for ( size_t i = 0; i < s_mountedPackages.size(); ++i )
+	{
+		if ( const auto* const entry = Package::FindEntry( s_mountedPackages[i].data, i_path ) )
+		{
+			o_location.packageIndex = static_cast<uint32_t>( i );
+			o_location.offset = entry->offset;
+			o_location.storedSize = entry->storedSize;
+			return Results::Success;
+		}
+	}
+	// Otherwise the file is loose
+	{
+		int looseFile = -1;
+		auto result = OpenFileForReading( i_path, looseFile, o_location.storedSize, o_errorMessage );
+		if ( result )
+		{
+			result = CloseFile( looseFile, i_path, o_errorMessage );
+		}
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::Platform::PrefetchFile( const char* const i_path, uint64_t* const o_storedSize, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	uint64_t storedSize = 0;
+	const void* package = nullptr;
+	if ( const auto* const packageEntry = FindFileInMountedPackages( i_path, package ) )
+	{
+		// The package is mapped into memory,
+		// and reading one byte from every page makes the operating system read the whole file
+		// (every file in a package starts on its own page)
+		storedSize = packageEntry->storedSize;
+		const auto* const storedData = static_cast<const volatile uint8_t*>( package ) + packageEntry->offset;
+		uint8_t ignoredByte = 0;
+		for ( uint64_t offset = 0; offset < storedSize; offset += Package::s_entryAlignment )
+		{
+			ignoredByte ^= storedData[offset];
+		}
+		static_cast<void>( ignoredByte );
+	}
+	else
+	{
+		int looseFile = -1;
+		if ( !( result = OpenFileForReading( i_path, looseFile, storedSize, o_errorMessage ) ) )
+		{
+			return result;
+		}
+		{
+			std::unique_ptr<uint8_t[]> buffer( new uint8_t[s_prefetchBufferSize] );
+			for ( uint64_t offset = 0; offset < storedSize; offset += s_prefetchBufferSize )
+			{
+				const auto size = static_cast<size_t>( std::min<uint64_t>( storedSize - offset, s_prefetchBufferSize ) );
+				if ( !( result = ReadFromFile( looseFile, i_path, offset, size, buffer.get(), o_errorMessage ) ) )
+				{
+					break;
+				}
+			}
+		}
+		const auto closeResult = CloseFile( looseFile, i_path, result ? o_errorMessage : nullptr );
+		if ( !closeResult && result )
+		{
+			result = closeResult;
+		}
+	}
+	if ( result && o_storedSize )
+	{
+		*o_storedSize = storedSize;
+	}
+
+	return result;
+}
+
+void eae6320::Platform::SetFileLoadObserver( const fFileLoadObserver i_observer )
+{
+	s_fileLoadObserver.store( i_observer );
+}
+
+void eae6320::Platform::UnmountAllPackages()
+{
+	for ( auto& package : s_mountedPackages )
+	{
+		UnmapPackage( package );
+	}
+	s_mountedPackages.clear();
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* FindFileInMountedPackages( const char* const i_path, const void*& o_package )
+	{
+		for ( const auto& package : s_mountedPackages )
+		{
+			if ( const auto* const entry = eae6320::Platform::Package::FindEntry( package.data, i_path ) )
+			{
+				o_package = package.data;
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	eae6320::cResult LoadFile( const char* const i_path, const bool i_shouldEntireFileBeLoaded, const uint64_t i_offset, const size_t i_size,
+		void* const o_destination, eae6320::Platform::sDataFromFile& o_data, std::string* const o_errorMessage )
+	{
+		auto result = eae6320::Results::Success;
+
+		using namespace eae6320::Platform;
+
+		// Initialize the output struct so that if there's an error during this function any existing garbage data isn't misinterpreted
+		{
+			o_data.data = nullptr;
+			o_data.size = 0;
+		}
+
+		// A file can be in a mounted package or a loose file
+		const void* package = nullptr;
+		const auto* const packageEntry = FindFileInMountedPackages( i_path, package );
+		int looseFile = -1;
+		uint64_t storedSize = packageEntry ? packageEntry->uncompressedSize : 0;
+		const auto readStoredBytes = [&]( const uint64_t i_offset_stored, const size_t i_size_stored, void* const o_storedData ) -> eae6320::cResult
+		{
+			if ( packageEntry )
+			{
+				const auto result = Package::ReadEntry( package, *packageEntry, i_offset_stored, i_size_stored, o_storedData );
+				if ( !result && o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The packaged file \"" << i_path << "\" couldn't be read (" << i_size_stored << " bytes at offset " << i_offset_stored << ")";
+					*o_errorMessage = errorMessage.str();
+				}
+				return result;
+			}
+			else
+			{
+				return ReadFromFile( looseFile, i_path, i_offset_stored, i_size_stored, o_storedData, o_errorMessage );
+			}
+		};
+		// Built assets may have been compressed,
+		// in which case they are decompressed a block at a time directly into the memory that is returned
+		Compression::sFileHeader compressedFileHeader;
+		auto isFileCompressed = false;
+		uint64_t offset = i_offset;
+		size_t size = i_size;
+
+		if ( !packageEntry )
+		{
+			if ( !( result = OpenFileForReading( i_path, looseFile, storedSize, o_errorMessage ) ) )
+			{
+				goto OnExit;
+			}
+		}
+		// A package entry that is compressed by the package is never also a compressed file
+		// (the packager stores the decompressed contents of every built file),
+		// and checking it for a header would decompress the whole entry an extra time
+		if ( ( !packageEntry || ( packageEntry->codec == Compression::None ) ) && ( storedSize >= sizeof( compressedFileHeader ) ) )
+		{
+			if ( !( result = readStoredBytes( 0, sizeof( compressedFileHeader ), &compressedFileHeader ) ) )
+			{
+				goto OnExit;
+			}
+			isFileCompressed = Compression::IsCompressedFile( &compressedFileHeader, sizeof( compressedFileHeader ) );
+		}
+		// Decide which bytes to read
+		{
+			const auto fileSize = isFileCompressed ? compressedFileHeader.uncompressedSize : storedSize;
+			if ( i_shouldEntireFileBeLoaded )
+			{
+				if ( fileSize > SIZE_MAX )
+				{
+					result = eae6320::Results::OutOfMemory;
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "The file \"" << i_path << "\" is too big (" << fileSize << " bytes) to be loaded";
+						*o_errorMessage = errorMessage.str();
+					}
+					goto OnExit;
+				}
+				offset = 0;
+				size = static_cast<size_t>( fileSize );
+			}
+			else if ( ( i_offset > fileSize ) || ( i_size > ( fileSize - i_offset ) ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The file \"" << i_path << "\" (" << fileSize << " bytes) is too small to read "
+						<< i_size << " bytes at offset " << i_offset;
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		// Allocate memory
+		// (it is the caller's responsibility to free it with sDataFromFile::Free())
+		if ( o_destination )
+		{
+			o_data.data = o_destination;
+		}
+		else if ( size > 0 )
+		{
+			o_data.data = malloc( size );
+			if ( !o_data.data )
+			{
+				result = eae6320::Results::OutOfMemory;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to allocate " << size << " bytes to read in the file \"" << i_path << "\"";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		o_data.size = size;
+		// Read the requested bytes
+		if ( isFileCompressed )
+		{
+			if ( !( result = Compression::DecompressFile( compressedFileHeader, readStoredBytes, offset, size, o_data.data ) ) )
+			{
+				if ( o_errorMessage && o_errorMessage->empty() )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The compressed file \"" << i_path << "\" couldn't be decompressed";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		else if ( size > 0 )
+		{
+			if ( !( result = readStoredBytes( offset, size, o_data.data ) ) )
+			{
+				goto OnExit;
+			}
+		}
+
+	OnExit:
+
+		if ( !result )
+		{
+			// The caller's memory is never freed
+			if ( o_destination )
+			{
+				o_data.data = nullptr;
+			}
+			else
+			{
+				o_data.Free();
+			}
+			o_data.size = 0;
+		}
+		if ( looseFile != -1 )
+		{
+			const auto closeResult = CloseFile( looseFile, i_path, result ? o_errorMessage : nullptr );
+			if ( !closeResult && result )
+			{
+				result = closeResult;
+			}
+		}
+		if ( result )
+		{
+			if ( const auto observer = s_fileLoadObserver.load() )
+			{
+				observer( i_path );
+			}
+		}
+
+		return result;
+	}
+
+	void UnmapPackage( sMountedPackage& io_package )
+	{
+		if ( io_package.data )
+		{
+			const auto wasUnmapSuccessful = munmap( const_cast<void*>( io_package.data ), static_cast<size_t>( io_package.size ) ) == 0;
+			EAE6320_ASSERT( wasUnmapSuccessful );
+			static_cast<void>( wasUnmapSuccessful );
+			io_package.data = nullptr;
+		}
+		if ( io_package.file != -1 )
+		{
+			const auto wasCloseSuccessful = close( io_package.file ) == 0;
+			EAE6320_ASSERT( wasCloseSuccessful );
+			static_cast<void>( wasCloseSuccessful );
+			io_package.file = -1;
+		}
+		io_package.size = 0;
+	}
+
+	eae6320::cResult CloseFile( const int i_file, const char* const i_path, std::string* const o_errorMessage )
+	{
+		if ( close( i_file ) == 0 )
+		{
+			return eae6320::Results::Success;
+		}
+		else
+		{
+			if ( o_errorMessage )
+			{
+				const auto errorMessage_system = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to close the file \"" << i_path << "\": " << errorMessage_system;
+				*o_errorMessage = errorMessage.str();
+			}
+			return eae6320::Results::Failure;
+		}
+	}
+
+	std::string GetLastSystemError( int* const o_optionalErrorCode )
+	{
+		// The error code is saved before anything else can change it
+		const auto errorCode = errno;
+		if ( o_optionalErrorCode )
+		{
+			*o_optionalErrorCode = errorCode;
+		}
+		// Unlike strerror() this is thread-safe
+		return std::error_code( errorCode, std::generic_category() ).message();
+	}
+
+	eae6320::cResult OpenFileForReading( const char* const i_path, int& o_file, uint64_t& o_fileSize, std::string* const o_errorMessage )
+	{
+		o_fileSize = 0;
+
+		// Open the file
+		o_file = open( i_path, O_RDONLY | O_CLOEXEC );
+		if ( o_file == -1 )
+		{
+			int errorCode;
+			const auto errorMessage_system = GetLastSystemError( &errorCode );
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to open the file \"" << i_path << "\" for reading: " << errorMessage_system;
+				*o_errorMessage = errorMessage.str();
+			}
+			return GetResultFromErrorCode( errorCode );
+		}
+		// Get the file's size
+		{
+			struct stat fileStatus;
+			if ( fstat( o_file, &fileStatus ) == 0 )
+			{
+				o_fileSize = static_cast<uint64_t>( fileStatus.st_size );
+			}
+			else
+			{
+				if ( o_errorMessage )
+				{
+					const auto errorMessage_system = GetLastSystemError();
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to get the size of the file \"" << i_path << "\": " << errorMessage_system;
+					*o_errorMessage = errorMessage.str();
+				}
+				close( o_file );
+				o_file = -1;
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult ReadFromFile( const int i_file, const char* const i_path, const uint64_t i_offset, const size_t i_size,
+		void* const o_data, std::string* const o_errorMessage )
+	{
+		// pread() doesn't move the file's position,
+		// but it can return fewer bytes than were requested and so it is called until everything has been read
+		size_t readByteCount = 0;
+		while ( readByteCount < i_size )
+		{
+			const auto result = pread( i_file, static_cast<uint8_t*>( o_data ) + readByteCount, i_size - readByteCount,
+				static_cast<off_t>( i_offset + readByteCount ) );
+			if ( result > 0 )
+			{
+				readByteCount += static_cast<size_t>( result );
+			}
+			else if ( result == 0 )
+			{
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "Only " << readByteCount << " of " << i_size << " bytes could be read from the file \"" << i_path << "\"";
+					*o_errorMessage = errorMessage.str();
+				}
+				return eae6320::Results::InvalidFile;
+			}
+			else if ( errno != EINTR )
+			{
+				if ( o_errorMessage )
+				{
+					const auto errorMessage_system = GetLastSystemError();
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to read the contents of the file \"" << i_path << "\": " << errorMessage_system;
+					*o_errorMessage = errorMessage.str();
+				}
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult WriteToFile( const int i_file, const char* const i_path, const void* const i_data, const size_t i_size,
+		std::string* const o_errorMessage )
+	{
+		// write() can write fewer bytes than were requested and so it is called until everything has been written
+		size_t writtenByteCount = 0;
+		while ( writtenByteCount < i_size )
+		{
+			const auto result = write( i_file, static_cast<const uint8_t*>( i_data ) + writtenByteCount, i_size - writtenByteCount );
+			if ( result >= 0 )
+			{
+				writtenByteCount += static_cast<size_t>( result );
+			}
+			else if ( errno != EINTR )
+			{
+				if ( o_errorMessage )
+				{
+					const auto errorMessage_system = GetLastSystemError();
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to write to the file \"" << i_path << "\": " << errorMessage_system;
+					*o_errorMessage = errorMessage.str();
+				}
+				return eae6320::Results::Failure;
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult GetResultFromErrorCode( const int i_errorCode )
+	{
+		switch ( i_errorCode )
+		{
+		case ENOENT:
+		case ENOTDIR:
+			return eae6320::Results::FileDoesntExist;
+		default:
+			return eae6320::Results::Failure;
+		}
+	}
+}
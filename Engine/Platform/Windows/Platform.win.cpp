@@ -3,7 +3,49 @@
 
 #include "../Platform.h"
 
+#include "../Package.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
 #include <Engine/Windows/Functions.h>
+#include <memory>
+#include <sstream>
+
+// Static Data Initialization
+//===========================
+
+namespace
+{
+	struct sMountedPackage
+	{
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE fileMapping = NULL;
+		const void* data = nullptr;
+		uint64_t size = 0;
+	};
+	std::vector<sMountedPackage> s_mountedPackages;
+
+	std::atomic<eae6320::Platform::fFileLoadObserver> s_fileLoadObserver( nullptr );
+
+	// Loose files are prefetched this many bytes at a time
+	constexpr size_t s_prefetchBufferSize = 256 * 1024;
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* FindFileInMountedPackages( const char* const i_path, const void*& o_package );
+	// If i_shouldEntireFileBeLoaded is true then i_offset and i_size are ignored.
+	// If o_destination is null memory is allocated for the file,
+	// and otherwise the file is read into o_destination (which o_data then refers to).
+	eae6320::cResult LoadFile( const char* const i_path, const bool i_shouldEntireFileBeLoaded, const uint64_t i_offset, const size_t i_size,
+		void* const o_destination, eae6320::Platform::sDataFromFile& o_data, std::string* const o_errorMessage );
+	void UnmapPackage( sMountedPackage& io_package );
+}
 
 // Interface
 //==========
@@ -62,17 +104,512 @@ eae6320::cResult eae6320::Platform::InvalidateLastWriteTime( const char* const i
 
 eae6320::cResult eae6320::Platform::LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage )
 {
-	Windows::sDataFromFile dataFromFile;
-	const auto result = Windows::LoadBinaryFile( i_path, dataFromFile, o_errorMessage );
+	constexpr bool loadTheEntireFile = true;
+	constexpr uint64_t ignoredOffset = 0;
+	constexpr size_t ignoredSize = 0;
+	constexpr void* const allocateMemory = nullptr;
+	return LoadFile( i_path, loadTheEntireFile, ignoredOffset, ignoredSize, allocateMemory, o_data, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::LoadPartOfBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, sDataFromFile& o_data,
+	std::string* const o_errorMessage )
+{
+	constexpr bool loadOnlyPartOfTheFile = false;
+	constexpr void* const allocateMemory = nullptr;
+	return LoadFile( i_path, loadOnlyPartOfTheFile, i_offset, i_size, allocateMemory, o_data, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::ReadBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, void* const o_destination,
+	std::string* const o_errorMessage )
+{
+	EAE6320_ASSERT( o_destination || ( i_size == 0 ) );
+	constexpr bool loadOnlyPartOfTheFile = false;
+	sDataFromFile ignoredData;
+	return LoadFile( i_path, loadOnlyPartOfTheFile, i_offset, i_size, o_destination, ignoredData, o_errorMessage );
+}
+
+eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
+{
+	return Windows::WriteBinaryFile( i_path, i_data, i_size, o_errorMessage );
+}
+
+// Packages
+//---------
+
+eae6320::cResult eae6320::Platform::MountPackage( const char* const i_path, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	sMountedPackage package;
+
+	// Open the file
+	{
+		constexpr DWORD desiredAccess = FILE_GENERIC_READ;
+		constexpr DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		// Files are read from all over a package
+		constexpr DWORD attributes = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS;
+		constexpr HANDLE dontUseTemplateFile = NULL;
+		package.file = CreateFile( i_path, desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, attributes, dontUseTemplateFile );
+		if ( package.file == INVALID_HANDLE_VALUE )
+		{
+			DWORD errorCode;
+			const auto windowsError = Windows::GetLastSystemError( &errorCode );
+			switch ( errorCode )
+			{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				result = Results::FileDoesntExist;
+				break;
+			default:
+				result = Results::Failure;
+			}
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the package \"" << i_path << "\" for reading: " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Get the file's size
+	{
+		LARGE_INTEGER fileSize_integer;
+		if ( GetFileSizeEx( package.file, &fileSize_integer ) != FALSE )
+		{
+			package.size = static_cast<uint64_t>( fileSize_integer.QuadPart );
+			// The entire package is mapped at once,
+			// which means that it must fit in the address space
+			if ( package.size > SIZE_MAX )
+			{
+				result = Results::OutOfMemory;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The package \"" << i_path << "\" is too big (" << package.size << " bytes) to be memory-mapped";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+			// An empty file can't be mapped
+			if ( package.size < sizeof( Package::sHeader ) )
+			{
+				result = Results::InvalidFile;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The package \"" << i_path << "\" is too small (" << package.size << " bytes) to be valid";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				const auto windowsError = Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the size of the package \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Map the file into memory
+	// (nothing is actually read until a page is used)
+	{
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD mapTheEntireFile = 0;
+		constexpr char* const dontNameTheMapping = nullptr;
+		package.fileMapping = CreateFileMapping( package.file, useDefaultSecurity, PAGE_READONLY, mapTheEntireFile, mapTheEntireFile, dontNameTheMapping );
+		if ( package.fileMapping == NULL )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				const auto windowsError = Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to create a file mapping for the package \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		constexpr DWORD startAtTheBeginning = 0;
+		constexpr SIZE_T mapEverything = 0;
+		package.data = MapViewOfFile( package.fileMapping, FILE_MAP_READ, startAtTheBeginning, startAtTheBeginning, mapEverything );
+		if ( !package.data )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				const auto windowsError = Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to map a view of the package \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Validate the table of contents
+	if ( !Package::IsValid( package.data, package.size ) )
+	{
+		result = Results::InvalidFile;
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The package \"" << i_path << "\" has an invalid header or table of contents"
+				" (it may have been built with a different version of the asset build)";
+			*o_errorMessage = errorMessage.str();
+		}
+		goto OnExit;
+	}
+
+	s_mountedPackages.push_back( package );
+
+OnExit:
+
+	if ( !result )
 	{
-		o_data.data = dataFromFile.data;
-		o_data.size = dataFromFile.size;
+		UnmapPackage( package );
 	}
 
 	return result;
 }
 
-eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
+eae6320::cResult eae6320::Platform::MountPackagesInDirectory( const char* const i_path, std::string* const o_errorMessage )
 {
-	return Windows::WriteBinaryFile( i_path, i_data, i_size, o_errorMessage );
+	auto result = Results::Success;
+
+	std::vector<std::string> paths;
+	{
+		constexpr bool dontSearchSubdirectories = false;
+		if ( !( result = GetFilesInDirectory( i_path, paths, dontSearchSubdirectories, o_errorMessage ) ) )
+		{
+			return result;
+		}
+	}
+	for ( const auto& path : paths )
+	{
+		constexpr char extension[] = ".pak";
+		constexpr auto extensionLength = sizeof( extension ) - 1;
+		if ( ( path.length() > extensionLength ) && ( _stricmp( path.c_str() + ( path.length() - extensionLength ), extension ) == 0 ) )
+		{
+			if ( !( result = MountPackage( path.c_str(), o_errorMessage ) ) )
+			{
+				return result;
+			}
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::GetFileLocation( const char* const i_path, sFileLocation& o_location, std::string* const o_errorMessage )
+{
+	o_location = sFileLocation();
+	// Packages are searched in the same order as when a file is loaded
+	for ( size_t i = 0; i < s_mountedPackages.size(); ++i )
+	{
+		if ( const auto* const entry = Package::FindEntry( s_mountedPackages[i].data, i_path ) )
+		{
+			o_location.packageIndex = static_cast<uint32_t>( i );
+			o_location.offset = entry->offset;
+			o_location.storedSize = entry->storedSize;
+			return Results::Success;
+		}
+	}
+	// Otherwise the file is loose
+	{
+		HANDLE looseFile = INVALID_HANDLE_VALUE;
+		auto result = Windows::OpenFileForReading( i_path, looseFile, o_location.storedSize, o_errorMessage );
+		if ( result )
+		{
+			result = Windows::CloseFile( looseFile, i_path, o_errorMessage );
+		}
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::Platform::PrefetchFile( const char* const i_path, uint64_t* const o_storedSize, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	uint64_t storedSize = 0;
+	const void* package = nullptr;
+	if ( const auto* const packageEntry = FindFileInMountedPackages( i_path, package ) )
+	{
+		// The package is mapped into memory,
+		// and reading one byte from every page makes the operating system read the whole file
+		// (every file in a package starts on its own page)
+		storedSize = packageEntry->storedSize;
+		const auto* const storedData = static_cast<const volatile uint8_t*>( package ) + packageEntry->offset;
+		uint8_t ignoredByte = 0;
+		for ( uint64_t offset = 0; offset < storedSize; offset += Package::s_entryAlignment )
+		{
+			ignoredByte ^= storedData[offset];
+		}
+		static_cast<void>( ignoredByte );
+	}
+	else
+	{
+		HANDLE looseFile = INVALID_HANDLE_VALUE;
+		if ( !( result = Windows::OpenFileForReading( i_path, looseFile, storedSize, o_errorMessage ) ) )
+		{
+			return result;
+		}
+		{
+			std::unique_ptr<uint8_t[]> buffer( new uint8_t[s_prefetchBufferSize] );
+			for ( uint64_t offset = 0; offset < storedSize; offset += s_prefetchBufferSize )
+			{
+				const auto size = static_cast<size_t>( std::min<uint64_t>( storedSize - offset, s_prefetchBufferSize ) );
+				if ( !( result = Windows::ReadFromFile( looseFile, i_path, offset, size, buffer.get(), o_errorMessage ) ) )
+				{
+					break;
+				}
+			}
+		}
+		const auto closeResult = Windows::CloseFile( looseFile, i_path, result ? o_errorMessage : nullptr );
+		if ( !closeResult && result )
+		{
+			result = closeResult;
+		}
+	}
+	if ( result && o_storedSize )
+	{
+		*o_storedSize = storedSize;
+	}
+
+	return result;
+}
+
+void eae6320::Platform::SetFileLoadObserver( const fFileLoadObserver i_observer )
+{
+	s_fileLoadObserver.store( i_observer );
+}
+
+void eae6320::Platform::UnmountAllPackages()
+{
+	for ( auto& package : s_mountedPackages )
+	{
+		UnmapPackage( package );
+	}
+	s_mountedPackages.clear();
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	const eae6320::Platform::Package::sEntry* FindFileInMountedPackages( const char* const i_path, const void*& o_package )
+	{
+		for ( const auto& package : s_mountedPackages )
+		{
+			if ( const auto* const entry = eae6320::Platform::Package::FindEntry( package.data, i_path ) )
+			{
+				o_package = package.data;
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	eae6320::cResult LoadFile( const char* const i_path, const bool i_shouldEntireFileBeLoaded, const uint64_t i_offset, const size_t i_size,
+		void* const o_destination, eae6320::Platform::sDataFromFile& o_data, std::string* const o_errorMessage )
+	{
+		auto result = eae6320::Results::Success;
+
+		using namespace eae6320::Platform;
+
+		// Initialize the output struct so that if there's an error during this function any existing garbage data isn't misinterpreted
+		{
+			o_data.data = nullptr;
+			o_data.size = 0;
+		}
+
+		// A file can be in a mounted package or a loose file
+		const void* package = nullptr;
+		const auto* const packageEntry = FindFileInMountedPackages( i_path, package );
+		HANDLE looseFile = INVALID_HANDLE_VALUE;
+		uint64_t storedSize = packageEntry ? packageEntry->uncompressedSize : 0;
+		const auto readStoredBytes = [&]( const uint64_t i_offset_stored, const size_t i_size_stored, void* const o_storedData ) -> eae6320::cResult
+		{
+			if ( packageEntry )
+			{
+				const auto result = Package::ReadEntry( package, *packageEntry, i_offset_stored, i_size_stored, o_storedData );
+				if ( !result && o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The packaged file \"" << i_path << "\" couldn't be read (" << i_size_stored << " bytes at offset " << i_offset_stored << ")";
+					*o_errorMessage = errorMessage.str();
+				}
+				return result;
+			}
+			else
+			{
+				return eae6320::Windows::ReadFromFile( looseFile, i_path, i_offset_stored, i_size_stored, o_storedData, o_errorMessage );
+			}
+		};
+		// Built assets may have been compressed,
+		// in which case they are decompressed a block at a time directly into the memory that is returned
+		Compression::sFileHeader compressedFileHeader;
+		auto isFileCompressed = false;
+		uint64_t offset = i_offset;
+		size_t size = i_size;
+
+		if ( !packageEntry )
+		{
+			if ( !( result = eae6320::Windows::OpenFileForReading( i_path, looseFile, storedSize, o_errorMessage ) ) )
+			{
+				goto OnExit;
+			}
+		}
+		// A package entry that is compressed by the package is never also a compressed file
+		// (the packager stores the decompressed contents of every built file),
+		// and checking it for a header would decompress the whole entry an extra time
+		if ( ( !packageEntry || ( packageEntry->codec == Compression::None ) ) && ( storedSize >= sizeof( compressedFileHeader ) ) )
+		{
+			if ( !( result = readStoredBytes( 0, sizeof( compressedFileHeader ), &compressedFileHeader ) ) )
+			{
+				goto OnExit;
+			}
+			isFileCompressed = Compression::IsCompressedFile( &compressedFileHeader, sizeof( compressedFileHeader ) );
+		}
+		// Decide which bytes to read
+		{
+			const auto fileSize = isFileCompressed ? compressedFileHeader.uncompressedSize : storedSize;
+			if ( i_shouldEntireFileBeLoaded )
+			{
+				if ( fileSize > SIZE_MAX )
+				{
+					result = eae6320::Results::OutOfMemory;
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "The file \"" << i_path << "\" is too big (" << fileSize << " bytes) to be loaded";
+						*o_errorMessage = errorMessage.str();
+					}
+					goto OnExit;
+				}
+				offset = 0;
+				size = static_cast<size_t>( fileSize );
+			}
+			else if ( ( i_offset > fileSize ) || ( i_size > ( fileSize - i_offset ) ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The file \"" << i_path << "\" (" << fileSize << " bytes) is too small to read "
+						<< i_size << " bytes at offset " << i_offset;
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		// Allocate memory
+		// (it is the caller's responsibility to free it with sDataFromFile::Free())
+		if ( o_destination )
+		{
+			o_data.data = o_destination;
+		}
+		else if ( size > 0 )
+		{
+			o_data.data = malloc( size );
+			if ( !o_data.data )
+			{
+				result = eae6320::Results::OutOfMemory;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "Failed to allocate " << size << " bytes to read in the file \"" << i_path << "\"";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		o_data.size = size;
+		// Read the requested bytes
+		if ( isFileCompressed )
+		{
+			if ( !( result = Compression::DecompressFile( compressedFileHeader, readStoredBytes, offset, size, o_data.data ) ) )
+			{
+				if ( o_errorMessage && o_errorMessage->empty() )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The compressed file \"" << i_path << "\" couldn't be decompressed";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		else if ( size > 0 )
+		{
+			if ( !( result = readStoredBytes( offset, size, o_data.data ) ) )
+			{
+				goto OnExit;
+			}
+		}
+
+	OnExit:
+
+		if ( !result )
+		{
+			// The caller's memory is never freed
+			if ( o_destination )
+			{
+				o_data.data = nullptr;
+			}
+			else
+			{
+				o_data.Free();
+			}
+			o_data.size = 0;
+		}
+		if ( looseFile != INVALID_HANDLE_VALUE )
+		{
+			const auto closeResult = eae6320::Windows::CloseFile( looseFile, i_path, result ? o_errorMessage : nullptr );
+			if ( !closeResult && result )
+			{
+				result = closeResult;
+			}
+		}
+		if ( result )
+		{
+			if ( const auto observer = s_fileLoadObserver.load() )
+			{
+				observer( i_path );
+			}
+		}
+
+		return result;
+	}
+
+	void UnmapPackage( sMountedPackage& io_package )
+	{
+		if ( io_package.data )
+		{
+			const auto wasUnmapSuccessful = UnmapViewOfFile( io_package.data ) != FALSE;
+			EAE6320_ASSERT( wasUnmapSuccessful );
+			io_package.data = nullptr;
+		}
+		if ( io_package.fileMapping != NULL )
+		{
+			const auto wasCloseSuccessful = CloseHandle( io_package.fileMapping ) != FALSE;
+			EAE6320_ASSERT( wasCloseSuccessful );
+			io_package.fileMapping = NULL;
+		}
+		if ( io_package.file != INVALID_HANDLE_VALUE )
+		{
+			const auto wasCloseSuccessful = CloseHandle( io_package.file ) != FALSE;
+			EAE6320_ASSERT( wasCloseSuccessful );
+			io_package.file = INVALID_HANDLE_VALUE;
+		}
+		io_package.size = 0;
+	}
 }
@@ -0,0 +1,36 @@
+// Include Files
+//==============
+
+#include "../UserOutput.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+// Interface
+//==========
+
+void eae6320::UserOutput::Print( const char* const i_message, ... )
+{
+	// There is no window to show a message box in,
+	// and so the message is written to the standard error stream
+	{
+		va_list insertions;
+		va_start( insertions, i_message );
+		std::vfprintf( stderr, i_message, insertions );
+		va_end( insertions );
+	}
+	std::fputc( '\n', stderr );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::UserOutput::Initialize( const sInitializationParameters& )
+{
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::UserOutput::CleanUp()
+{
+	return Results::Success;
+}
@@ -9,6 +9,7 @@
 #include <Engine/Platform/Platform.h>
 #include <External/Lua/Includes.h>
 #include <string>
+#include <unordered_map>
 
 // Static Data Initialization
 //===========================
@@ -19,6 +20,25 @@ namespace
 	auto s_resolutionHeight_validity = eae6320::Results::Failure;
 	uint16_t s_resolutionWidth = 0;
 	auto s_resolutionWidth_validity = eae6320::Results::Failure;
+	uint32_t s_textureMemoryBudget = 0;
+	auto s_textureMemoryBudget_validity = eae6320::Results::Failure;
+	uint32_t s_assetCacheBudget = 0;
+	auto s_assetCacheBudget_validity = eae6320::Results::Failure;
+	bool s_shouldAssetsBePrefetched = false;
+	auto s_shouldAssetsBePrefetched_validity = eae6320::Results::Failure;
+	bool s_shouldBenchmarksBeRun = false;
+	auto s_shouldBenchmarksBeRun_validity = eae6320::Results::Failure;
+	struct sThreadSettings
+	{
+		eae6320::Concurrency::eThreadPriority priority = eae6320::Concurrency::eThreadPriority::Normal;
+		uint64_t affinityMask = 0;
+		size_t stackSize_inBytes = 0;
+		bool isPrioritySpecified = false;
+		bool isAffinityMaskSpecified = false;
+		bool isStackSizeSpecified = false;
+		eae6320::cResult validity = eae6320::Results::Failure;
+	};
+	std::unordered_map<std::string, sThreadSettings> s_threadSettings;
 
 	constexpr auto* const s_userSettingsFileName = "Settings.ini";
 }
@@ -31,6 +51,8 @@ namespace
 	eae6320::cResult InitializeIfNecessary();
 	eae6320::cResult LoadUserSettingsIntoLuaTable( lua_State& io_luaState );
 	eae6320::cResult PopulateUserSettingsFromLuaTable( lua_State& io_luaState );
+	// The table with the thread's settings must be at the top of the stack
+	void PopulateThreadSettingsFromLuaTable( lua_State& io_luaState, const char* const i_threadKind, sThreadSettings& o_threadSettings );
 }
 
 // Interface
@@ -70,6 +92,108 @@ eae6320::cResult eae6320::UserSettings::GetDesiredInitialResolutionHeight( uint1
 	}
 }
 
+eae6320::cResult eae6320::UserSettings::GetTextureMemoryBudget( uint32_t& o_budget_inMegabytes )
+{
+	const auto result = InitializeIfNecessary();
+	if ( result )
+	{
+		if ( s_textureMemoryBudget_validity )
+		{
+			o_budget_inMegabytes = s_textureMemoryBudget;
+		}
+		return s_textureMemoryBudget_validity;
+	}
+	else
+	{
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::UserSettings::GetAssetCacheBudget( uint32_t& o_budget_inMegabytes )
+{
+	const auto result = InitializeIfNecessary();
+	if ( result )
+	{
+		if ( s_assetCacheBudget_validity )
+		{
+			o_budget_inMegabytes = s_assetCacheBudget;
+		}
+		return s_assetCacheBudget_validity;
+	}
+	else
+	{
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::UserSettings::GetShouldAssetsBePrefetched( bool& o_shouldAssetsBePrefetched )
+{
+	const auto result = InitializeIfNecessary();
+	if ( result )
+	{
+		if ( s_shouldAssetsBePrefetched_validity )
+		{
+			o_shouldAssetsBePrefetched = s_shouldAssetsBePrefetched;
+		}
+		return s_shouldAssetsBePrefetched_validity;
+	}
+	else
+	{
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::UserSettings::GetShouldBenchmarksBeRun( bool& o_shouldBenchmarksBeRun )
+{
+	const auto result = InitializeIfNecessary();
+	if ( result )
+	{
+		if ( s_shouldBenchmarksBeRun_validity )
+		{
+			o_shouldBenchmarksBeRun = s_shouldBenchmarksBeRun;
+		}
+		return s_shouldBenchmarksBeRun_validity;
+	}
+	else
+	{
+		return result;
+	}
+}
+
+eae6320::cResult eae6320::UserSettings::GetThreadOptions( const char* const i_threadKind, Concurrency::sThreadOptions& io_options )
+{
+	const auto result = InitializeIfNecessary();
+	if ( result )
+	{
+		const auto iterator = s_threadSettings.find( i_threadKind );
+		if ( iterator == s_threadSettings.end() )
+		{
+			return Results::Failure;
+		}
+		const auto& threadSettings = iterator->second;
+		if ( threadSettings.validity )
+		{
+			if ( threadSettings.isPrioritySpecified )
+			{
+				io_options.priority = threadSettings.priority;
+			}
+			if ( threadSettings.isAffinityMaskSpecified )
+			{
+				io_options.affinityMask = threadSettings.affinityMask;
+			}
+			if ( threadSettings.isStackSizeSpecified )
+			{
+				io_options.stackSize_inBytes = threadSettings.stackSize_inBytes;
+			}
+		}
+		return threadSettings.validity;
+	}
+	else
+	{
+		return result;
+	}
+}
+
 // Helper Function Definitions
 //============================
 
@@ -309,7 +433,325 @@ namespace
 			}
 			lua_pop( &io_luaState, 1 );
 		}
+		// Texture Memory Budget
+		{
+			const char* key_textureMemoryBudget = "TextureMemoryBudget";
+
+			lua_pushstring( &io_luaState, key_textureMemoryBudget );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isinteger( &io_luaState, -1 ) )
+			{
+				const auto luaInteger = lua_tointeger( &io_luaState, -1 );
+				if ( luaInteger > 0 )
+				{
+					// The budget is in megabytes, and the limit keeps the number of bytes from overflowing
+					constexpr auto maxBudget = 1u << 20;
+					if ( luaInteger <= maxBudget )
+					{
+						s_textureMemoryBudget = static_cast<uint32_t>( luaInteger );
+						s_textureMemoryBudget_validity = eae6320::Results::Success;
+						eae6320::Logging::OutputMessage( "User settings defined texture memory budget of %u MB", s_textureMemoryBudget );
+					}
+					else
+					{
+						s_textureMemoryBudget_validity = eae6320::Results::InvalidFile;
+						eae6320::Logging::OutputMessage( "The user settings file %s specifies a texture memory budget (%i)"
+							" that is bigger than the maximum (%u)", s_userSettingsFileName, luaInteger, maxBudget );
+					}
+				}
+				else
+				{
+					s_textureMemoryBudget_validity = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputMessage( "The user settings file %s specifies a non-positive texture memory budget (%i)",
+						s_userSettingsFileName, luaInteger );
+				}
+			}
+			else if ( lua_isnil( &io_luaState, -1 ) )
+			{
+				// The texture memory budget is optional
+				s_textureMemoryBudget_validity = eae6320::Results::Failure;
+			}
+			else
+			{
+				s_textureMemoryBudget_validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for %s instead of an integer",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), key_textureMemoryBudget );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Asset Cache Budget
+		{
+			const char* key_assetCacheBudget = "AssetCacheBudget";
+
+			lua_pushstring( &io_luaState, key_assetCacheBudget );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isinteger( &io_luaState, -1 ) )
+			{
+				const auto luaInteger = lua_tointeger( &io_luaState, -1 );
+				// Unlike the texture memory budget zero is valid (it disables the cache)
+				if ( luaInteger >= 0 )
+				{
+					// The budget is in megabytes, and the limit keeps the number of bytes from overflowing
+					constexpr auto maxBudget = 1u << 20;
+					if ( luaInteger <= maxBudget )
+					{
+						s_assetCacheBudget = static_cast<uint32_t>( luaInteger );
+						s_assetCacheBudget_validity = eae6320::Results::Success;
+						eae6320::Logging::OutputMessage( "User settings defined an asset cache budget of %u MB", s_assetCacheBudget );
+					}
+					else
+					{
+						s_assetCacheBudget_validity = eae6320::Results::InvalidFile;
+						eae6320::Logging::OutputMessage( "The user settings file %s specifies an asset cache budget (%i)"
+							" that is bigger than the maximum (%u)", s_userSettingsFileName, luaInteger, maxBudget );
+					}
+				}
+				else
+				{
+					s_assetCacheBudget_validity = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputMessage( "The user settings file %s specifies a negative asset cache budget (%i)",
+						s_userSettingsFileName, luaInteger );
+				}
+			}
+			else if ( lua_isnil( &io_luaState, -1 ) )
+			{
+				// The asset cache budget is optional
+				s_assetCacheBudget_validity = eae6320::Results::Failure;
+			}
+			else
+			{
+				s_assetCacheBudget_validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for %s instead of an integer",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), key_assetCacheBudget );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Asset Prefetching
+		{
+			const char* key_prefetchAssets = "PrefetchAssets";
+
+			lua_pushstring( &io_luaState, key_prefetchAssets );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isboolean( &io_luaState, -1 ) )
+			{
+				s_shouldAssetsBePrefetched = lua_toboolean( &io_luaState, -1 ) != 0;
+				s_shouldAssetsBePrefetched_validity = eae6320::Results::Success;
+				eae6320::Logging::OutputMessage( "User settings %s asset prefetching", s_shouldAssetsBePrefetched ? "enabled" : "disabled" );
+			}
+			else if ( lua_isnil( &io_luaState, -1 ) )
+			{
+				// Asset prefetching is optional
+				s_shouldAssetsBePrefetched_validity = eae6320::Results::Failure;
+			}
+			else
+			{
+				s_shouldAssetsBePrefetched_validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for %s instead of a boolean",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), key_prefetchAssets );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Benchmarks
+		{
+			const char* key_runBenchmarks = "RunBenchmarks";
+
+			lua_pushstring( &io_luaState, key_runBenchmarks );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isboolean( &io_luaState, -1 ) )
+			{
+				s_shouldBenchmarksBeRun = lua_toboolean( &io_luaState, -1 ) != 0;
+				s_shouldBenchmarksBeRun_validity = eae6320::Results::Success;
+				eae6320::Logging::OutputMessage( "User settings %s the startup benchmarks", s_shouldBenchmarksBeRun ? "enabled" : "disabled" );
+			}
+			else if ( lua_isnil( &io_luaState, -1 ) )
+			{
+				// The benchmarks are optional
+				s_shouldBenchmarksBeRun_validity = eae6320::Results::Failure;
+			}
+			else
+			{
+				s_shouldBenchmarksBeRun_validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for %s instead of a boolean",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), key_runBenchmarks );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Threads
+		{
+			const char* key_threads = "Threads";
+
+			lua_pushstring( &io_luaState, key_threads );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_istable( &io_luaState, -1 ) )
+			{
+				// Every kind of thread is optional
+				lua_pushnil( &io_luaState );
+				while ( lua_next( &io_luaState, -2 ) )
+				{
+					if ( lua_type( &io_luaState, -2 ) == LUA_TSTRING )
+					{
+						const std::string threadKind = lua_tostring( &io_luaState, -2 );
+						auto& threadSettings = s_threadSettings[threadKind];
+						if ( lua_istable( &io_luaState, -1 ) )
+						{
+							PopulateThreadSettingsFromLuaTable( io_luaState, threadKind.c_str(), threadSettings );
+						}
+						else
+						{
+							threadSettings.validity = eae6320::Results::InvalidFile;
+							eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for the %s %s instead of a table",
+								s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), threadKind.c_str(), key_threads );
+						}
+					}
+					else
+					{
+						eae6320::Logging::OutputMessage( "The user settings file %s has a %s key in %s instead of the kind of thread",
+							s_userSettingsFileName, luaL_typename( &io_luaState, -2 ), key_threads );
+					}
+					// Pop the value but leave the key for the next iteration
+					lua_pop( &io_luaState, 1 );
+				}
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for %s instead of a table",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), key_threads );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
 
 		return result;
 	}
+
+	void PopulateThreadSettingsFromLuaTable( lua_State& io_luaState, const char* const i_threadKind, sThreadSettings& o_threadSettings )
+	{
+		o_threadSettings.validity = eae6320::Results::Success;
+
+		// Priority
+		{
+			const char* key_priority = "Priority";
+
+			lua_pushstring( &io_luaState, key_priority );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_type( &io_luaState, -1 ) == LUA_TSTRING )
+			{
+				const std::string priority = lua_tostring( &io_luaState, -1 );
+				o_threadSettings.isPrioritySpecified = true;
+				if ( priority == "Lowest" )
+				{
+					o_threadSettings.priority = eae6320::Concurrency::eThreadPriority::Lowest;
+				}
+				else if ( priority == "BelowNormal" )
+				{
+					o_threadSettings.priority = eae6320::Concurrency::eThreadPriority::BelowNormal;
+				}
+				else if ( priority == "Normal" )
+				{
+					o_threadSettings.priority = eae6320::Concurrency::eThreadPriority::Normal;
+				}
+				else if ( priority == "AboveNormal" )
+				{
+					o_threadSettings.priority = eae6320::Concurrency::eThreadPriority::AboveNormal;
+				}
+				else if ( priority == "Highest" )
+				{
+					o_threadSettings.priority = eae6320::Concurrency::eThreadPriority::Highest;
+				}
+				else
+				{
+					o_threadSettings.isPrioritySpecified = false;
+					o_threadSettings.validity = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputMessage( "The user settings file %s specifies an unknown %s thread priority (\"%s\")"
+						" instead of Lowest, BelowNormal, Normal, AboveNormal, or Highest",
+						s_userSettingsFileName, i_threadKind, priority.c_str() );
+				}
+				if ( o_threadSettings.isPrioritySpecified )
+				{
+					eae6320::Logging::OutputMessage( "User settings defined a %s thread priority of %s", i_threadKind, priority.c_str() );
+				}
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				o_threadSettings.validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for the %s %s instead of a string",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), i_threadKind, key_priority );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Affinity Mask
+		{
+			const char* key_affinityMask = "AffinityMask";
+
+			lua_pushstring( &io_luaState, key_affinityMask );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isinteger( &io_luaState, -1 ) )
+			{
+				const auto luaInteger = lua_tointeger( &io_luaState, -1 );
+				// Zero is valid (it lets the operating system choose)
+				if ( luaInteger >= 0 )
+				{
+					o_threadSettings.affinityMask = static_cast<uint64_t>( luaInteger );
+					o_threadSettings.isAffinityMaskSpecified = true;
+					eae6320::Logging::OutputMessage( "User settings defined a %s thread affinity mask of 0x%llx",
+						i_threadKind, static_cast<unsigned long long>( o_threadSettings.affinityMask ) );
+				}
+				else
+				{
+					o_threadSettings.validity = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputMessage( "The user settings file %s specifies a negative %s thread affinity mask (%i)",
+						s_userSettingsFileName, i_threadKind, luaInteger );
+				}
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				o_threadSettings.validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for the %s %s instead of an integer",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), i_threadKind, key_affinityMask );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+		// Stack Size
+		{
+			const char* key_stackSize = "StackSize";
+
+			lua_pushstring( &io_luaState, key_stackSize );
+			lua_gettable( &io_luaState, -2 );
+			if ( lua_isinteger( &io_luaState, -1 ) )
+			{
+				const auto luaInteger = lua_tointeger( &io_luaState, -1 );
+				// Zero is valid (it uses the platform's default stack size)
+				if ( luaInteger >= 0 )
+				{
+					// The stack size is in kilobytes, and the limit keeps the number of bytes from overflowing
+					constexpr auto maxStackSize = 1u << 20;
+					if ( luaInteger <= maxStackSize )
+					{
+						o_threadSettings.stackSize_inBytes = static_cast<size_t>( luaInteger ) * 1024;
+						o_threadSettings.isStackSizeSpecified = true;
+						eae6320::Logging::OutputMessage( "User settings defined a %s thread stack size of %u KB",
+							i_threadKind, static_cast<unsigned int>( luaInteger ) );
+					}
+					else
+					{
+						o_threadSettings.validity = eae6320::Results::InvalidFile;
+						eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s thread stack size (%i)"
+							" that is bigger than the maximum (%u)", s_userSettingsFileName, i_threadKind, luaInteger, maxStackSize );
+					}
+				}
+				else
+				{
+					o_threadSettings.validity = eae6320::Results::InvalidFile;
+					eae6320::Logging::OutputMessage( "The user settings file %s specifies a negative %s thread stack size (%i)",
+						s_userSettingsFileName, i_threadKind, luaInteger );
+				}
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				o_threadSettings.validity = eae6320::Results::InvalidFile;
+				eae6320::Logging::OutputMessage( "The user settings file %s specifies a %s for the %s %s instead of an integer",
+					s_userSettingsFileName, luaL_typename( &io_luaState, -1 ), i_threadKind, key_stackSize );
+			}
+			lua_pop( &io_luaState, 1 );
+		}
+	}
 }
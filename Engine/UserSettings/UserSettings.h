@@ -10,6 +10,7 @@
 //==============
 
 #include <cstdint>
+#include <Engine/Concurrency/cThread.h>
 #include <Engine/Results/Results.h>
 
 // Interface
@@ -21,6 +22,20 @@ namespace eae6320
 	{
 		cResult GetDesiredInitialResolutionWidth( uint16_t& o_width );
 		cResult GetDesiredInitialResolutionHeight( uint16_t& o_height );
+		// The maximum amount of GPU memory (in megabytes) that streamed textures can use
+		cResult GetTextureMemoryBudget( uint32_t& o_budget_inMegabytes );
+		// The maximum amount of memory (in megabytes) that each kind of asset can keep loaded after it has been released
+		// (zero disables keeping released assets)
+		cResult GetAssetCacheBudget( uint32_t& o_budget_inMegabytes );
+		// Whether the files that the previous session loaded are prefetched while the application starts
+		cResult GetShouldAssetsBePrefetched( bool& o_shouldAssetsBePrefetched );
+		// Whether the engine's benchmarks and self-checks are run while the application starts
+		// (their results are output to the log)
+		cResult GetShouldBenchmarksBeRun( bool& o_shouldBenchmarksBeRun );
+		// The kinds of threads are "Application", "Render", "Worker", and "Background".
+		// Only the options that the user settings specify are changed
+		// (the name is never changed).
+		cResult GetThreadOptions( const char* const i_threadKind, Concurrency::sThreadOptions& io_options );
 	}
 }
 
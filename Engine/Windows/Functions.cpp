@@ -23,6 +23,25 @@ namespace
 // Interface
 //==========
 
+eae6320::cResult eae6320::Windows::CloseFile( const HANDLE i_fileHandle, const char* const i_path, std::string* const o_errorMessage )
+{
+	if ( CloseHandle( i_fileHandle ) != FALSE )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		if ( o_errorMessage )
+		{
+			const auto windowsError = GetLastSystemError();
+			std::ostringstream errorMessage;
+			errorMessage << "Windows failed to close the file handle from \"" << i_path << "\": " << windowsError;
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::Failure;
+	}
+}
+
 eae6320::cResult eae6320::Windows::CopyFile( const char* const i_path_source, const char* const i_path_target,
 	const bool i_shouldFunctionFailIfTargetAlreadyExists, const bool i_shouldTargetFileTimeBeModified,
 	std::string* const o_errorMessage )
@@ -924,6 +943,249 @@ OnExit:
 	return result;
 }
 
+eae6320::cResult eae6320::Windows::LoadPartOfBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, sDataFromFile& o_data,
+	std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	// Initialize the output struct so that if there's an error during this function any existing garbage data isn't misinterpreted
+	{
+		o_data.data = nullptr;
+		o_data.size = 0;
+	}
+
+	// Open the file
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+	{
+		constexpr DWORD desiredAccess = FILE_GENERIC_READ;
+		constexpr DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		constexpr DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL;
+		constexpr HANDLE dontUseTemplateFile = NULL;
+		fileHandle = CreateFile( i_path, desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, useDefaultAttributes, dontUseTemplateFile );
+		if ( fileHandle == INVALID_HANDLE_VALUE )
+		{
+			DWORD errorCode;
+			const auto windowsError = eae6320::Windows::GetLastSystemError( &errorCode );
+			switch ( errorCode )
+			{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				result = Results::FileDoesntExist;
+				break;
+			default:
+				result = Results::Failure;
+			}
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the file \"" << i_path << "\" for reading: " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Make sure that the file is big enough
+	{
+		LARGE_INTEGER fileSize_integer;
+		if ( GetFileSizeEx( fileHandle, &fileSize_integer ) != FALSE )
+		{
+			const auto fileSize = static_cast<uint64_t>( fileSize_integer.QuadPart );
+			if ( ( i_offset > fileSize ) || ( i_size > ( fileSize - i_offset ) ) )
+			{
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "The file \"" << i_path << "\" (" << fileSize << " bytes) is too small to read "
+						<< i_size << " bytes at offset " << i_offset;
+					*o_errorMessage = errorMessage.str();
+				}
+				result = Results::InvalidFile;
+				goto OnExit;
+			}
+		}
+		else
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = eae6320::Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the size of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			goto OnExit;
+		}
+	}
+	// Move to the requested offset
+	{
+		LARGE_INTEGER offset_integer;
+		offset_integer.QuadPart = static_cast<LONGLONG>( i_offset );
+		constexpr PLARGE_INTEGER dontReturnNewOffset = nullptr;
+		if ( SetFilePointerEx( fileHandle, offset_integer, dontReturnNewOffset, FILE_BEGIN ) == FALSE )
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = eae6320::Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to move to offset " << i_offset << " of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			goto OnExit;
+		}
+	}
+	// Read the requested contents into allocated memory
+	o_data.size = i_size;
+	o_data.data = malloc( o_data.size );
+	if ( o_data.data )
+	{
+		DWORD bytesReadCount;
+		constexpr OVERLAPPED* const readSynchronously = nullptr;
+		EAE6320_ASSERT( o_data.size < ( uint64_t( 1u ) << ( sizeof( bytesReadCount ) * 8 ) ) );
+		if ( ReadFile( fileHandle, o_data.data, static_cast<DWORD>( o_data.size ),
+			&bytesReadCount, readSynchronously ) == FALSE )
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = eae6320::Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to read the contents of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			goto OnExit;
+		}
+		else if ( bytesReadCount != o_data.size )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Only " << bytesReadCount << " of " << o_data.size << " bytes could be read from the file \"" << i_path << "\"";
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::InvalidFile;
+			goto OnExit;
+		}
+	}
+	else
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "Failed to allocate " << o_data.size << " bytes to read in the file \"" << i_path << "\"";
+			*o_errorMessage = errorMessage.str();
+		}
+		result = Results::OutOfMemory;
+		goto OnExit;
+	}
+
+OnExit:
+
+	if ( !result )
+	{
+		if ( o_data.data )
+		{
+			o_data.Free();
+		}
+		o_data.size = 0;
+	}
+	if ( fileHandle != INVALID_HANDLE_VALUE )
+	{
+		if ( CloseHandle( fileHandle ) == FALSE )
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = eae6320::Windows::GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "\nWindows failed to close the file handle from \"" << i_path << "\": " << windowsError;
+				*o_errorMessage += errorMessage.str();
+			}
+			if ( result )
+			{
+				result = Results::Failure;
+			}
+		}
+		fileHandle = INVALID_HANDLE_VALUE;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Windows::OpenFileForReading( const char* const i_path, HANDLE& o_fileHandle, uint64_t& o_fileSize,
+	std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	o_fileHandle = INVALID_HANDLE_VALUE;
+	o_fileSize = 0;
+
+	// Open the file
+	{
+		constexpr DWORD desiredAccess = FILE_GENERIC_READ;
+		constexpr DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		constexpr DWORD useDefaultAttributes = FILE_ATTRIBUTE_NORMAL;
+		constexpr HANDLE dontUseTemplateFile = NULL;
+		o_fileHandle = CreateFile( i_path, desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, useDefaultAttributes, dontUseTemplateFile );
+		if ( o_fileHandle == INVALID_HANDLE_VALUE )
+		{
+			DWORD errorCode;
+			const auto windowsError = GetLastSystemError( &errorCode );
+			switch ( errorCode )
+			{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				result = Results::FileDoesntExist;
+				break;
+			default:
+				result = Results::Failure;
+			}
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the file \"" << i_path << "\" for reading: " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	// Get the file's size
+	{
+		LARGE_INTEGER fileSize_integer;
+		if ( GetFileSizeEx( o_fileHandle, &fileSize_integer ) != FALSE )
+		{
+			o_fileSize = static_cast<uint64_t>( fileSize_integer.QuadPart );
+		}
+		else
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the size of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( !result && ( o_fileHandle != INVALID_HANDLE_VALUE ) )
+	{
+		CloseHandle( o_fileHandle );
+		o_fileHandle = INVALID_HANDLE_VALUE;
+	}
+
+	return result;
+}
+
 void eae6320::Windows::OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath,
 	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
 {
@@ -936,6 +1198,57 @@ void eae6320::Windows::OutputWarningMessageForVisualStudio( const char* const i_
 	OutputMessageForVisualStudio( "warning", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
 }
 
+eae6320::cResult eae6320::Windows::ReadFromFile( const HANDLE i_fileHandle, const char* const i_path, const uint64_t i_offset, const size_t i_size,
+	void* const o_data, std::string* const o_errorMessage )
+{
+	// Move to the requested offset
+	{
+		LARGE_INTEGER offset_integer;
+		offset_integer.QuadPart = static_cast<LONGLONG>( i_offset );
+		constexpr PLARGE_INTEGER dontReturnNewOffset = nullptr;
+		if ( SetFilePointerEx( i_fileHandle, offset_integer, dontReturnNewOffset, FILE_BEGIN ) == FALSE )
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to move to offset " << i_offset << " of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+	}
+	// Read the requested contents
+	{
+		DWORD bytesReadCount;
+		constexpr OVERLAPPED* const readSynchronously = nullptr;
+		EAE6320_ASSERT( i_size < ( uint64_t( 1u ) << ( sizeof( bytesReadCount ) * 8 ) ) );
+		if ( ReadFile( i_fileHandle, o_data, static_cast<DWORD>( i_size ), &bytesReadCount, readSynchronously ) == FALSE )
+		{
+			if ( o_errorMessage )
+			{
+				const auto windowsError = GetLastSystemError();
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to read the contents of the file \"" << i_path << "\": " << windowsError;
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+		else if ( bytesReadCount != i_size )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Only " << bytesReadCount << " of " << i_size << " bytes could be read from the file \"" << i_path << "\"";
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::InvalidFile;
+		}
+	}
+
+	return Results::Success;
+}
+
 eae6320::cResult eae6320::Windows::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
 {
 	auto result = Results::Success;
@@ -38,6 +38,8 @@ namespace eae6320
 			}
 		};
 
+		// The file must have been opened with OpenFileForReading()
+		cResult CloseFile( const HANDLE i_fileHandle, const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult CopyFile( const char* const i_path_source, const char* const i_path_target,
 			const bool i_shouldFunctionFailIfTargetAlreadyExists = false, const bool i_shouldTargetFileTimeBeModified = false,
 			std::string* o_errorMessage = nullptr );
@@ -54,10 +56,21 @@ namespace eae6320
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// This reads i_size bytes starting at i_offset
+		// (if the file isn't big enough the function fails with Results::InvalidFile)
+		cResult LoadPartOfBinaryFile( const char* const i_path, const uint64_t i_offset, const size_t i_size, sDataFromFile& o_data,
+			std::string* const o_errorMessage = nullptr );
+		// OpenFileForReading(), ReadFromFile() and CloseFile() are for reading several parts of a file
+		// without opening it again for each one
+		// (the path is only used for error messages)
+		cResult OpenFileForReading( const char* const i_path, HANDLE& o_fileHandle, uint64_t& o_fileSize, std::string* const o_errorMessage = nullptr );
 		void OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
 		void OutputWarningMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
+		// This reads exactly i_size bytes starting at i_offset into o_data
+		cResult ReadFromFile( const HANDLE i_fileHandle, const char* const i_path, const uint64_t i_offset, const size_t i_size, void* const o_data,
+			std::string* const o_errorMessage = nullptr );
 		cResult WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage = nullptr );
 	}
 }
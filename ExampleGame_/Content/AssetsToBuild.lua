@@ -34,4 +34,11 @@ return
 		"Textures/EvilShibe.jpg",
 		"Textures/AKM.tga",
 	},
+	-- Uncommenting the following puts every built asset into a single data/ExampleGame.pak
+	-- which the game will then load assets from instead of from the individual loose files
+	-- package = { name = "ExampleGame", shouldEntriesBeCompressed = true },
+	-- Uncommenting the following makes every builder compress its built file
+	-- ("fast" is quick to build while iterating, "high" is smaller for distribution builds).
+	-- Built files that already exist aren't rebuilt when this changes, and so the game's data should be cleaned first.
+	-- compression = "fast",
 }
@@ -4,10 +4,12 @@
 #include "cExampleGame.h"
 
 #include <Engine/UserInput/UserInput.h>
+#include <Engine/Concurrency/Parallel.h>
 #include <Engine/Graphics/cTexture.h>
 #include <Engine/Graphics/Effect.h>
 #include <Engine/Graphics/Sprite.h>
 #include <Engine/Graphics/Mesh.h>
+#include <Engine/Graphics/cPreloadManifest.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Math/Functions.h>
 
@@ -93,6 +95,23 @@ namespace
 	eae6320::Graphics::Sprite* s_sprite_static3 = nullptr;
 	eae6320::Graphics::Sprite* s_sprite_static4 = nullptr;
 
+	// Asset Paths
+	//------------
+	// These are hashed at compile time
+	constexpr eae6320::Assets::sPrehashedPath texture_pikachu("Pikachu.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath texture_pokeball("Pokeball.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath texture_electroball("Electroball.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath texture_flowerShibe("FlowerShibe.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath texture_evilShibe("EvilShibe.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath texture_AKM("AKM.bintxr");
+	constexpr eae6320::Assets::sPrehashedPath mesh_AKM("AKM.binmsh");
+	constexpr eae6320::Assets::sPrehashedPath mesh_plane("Plane.binmsh");
+	constexpr eae6320::Assets::sPrehashedPath mesh_sphere("Sphere.binmsh");
+
+	// Every texture and mesh is preloaded together
+	// and kept loaded by the manifest until the game has its own handles
+	eae6320::Graphics::cPreloadManifest s_preloadManifest;
+
 	// Texture Data
 	//-------------
 	eae6320::Graphics::cTexture::Handle pikachuTexture;
@@ -362,14 +381,26 @@ void eae6320::cExampleGame::UpdateSimulationBasedOnTime(const float i_elapsedSec
 	}
 	// Calculate the actual acceleration
 	s_render_movableAKM.rigidBody.acceleration = eae6320::Math::sVector(deaccelerationX, deaccelerationY, deaccelerationZ);
-	// Update transform information about the mesh
-	s_render_movableAKM.rigidBody.Update(i_elapsedSecondCount_sinceLastUpdate);
-	// Update transform information about the camera
-	viewCamera.rigidBody.Update(i_elapsedSecondCount_sinceLastUpdate);
-	// Update transform information about the bullet
-	s_render_bullet.rigidBody.Update(i_elapsedSecondCount_sinceLastUpdate);
-	// Update transform information about the plane
-	s_render_shibePlane.rigidBody.Update(i_elapsedSecondCount_sinceLastUpdate);
+	// Update transform information about the mesh, the camera, the bullet and the plane
+	// (the rigid bodies are independent of each other, and so they can be integrated in parallel;
+	// with this few of them they are just updated on this thread)
+	{
+		eae6320::Physics::sRigidBodyState* const rigidBodies[] =
+		{
+			&s_render_movableAKM.rigidBody,
+			&viewCamera.rigidBody,
+			&s_render_bullet.rigidBody,
+			&s_render_shibePlane.rigidBody,
+		};
+		constexpr size_t rigidBodyCount = sizeof(rigidBodies) / sizeof(rigidBodies[0]);
+		eae6320::Concurrency::ParallelFor(0, rigidBodyCount, 0, [&rigidBodies, i_elapsedSecondCount_sinceLastUpdate](const size_t i_begin, const size_t i_end)
+		{
+			for (size_t i = i_begin; i < i_end; i++)
+			{
+				rigidBodies[i]->Update(i_elapsedSecondCount_sinceLastUpdate);
+			}
+		});
+	}
 }
 
 void eae6320::cExampleGame::ResetBullet()
@@ -416,6 +447,13 @@ eae6320::cResult eae6320::cExampleGame::Initialize()
 		goto OnExit;
 	}
 
+	// Preload the textures and meshes
+	if (!(result = PreloadAssets()))
+	{
+		EAE6320_ASSERTF(false, "Asset preloading failed");
+		goto OnExit;
+	}
+
 	// Initialize the texture data
 	if (!(result = InitializeTexture()))
 	{
@@ -434,6 +472,18 @@ eae6320::cResult eae6320::cExampleGame::Initialize()
 	InitializeRenderData();
 
 OnExit:
+	// The game's handles keep the preloaded assets loaded
+	{
+		const auto localResult = s_preloadManifest.CleanUp();
+		if (!localResult)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = localResult;
+			}
+		}
+	}
 	return result;
 }
 
@@ -569,43 +619,40 @@ eae6320::cResult eae6320::cExampleGame::InitializeTexture()
 {
 	cResult result = Results::Success;
 
-	const char * texture_pikachu = "Pikachu.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_pikachu, pikachuTexture)))
+	// Textures have already been preloaded,
+	// and so loading them here only gets handles to them
+
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_pikachu), pikachuTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
 	}
 
-	const char * texture_pokeball = "Pokeball.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_pokeball, pokeballTexture)))
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_pokeball), pokeballTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
 	}
 
-	const char * texture_electroball = "Electroball.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_electroball, electroballTexture)))
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_electroball), electroballTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
 	}
 
-	const char * texture_flowerShibe = "FlowerShibe.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_flowerShibe, flowerShibeTexture)))
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_flowerShibe), flowerShibeTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
 	}
 
-	const char * texture_evilShibe = "EvilShibe.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_evilShibe, evilShibeTexture)))
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_evilShibe), evilShibeTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
 	}
 
-	const char * texture_AKM = "AKM.bintxr";
-	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(texture_AKM, AKMTexture)))
+	if (!(result = eae6320::Graphics::cTexture::s_manager.Load(eae6320::Assets::cPathId::Intern(texture_AKM), AKMTexture)))
 	{
 		EAE6320_ASSERTF(false, "Texture initialization failed");
 		goto OnExit;
@@ -619,22 +666,22 @@ eae6320::cResult eae6320::cExampleGame::InitializeMesh()
 {
 	cResult result = Results::Success;
 
-	const char * mesh_AKM = "AKM.binmsh";
-	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(mesh_AKM, AKMMesh)))
+	// Meshes have already been preloaded,
+	// and so loading them here only gets handles to them
+
+	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(eae6320::Assets::cPathId::Intern(mesh_AKM), AKMMesh)))
 	{
 		EAE6320_ASSERTF(false, "Mesh initialization failed");
 		goto OnExit;
 	}
 
-	const char * mesh_plane = "Plane.binmsh";
-	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(mesh_plane, planeMesh)))
+	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(eae6320::Assets::cPathId::Intern(mesh_plane), planeMesh)))
 	{
 		EAE6320_ASSERTF(false, "Mesh initialization failed");
 		goto OnExit;
 	}
 
-	const char * mesh_sphere = "Sphere.binmsh";
-	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(mesh_sphere, sphereMesh)))
+	if (!(result = eae6320::Graphics::Mesh::s_manager.Load(eae6320::Assets::cPathId::Intern(mesh_sphere), sphereMesh)))
 	{
 		EAE6320_ASSERTF(false, "Mesh initialization failed");
 		goto OnExit;
@@ -644,6 +691,50 @@ OnExit:
 	return result;
 }
 
+eae6320::cResult eae6320::cExampleGame::PreloadAssets()
+{
+	cResult result = Results::Success;
+
+	// The files are read and parsed in parallel in the background,
+	// and the textures and meshes are created on this thread (which is the render thread)
+	// while it waits for them
+	{
+		const eae6320::Assets::sPrehashedPath textures[] = { texture_pikachu, texture_pokeball, texture_electroball, texture_flowerShibe, texture_evilShibe, texture_AKM };
+		for (const auto & texture : textures)
+		{
+			if (!(result = s_preloadManifest.Add(eae6320::Graphics::cPreloadManifest::eAssetType::Texture, eae6320::Assets::cPathId::Intern(texture))))
+			{
+				EAE6320_ASSERTF(false, "Texture couldn't be added to the preload manifest");
+				goto OnExit;
+			}
+		}
+	}
+	{
+		const eae6320::Assets::sPrehashedPath meshes[] = { mesh_AKM, mesh_plane, mesh_sphere };
+		for (const auto & mesh : meshes)
+		{
+			if (!(result = s_preloadManifest.Add(eae6320::Graphics::cPreloadManifest::eAssetType::Mesh, eae6320::Assets::cPathId::Intern(mesh))))
+			{
+				EAE6320_ASSERTF(false, "Mesh couldn't be added to the preload manifest");
+				goto OnExit;
+			}
+		}
+	}
+	if (!(result = s_preloadManifest.Load()))
+	{
+		EAE6320_ASSERTF(false, "Asset preloading couldn't be started");
+		goto OnExit;
+	}
+	if (!(result = s_preloadManifest.WaitUntilLoaded()))
+	{
+		EAE6320_ASSERTF(false, "Asset preloading failed");
+		goto OnExit;
+	}
+
+OnExit:
+	return result;
+}
+
 void eae6320::cExampleGame::InitializeRenderData()
 {
 	// Initialize render data struct with Sprite and Texture
@@ -94,6 +94,7 @@ namespace eae6320
 		void InitializeCamera();
 		eae6320::cResult InitializeEffect();
 		eae6320::cResult InitializeSprite();
+		eae6320::cResult PreloadAssets();
 		eae6320::cResult InitializeTexture();
 		eae6320::cResult InitializeMesh();
 		void InitializeRenderData();
@@ -106,6 +106,162 @@ local function CreateUniquePath( i_path )
 	return uniquePath
 end
 
+-- Build Profiling
+--================
+
+-- Every asset that is considered during a build gets an entry in this table
+-- with the phases that were timed for it.
+-- The driver (this script) times the up-to-date check and launching the builder,
+-- and the builder times its own phases (e.g. parse, process, write) and reports them back in a file.
+local buildProfile = {}
+local path_builderPhases = OutputDir .. "AssetBuildPhases.tmp"
+
+local function BeginBuildProfile()
+	buildProfile = { time_start = GetCurrentTime(), assets = {} }
+	os.remove( path_builderPhases )
+end
+
+local function AddBuildProfilePhase( io_assetProfile, i_name, i_time_start, i_time_end, i_worker )
+	io_assetProfile.phases[#io_assetProfile.phases + 1] = { name = i_name, time_start = i_time_start, time_end = i_time_end, worker = i_worker }
+end
+
+-- Reads the phases that a builder recorded (see cbBuilder::WriteProfilingPhases())
+-- and returns the time that the builder started and finished
+local function ReadBuilderPhases( io_assetProfile )
+	local file = io.open( path_builderPhases, "r" )
+	if not file then
+		return nil
+	end
+	local time_builderStart, time_builderEnd
+	for line in file:lines() do
+		local name, time_start, time_end = line:match( "^(%S+)%s+(%S+)%s+(%S+)" )
+		time_start, time_end = tonumber( time_start ), tonumber( time_end )
+		if name and time_start and time_end then
+			if name == "builder" then
+				time_builderStart, time_builderEnd = time_start, time_end
+			else
+				AddBuildProfilePhase( io_assetProfile, name, time_start, time_end, "builder" )
+			end
+		end
+	end
+	file:close()
+	os.remove( path_builderPhases )
+	return time_builderStart, time_builderEnd
+end
+
+local function EscapeJsonString( i_string )
+	return ( tostring( i_string ):gsub( "[%c\\\"]", function( i_character )
+		if i_character == "\\" then
+			return "\\\\"
+		elseif i_character == "\"" then
+			return "\\\""
+		else
+			return ( "\\u%04x" ):format( i_character:byte() )
+		end
+	end ) )
+end
+
+local function WriteBuildProfile()
+	local time_end = GetCurrentTime()
+	local wereThereErrors = false
+
+	-- The summary lists the total time spent in each phase
+	-- and every asset that was built sorted from slowest to fastest
+	do
+		local phaseTotals, phaseNames = {}, {}
+		local builtAssets = {}
+		for i, assetProfile in ipairs( buildProfile.assets ) do
+			local assetTotal = 0
+			for j, phase in ipairs( assetProfile.phases ) do
+				local duration = phase.time_end - phase.time_start
+				if not phaseTotals[phase.name] then
+					phaseTotals[phase.name] = { duration = 0, count = 0 }
+					phaseNames[#phaseNames + 1] = phase.name
+				end
+				phaseTotals[phase.name].duration = phaseTotals[phase.name].duration + duration
+				phaseTotals[phase.name].count = phaseTotals[phase.name].count + 1
+				-- Builder phases are nested inside of the driver's "execute" phase
+				if phase.worker ~= "builder" then
+					assetTotal = assetTotal + duration
+				end
+			end
+			assetProfile.duration = assetTotal
+			if assetProfile.wasBuilt then
+				builtAssets[#builtAssets + 1] = assetProfile
+			end
+		end
+		table.sort( builtAssets, function( i_lhs, i_rhs ) return i_lhs.duration > i_rhs.duration end )
+
+		local lines = {}
+		lines[#lines + 1] = "{"
+		lines[#lines + 1] = ( "\t\"totalSeconds\": %.6f," ):format( time_end - buildProfile.time_start )
+		lines[#lines + 1] = ( "\t\"assetCount\": %d," ):format( #buildProfile.assets )
+		lines[#lines + 1] = ( "\t\"builtAssetCount\": %d," ):format( #builtAssets )
+		lines[#lines + 1] = "\t\"phases\": {"
+		for i, phaseName in ipairs( phaseNames ) do
+			local phaseTotal = phaseTotals[phaseName]
+			lines[#lines + 1] = ( "\t\t\"%s\": { \"totalSeconds\": %.6f, \"count\": %d }%s" ):format(
+				EscapeJsonString( phaseName ), phaseTotal.duration, phaseTotal.count, ( i < #phaseNames ) and "," or "" )
+		end
+		lines[#lines + 1] = "\t},"
+		lines[#lines + 1] = "\t\"builtAssets\": ["
+		for i, assetProfile in ipairs( builtAssets ) do
+			local phases = {}
+			for j, phase in ipairs( assetProfile.phases ) do
+				phases[#phases + 1] = ( "\"%s\": %.6f" ):format( EscapeJsonString( phase.name ), phase.time_end - phase.time_start )
+			end
+			lines[#lines + 1] = ( "\t\t{ \"path\": \"%s\", \"type\": \"%s\", \"succeeded\": %s, \"totalSeconds\": %.6f, \"phases\": { %s } }%s" ):format(
+				EscapeJsonString( assetProfile.path ), EscapeJsonString( assetProfile.type ), tostring( assetProfile.succeeded ),
+				assetProfile.duration, table.concat( phases, ", " ), ( i < #builtAssets ) and "," or "" )
+		end
+		lines[#lines + 1] = "\t]"
+		lines[#lines + 1] = "}"
+
+		local path = OutputDir .. "AssetBuildProfile.json"
+		local file, errorMessage = io.open( path, "w" )
+		if file then
+			file:write( table.concat( lines, "\n" ), "\n" )
+			file:close()
+		else
+			wereThereErrors = true
+			OutputWarningMessage( "The asset build profile couldn't be written: " .. tostring( errorMessage ), path )
+		end
+	end
+	-- The trace uses the Chrome trace event format
+	-- and can be opened with chrome://tracing (or about:tracing)
+	do
+		-- The driver and the builders are shown as separate threads
+		local threadIds = { driver = 1, builder = 2 }
+		local events = {}
+		events[#events + 1] = "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": { \"name\": \"BuildAssets\" } }"
+		events[#events + 1] = "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2, \"args\": { \"name\": \"Builders\" } }"
+		for i, assetProfile in ipairs( buildProfile.assets ) do
+			for j, phase in ipairs( assetProfile.phases ) do
+				local microsecondsPerSecond = 1000000
+				events[#events + 1] = ( "{ \"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d,"
+					.. " \"args\": { \"asset\": \"%s\" } }" ):format(
+					EscapeJsonString( phase.name ), EscapeJsonString( assetProfile.type ),
+					( phase.time_start - buildProfile.time_start ) * microsecondsPerSecond, ( phase.time_end - phase.time_start ) * microsecondsPerSecond,
+					threadIds[phase.worker] or threadIds.driver, EscapeJsonString( assetProfile.path ) )
+			end
+		end
+
+		local path = OutputDir .. "AssetBuildTrace.json"
+		local file, errorMessage = io.open( path, "w" )
+		if file then
+			file:write( "{ \"displayTimeUnit\": \"ms\", \"traceEvents\": [\n\t", table.concat( events, ",\n\t" ), "\n] }\n" )
+			file:close()
+		else
+			wereThereErrors = true
+			OutputWarningMessage( "The asset build trace couldn't be written: " .. tostring( errorMessage ), path )
+		end
+	end
+
+	if not wereThereErrors then
+		print( ( "Asset build took %.3f seconds (profile written to %sAssetBuildProfile.json)" ):format( time_end - buildProfile.time_start, OutputDir ) )
+	end
+end
+
 -- Asset Types
 --============
 
@@ -152,6 +308,9 @@ end
 
 -- In order to be built an asset must be "registered"
 local registeredAssetsToBuild = {}
+-- If the list of assets to build specifies a compression level ("fast" or "high")
+-- then every builder compresses its target after building it
+local compressionLevel = nil
 --
 local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i_optionalCommandLineArguments )
 	-- Get the asset type info
@@ -239,13 +398,20 @@ function cbAssetTypeInfo.RegisterReferencedAssets( i_sourceRelativePath )
 end
 
 -- You may need to override the following function for some new asset types, but not for many
-function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset )
+function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset, i_path_builtAsset )
 	-- By default this returns false,
 	-- because there are no special dependencies for this asset type
 	-- that need to be taken into account
 	return false
 end
 
+-- You may need to override the following function for some new asset types, but not for many
+function cbAssetTypeInfo.ShouldBeCompressedInPackage()
+	-- By default built assets are compressed when they are put in a package
+	-- (a packaged file is only stored compressed if that actually makes it meaningfully smaller)
+	return true
+end
+
 -- Mesh Asset Type
 --------------------
 
@@ -289,6 +455,10 @@ NewAssetTypeInfo( "shaders",
 -- Texture Asset Type
 ---------------------
 
+-- These must match TextureFormats::s_signature and TextureFormats::s_version
+local textureFormatSignature = 0x52585445
+local textureFormatVersion = 2
+
 NewAssetTypeInfo( "textures",
 	{
 		ConvertSourceRelativePathToBuiltRelativePath = function( i_sourceRelativePath )
@@ -300,6 +470,26 @@ NewAssetTypeInfo( "textures",
 		GetBuilderRelativePath = function()
 			return "TextureBuilder.exe"
 		end,
+		ShouldTargetBeBuilt = function( i_lastWriteTime_builtAsset, i_path_builtAsset )
+			-- If the texture was built with a different version of the texture format
+			-- (see TextureFormats.h) then it can't be loaded and should be built again
+			local file = io.open( i_path_builtAsset, "rb" )
+			if not file then
+				return true
+			end
+			local header = file:read( 6 )
+			file:close()
+			if not header or #header < 6 then
+				return true
+			end
+			local signature, version = string.unpack( "<I4I2", header )
+			return ( signature ~= textureFormatSignature ) or ( version ~= textureFormatVersion )
+		end,
+		ShouldBeCompressedInPackage = function()
+			-- Textures are streamed by reading only some of their MIP levels at a time,
+			-- and a compressed file can only be decompressed in its entirety
+			return false
+		end,
 	}
 )
 
@@ -309,6 +499,10 @@ NewAssetTypeInfo( "textures",
 local function BuildAsset( i_assetInfo )
 	local assetTypeInfo = i_assetInfo.assetTypeInfo
 
+	local assetProfile = { path = i_assetInfo.path, type = assetTypeInfo.type, wasBuilt = false, succeeded = false, phases = {} }
+	buildProfile.assets[#buildProfile.assets + 1] = assetProfile
+	local time_checkStart = GetCurrentTime()
+
 	-- Get the absolute path to the source
 	-- (The "source" is the authored asset)
 	local path_source
@@ -374,7 +568,7 @@ local function BuildAsset( i_assetInfo )
 					if not shouldTargetBeBuilt then
 						-- Even if there is no reason that a general asset shouldn't be built
 						-- the specific asset type may have specialized dependencies
-						shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target )
+						shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target, path_target )
 					end
 				end
 			end
@@ -382,9 +576,11 @@ local function BuildAsset( i_assetInfo )
 			shouldTargetBeBuilt = true;
 		end
 	end
+	AddBuildProfilePhase( assetProfile, "up-to-date check", time_checkStart, GetCurrentTime(), "driver" )
 
 	-- Build the target if necessary
 	if shouldTargetBeBuilt then
+		assetProfile.wasBuilt = true
 		-- Create the target directory if necessary
 		CreateDirectoryIfItDoesntExist( path_target )
 		-- Build
@@ -397,11 +593,34 @@ local function BuildAsset( i_assetInfo )
 			if #i_assetInfo.arguments > 0 then
 				arguments = arguments .. " " .. table.concat( i_assetInfo.arguments, " " )
 			end
+			-- The builder reports the timings of its own phases to a file
+			-- (cbBuilder removes this argument before the specific builder sees its optional arguments)
+			arguments = arguments .. " -profile \"" .. path_builderPhases .. "\""
+			-- The builder compresses the target itself
+			-- (cbBuilder also removes this argument)
+			if compressionLevel then
+				arguments = arguments .. " -compress " .. compressionLevel
+			end
 			-- Execute the command
 			local commandLine = command .. " " .. arguments
+			local time_commandStart = GetCurrentTime()
 			local result, exitCode = ExecuteCommand( commandLine )
+			local time_commandEnd = GetCurrentTime()
+			-- Split the time spent executing the command into
+			-- launching the builder process, the builder's own work, and exiting the builder process
+			do
+				local time_builderStart, time_builderEnd = ReadBuilderPhases( assetProfile )
+				if time_builderStart and time_builderEnd then
+					AddBuildProfilePhase( assetProfile, "launch", time_commandStart, time_builderStart, "driver" )
+					AddBuildProfilePhase( assetProfile, "build", time_builderStart, time_builderEnd, "driver" )
+					AddBuildProfilePhase( assetProfile, "exit", time_builderEnd, time_commandEnd, "driver" )
+				else
+					AddBuildProfilePhase( assetProfile, "execute", time_commandStart, time_commandEnd, "driver" )
+				end
+			end
 			if result then
 				if exitCode == 0 then
+					assetProfile.succeeded = true
 					-- Display a message for each asset
 					print( "Built " .. path_source )
 					-- Return success, and the exit code for informational purposes
@@ -432,10 +651,123 @@ local function BuildAsset( i_assetInfo )
 			return false
 		end
 	else
+		assetProfile.succeeded = true
 		return true
 	end
 end
 
+local function BuildContentManifest( i_path_assetsToBuild )
+	-- The run-time loads the manifest from this path
+	-- (see s_contentManifestPath in cbApplication.cpp)
+	local path_manifest = GameInstallDir .. "/data/ContentManifest.bin"
+
+	-- Every built asset is listed in the manifest
+	local entries = {}
+	-- The manifest must be written again if any of its files have changed
+	-- or if the list of assets has changed
+	local lastWriteTime_newestInput = math.max( lastWriteTime_this, GetLastWriteTime( i_path_assetsToBuild ) )
+	for i, assetInfo in ipairs( registeredAssetsToBuild ) do
+		local result, returnValue = ConvertSourceRelativePathToBuiltRelativePath( assetInfo.path, assetInfo.assetTypeInfo )
+		if not result then
+			OutputErrorMessage( returnValue )
+			return false
+		end
+		local path_builtFile = GameInstallDir .. "/data/" .. returnValue
+		entries[#entries + 1] =
+		{
+			-- This is the path that the run-time uses to load the asset
+			path = "data/" .. returnValue,
+			file = path_builtFile,
+		}
+		lastWriteTime_newestInput = math.max( lastWriteTime_newestInput, GetLastWriteTime( path_builtFile ) )
+	end
+
+	-- Write the manifest if necessary
+	if ( not DoesFileExist( path_manifest ) ) or ( lastWriteTime_newestInput > GetLastWriteTime( path_manifest ) ) then
+		local result, duplicateFileCount_orErrorMessage, duplicateByteCount = WriteContentManifest( path_manifest, entries )
+		if result then
+			print( "Hashed the contents of " .. tostring( #entries ) .. " assets into " .. path_manifest
+				.. " (" .. tostring( duplicateFileCount_orErrorMessage ) .. " are duplicates of other assets, "
+				.. tostring( math.floor( duplicateByteCount / 1024 ) ) .. " KB that will only be loaded once)" )
+		else
+			OutputErrorMessage( "The content manifest \"" .. path_manifest .. "\" couldn't be written: " .. duplicateFileCount_orErrorMessage )
+			-- A partially-written manifest shouldn't be considered up-to-date
+			if DoesFileExist( path_manifest ) then
+				InvalidateLastWriteTime( path_manifest )
+			end
+			return false
+		end
+	else
+		print( "ContentManifest.bin is up to date" )
+	end
+
+	return true
+end
+
+local function BuildPackage( i_packageInfo, i_path_assetsToBuild )
+	-- Validate the package information
+	if ( type( i_packageInfo ) ~= "table" ) or ( type( i_packageInfo.name ) ~= "string" ) then
+		OutputErrorMessage( "The package must be a table with a name string", i_path_assetsToBuild )
+		return false
+	end
+	local path_package = GameInstallDir .. "/data/" .. i_packageInfo.name .. ".pak"
+	local shouldEntriesBeCompressed = i_packageInfo.shouldEntriesBeCompressed ~= false
+
+	-- Every built asset goes in the package
+	local entries = {}
+	-- The package must be written again if any of its files have changed
+	-- or if the list of assets has changed
+	local lastWriteTime_newestInput = math.max( lastWriteTime_this, GetLastWriteTime( i_path_assetsToBuild ) )
+	for i, assetInfo in ipairs( registeredAssetsToBuild ) do
+		local result, returnValue = ConvertSourceRelativePathToBuiltRelativePath( assetInfo.path, assetInfo.assetTypeInfo )
+		if not result then
+			OutputErrorMessage( returnValue )
+			return false
+		end
+		local path_builtFile = GameInstallDir .. "/data/" .. returnValue
+		entries[#entries + 1] =
+		{
+			-- This is the path that the run-time uses to load the asset
+			path = "data/" .. returnValue,
+			file = path_builtFile,
+			shouldBeCompressed = shouldEntriesBeCompressed and assetInfo.assetTypeInfo.ShouldBeCompressedInPackage(),
+		}
+		lastWriteTime_newestInput = math.max( lastWriteTime_newestInput, GetLastWriteTime( path_builtFile ) )
+	end
+	-- The content manifest is packaged too so that a game that only ships its package can still share identical assets
+	do
+		local path_manifest = GameInstallDir .. "/data/ContentManifest.bin"
+		if DoesFileExist( path_manifest ) then
+			entries[#entries + 1] =
+			{
+				path = "data/ContentManifest.bin",
+				file = path_manifest,
+				shouldBeCompressed = shouldEntriesBeCompressed,
+			}
+			lastWriteTime_newestInput = math.max( lastWriteTime_newestInput, GetLastWriteTime( path_manifest ) )
+		end
+	end
+
+	-- Write the package if necessary
+	if ( not DoesFileExist( path_package ) ) or ( lastWriteTime_newestInput > GetLastWriteTime( path_package ) ) then
+		local result, errorMessage = WritePackage( path_package, entries )
+		if result then
+			print( "Packaged " .. tostring( #entries ) .. " assets into " .. path_package )
+		else
+			OutputErrorMessage( "The package \"" .. path_package .. "\" couldn't be written: " .. errorMessage )
+			-- A partially-written package shouldn't be considered up-to-date
+			if DoesFileExist( path_package ) then
+				InvalidateLastWriteTime( path_package )
+			end
+			return false
+		end
+	else
+		print( i_packageInfo.name .. ".pak is up to date" )
+	end
+
+	return true
+end
+
 -- External Interface
 --===================
 
@@ -457,11 +789,27 @@ function BuildAssets( i_path_assetsToBuild )
 	-- Register every asset that needs to be built
 	registeredAssetsToBuild = {}	-- Clear the table
 	-- Iterate through every type of asset in the file
+	-- (except for the optional package and compression level, which aren't asset types)
+	local packageInfo = assetsToBuild.package
+	compressionLevel = nil
+	if assetsToBuild.compression ~= nil then
+		if ( assetsToBuild.compression == "fast" ) or ( assetsToBuild.compression == "high" ) then
+			compressionLevel = assetsToBuild.compression
+		else
+			wereThereErrors = true
+			OutputErrorMessage( "The compression level must be \"fast\" or \"high\" (not \"" .. tostring( assetsToBuild.compression ) .. "\")",
+				i_path_assetsToBuild )
+		end
+	end
 	for assetType, assetsToBuild_specificType in pairs( assetsToBuild ) do
 		-- In order for an asset of this type to be built
 		-- an asset type info must have been defined
 		local assetTypeInfo = assetTypeInfos[assetType]
-		if assetTypeInfo then
+		if assetType == "package" then
+			-- The package is built after every asset
+		elseif assetType == "compression" then
+			-- The compression level is passed to every builder
+		elseif assetTypeInfo then
 			-- Iterate through every asset of this type
 			for i, assetToBuild in ipairs( assetsToBuild_specificType ) do
 				if type( assetToBuild ) == "string" then
@@ -481,11 +829,35 @@ function BuildAssets( i_path_assetsToBuild )
 	end
 
 	-- Build every asset that was registered
+	BeginBuildProfile()
 	for i, assetInfo in ipairs( registeredAssetsToBuild ) do
 		if not BuildAsset( assetInfo ) then
 			wereThereErrors = true
 		end
 	end
+	WriteBuildProfile()
+
+	-- Record the content hash of every built asset
+	-- so that the run-time can share assets that are byte-identical under different paths
+	-- (like the package, the manifest is only written when every asset was built successfully)
+	if not wereThereErrors then
+		if not BuildContentManifest( i_path_assetsToBuild ) then
+			wereThereErrors = true
+		end
+	end
+
+	-- If a package was requested put every built asset into it
+	-- (the package is only built when every asset was built successfully
+	-- so that it never contains a mix of old and new assets)
+	if packageInfo then
+		if not wereThereErrors then
+			if not BuildPackage( packageInfo, i_path_assetsToBuild ) then
+				wereThereErrors = true
+			end
+		else
+			OutputWarningMessage( "The package wasn't built because there were errors building assets", i_path_assetsToBuild )
+		end
+	end
 
 	-- Copy the licenses to the installation location
 	do
@@ -0,0 +1,155 @@
+// Include Files
+//==============
+
+#include "Functions.h"
+
+#include <algorithm>
+#include <Engine/Assets/ContentManifest.h>
+#include <Engine/Platform/Package.h>
+#include <Engine/Platform/Platform.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::WriteContentManifest( const char* const i_path_manifest, const std::vector<sContentManifestEntry>& i_entries,
+	sContentManifestStatistics* const o_statistics, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	std::vector<ContentManifest::sEntry> entries( i_entries.size() );
+	sContentManifestStatistics statistics;
+	std::ofstream fout;
+
+	if ( i_entries.size() > std::numeric_limits<uint32_t>::max() )
+	{
+		result = Results::Failure;
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "There are too many files to put in a content manifest";
+		}
+		goto OnExit;
+	}
+	// Hash every built file
+	{
+		// Each content hash is mapped to the size of the first file that had it
+		// so that duplicates can be reported
+		std::unordered_map<uint64_t, uint64_t> sizesOfContent;
+		for ( size_t i = 0; i < i_entries.size(); ++i )
+		{
+			const auto& source = i_entries[i];
+			auto& entry = entries[i];
+			Platform::sDataFromFile dataFromFile;
+			if ( !( result = Platform::LoadBinaryFile( source.path_builtFile.c_str(), dataFromFile, o_errorMessage ) ) )
+			{
+				goto OnExit;
+			}
+			entry.pathHash = Platform::Package::CalculatePathHash( source.path_runTime.c_str(), source.path_runTime.length() );
+			entry.contentHash = ContentManifest::CalculateContentHash( dataFromFile.data, dataFromFile.size );
+			entry.size = dataFromFile.size;
+			dataFromFile.Free();
+
+			const auto iterator = sizesOfContent.find( entry.contentHash );
+			if ( iterator == sizesOfContent.end() )
+			{
+				sizesOfContent.insert( std::make_pair( entry.contentHash, entry.size ) );
+			}
+			else if ( iterator->second == entry.size )
+			{
+				++statistics.duplicateFileCount;
+				statistics.duplicateByteCount += entry.size;
+			}
+		}
+	}
+	// Sort the entries by path hash so that the run-time can do a binary search
+	{
+		std::vector<size_t> order( entries.size() );
+		for ( size_t i = 0; i < order.size(); ++i )
+		{
+			order[i] = i;
+		}
+		std::sort( order.begin(), order.end(),
+			[&entries]( const size_t i_lhs, const size_t i_rhs ) { return entries[i_lhs].pathHash < entries[i_rhs].pathHash; } );
+		for ( size_t i = 1; i < order.size(); ++i )
+		{
+			if ( entries[order[i - 1]].pathHash == entries[order[i]].pathHash )
+			{
+				result = Results::Failure;
+				if ( o_errorMessage )
+				{
+					std::ostringstream errorMessage;
+					errorMessage << "\"" << i_entries[order[i - 1]].path_runTime << "\" and \"" << i_entries[order[i]].path_runTime
+						<< "\" have the same path hash and can't both be in a content manifest";
+					*o_errorMessage = errorMessage.str();
+				}
+				goto OnExit;
+			}
+		}
+		std::vector<ContentManifest::sEntry> sortedEntries( entries.size() );
+		for ( size_t i = 0; i < order.size(); ++i )
+		{
+			sortedEntries[i] = entries[order[i]];
+		}
+		std::swap( entries, sortedEntries );
+	}
+	// Write the manifest
+	{
+		fout.open( i_path_manifest, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary );
+		if ( !fout.is_open() )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The content manifest \"" << i_path_manifest << "\" couldn't be opened for writing";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		{
+			ContentManifest::sHeader header{};
+			header.signature = ContentManifest::s_signature;
+			header.version = ContentManifest::s_version;
+			header.entryCount = static_cast<uint32_t>( entries.size() );
+			fout.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+		}
+		fout.write( reinterpret_cast<const char*>( entries.data() ), entries.size() * sizeof( ContentManifest::sEntry ) );
+		if ( !fout.good() )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to write the content manifest \"" << i_path_manifest << "\"";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+	if ( o_statistics )
+	{
+		*o_statistics = statistics;
+	}
+
+OnExit:
+
+	if ( fout.is_open() )
+	{
+		fout.close();
+		if ( fout.is_open() && result )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to close the content manifest \"" << i_path_manifest << "\" after writing";
+				*o_errorMessage = errorMessage.str();
+			}
+		}
+	}
+
+	return result;
+}
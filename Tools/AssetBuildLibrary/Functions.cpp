@@ -3,6 +3,7 @@
 
 #include "Functions.h"
 
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
 #include <Engine/Asserts/Asserts.h>
@@ -93,12 +94,15 @@ namespace
 	int luaCreateDirectoryIfItDoesntExist( lua_State* io_luaState );
 	int luaDoesFileExist( lua_State* io_luaState );
 	int luaExecuteCommand( lua_State* io_luaState );
+	int luaGetCurrentTime( lua_State* io_luaState );
 	int luaGetEnvironmentVariable( lua_State* io_luaState );
 	int LuaGetFilesInDirectory( lua_State* io_luaState );
 	int luaGetLastWriteTime( lua_State* io_luaState );
 	int luaInvalidateLastWriteTime( lua_State* io_luaState );
 	int luaOutputErrorMessage( lua_State* io_luaState );
 	int luaOutputWarningMessage( lua_State* io_luaState );
+	int luaWriteContentManifest( lua_State* io_luaState );
+	int luaWritePackage( lua_State* io_luaState );
 }
 
 // Interface
@@ -115,6 +119,17 @@ eae6320::cResult eae6320::Assets::ConvertSourceRelativePathToBuiltRelativePath(
 	return s_luaState.ConvertSourceRelativePathToBuiltRelativePath( i_sourceRelativePath, i_assetType, o_builtRelativePath, o_errorMessage );
 }
 
+// Profiling
+//----------
+
+double eae6320::Assets::GetCurrentTimeInSeconds()
+{
+	// steady_clock is monotonic and (on Windows) backed by the system-wide performance counter,
+	// which means that times from AssetBuildExe and from the builders it launches are comparable
+	const auto timeSinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration<double>( timeSinceEpoch ).count();
+}
+
 // Error / Warning Output
 //-----------------------
 
@@ -552,12 +567,15 @@ namespace
 			lua_register( luaState, "CreateDirectoryIfItDoesntExist", luaCreateDirectoryIfItDoesntExist );
 			lua_register( luaState, "DoesFileExist", luaDoesFileExist );
 			lua_register( luaState, "ExecuteCommand", luaExecuteCommand );
+			lua_register( luaState, "GetCurrentTime", luaGetCurrentTime );
 			lua_register( luaState, "GetEnvironmentVariable", luaGetEnvironmentVariable );
 			lua_register( luaState, "GetFilesInDirectory", LuaGetFilesInDirectory );
 			lua_register( luaState, "GetLastWriteTime", luaGetLastWriteTime );
 			lua_register( luaState, "InvalidateLastWriteTime", luaInvalidateLastWriteTime );
 			lua_register( luaState, "OutputErrorMessage", luaOutputErrorMessage );
 			lua_register( luaState, "OutputWarningMessage", luaOutputWarningMessage );
+			lua_register( luaState, "WriteContentManifest", luaWriteContentManifest );
+			lua_register( luaState, "WritePackage", luaWritePackage );
 		}
 		// Set the platform #defines
 		{
@@ -949,6 +967,13 @@ namespace
 		}
 	}
 
+	int luaGetCurrentTime( lua_State* io_luaState )
+	{
+		lua_pushnumber( io_luaState, eae6320::Assets::GetCurrentTimeInSeconds() );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
 	int luaGetEnvironmentVariable( lua_State* io_luaState )
 	{
 		// Argument #1: The key
@@ -1179,4 +1204,158 @@ namespace
 		constexpr int returnValueCount = 0;
 		return returnValueCount;
 	}
+
+	int luaWriteContentManifest( lua_State* io_luaState )
+	{
+		// Argument #1: The path of the content manifest
+		const char* i_path_manifest;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_manifest = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: An array of entries
+		// (each of which is a table with a "path" for the run-time and a built "file")
+		std::vector<eae6320::Assets::sContentManifestEntry> i_entries;
+		if ( lua_istable( io_luaState, 2 ) )
+		{
+			const auto entryCount = luaL_len( io_luaState, 2 );
+			i_entries.resize( static_cast<size_t>( entryCount ) );
+			for ( lua_Integer i = 1; i <= entryCount; ++i )
+			{
+				auto& entry = i_entries[static_cast<size_t>( i - 1 )];
+				if ( lua_rawgeti( io_luaState, 2, i ) != LUA_TTABLE )
+				{
+					return luaL_error( io_luaState,
+						"Content manifest entry #%d must be a table (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				if ( lua_getfield( io_luaState, -1, "path" ) != LUA_TSTRING )
+				{
+					return luaL_error( io_luaState,
+						"The path of content manifest entry #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				entry.path_runTime = lua_tostring( io_luaState, -1 );
+				lua_pop( io_luaState, 1 );
+				if ( lua_getfield( io_luaState, -1, "file" ) != LUA_TSTRING )
+				{
+					return luaL_error( io_luaState,
+						"The file of content manifest entry #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				entry.path_builtFile = lua_tostring( io_luaState, -1 );
+				lua_pop( io_luaState, 2 );
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+
+		// Write the content manifest
+		eae6320::Assets::sContentManifestStatistics statistics;
+		std::string errorMessage;
+		if ( eae6320::Assets::WriteContentManifest( i_path_manifest, i_entries, &statistics, &errorMessage ) )
+		{
+			// The number of duplicate files and their total size are also returned
+			// so that the build can report how much duplicated content there is
+			lua_pushboolean( io_luaState, true );
+			lua_pushinteger( io_luaState, static_cast<lua_Integer>( statistics.duplicateFileCount ) );
+			lua_pushinteger( io_luaState, static_cast<lua_Integer>( statistics.duplicateByteCount ) );
+			constexpr int returnValueCount = 3;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushboolean( io_luaState, false );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
+	int luaWritePackage( lua_State* io_luaState )
+	{
+		// Argument #1: The path of the package
+		const char* i_path_package;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_package = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: An array of entries
+		// (each of which is a table with a "path" for the run-time, a built "file", and an optional "shouldBeCompressed")
+		std::vector<eae6320::Assets::sPackageEntry> i_entries;
+		if ( lua_istable( io_luaState, 2 ) )
+		{
+			const auto entryCount = luaL_len( io_luaState, 2 );
+			i_entries.resize( static_cast<size_t>( entryCount ) );
+			for ( lua_Integer i = 1; i <= entryCount; ++i )
+			{
+				auto& entry = i_entries[static_cast<size_t>( i - 1 )];
+				if ( lua_rawgeti( io_luaState, 2, i ) != LUA_TTABLE )
+				{
+					return luaL_error( io_luaState,
+						"Package entry #%d must be a table (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				if ( lua_getfield( io_luaState, -1, "path" ) != LUA_TSTRING )
+				{
+					return luaL_error( io_luaState,
+						"The path of package entry #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				entry.path_runTime = lua_tostring( io_luaState, -1 );
+				lua_pop( io_luaState, 1 );
+				if ( lua_getfield( io_luaState, -1, "file" ) != LUA_TSTRING )
+				{
+					return luaL_error( io_luaState,
+						"The file of package entry #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+				entry.path_builtFile = lua_tostring( io_luaState, -1 );
+				lua_pop( io_luaState, 1 );
+				if ( lua_getfield( io_luaState, -1, "shouldBeCompressed" ) != LUA_TNIL )
+				{
+					entry.shouldBeCompressed = lua_toboolean( io_luaState, -1 ) != 0;
+				}
+				lua_pop( io_luaState, 2 );
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+
+		// Write the package
+		std::string errorMessage;
+		if ( eae6320::Assets::WritePackage( i_path_package, i_entries, &errorMessage ) )
+		{
+			lua_pushboolean( io_luaState, true );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushboolean( io_luaState, false );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
 }
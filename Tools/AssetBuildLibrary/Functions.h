@@ -8,8 +8,11 @@
 // Include Files
 //==============
 
+#include <cstddef>
+#include <cstdint>
 #include <Engine/Results/Results.h>
 #include <string>
+#include <vector>
 
 // Interface
 //==========
@@ -26,6 +29,52 @@ namespace eae6320
 		eae6320::cResult ConvertSourceRelativePathToBuiltRelativePath( const char* const i_sourceRelativePath, const char* const i_assetType,
 			std::string& o_builtRelativePath, std::string* o_errorMessage = nullptr );
 
+		// Packages
+		//---------
+
+		struct sPackageEntry
+		{
+			// The path that the run-time will load the file with (e.g. "data/Meshes/Cube.binmsh")
+			std::string path_runTime;
+			// The path of the built file whose contents will be put in the package
+			std::string path_builtFile;
+			// Compressed files are only stored compressed if it makes them meaningfully smaller
+			bool shouldBeCompressed = true;
+		};
+
+		// Writes every entry into a single package file (see Engine/Platform/Package.h)
+		eae6320::cResult WritePackage( const char* const i_path_package, const std::vector<sPackageEntry>& i_entries,
+			std::string* const o_errorMessage = nullptr );
+
+		// Content Manifest
+		//-----------------
+
+		struct sContentManifestEntry
+		{
+			// The path that the run-time will load the file with (e.g. "data/Meshes/Cube.binmsh")
+			std::string path_runTime;
+			// The path of the built file whose contents will be hashed
+			std::string path_builtFile;
+		};
+		struct sContentManifestStatistics
+		{
+			// A duplicate is a file whose contents are identical to a file earlier in the list
+			size_t duplicateFileCount = 0;
+			uint64_t duplicateByteCount = 0;
+		};
+
+		// Writes the content hash of every entry into a content manifest file (see Engine/Assets/ContentManifest.h)
+		eae6320::cResult WriteContentManifest( const char* const i_path_manifest, const std::vector<sContentManifestEntry>& i_entries,
+			sContentManifestStatistics* const o_statistics = nullptr, std::string* const o_errorMessage = nullptr );
+
+		// Profiling
+		//----------
+
+		// Returns a monotonic time in seconds.
+		// The same clock is used by AssetBuildFunctions.lua (via GetCurrentTime())
+		// and by every builder, so timings recorded in different processes can be put on one timeline.
+		double GetCurrentTimeInSeconds();
+
 		// Error / Warning Output
 		//-----------------------
 
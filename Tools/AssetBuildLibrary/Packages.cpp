@@ -0,0 +1,257 @@
+// Include Files
+//==============
+
+#include "Functions.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Platform/Package.h>
+#include <Engine/Platform/Platform.h>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	struct sEntryToWrite
+	{
+		eae6320::Platform::Package::sEntry entry;
+		const eae6320::Assets::sPackageEntry* source = nullptr;
+		std::vector<uint8_t> storedData;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	eae6320::cResult PrepareEntry( const eae6320::Assets::sPackageEntry& i_source, sEntryToWrite& o_entry, std::string* const o_errorMessage );
+	void WritePadding( std::ofstream& io_file, const uint64_t i_alignment );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::WritePackage( const char* const i_path_package, const std::vector<sPackageEntry>& i_entries,
+	std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	using namespace Platform::Package;
+
+	std::vector<sEntryToWrite> entries( i_entries.size() );
+	std::string paths;
+	std::ofstream fout;
+
+	// Read (and compress if necessary) every file
+	for ( size_t i = 0; i < i_entries.size(); ++i )
+	{
+		if ( !( result = PrepareEntry( i_entries[i], entries[i], o_errorMessage ) ) )
+		{
+			goto OnExit;
+		}
+	}
+	// Sort the table of contents by hash so that the run-time can do a binary search
+	{
+		std::sort( entries.begin(), entries.end(),
+			[]( const sEntryToWrite& i_lhs, const sEntryToWrite& i_rhs ) { return i_lhs.entry.pathHash < i_rhs.entry.pathHash; } );
+		for ( size_t i = 1; i < entries.size(); ++i )
+		{
+			for ( auto j = i; ( j > 0 ) && ( entries[j - 1].entry.pathHash == entries[i].entry.pathHash ); --j )
+			{
+				const auto& pathA = entries[j - 1].source->path_runTime;
+				const auto& pathB = entries[i].source->path_runTime;
+				if ( ArePathsEquivalent( pathA.c_str(), pathA.length(), pathB.c_str(), pathB.length() ) )
+				{
+					result = Results::Failure;
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "\"" << pathA << "\" and \"" << pathB << "\" are the same path and can't both be in a package";
+						*o_errorMessage = errorMessage.str();
+					}
+					goto OnExit;
+				}
+			}
+		}
+	}
+	// Lay out the package
+	{
+		for ( auto& entry : entries )
+		{
+			entry.entry.pathOffset = static_cast<uint32_t>( paths.length() );
+			paths += entry.source->path_runTime;
+		}
+		if ( paths.length() > std::numeric_limits<uint32_t>::max() )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = "The paths of the files in the package are too long";
+			}
+			goto OnExit;
+		}
+		uint64_t offset = sizeof( sHeader ) + ( entries.size() * sizeof( sEntry ) ) + paths.length();
+		for ( auto& entry : entries )
+		{
+			offset = ( ( offset + s_entryAlignment - 1 ) / s_entryAlignment ) * s_entryAlignment;
+			entry.entry.offset = offset;
+			offset += entry.entry.storedSize;
+		}
+	}
+	// Write the package
+	{
+		fout.open( i_path_package, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary );
+		if ( !fout.is_open() )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The package \"" << i_path_package << "\" couldn't be opened for writing";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		{
+			sHeader header{};
+			header.signature = s_signature;
+			header.version = s_version;
+			header.entryCount = static_cast<uint32_t>( entries.size() );
+			header.pathsSize = static_cast<uint32_t>( paths.length() );
+			fout.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+		}
+		for ( const auto& entry : entries )
+		{
+			fout.write( reinterpret_cast<const char*>( &entry.entry ), sizeof( entry.entry ) );
+		}
+		fout.write( paths.data(), paths.length() );
+		for ( const auto& entry : entries )
+		{
+			WritePadding( fout, s_entryAlignment );
+			EAE6320_ASSERT( static_cast<uint64_t>( fout.tellp() ) == entry.entry.offset );
+			fout.write( reinterpret_cast<const char*>( entry.storedData.data() ), entry.storedData.size() );
+		}
+		if ( !fout.good() )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to write the package \"" << i_path_package << "\"";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	if ( fout.is_open() )
+	{
+		fout.close();
+		if ( fout.is_open() && result )
+		{
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Failed to close the package \"" << i_path_package << "\" after writing";
+				*o_errorMessage = errorMessage.str();
+			}
+		}
+	}
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult PrepareEntry( const eae6320::Assets::sPackageEntry& i_source, sEntryToWrite& o_entry, std::string* const o_errorMessage )
+	{
+		auto result = eae6320::Results::Success;
+
+		using namespace eae6320::Platform;
+
+		eae6320::Platform::sDataFromFile dataFromFile;
+
+		o_entry.source = &i_source;
+		o_entry.entry = {};
+		if ( i_source.path_runTime.length() > std::numeric_limits<uint16_t>::max() )
+		{
+			result = eae6320::Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The path \"" << i_source.path_runTime << "\" is too long to be put in a package";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		o_entry.entry.pathHash = Package::CalculatePathHash( i_source.path_runTime.c_str(), i_source.path_runTime.length() );
+		o_entry.entry.pathLength = static_cast<uint16_t>( i_source.path_runTime.length() );
+
+		// Read the built file
+		if ( !( result = LoadBinaryFile( i_source.path_builtFile.c_str(), dataFromFile, o_errorMessage ) ) )
+		{
+			goto OnExit;
+		}
+		if ( dataFromFile.size > std::numeric_limits<uint32_t>::max() )
+		{
+			result = eae6320::Results::Failure;
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The file \"" << i_source.path_builtFile << "\" is too big (" << dataFromFile.size << " bytes) to be put in a package";
+				*o_errorMessage = errorMessage.str();
+			}
+			goto OnExit;
+		}
+		o_entry.entry.uncompressedSize = static_cast<uint32_t>( dataFromFile.size );
+		// Compress it if requested
+		if ( i_source.shouldBeCompressed && ( dataFromFile.size > 0 ) )
+		{
+			o_entry.storedData.resize( Compression::GetMaxCompressedSize( dataFromFile.size ) );
+			const auto compressedSize = Compression::CompressBlock( dataFromFile.data, dataFromFile.size, o_entry.storedData.data() );
+			// If compression doesn't save at least 1/16 of the size
+			// it isn't worth the time it takes to decompress
+			if ( compressedSize <= ( dataFromFile.size - ( dataFromFile.size / 16 ) ) )
+			{
+				o_entry.storedData.resize( compressedSize );
+				o_entry.entry.storedSize = static_cast<uint32_t>( compressedSize );
+				o_entry.entry.codec = Compression::LZ4;
+				goto OnExit;
+			}
+		}
+		// Otherwise store it as-is
+		{
+			const auto* const data = static_cast<const uint8_t*>( dataFromFile.data );
+			o_entry.storedData.assign( data, data + dataFromFile.size );
+			o_entry.entry.storedSize = o_entry.entry.uncompressedSize;
+			o_entry.entry.codec = Compression::None;
+		}
+
+	OnExit:
+
+		dataFromFile.Free();
+
+		return result;
+	}
+
+	void WritePadding( std::ofstream& io_file, const uint64_t i_alignment )
+	{
+		const auto position = static_cast<uint64_t>( io_file.tellp() );
+		const auto paddingSize = ( i_alignment - ( position % i_alignment ) ) % i_alignment;
+		for ( uint64_t i = 0; i < paddingSize; ++i )
+		{
+			io_file.put( '\0' );
+		}
+	}
+}
@@ -5,6 +5,10 @@
 
 #include "Functions.h"
 
+#include <cstring>
+#include <Engine/Platform/Compression.h>
+#include <Engine/Platform/Platform.h>
+#include <fstream>
 #include <sstream>
 
 // Interface
@@ -20,15 +24,42 @@ eae6320::cResult eae6320::Assets::cbBuilder::ParseCommandArgumentsAndBuild( char
 	constexpr unsigned int requiredArgumentCount = 2;
 	if ( actualArgumentCount >= requiredArgumentCount )
 	{
+		const auto time_start = GetCurrentTimeInSeconds();
+
 		m_path_source = i_arguments[commandCount + 0];
 		m_path_target = i_arguments[commandCount + 1];
 
 		std::vector<std::string> optionalArguments;
 		for ( auto i = ( commandCount + requiredArgumentCount ); i < i_argumentCount; ++i )
 		{
+			// The profiling argument is consumed here rather than being passed on to the derived builder
+			if ( ( std::strcmp( i_arguments[i], "-profile" ) == 0 ) && ( ( i + 1 ) < i_argumentCount ) )
+			{
+				m_path_profile = i_arguments[++i];
+				continue;
+			}
+			// So is the compression argument
+			if ( ( std::strcmp( i_arguments[i], "-compress" ) == 0 ) && ( ( i + 1 ) < i_argumentCount ) )
+			{
+				m_compression = i_arguments[++i];
+				continue;
+			}
 			optionalArguments.push_back( i_arguments[i] );
 		}
-		return Build( optionalArguments );
+		auto result = Build( optionalArguments );
+		if ( result && m_compression )
+		{
+			result = CompressTarget();
+		}
+		EndProfilingPhase();
+
+		if ( m_path_profile )
+		{
+			// Failing to write the profile is reported but doesn't fail the build
+			WriteProfilingPhases( time_start, GetCurrentTimeInSeconds() );
+		}
+
+		return result;
 	}
 	else
 	{
@@ -53,3 +84,118 @@ eae6320::cResult eae6320::Assets::cbBuilder::ParseCommandArgumentsAndBuild( char
 		return Results::Failure;
 	}
 }
+
+// Profiling
+//----------
+
+void eae6320::Assets::cbBuilder::BeginProfilingPhase( const char* const i_name )
+{
+	const auto time = GetCurrentTimeInSeconds();
+	if ( m_isProfilingPhaseOpen )
+	{
+		m_profilingPhases.back().time_end = time;
+	}
+	sProfilingPhase phase;
+	{
+		phase.name = i_name;
+		phase.time_start = time;
+	}
+	m_profilingPhases.push_back( phase );
+	m_isProfilingPhaseOpen = true;
+}
+
+void eae6320::Assets::cbBuilder::EndProfilingPhase()
+{
+	if ( m_isProfilingPhaseOpen )
+	{
+		m_profilingPhases.back().time_end = GetCurrentTimeInSeconds();
+		m_isProfilingPhaseOpen = false;
+	}
+}
+
+// Implementation
+//===============
+
+// Profiling
+//----------
+
+eae6320::cResult eae6320::Assets::cbBuilder::WriteProfilingPhases( const double i_time_start, const double i_time_end ) const
+{
+	// The format is read by AssetBuildFunctions.lua:
+	//	* The first line is the time that the builder started and finished
+	//	* Every other line is a phase name followed by its start and end times
+	// (Phase names can't contain whitespace)
+	std::ofstream file( m_path_profile );
+	if ( !file.is_open() )
+	{
+		OutputWarningMessageWithFileInfo( m_path_source, "The build profile couldn't be written to \"%s\"", m_path_profile );
+		return Results::Failure;
+	}
+	file.precision( 17 );
+	file << "builder " << i_time_start << " " << i_time_end << "\n";
+	for ( const auto& phase : m_profilingPhases )
+	{
+		file << phase.name << " " << phase.time_start << " " << phase.time_end << "\n";
+	}
+	return Results::Success;
+}
+
+// Compression
+//------------
+
+eae6320::cResult eae6320::Assets::cbBuilder::CompressTarget()
+{
+	auto result = Results::Success;
+
+	using namespace Platform;
+
+	Platform::sDataFromFile builtFile;
+	std::vector<uint8_t> compressedFile;
+	std::string errorMessage;
+
+	BeginProfilingPhase( "compress" );
+
+	Compression::eLevel level;
+	if ( std::strcmp( m_compression, "fast" ) == 0 )
+	{
+		level = Compression::eLevel::Fast;
+	}
+	else if ( std::strcmp( m_compression, "high" ) == 0 )
+	{
+		level = Compression::eLevel::High;
+	}
+	else
+	{
+		result = Results::Failure;
+		OutputErrorMessageWithFileInfo( m_path_source, "\"%s\" isn't a valid compression level (it must be \"fast\" or \"high\")", m_compression );
+		goto OnExit;
+	}
+	// The uncompressed target is read back in after the specific builder has written it
+	// so that no builder needs to know about compression
+	if ( !( result = LoadBinaryFile( m_path_target, builtFile, &errorMessage ) ) )
+	{
+		OutputErrorMessageWithFileInfo( m_path_target, "%s", errorMessage.c_str() );
+		goto OnExit;
+	}
+	if ( !( result = Compression::CompressFile( builtFile.data, builtFile.size, level, compressedFile ) ) )
+	{
+		OutputErrorMessageWithFileInfo( m_path_target, "The built file couldn't be compressed" );
+		goto OnExit;
+	}
+	// If compressing doesn't make the file smaller it is left as-is
+	// (an uncompressed file is always valid)
+	if ( compressedFile.size() < builtFile.size )
+	{
+		if ( !( result = WriteBinaryFile( m_path_target, compressedFile.data(), compressedFile.size(), &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( m_path_target, "%s", errorMessage.c_str() );
+			goto OnExit;
+		}
+	}
+
+OnExit:
+
+	builtFile.Free();
+
+	return result;
+}
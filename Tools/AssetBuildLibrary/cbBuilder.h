@@ -46,6 +46,18 @@ namespace eae6320
 			// with the command line arguments directly from the main() entry point:
 			cResult ParseCommandArgumentsAndBuild( char* const* i_arguments, const unsigned int i_argumentCount );
 
+		protected:
+
+			// Profiling
+			//----------
+
+			// A derived builder can mark where each phase of its work starts
+			// (e.g. "parse", "process", "write").
+			// Starting a new phase ends the previous one,
+			// and any phase that is still open when Build() returns is ended automatically.
+			void BeginProfilingPhase( const char* const i_name );
+			void EndProfilingPhase();
+
 			// Data
 			//=====
 
@@ -54,6 +66,23 @@ namespace eae6320
 			const char* m_path_source = nullptr;
 			const char* m_path_target = nullptr;
 
+		private:
+
+			struct sProfilingPhase
+			{
+				std::string name;
+				double time_start = 0.0;
+				double time_end = 0.0;
+			};
+			std::vector<sProfilingPhase> m_profilingPhases;
+			bool m_isProfilingPhaseOpen = false;
+			// If AssetBuildFunctions.lua passes a "-profile" argument
+			// then the phase timings are written to this path after the build
+			const char* m_path_profile = nullptr;
+			// If AssetBuildFunctions.lua passes a "-compress" argument ("fast" or "high")
+			// then the target is compressed after it has been built
+			const char* m_compression = nullptr;
+
 			// Inheritable Implementation
 			//===========================
 
@@ -65,6 +94,21 @@ namespace eae6320
 			// ParseCommandArgumentsAndBuild() will extract the source and target paths
 			// and then call this function in the derived class with any remaining (optional) arguments:
 			virtual cResult Build( const std::vector<std::string>& i_optionalArguments ) = 0;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Profiling
+			//----------
+
+			cResult WriteProfilingPhases( const double i_time_start, const double i_time_end ) const;
+
+			// Compression
+			//------------
+
+			cResult CompressTarget();
 		};
 	}
 }
@@ -26,6 +26,7 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::str
 	std::ofstream outfile(m_path_target, std::ofstream::binary);
 
 	// This function should fill vertex and index vectors with data
+	BeginProfilingPhase("parse");
 	if (!(result = LoadAsset(m_path_source)))
 	{
 		eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, errorMessage.c_str());
@@ -33,6 +34,7 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::str
 
 	// If the current platform is Direct3D, we will have to
 	// flip V value for Texcoord and change winding order
+	BeginProfilingPhase("process");
 #if defined (EAE6320_PLATFORM_D3D)
 	// Flip all V values for Texcoord to display correctly under Direct3D
 	for (size_t i = 0; i < s_vertexData.size(); i++)
@@ -43,6 +45,7 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::str
 #endif
 
 	// Write vertex count into binary file
+	BeginProfilingPhase("write");
 	const uint16_t vertexCount = static_cast<uint16_t>(s_vertexData.size());
 	outfile.write(reinterpret_cast<const char *>(&vertexCount), sizeof(uint16_t));
 
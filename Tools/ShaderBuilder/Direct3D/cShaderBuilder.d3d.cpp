@@ -60,6 +60,7 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 
 	// Load the source code
 	{
+		BeginProfilingPhase( "parse" );
 		std::string errorMessage;
 		if ( !( result = Platform::LoadBinaryFile( m_path_source, dataFromFile, &errorMessage ) ) )
 		{
@@ -69,6 +70,7 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 	}
 	// Compile it
 	{
+		BeginProfilingPhase( "process" );
 		const D3D_SHADER_MACRO defines[] =
 		{
 			{ "EAE6320_PLATFORM_D3D" },
@@ -125,6 +127,7 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 	}
 	// Write the compiled shader to disk
 	{
+		BeginProfilingPhase( "write" );
 		std::string errorMessage;
 		if ( !( result = eae6320::Platform::WriteBinaryFile( m_path_target, compiledCode->GetBufferPointer(), compiledCode->GetBufferSize(), &errorMessage ) ) )
 		{
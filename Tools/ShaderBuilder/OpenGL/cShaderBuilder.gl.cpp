@@ -65,14 +65,17 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::ShaderT
 	auto result = Results::Success;
 
 	std::string shaderSource_preProcessed;
+	BeginProfilingPhase( "parse" );
 	if ( !( result = PreProcessShaderSource( m_path_source, shaderSource_preProcessed ) ) )
 	{
 		goto OnExit;
 	}
+	BeginProfilingPhase( "write" );
 	if ( !( result = SaveGeneratedShaderSource( m_path_target, shaderSource_preProcessed ) ) )
 	{
 		goto OnExit;
 	}
+	BeginProfilingPhase( "process" );
 	if ( !( result = BuildAndVerifyGeneratedShaderSource( m_path_source, m_path_target, i_shaderType, shaderSource_preProcessed ) ) )
 	{
 		goto OnExit;
@@ -0,0 +1,966 @@
+// Include Files
+//==============
+
+#include "BlockCompression.h"
+
+#include "cWorkerPool.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <initializer_list>
+#include <utility>
+
+// SSE2 is always available on x64,
+// and for 32-bit builds it depends on the /arch (or -msse2) setting
+#if defined( _M_X64 ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define EAE6320_BLOCKCOMPRESSION_ISSSE2ENABLED
+	#include <emmintrin.h>
+#endif
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// A block's pixels are stored as a structure of arrays
+	// so that the closest palette entries can be found for 4 pixels at a time
+	struct alignas( 16 ) sBlock
+	{
+		float channels[4][16];
+	};
+
+	struct sPalette
+	{
+		alignas( 16 ) float entries[16][4];
+		unsigned int entryCount = 0;
+	};
+
+	// Writes bits starting with the least significant bit of the first byte
+	class cBitWriter
+	{
+	public:
+
+		void Write( const uint32_t i_value, const unsigned int i_bitCount )
+		{
+			for ( unsigned int i = 0; i < i_bitCount; ++i, ++m_bitIndex )
+			{
+				if ( ( i_value >> i ) & 1u )
+				{
+					m_bytes[m_bitIndex / 8] |= static_cast<uint8_t>( 1u << ( m_bitIndex % 8 ) );
+				}
+			}
+		}
+
+		cBitWriter( uint8_t* const io_bytes, const size_t i_byteCount ) : m_bytes( io_bytes ) { std::memset( io_bytes, 0, i_byteCount ); }
+
+	private:
+
+		uint8_t* const m_bytes;
+		unsigned int m_bitIndex = 0;
+	};
+}
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	// Block Helpers
+	//--------------
+
+	void LoadBlock( const eae6320::Assets::sImage& i_image, const unsigned int i_blockX, const unsigned int i_blockY, eae6320::Assets::sColor ( &o_pixels )[16] );
+
+	// Endpoint Search
+	//----------------
+
+	// Assigns every pixel the palette entry that is closest to it (considering the first i_channelCount channels)
+	// and returns the total squared error.
+	// If weights are provided each pixel's error is scaled by its weight.
+	float FindClosestPaletteEntries( const sBlock& i_block, const unsigned int i_channelCount, const sPalette& i_palette,
+		const float* const i_pixelWeights, uint8_t ( &o_indices )[16] );
+	// Finds endpoints at the extremes of the pixels' principal axis
+	void FindEndpointsAlongPrincipalAxis( const sBlock& i_block, const unsigned int i_channelCount, const float* const i_pixelWeights,
+		float ( &o_endpoint0 )[4], float ( &o_endpoint1 )[4] );
+	// Given how far each pixel's palette entry is from endpoint 0 towards endpoint 1
+	// (a negative value means that the pixel should be ignored)
+	// finds the endpoints that minimize the squared error
+	bool FitEndpointsWithLeastSquares( const sBlock& i_block, const unsigned int i_channelCount, const float ( &i_interpolationFactors )[16],
+		float ( &o_endpoint0 )[4], float ( &o_endpoint1 )[4] );
+
+	// Format Helpers
+	//---------------
+
+	void CompressColorBlock( const sBlock& i_block, const float* const i_opaqueWeights, const bool i_isThreeColorModeAllowed,
+		const eae6320::Assets::BlockCompression::Quality::eType i_quality, uint8_t* const o_block );
+	void CompressSingleChannelBlock( const sBlock& i_block, const eae6320::Assets::BlockCompression::Quality::eType i_quality, uint8_t* const o_block );
+
+	uint16_t QuantizeToRgb565( const float ( &i_color )[4] );
+	void ExpandFromRgb565( const uint16_t i_color, float ( &o_color )[4] );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::BlockCompression::CompressImage( const sImage& i_image, const Graphics::TextureFormats::Compression::eType i_format,
+	const Quality::eType i_quality, cWorkerPool& io_workerPool, std::vector<uint8_t>& o_compressedData )
+{
+	const auto blockSize = Graphics::TextureFormats::Compression::GetSizeOfBlock( i_format );
+	switch ( i_format )
+	{
+	case Graphics::TextureFormats::Compression::BC1:
+	case Graphics::TextureFormats::Compression::BC3:
+	case Graphics::TextureFormats::Compression::BC4:
+	case Graphics::TextureFormats::Compression::BC5:
+	case Graphics::TextureFormats::Compression::BC7:
+		break;
+	default:
+		EAE6320_ASSERTF( false, "Compressing to format %u isn't supported", static_cast<unsigned int>( i_format ) );
+		return Results::Failure;
+	}
+
+	const auto blockCount_x = ( i_image.width + 3 ) / 4;
+	const auto blockCount_y = ( i_image.height + 3 ) / 4;
+	o_compressedData.resize( static_cast<size_t>( blockCount_x ) * blockCount_y * blockSize );
+	io_workerPool.Run( blockCount_y, [&]( const size_t i_begin, const size_t i_end )
+	{
+		for ( auto blockY = static_cast<unsigned int>( i_begin ); blockY < i_end; ++blockY )
+		{
+			for ( unsigned int blockX = 0; blockX < blockCount_x; ++blockX )
+			{
+				sColor pixels[16];
+				LoadBlock( i_image, blockX, blockY, pixels );
+				auto* const block = &o_compressedData[( ( static_cast<size_t>( blockY ) * blockCount_x ) + blockX ) * blockSize];
+				switch ( i_format )
+				{
+				case Graphics::TextureFormats::Compression::BC1:
+					CompressBlock_BC1( pixels, i_quality, *reinterpret_cast<uint8_t(*)[8]>( block ) );
+					break;
+				case Graphics::TextureFormats::Compression::BC3:
+					CompressBlock_BC3( pixels, i_quality, *reinterpret_cast<uint8_t(*)[16]>( block ) );
+					break;
+				case Graphics::TextureFormats::Compression::BC4:
+					{
+						uint8_t values[16];
+						for ( unsigned int i = 0; i < 16; ++i )
+						{
+							values[i] = pixels[i].r;
+						}
+						CompressBlock_BC4( values, i_quality, *reinterpret_cast<uint8_t(*)[8]>( block ) );
+					}
+					break;
+				case Graphics::TextureFormats::Compression::BC5:
+					CompressBlock_BC5( pixels, i_quality, *reinterpret_cast<uint8_t(*)[16]>( block ) );
+					break;
+				case Graphics::TextureFormats::Compression::BC7:
+					CompressBlock_BC7( pixels, i_quality, *reinterpret_cast<uint8_t(*)[16]>( block ) );
+					break;
+				}
+			}
+		}
+	} );
+
+	return Results::Success;
+}
+
+// Individual Blocks
+//------------------
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC1( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[8] )
+{
+	sBlock block;
+	float opaqueWeights[16];
+	auto isAnyPixelTransparent = false;
+	for ( unsigned int i = 0; i < 16; ++i )
+	{
+		block.channels[0][i] = i_pixels[i].r;
+		block.channels[1][i] = i_pixels[i].g;
+		block.channels[2][i] = i_pixels[i].b;
+		block.channels[3][i] = i_pixels[i].a;
+		const auto isOpaque = i_pixels[i].a >= 128;
+		opaqueWeights[i] = isOpaque ? 1.0f : 0.0f;
+		isAnyPixelTransparent |= !isOpaque;
+	}
+	constexpr bool isThreeColorModeAllowed = true;
+	CompressColorBlock( block, isAnyPixelTransparent ? opaqueWeights : nullptr, isThreeColorModeAllowed, i_quality, o_block );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC3( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] )
+{
+	// The alpha block is the same as BC4 and comes first
+	{
+		uint8_t alphas[16];
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			alphas[i] = i_pixels[i].a;
+		}
+		CompressBlock_BC4( alphas, i_quality, *reinterpret_cast<uint8_t(*)[8]>( &o_block[0] ) );
+	}
+	// The color block is the same as BC1 except that it is always decoded with 4 colors
+	{
+		sBlock block;
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			block.channels[0][i] = i_pixels[i].r;
+			block.channels[1][i] = i_pixels[i].g;
+			block.channels[2][i] = i_pixels[i].b;
+		}
+		constexpr float* const noWeights = nullptr;
+		constexpr bool isThreeColorModeAllowed = false;
+		CompressColorBlock( block, noWeights, isThreeColorModeAllowed, i_quality, &o_block[8] );
+	}
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC4( const uint8_t ( &i_values )[16], const Quality::eType i_quality, uint8_t ( &o_block )[8] )
+{
+	sBlock block;
+	for ( unsigned int i = 0; i < 16; ++i )
+	{
+		block.channels[0][i] = i_values[i];
+	}
+	CompressSingleChannelBlock( block, i_quality, o_block );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC5( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] )
+{
+	// BC5 is two independent BC4 blocks (red and then green)
+	uint8_t reds[16], greens[16];
+	for ( unsigned int i = 0; i < 16; ++i )
+	{
+		reds[i] = i_pixels[i].r;
+		greens[i] = i_pixels[i].g;
+	}
+	CompressBlock_BC4( reds, i_quality, *reinterpret_cast<uint8_t(*)[8]>( &o_block[0] ) );
+	CompressBlock_BC4( greens, i_quality, *reinterpret_cast<uint8_t(*)[8]>( &o_block[8] ) );
+}
+
+void eae6320::Assets::BlockCompression::CompressBlock_BC7( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] )
+{
+	constexpr unsigned int channelCount = 4;
+	constexpr float* const noWeights = nullptr;
+	// Mode 6 uses 4-bit indices with these interpolation weights (out of 64)
+	constexpr unsigned int weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	sBlock block;
+	for ( unsigned int i = 0; i < 16; ++i )
+	{
+		block.channels[0][i] = i_pixels[i].r;
+		block.channels[1][i] = i_pixels[i].g;
+		block.channels[2][i] = i_pixels[i].b;
+		block.channels[3][i] = i_pixels[i].a;
+	}
+
+	// Mode 6 endpoints have 7 bits per channel plus a "P-bit" per endpoint that is shared by all of its channels
+	struct sEndpoints
+	{
+		uint8_t values[2][4];
+		uint8_t pBits[2];
+	};
+	const auto Quantize = []( const float ( &i_endpoint )[4], const uint8_t i_pBit, uint8_t ( &o_values )[4] )
+	{
+		for ( unsigned int c = 0; c < channelCount; ++c )
+		{
+			const auto value = std::round( ( i_endpoint[c] - static_cast<float>( i_pBit ) ) * 0.5f );
+			o_values[c] = static_cast<uint8_t>( std::min( std::max( value, 0.0f ), 127.0f ) );
+		}
+	};
+	const auto Evaluate = [&]( const sEndpoints& i_endpoints, uint8_t ( &o_indices )[16] )
+	{
+		sPalette palette;
+		palette.entryCount = 16;
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			for ( unsigned int c = 0; c < channelCount; ++c )
+			{
+				const auto value0 = ( static_cast<unsigned int>( i_endpoints.values[0][c] ) << 1 ) | i_endpoints.pBits[0];
+				const auto value1 = ( static_cast<unsigned int>( i_endpoints.values[1][c] ) << 1 ) | i_endpoints.pBits[1];
+				palette.entries[i][c] = static_cast<float>( ( ( ( 64 - weights[i] ) * value0 ) + ( weights[i] * value1 ) + 32 ) >> 6 );
+			}
+		}
+		return FindClosestPaletteEntries( block, channelCount, palette, noWeights, o_indices );
+	};
+	// Every combination of P-bits is tried
+	const auto QuantizeAndEvaluate = [&]( const float ( &i_endpoint0 )[4], const float ( &i_endpoint1 )[4], sEndpoints& o_endpoints, uint8_t ( &o_indices )[16] )
+	{
+		auto bestError = FLT_MAX;
+		for ( uint8_t pBits = 0; pBits < 4; ++pBits )
+		{
+			sEndpoints endpoints;
+			endpoints.pBits[0] = pBits & 1;
+			endpoints.pBits[1] = pBits >> 1;
+			Quantize( i_endpoint0, endpoints.pBits[0], endpoints.values[0] );
+			Quantize( i_endpoint1, endpoints.pBits[1], endpoints.values[1] );
+			uint8_t indices[16];
+			const auto error = Evaluate( endpoints, indices );
+			if ( error < bestError )
+			{
+				bestError = error;
+				o_endpoints = endpoints;
+				std::memcpy( o_indices, indices, sizeof( indices ) );
+			}
+		}
+		return bestError;
+	};
+
+	sEndpoints bestEndpoints;
+	uint8_t bestIndices[16];
+	float bestError;
+	{
+		float endpoint0[4], endpoint1[4];
+		FindEndpointsAlongPrincipalAxis( block, channelCount, noWeights, endpoint0, endpoint1 );
+		bestError = QuantizeAndEvaluate( endpoint0, endpoint1, bestEndpoints, bestIndices );
+	}
+	// Refine the endpoints with least squares
+	{
+		const unsigned int iterationCount = ( i_quality == Quality::Fast ) ? 0 : ( ( i_quality == Quality::Normal ) ? 2 : 4 );
+		for ( unsigned int i = 0; ( i < iterationCount ) && ( bestError > 0.0f ); ++i )
+		{
+			float interpolationFactors[16];
+			for ( unsigned int j = 0; j < 16; ++j )
+			{
+				interpolationFactors[j] = static_cast<float>( weights[bestIndices[j]] ) / 64.0f;
+			}
+			float endpoint0[4], endpoint1[4];
+			if ( !FitEndpointsWithLeastSquares( block, channelCount, interpolationFactors, endpoint0, endpoint1 ) )
+			{
+				break;
+			}
+			sEndpoints endpoints;
+			uint8_t indices[16];
+			const auto error = QuantizeAndEvaluate( endpoint0, endpoint1, endpoints, indices );
+			if ( error < bestError )
+			{
+				bestError = error;
+				bestEndpoints = endpoints;
+				std::memcpy( bestIndices, indices, sizeof( indices ) );
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+	// Search the neighboring quantized endpoints
+	if ( i_quality == Quality::High )
+	{
+		auto wasImproved = true;
+		for ( unsigned int pass = 0; wasImproved && ( pass < 4 ) && ( bestError > 0.0f ); ++pass )
+		{
+			wasImproved = false;
+			for ( unsigned int e = 0; e < 2; ++e )
+			{
+				for ( unsigned int c = 0; c < channelCount; ++c )
+				{
+					for ( const int delta : { -1, 1 } )
+					{
+						const auto value = static_cast<int>( bestEndpoints.values[e][c] ) + delta;
+						if ( ( value >= 0 ) && ( value <= 127 ) )
+						{
+							auto endpoints = bestEndpoints;
+							endpoints.values[e][c] = static_cast<uint8_t>( value );
+							uint8_t indices[16];
+							const auto error = Evaluate( endpoints, indices );
+							if ( error < bestError )
+							{
+								bestError = error;
+								bestEndpoints = endpoints;
+								std::memcpy( bestIndices, indices, sizeof( indices ) );
+								wasImproved = true;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	// The most significant bit of the first index isn't stored and is implicitly 0,
+	// and so the endpoints are swapped if necessary
+	if ( bestIndices[0] >= 8 )
+	{
+		std::swap( bestEndpoints.values[0], bestEndpoints.values[1] );
+		std::swap( bestEndpoints.pBits[0], bestEndpoints.pBits[1] );
+		for ( auto& index : bestIndices )
+		{
+			index = 15 - index;
+		}
+	}
+	// Write the block
+	{
+		cBitWriter writer( o_block, sizeof( o_block ) );
+		// The mode is stored as a 1 bit after (mode number) 0 bits
+		constexpr unsigned int mode = 6;
+		writer.Write( 1u << mode, mode + 1 );
+		for ( unsigned int c = 0; c < channelCount; ++c )
+		{
+			writer.Write( bestEndpoints.values[0][c], 7 );
+			writer.Write( bestEndpoints.values[1][c], 7 );
+		}
+		writer.Write( bestEndpoints.pBits[0], 1 );
+		writer.Write( bestEndpoints.pBits[1], 1 );
+		writer.Write( bestIndices[0], 3 );
+		for ( unsigned int i = 1; i < 16; ++i )
+		{
+			writer.Write( bestIndices[i], 4 );
+		}
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	// Block Helpers
+	//--------------
+
+	void LoadBlock( const eae6320::Assets::sImage& i_image, const unsigned int i_blockX, const unsigned int i_blockY, eae6320::Assets::sColor ( &o_pixels )[16] )
+	{
+		for ( unsigned int y = 0; y < 4; ++y )
+		{
+			const auto y_image = std::min( ( i_blockY * 4 ) + y, i_image.height - 1 );
+			for ( unsigned int x = 0; x < 4; ++x )
+			{
+				const auto x_image = std::min( ( i_blockX * 4 ) + x, i_image.width - 1 );
+				o_pixels[( y * 4 ) + x] = i_image.GetPixel( x_image, y_image );
+			}
+		}
+	}
+
+	// Endpoint Search
+	//----------------
+
+	float FindClosestPaletteEntries( const sBlock& i_block, const unsigned int i_channelCount, const sPalette& i_palette,
+		const float* const i_pixelWeights, uint8_t ( &o_indices )[16] )
+	{
+		EAE6320_ASSERT( ( i_channelCount > 0 ) && ( i_channelCount <= 4 ) );
+		EAE6320_ASSERT( ( i_palette.entryCount > 0 ) && ( i_palette.entryCount <= 16 ) );
+#if defined( EAE6320_BLOCKCOMPRESSION_ISSSE2ENABLED )
+		auto totalError = _mm_setzero_ps();
+		for ( unsigned int i = 0; i < 16; i += 4 )
+		{
+			__m128 pixels[4];
+			for ( unsigned int c = 0; c < i_channelCount; ++c )
+			{
+				pixels[c] = _mm_load_ps( &i_block.channels[c][i] );
+			}
+			auto bestErrors = _mm_set1_ps( FLT_MAX );
+			auto bestIndices = _mm_setzero_si128();
+			for ( unsigned int e = 0; e < i_palette.entryCount; ++e )
+			{
+				auto errors = _mm_setzero_ps();
+				for ( unsigned int c = 0; c < i_channelCount; ++c )
+				{
+					const auto difference = _mm_sub_ps( pixels[c], _mm_set1_ps( i_palette.entries[e][c] ) );
+					errors = _mm_add_ps( errors, _mm_mul_ps( difference, difference ) );
+				}
+				const auto isBetter = _mm_castps_si128( _mm_cmplt_ps( errors, bestErrors ) );
+				bestErrors = _mm_min_ps( errors, bestErrors );
+				bestIndices = _mm_or_si128( _mm_and_si128( isBetter, _mm_set1_epi32( static_cast<int>( e ) ) ), _mm_andnot_si128( isBetter, bestIndices ) );
+			}
+			if ( i_pixelWeights )
+			{
+				bestErrors = _mm_mul_ps( bestErrors, _mm_loadu_ps( &i_pixelWeights[i] ) );
+			}
+			totalError = _mm_add_ps( totalError, bestErrors );
+			alignas( 16 ) int32_t indices[4];
+			_mm_store_si128( reinterpret_cast<__m128i*>( indices ), bestIndices );
+			for ( unsigned int j = 0; j < 4; ++j )
+			{
+				o_indices[i + j] = static_cast<uint8_t>( indices[j] );
+			}
+		}
+		alignas( 16 ) float errors[4];
+		_mm_store_ps( errors, totalError );
+		return ( errors[0] + errors[1] ) + ( errors[2] + errors[3] );
+#else
+		auto totalError = 0.0f;
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			auto bestError = FLT_MAX;
+			uint8_t bestIndex = 0;
+			for ( unsigned int e = 0; e < i_palette.entryCount; ++e )
+			{
+				auto error = 0.0f;
+				for ( unsigned int c = 0; c < i_channelCount; ++c )
+				{
+					const auto difference = i_block.channels[c][i] - i_palette.entries[e][c];
+					error += difference * difference;
+				}
+				if ( error < bestError )
+				{
+					bestError = error;
+					bestIndex = static_cast<uint8_t>( e );
+				}
+			}
+			o_indices[i] = bestIndex;
+			totalError += i_pixelWeights ? ( bestError * i_pixelWeights[i] ) : bestError;
+		}
+		return totalError;
+#endif
+	}
+
+	void FindEndpointsAlongPrincipalAxis( const sBlock& i_block, const unsigned int i_channelCount, const float* const i_pixelWeights,
+		float ( &o_endpoint0 )[4], float ( &o_endpoint1 )[4] )
+	{
+		// Calculate the mean
+		float mean[4] = {};
+		auto totalWeight = 0.0f;
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			const auto weight = i_pixelWeights ? i_pixelWeights[i] : 1.0f;
+			for ( unsigned int c = 0; c < i_channelCount; ++c )
+			{
+				mean[c] += i_block.channels[c][i] * weight;
+			}
+			totalWeight += weight;
+		}
+		if ( totalWeight <= 0.0f )
+		{
+			std::fill( std::begin( o_endpoint0 ), std::end( o_endpoint0 ), 0.0f );
+			std::fill( std::begin( o_endpoint1 ), std::end( o_endpoint1 ), 0.0f );
+			return;
+		}
+		for ( unsigned int c = 0; c < i_channelCount; ++c )
+		{
+			mean[c] /= totalWeight;
+		}
+		// Calculate the covariance matrix
+		float covariance[4][4] = {};
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			const auto weight = i_pixelWeights ? i_pixelWeights[i] : 1.0f;
+			for ( unsigned int c0 = 0; c0 < i_channelCount; ++c0 )
+			{
+				const auto difference0 = i_block.channels[c0][i] - mean[c0];
+				for ( unsigned int c1 = c0; c1 < i_channelCount; ++c1 )
+				{
+					covariance[c0][c1] += difference0 * ( i_block.channels[c1][i] - mean[c1] ) * weight;
+				}
+			}
+		}
+		for ( unsigned int c0 = 0; c0 < i_channelCount; ++c0 )
+		{
+			for ( unsigned int c1 = 0; c1 < c0; ++c1 )
+			{
+				covariance[c0][c1] = covariance[c1][c0];
+			}
+		}
+		// Find the principal axis with power iteration,
+		// starting with the diagonal so that the first guess is already reasonable
+		float axis[4] = {};
+		for ( unsigned int c = 0; c < i_channelCount; ++c )
+		{
+			axis[c] = covariance[c][c];
+		}
+		for ( unsigned int iteration = 0; iteration < 8; ++iteration )
+		{
+			float nextAxis[4] = {};
+			auto largestComponent = 0.0f;
+			for ( unsigned int c0 = 0; c0 < i_channelCount; ++c0 )
+			{
+				for ( unsigned int c1 = 0; c1 < i_channelCount; ++c1 )
+				{
+					nextAxis[c0] += covariance[c0][c1] * axis[c1];
+				}
+				largestComponent = std::max( largestComponent, std::abs( nextAxis[c0] ) );
+			}
+			if ( largestComponent <= FLT_EPSILON )
+			{
+				break;
+			}
+			for ( unsigned int c = 0; c < i_channelCount; ++c )
+			{
+				axis[c] = nextAxis[c] / largestComponent;
+			}
+		}
+		// Project every pixel onto the axis to find the extremes
+		auto axisLengthSquared = 0.0f;
+		for ( unsigned int c = 0; c < i_channelCount; ++c )
+		{
+			axisLengthSquared += axis[c] * axis[c];
+		}
+		auto t_min = 0.0f, t_max = 0.0f;
+		if ( axisLengthSquared > FLT_EPSILON )
+		{
+			t_min = FLT_MAX;
+			t_max = -FLT_MAX;
+			for ( unsigned int i = 0; i < 16; ++i )
+			{
+				if ( !i_pixelWeights || ( i_pixelWeights[i] > 0.0f ) )
+				{
+					auto t = 0.0f;
+					for ( unsigned int c = 0; c < i_channelCount; ++c )
+					{
+						t += ( i_block.channels[c][i] - mean[c] ) * axis[c];
+					}
+					t /= axisLengthSquared;
+					t_min = std::min( t_min, t );
+					t_max = std::max( t_max, t );
+				}
+			}
+		}
+		for ( unsigned int c = 0; c < 4; ++c )
+		{
+			o_endpoint0[c] = ( c < i_channelCount ) ? std::min( std::max( mean[c] + ( axis[c] * t_max ), 0.0f ), 255.0f ) : 0.0f;
+			o_endpoint1[c] = ( c < i_channelCount ) ? std::min( std::max( mean[c] + ( axis[c] * t_min ), 0.0f ), 255.0f ) : 0.0f;
+		}
+	}
+
+	bool FitEndpointsWithLeastSquares( const sBlock& i_block, const unsigned int i_channelCount, const float ( &i_interpolationFactors )[16],
+		float ( &o_endpoint0 )[4], float ( &o_endpoint1 )[4] )
+	{
+		// Every pixel is approximated as ( ( 1 - t ) * endpoint0 ) + ( t * endpoint1 ),
+		// and minimizing the squared error gives a 2x2 linear system for each channel
+		auto a = 0.0f, b = 0.0f, c = 0.0f;
+		float x[4] = {}, y[4] = {};
+		for ( unsigned int i = 0; i < 16; ++i )
+		{
+			const auto t = i_interpolationFactors[i];
+			if ( t >= 0.0f )
+			{
+				const auto s = 1.0f - t;
+				a += s * s;
+				b += s * t;
+				c += t * t;
+				for ( unsigned int j = 0; j < i_channelCount; ++j )
+				{
+					x[j] += s * i_block.channels[j][i];
+					y[j] += t * i_block.channels[j][i];
+				}
+			}
+		}
+		const auto determinant = ( a * c ) - ( b * b );
+		if ( std::abs( determinant ) <= FLT_EPSILON )
+		{
+			return false;
+		}
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			o_endpoint0[j] = ( j < i_channelCount ) ? std::min( std::max( ( ( c * x[j] ) - ( b * y[j] ) ) / determinant, 0.0f ), 255.0f ) : 0.0f;
+			o_endpoint1[j] = ( j < i_channelCount ) ? std::min( std::max( ( ( a * y[j] ) - ( b * x[j] ) ) / determinant, 0.0f ), 255.0f ) : 0.0f;
+		}
+		return true;
+	}
+
+	// Format Helpers
+	//---------------
+
+	void CompressColorBlock( const sBlock& i_block, const float* const i_opaqueWeights, const bool i_isThreeColorModeAllowed,
+		const eae6320::Assets::BlockCompression::Quality::eType i_quality, uint8_t* const o_block )
+	{
+		constexpr unsigned int channelCount = 3;
+		// If any pixels are transparent the block must be decoded with 3 colors (and transparent black)
+		const auto isThreeColorMode = i_isThreeColorModeAllowed && ( i_opaqueWeights != nullptr );
+		// The order of the palette entries in the block is the two endpoints followed by the interpolated colors
+		const float interpolationFactors_fourColors[] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		const float interpolationFactors_threeColors[] = { 0.0f, 1.0f, 0.5f, -1.0f };
+		const auto& interpolationFactors = isThreeColorMode ? interpolationFactors_threeColors : interpolationFactors_fourColors;
+
+		const auto Evaluate = [&]( const uint16_t i_color0, const uint16_t i_color1, uint8_t ( &o_indices )[16] )
+		{
+			sPalette palette;
+			palette.entryCount = isThreeColorMode ? 3 : 4;
+			float endpoint0[4], endpoint1[4];
+			ExpandFromRgb565( i_color0, endpoint0 );
+			ExpandFromRgb565( i_color1, endpoint1 );
+			for ( unsigned int i = 0; i < palette.entryCount; ++i )
+			{
+				const auto t = interpolationFactors[i];
+				for ( unsigned int c = 0; c < channelCount; ++c )
+				{
+					palette.entries[i][c] = ( ( 1.0f - t ) * endpoint0[c] ) + ( t * endpoint1[c] );
+				}
+			}
+			return FindClosestPaletteEntries( i_block, channelCount, palette, i_opaqueWeights, o_indices );
+		};
+
+		uint16_t bestColors[2];
+		uint8_t bestIndices[16];
+		float bestError;
+		{
+			float endpoint0[4], endpoint1[4];
+			FindEndpointsAlongPrincipalAxis( i_block, channelCount, i_opaqueWeights, endpoint0, endpoint1 );
+			bestColors[0] = QuantizeToRgb565( endpoint0 );
+			bestColors[1] = QuantizeToRgb565( endpoint1 );
+			bestError = Evaluate( bestColors[0], bestColors[1], bestIndices );
+		}
+		// Refine the endpoints with least squares
+		{
+			const unsigned int iterationCount =
+				( i_quality == eae6320::Assets::BlockCompression::Quality::Fast ) ? 0 : ( ( i_quality == eae6320::Assets::BlockCompression::Quality::Normal ) ? 2 : 4 );
+			for ( unsigned int i = 0; ( i < iterationCount ) && ( bestError > 0.0f ); ++i )
+			{
+				float pixelInterpolationFactors[16];
+				for ( unsigned int j = 0; j < 16; ++j )
+				{
+					const auto isOpaque = !i_opaqueWeights || ( i_opaqueWeights[j] > 0.0f );
+					pixelInterpolationFactors[j] = isOpaque ? interpolationFactors[bestIndices[j]] : -1.0f;
+				}
+				float endpoint0[4], endpoint1[4];
+				if ( !FitEndpointsWithLeastSquares( i_block, channelCount, pixelInterpolationFactors, endpoint0, endpoint1 ) )
+				{
+					break;
+				}
+				const uint16_t colors[] = { QuantizeToRgb565( endpoint0 ), QuantizeToRgb565( endpoint1 ) };
+				uint8_t indices[16];
+				const auto error = Evaluate( colors[0], colors[1], indices );
+				if ( error < bestError )
+				{
+					bestError = error;
+					bestColors[0] = colors[0];
+					bestColors[1] = colors[1];
+					std::memcpy( bestIndices, indices, sizeof( indices ) );
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+		// Search the neighboring quantized endpoints
+		if ( i_quality == eae6320::Assets::BlockCompression::Quality::High )
+		{
+			struct sChannel { unsigned int shift, maxValue; };
+			constexpr sChannel channels[] = { { 11, 31 }, { 5, 63 }, { 0, 31 } };
+			auto wasImproved = true;
+			for ( unsigned int pass = 0; wasImproved && ( pass < 4 ) && ( bestError > 0.0f ); ++pass )
+			{
+				wasImproved = false;
+				for ( unsigned int e = 0; e < 2; ++e )
+				{
+					for ( const auto& channel : channels )
+					{
+						for ( const int delta : { -1, 1 } )
+						{
+							const auto value = static_cast<int>( ( bestColors[e] >> channel.shift ) & channel.maxValue ) + delta;
+							if ( ( value >= 0 ) && ( value <= static_cast<int>( channel.maxValue ) ) )
+							{
+								uint16_t colors[] = { bestColors[0], bestColors[1] };
+								colors[e] = static_cast<uint16_t>( ( colors[e] & ~( channel.maxValue << channel.shift ) ) | ( value << channel.shift ) );
+								uint8_t indices[16];
+								const auto error = Evaluate( colors[0], colors[1], indices );
+								if ( error < bestError )
+								{
+									bestError = error;
+									bestColors[0] = colors[0];
+									bestColors[1] = colors[1];
+									std::memcpy( bestIndices, indices, sizeof( indices ) );
+									wasImproved = true;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		// The order of the endpoints determines how the block is decoded:
+		//	* color0 > color1: 4 colors
+		//	* color0 <= color1: 3 colors and transparent black
+		if ( isThreeColorMode )
+		{
+			for ( unsigned int i = 0; i < 16; ++i )
+			{
+				if ( i_opaqueWeights[i] <= 0.0f )
+				{
+					bestIndices[i] = 3;
+				}
+			}
+			if ( bestColors[0] > bestColors[1] )
+			{
+				std::swap( bestColors[0], bestColors[1] );
+				for ( auto& index : bestIndices )
+				{
+					index = ( index < 2 ) ? ( index ^ 1 ) : index;
+				}
+			}
+		}
+		else
+		{
+			if ( bestColors[0] < bestColors[1] )
+			{
+				std::swap( bestColors[0], bestColors[1] );
+				for ( auto& index : bestIndices )
+				{
+					index ^= 1;
+				}
+			}
+			else if ( bestColors[0] == bestColors[1] )
+			{
+				// This would be decoded with 3 colors, but every pixel uses the first endpoint anyway
+				std::fill( std::begin( bestIndices ), std::end( bestIndices ), static_cast<uint8_t>( 0 ) );
+			}
+		}
+		// Write the block
+		{
+			cBitWriter writer( o_block, 8 );
+			writer.Write( bestColors[0], 16 );
+			writer.Write( bestColors[1], 16 );
+			for ( const auto index : bestIndices )
+			{
+				writer.Write( index, 2 );
+			}
+		}
+	}
+
+	void CompressSingleChannelBlock( const sBlock& i_block, const eae6320::Assets::BlockCompression::Quality::eType i_quality, uint8_t* const o_block )
+	{
+		constexpr unsigned int channelCount = 1;
+		constexpr float* const noWeights = nullptr;
+		// The order of the endpoints determines how the block is decoded:
+		//	* endpoint0 > endpoint1: 8 values
+		//	* endpoint0 <= endpoint1: 6 values, 0, and 255
+		const auto Evaluate = [&]( const int i_endpoint0, const int i_endpoint1, uint8_t ( &o_indices )[16] )
+		{
+			sPalette palette;
+			palette.entryCount = 8;
+			palette.entries[0][0] = static_cast<float>( i_endpoint0 );
+			palette.entries[1][0] = static_cast<float>( i_endpoint1 );
+			if ( i_endpoint0 > i_endpoint1 )
+			{
+				for ( int i = 1; i < 7; ++i )
+				{
+					palette.entries[i + 1][0] = static_cast<float>( ( ( ( 7 - i ) * i_endpoint0 ) + ( i * i_endpoint1 ) ) / 7.0f );
+				}
+			}
+			else
+			{
+				for ( int i = 1; i < 5; ++i )
+				{
+					palette.entries[i + 1][0] = static_cast<float>( ( ( ( 5 - i ) * i_endpoint0 ) + ( i * i_endpoint1 ) ) / 5.0f );
+				}
+				palette.entries[6][0] = 0.0f;
+				palette.entries[7][0] = 255.0f;
+			}
+			return FindClosestPaletteEntries( i_block, channelCount, palette, noWeights, o_indices );
+		};
+
+		int bestEndpoints[2];
+		uint8_t bestIndices[16];
+		float bestError;
+		const auto TryEndpoints = [&]( const int i_endpoint0, const int i_endpoint1 )
+		{
+			if ( ( i_endpoint0 < 0 ) || ( i_endpoint0 > 255 ) || ( i_endpoint1 < 0 ) || ( i_endpoint1 > 255 ) )
+			{
+				return false;
+			}
+			uint8_t indices[16];
+			const auto error = Evaluate( i_endpoint0, i_endpoint1, indices );
+			if ( error < bestError )
+			{
+				bestError = error;
+				bestEndpoints[0] = i_endpoint0;
+				bestEndpoints[1] = i_endpoint1;
+				std::memcpy( bestIndices, indices, sizeof( indices ) );
+				return true;
+			}
+			return false;
+		};
+
+		// Start with the extremes using 8 values
+		auto value_min = 255.0f, value_max = 0.0f;
+		for ( const auto value : i_block.channels[0] )
+		{
+			value_min = std::min( value_min, value );
+			value_max = std::max( value_max, value );
+		}
+		bestEndpoints[0] = static_cast<int>( value_max );
+		bestEndpoints[1] = static_cast<int>( value_min );
+		bestError = Evaluate( bestEndpoints[0], bestEndpoints[1], bestIndices );
+		// Refine the endpoints with least squares
+		if ( i_quality != eae6320::Assets::BlockCompression::Quality::Fast )
+		{
+			const unsigned int iterationCount = ( i_quality == eae6320::Assets::BlockCompression::Quality::Normal ) ? 2 : 4;
+			for ( unsigned int i = 0; ( i < iterationCount ) && ( bestError > 0.0f ) && ( bestEndpoints[0] > bestEndpoints[1] ); ++i )
+			{
+				float interpolationFactors[16];
+				for ( unsigned int j = 0; j < 16; ++j )
+				{
+					const auto index = bestIndices[j];
+					interpolationFactors[j] = ( index == 0 ) ? 0.0f : ( ( index == 1 ) ? 1.0f : ( static_cast<float>( index - 1 ) / 7.0f ) );
+				}
+				float endpoint0[4], endpoint1[4];
+				if ( !FitEndpointsWithLeastSquares( i_block, channelCount, interpolationFactors, endpoint0, endpoint1 ) )
+				{
+					break;
+				}
+				const auto rounded0 = static_cast<int>( std::round( endpoint0[0] ) );
+				const auto rounded1 = static_cast<int>( std::round( endpoint1[0] ) );
+				if ( ( rounded0 <= rounded1 ) || !TryEndpoints( rounded0, rounded1 ) )
+				{
+					break;
+				}
+			}
+		}
+		if ( ( i_quality == eae6320::Assets::BlockCompression::Quality::High ) && ( bestError > 0.0f ) )
+		{
+			// Try 6 values, which can represent 0 and 255 exactly
+			// and so the endpoints only need to cover the other values
+			{
+				auto value_min_inner = 255.0f, value_max_inner = 0.0f;
+				for ( const auto value : i_block.channels[0] )
+				{
+					if ( ( value > 0.0f ) && ( value < 255.0f ) )
+					{
+						value_min_inner = std::min( value_min_inner, value );
+						value_max_inner = std::max( value_max_inner, value );
+					}
+				}
+				if ( value_min_inner <= value_max_inner )
+				{
+					TryEndpoints( static_cast<int>( value_min_inner ), static_cast<int>( value_max_inner ) );
+				}
+			}
+			// Search the neighboring endpoints
+			{
+				const int endpoints[] = { bestEndpoints[0], bestEndpoints[1] };
+				for ( int delta0 = -2; delta0 <= 2; ++delta0 )
+				{
+					for ( int delta1 = -2; delta1 <= 2; ++delta1 )
+					{
+						const auto endpoint0 = endpoints[0] + delta0;
+						const auto endpoint1 = endpoints[1] + delta1;
+						// Changing the endpoints mustn't change which decoding is used
+						if ( ( endpoint0 > endpoint1 ) == ( endpoints[0] > endpoints[1] ) )
+						{
+							TryEndpoints( endpoint0, endpoint1 );
+						}
+					}
+				}
+			}
+		}
+		// Write the block
+		{
+			cBitWriter writer( o_block, 8 );
+			writer.Write( static_cast<uint32_t>( bestEndpoints[0] ), 8 );
+			writer.Write( static_cast<uint32_t>( bestEndpoints[1] ), 8 );
+			for ( const auto index : bestIndices )
+			{
+				writer.Write( index, 3 );
+			}
+		}
+	}
+
+	uint16_t QuantizeToRgb565( const float ( &i_color )[4] )
+	{
+		const auto Quantize = []( const float i_value, const unsigned int i_maxValue )
+		{
+			const auto value = std::round( ( i_value / 255.0f ) * static_cast<float>( i_maxValue ) );
+			return static_cast<unsigned int>( std::min( std::max( value, 0.0f ), static_cast<float>( i_maxValue ) ) );
+		};
+		return static_cast<uint16_t>( ( Quantize( i_color[0], 31 ) << 11 ) | ( Quantize( i_color[1], 63 ) << 5 ) | Quantize( i_color[2], 31 ) );
+	}
+
+	void ExpandFromRgb565( const uint16_t i_color, float ( &o_color )[4] )
+	{
+		// The high bits are replicated into the low bits so that the full range is used
+		const auto r = ( i_color >> 11 ) & 0x1f;
+		const auto g = ( i_color >> 5 ) & 0x3f;
+		const auto b = i_color & 0x1f;
+		o_color[0] = static_cast<float>( ( r << 3 ) | ( r >> 2 ) );
+		o_color[1] = static_cast<float>( ( g << 2 ) | ( g >> 4 ) );
+		o_color[2] = static_cast<float>( ( b << 3 ) | ( b >> 2 ) );
+		o_color[3] = 255.0f;
+	}
+}
@@ -0,0 +1,71 @@
+/*
+	These functions compress images into the block compressed ("BC") formats
+	that graphics hardware can decompress
+
+	The encoders are platform-independent
+	(they don't use DirectXTex or any operating system functionality)
+	and a single image is split across a worker pool one row of blocks at a time.
+*/
+
+#ifndef EAE6320_BLOCKCOMPRESSION_H
+#define EAE6320_BLOCKCOMPRESSION_H
+
+// Include Files
+//==============
+
+#include "ImageProcessing.h"
+
+#include <cstdint>
+#include <Engine/Graphics/TextureFormats.h>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BlockCompression
+		{
+			// Higher quality spends more time refining the endpoints of every block
+			namespace Quality
+			{
+				enum eType
+				{
+					// The endpoints are the extremes of the block's principal axis
+					Fast,
+					// The endpoints are refined with a least squares fit of the chosen palette entries
+					Normal,
+					// The refined endpoints are then perturbed to search for a lower error
+					High,
+				};
+			}
+
+			// Compresses an image into blocks that are stored row by row
+			// (the layout that both Direct3D and OpenGL expect for a single MIP level).
+			// Images whose dimensions aren't multiples of 4 have their edge pixels repeated in partial blocks.
+			// The supported formats are BC1, BC3, BC4 (red), BC5 (red and green), and BC7.
+			cResult CompressImage( const sImage& i_image, const Graphics::TextureFormats::Compression::eType i_format,
+				const Quality::eType i_quality, cWorkerPool& io_workerPool, std::vector<uint8_t>& o_compressedData );
+
+			// Individual Blocks
+			//------------------
+
+			// Pixels are stored in rows from top to bottom, and each row is from left to right
+
+			// Pixels whose alpha is less than 128 are encoded as transparent
+			void CompressBlock_BC1( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[8] );
+			void CompressBlock_BC3( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] );
+			void CompressBlock_BC4( const uint8_t ( &i_values )[16], const Quality::eType i_quality, uint8_t ( &o_block )[8] );
+			void CompressBlock_BC5( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] );
+			// Only BC7 mode 6 is used
+			// (a single subset with RGBA endpoints and 4-bit indices),
+			// which is fast to search and works well for most content
+			void CompressBlock_BC7( const sColor ( &i_pixels )[16], const Quality::eType i_quality, uint8_t ( &o_block )[16] );
+		}
+	}
+}
+
+#endif	// EAE6320_BLOCKCOMPRESSION_H
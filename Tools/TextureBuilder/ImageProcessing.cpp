@@ -0,0 +1,220 @@
+// Include Files
+//==============
+
+#include "ImageProcessing.h"
+
+#include "cWorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	struct sLinearColor
+	{
+		float r, g, b, a;
+	};
+
+	sLinearColor ConvertToLinear( const eae6320::Assets::sColor i_color, const eae6320::Assets::ImageProcessing::Gamma::eType i_gamma );
+	eae6320::Assets::sColor ConvertFromLinear( const sLinearColor& i_color, const eae6320::Assets::ImageProcessing::Gamma::eType i_gamma );
+	uint8_t ConvertToUnorm8( const float i_value );
+}
+
+// Interface
+//==========
+
+bool eae6320::Assets::sImage::IsAlphaAllOpaque() const
+{
+	for ( const auto& pixel : pixels )
+	{
+		if ( pixel.a != 0xff )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void eae6320::Assets::ImageProcessing::FlipVertically( sImage& io_image )
+{
+	// There is nothing to swap in an image with fewer than two rows
+	// (and subtracting one from a height of zero would wrap around)
+	if ( io_image.height < 2 )
+	{
+		return;
+	}
+	for ( unsigned int y_top = 0, y_bottom = io_image.height - 1; y_top < y_bottom; ++y_top, --y_bottom )
+	{
+		std::swap_ranges( &io_image.GetPixel( 0, y_top ), &io_image.GetPixel( 0, y_top ) + io_image.width, &io_image.GetPixel( 0, y_bottom ) );
+	}
+}
+
+void eae6320::Assets::ImageProcessing::Resize( const sImage& i_image, const unsigned int i_width, const unsigned int i_height,
+	const Gamma::eType i_gamma, cWorkerPool& io_workerPool, sImage& o_image )
+{
+	o_image.width = i_width;
+	o_image.height = i_height;
+	o_image.pixels.resize( static_cast<size_t>( i_width ) * i_height );
+
+	const auto scale_x = static_cast<float>( i_image.width ) / static_cast<float>( i_width );
+	const auto scale_y = static_cast<float>( i_image.height ) / static_cast<float>( i_height );
+	io_workerPool.Run( i_height, [&]( const size_t i_begin, const size_t i_end )
+	{
+		for ( auto y = static_cast<unsigned int>( i_begin ); y < i_end; ++y )
+		{
+			// Find the two source rows and how much each contributes
+			const auto v = std::max( ( ( static_cast<float>( y ) + 0.5f ) * scale_y ) - 0.5f, 0.0f );
+			const auto y0 = std::min( static_cast<unsigned int>( v ), i_image.height - 1 );
+			const auto y1 = std::min( y0 + 1, i_image.height - 1 );
+			const auto weight_y1 = v - static_cast<float>( y0 );
+			for ( unsigned int x = 0; x < i_width; ++x )
+			{
+				const auto u = std::max( ( ( static_cast<float>( x ) + 0.5f ) * scale_x ) - 0.5f, 0.0f );
+				const auto x0 = std::min( static_cast<unsigned int>( u ), i_image.width - 1 );
+				const auto x1 = std::min( x0 + 1, i_image.width - 1 );
+				const auto weight_x1 = u - static_cast<float>( x0 );
+
+				const sLinearColor samples[] =
+				{
+					ConvertToLinear( i_image.GetPixel( x0, y0 ), i_gamma ), ConvertToLinear( i_image.GetPixel( x1, y0 ), i_gamma ),
+					ConvertToLinear( i_image.GetPixel( x0, y1 ), i_gamma ), ConvertToLinear( i_image.GetPixel( x1, y1 ), i_gamma ),
+				};
+				const float weights[] =
+				{
+					( 1.0f - weight_x1 ) * ( 1.0f - weight_y1 ), weight_x1 * ( 1.0f - weight_y1 ),
+					( 1.0f - weight_x1 ) * weight_y1, weight_x1 * weight_y1,
+				};
+				sLinearColor filtered{};
+				for ( unsigned int i = 0; i < 4; ++i )
+				{
+					filtered.r += samples[i].r * weights[i];
+					filtered.g += samples[i].g * weights[i];
+					filtered.b += samples[i].b * weights[i];
+					filtered.a += samples[i].a * weights[i];
+				}
+				o_image.GetPixel( x, y ) = ConvertFromLinear( filtered, i_gamma );
+			}
+		}
+	} );
+}
+
+void eae6320::Assets::ImageProcessing::GenerateMipMaps( sImage&& i_image, const Gamma::eType i_gamma, cWorkerPool& io_workerPool, std::vector<sImage>& o_mipMaps )
+{
+	o_mipMaps.clear();
+	o_mipMaps.push_back( std::move( i_image ) );
+	// Each level is generated from the previous one with a 2x2 box filter
+	while ( ( o_mipMaps.back().width > 1 ) || ( o_mipMaps.back().height > 1 ) )
+	{
+		sImage mipMap;
+		{
+			const auto& previousMipMap = o_mipMaps.back();
+			mipMap.width = std::max( previousMipMap.width / 2, 1u );
+			mipMap.height = std::max( previousMipMap.height / 2, 1u );
+			mipMap.pixels.resize( static_cast<size_t>( mipMap.width ) * mipMap.height );
+			io_workerPool.Run( mipMap.height, [&]( const size_t i_begin, const size_t i_end )
+			{
+				for ( auto y = static_cast<unsigned int>( i_begin ); y < i_end; ++y )
+				{
+					// If a dimension is already 1 the same source pixel is used twice
+					const auto y0 = std::min( y * 2, previousMipMap.height - 1 );
+					const auto y1 = std::min( ( y * 2 ) + 1, previousMipMap.height - 1 );
+					for ( unsigned int x = 0; x < mipMap.width; ++x )
+					{
+						const auto x0 = std::min( x * 2, previousMipMap.width - 1 );
+						const auto x1 = std::min( ( x * 2 ) + 1, previousMipMap.width - 1 );
+
+						const sLinearColor samples[] =
+						{
+							ConvertToLinear( previousMipMap.GetPixel( x0, y0 ), i_gamma ), ConvertToLinear( previousMipMap.GetPixel( x1, y0 ), i_gamma ),
+							ConvertToLinear( previousMipMap.GetPixel( x0, y1 ), i_gamma ), ConvertToLinear( previousMipMap.GetPixel( x1, y1 ), i_gamma ),
+						};
+						sLinearColor average{};
+						for ( const auto& sample : samples )
+						{
+							average.r += sample.r * 0.25f;
+							average.g += sample.g * 0.25f;
+							average.b += sample.b * 0.25f;
+							average.a += sample.a * 0.25f;
+						}
+						mipMap.GetPixel( x, y ) = ConvertFromLinear( average, i_gamma );
+					}
+				}
+			} );
+		}
+		o_mipMaps.push_back( std::move( mipMap ) );
+	}
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	sLinearColor ConvertToLinear( const eae6320::Assets::sColor i_color, const eae6320::Assets::ImageProcessing::Gamma::eType i_gamma )
+	{
+		// There are only 256 possible values and so every conversion is calculated once
+		static const auto s_sRgbToLinear = []()
+		{
+			struct { float values[256]; } table;
+			for ( unsigned int i = 0; i < 256; ++i )
+			{
+				const auto value = static_cast<float>( i ) / 255.0f;
+				table.values[i] = ( value <= 0.04045f ) ? ( value / 12.92f ) : std::pow( ( value + 0.055f ) / 1.055f, 2.4f );
+			}
+			return table;
+		}();
+
+		constexpr auto unorm8ToFloat = 1.0f / 255.0f;
+		sLinearColor linearColor;
+		if ( i_gamma == eae6320::Assets::ImageProcessing::Gamma::sRGB )
+		{
+			linearColor.r = s_sRgbToLinear.values[i_color.r];
+			linearColor.g = s_sRgbToLinear.values[i_color.g];
+			linearColor.b = s_sRgbToLinear.values[i_color.b];
+		}
+		else
+		{
+			linearColor.r = static_cast<float>( i_color.r ) * unorm8ToFloat;
+			linearColor.g = static_cast<float>( i_color.g ) * unorm8ToFloat;
+			linearColor.b = static_cast<float>( i_color.b ) * unorm8ToFloat;
+		}
+		// Alpha is never gamma encoded
+		linearColor.a = static_cast<float>( i_color.a ) * unorm8ToFloat;
+		return linearColor;
+	}
+
+	eae6320::Assets::sColor ConvertFromLinear( const sLinearColor& i_color, const eae6320::Assets::ImageProcessing::Gamma::eType i_gamma )
+	{
+		const auto ConvertToSRgb = []( const float i_value )
+		{
+			const auto value = std::min( std::max( i_value, 0.0f ), 1.0f );
+			return ( value <= 0.0031308f ) ? ( value * 12.92f ) : ( ( 1.055f * std::pow( value, 1.0f / 2.4f ) ) - 0.055f );
+		};
+
+		eae6320::Assets::sColor color;
+		if ( i_gamma == eae6320::Assets::ImageProcessing::Gamma::sRGB )
+		{
+			color.r = ConvertToUnorm8( ConvertToSRgb( i_color.r ) );
+			color.g = ConvertToUnorm8( ConvertToSRgb( i_color.g ) );
+			color.b = ConvertToUnorm8( ConvertToSRgb( i_color.b ) );
+		}
+		else
+		{
+			color.r = ConvertToUnorm8( i_color.r );
+			color.g = ConvertToUnorm8( i_color.g );
+			color.b = ConvertToUnorm8( i_color.b );
+		}
+		color.a = ConvertToUnorm8( i_color.a );
+		return color;
+	}
+
+	uint8_t ConvertToUnorm8( const float i_value )
+	{
+		const auto value = std::min( std::max( i_value, 0.0f ), 1.0f );
+		return static_cast<uint8_t>( ( value * 255.0f ) + 0.5f );
+	}
+}
@@ -0,0 +1,79 @@
+/*
+	These functions do the image processing that the TextureBuilder needs
+	before an image can be block compressed
+	(flipping, resizing, and generating MIP maps)
+*/
+
+#ifndef EAE6320_IMAGEPROCESSING_H
+#define EAE6320_IMAGEPROCESSING_H
+
+// Include Files
+//==============
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cWorkerPool;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		struct sColor
+		{
+			uint8_t r, g, b, a;
+		};
+
+		// An uncompressed 8-bit RGBA image with rows stored from top to bottom
+		struct sImage
+		{
+			unsigned int width = 0, height = 0;
+			std::vector<sColor> pixels;
+
+			sColor& GetPixel( const unsigned int i_x, const unsigned int i_y ) { return pixels[( i_y * width ) + i_x]; }
+			const sColor& GetPixel( const unsigned int i_x, const unsigned int i_y ) const { return pixels[( i_y * width ) + i_x]; }
+
+			bool IsAlphaAllOpaque() const;
+		};
+
+		namespace ImageProcessing
+		{
+			// Color channels are stored with sRGB gamma.
+			// If an image is gamma-corrected then color channels are converted to linear space before they are filtered
+			// (which keeps smaller MIP levels from getting darker than the original),
+			// but images that store data (e.g. normal maps) should be filtered as they are.
+			namespace Gamma
+			{
+				enum eType
+				{
+					sRGB,
+					Linear,
+				};
+			}
+
+			void FlipVertically( sImage& io_image );
+
+			// Uses bilinear filtering
+			void Resize( const sImage& i_image, const unsigned int i_width, const unsigned int i_height,
+				const Gamma::eType i_gamma, cWorkerPool& io_workerPool, sImage& o_image );
+
+			// Generates every MIP level down to 1x1.
+			// The first level of the output is the given image.
+			void GenerateMipMaps( sImage&& i_image, const Gamma::eType i_gamma, cWorkerPool& io_workerPool, std::vector<sImage>& o_mipMaps );
+		}
+	}
+}
+
+#endif	// EAE6320_IMAGEPROCESSING_H
@@ -0,0 +1,274 @@
+// Include Files
+//==============
+
+#include "cTextureBuilder.h"
+
+#include "BlockCompression.h"
+#include "cWorkerPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <Engine/Graphics/TextureFormats.h>
+#include <Engine/Math/Functions.h>
+#include <fstream>
+#include <string>
+#include <Tools/AssetBuildLibrary/Functions.h>
+#include <utility>
+
+// Helper Function Declarations
+//=============================
+
+namespace
+{
+	eae6320::cResult WriteTextureToFile( const char* const i_path_target, const std::vector<eae6320::Assets::sImage>& i_mipMaps,
+		const eae6320::Graphics::TextureFormats::Compression::eType i_format, const std::vector<std::vector<uint8_t>>& i_compressedMipMaps );
+}
+
+// Inherited Implementation
+//=========================
+
+// Build
+//------
+
+eae6320::cResult eae6320::Assets::cTextureBuilder::Build( const std::vector<std::string>& i_arguments )
+{
+	auto result = eae6320::Results::Success;
+
+	using namespace Graphics::TextureFormats;
+
+	// Parse the optional arguments
+	auto format = Compression::Unknown;
+	auto quality = BlockCompression::Quality::Normal;
+	auto isGammaSpecified = false;
+	auto gamma = ImageProcessing::Gamma::sRGB;
+	for ( const auto& argument : i_arguments )
+	{
+		std::string argument_lowerCase( argument );
+		std::transform( argument_lowerCase.begin(), argument_lowerCase.end(), argument_lowerCase.begin(),
+			[]( const char i_character ) { return static_cast<char>( std::tolower( static_cast<unsigned char>( i_character ) ) ); } );
+		if ( argument_lowerCase == "bc1" ) format = Compression::BC1;
+		else if ( argument_lowerCase == "bc3" ) format = Compression::BC3;
+		else if ( argument_lowerCase == "bc4" ) format = Compression::BC4;
+		else if ( argument_lowerCase == "bc5" ) format = Compression::BC5;
+		else if ( argument_lowerCase == "bc7" ) format = Compression::BC7;
+		else if ( argument_lowerCase == "fast" ) quality = BlockCompression::Quality::Fast;
+		else if ( argument_lowerCase == "normal" ) quality = BlockCompression::Quality::Normal;
+		else if ( argument_lowerCase == "high" ) quality = BlockCompression::Quality::High;
+		else if ( argument_lowerCase == "linear" ) { gamma = ImageProcessing::Gamma::Linear; isGammaSpecified = true; }
+		else if ( argument_lowerCase == "srgb" ) { gamma = ImageProcessing::Gamma::sRGB; isGammaSpecified = true; }
+		else
+		{
+			OutputErrorMessageWithFileInfo( m_path_source, "\"%s\" isn't a valid texture build argument", argument.c_str() );
+			return Results::Failure;
+		}
+	}
+
+	cWorkerPool workerPool;
+	sImage sourceImage;
+	std::vector<sImage> mipMaps;
+	std::vector<std::vector<uint8_t>> compressedMipMaps;
+
+	// Load the source image
+	BeginProfilingPhase( "parse" );
+	if ( !( result = LoadSourceImage( sourceImage ) ) )
+	{
+		goto OnExit;
+	}
+	// Choose the format
+	{
+		if ( format == Compression::Unknown )
+		{
+			// BC1 (used to be known as "DXT1") if there is no alpha,
+			// and BC3 (used to be known as "DXT5") if there is
+			format = sourceImage.IsAlphaAllOpaque() ? Compression::BC1 : Compression::BC3;
+		}
+		if ( !isGammaSpecified && ( ( format == Compression::BC4 ) || ( format == Compression::BC5 ) ) )
+		{
+			// The single and dual channel formats are usually used for data
+			gamma = ImageProcessing::Gamma::Linear;
+		}
+	}
+	// Generate MIP maps
+	BeginProfilingPhase( "mipmaps" );
+	{
+		// Standard images are upside-down from what OpenGL expects
+#if defined ( EAE6320_PLATFORM_GL )
+		ImageProcessing::FlipVertically( sourceImage );
+#endif
+		// Textures used by the GPU have size restrictions that standard images don't
+		{
+			auto targetWidth = sourceImage.width;
+			auto targetHeight = sourceImage.height;
+			{
+				// Direct3D will only load BC compressed textures whose dimensions are multiples of 4
+				// ("BC" stands for "block compression", and each block is 4x4)
+				{
+					// Round up to the nearest multiple of 4
+					constexpr unsigned int blockSize = 4;
+					targetWidth = Math::RoundUpToMultiple_powerOf2( targetWidth, blockSize );
+					targetHeight = Math::RoundUpToMultiple_powerOf2( targetHeight, blockSize );
+				}
+				// Direct3D can't support textures over a certain size
+				// (this is D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+				{
+					constexpr unsigned int maxDimension = 16384;
+					targetWidth = std::min( targetWidth, maxDimension );
+					targetHeight = std::min( targetHeight, maxDimension );
+				}
+			}
+			if ( ( targetWidth != sourceImage.width ) || ( targetHeight != sourceImage.height ) )
+			{
+				sImage resizedImage;
+				ImageProcessing::Resize( sourceImage, targetWidth, targetHeight, gamma, workerPool, resizedImage );
+				sourceImage = std::move( resizedImage );
+			}
+		}
+		ImageProcessing::GenerateMipMaps( std::move( sourceImage ), gamma, workerPool, mipMaps );
+	}
+	// Compress every MIP map
+	BeginProfilingPhase( "compress" );
+	{
+		compressedMipMaps.resize( mipMaps.size() );
+		for ( size_t i = 0; i < mipMaps.size(); ++i )
+		{
+			if ( !( result = BlockCompression::CompressImage( mipMaps[i], format, quality, workerPool, compressedMipMaps[i] ) ) )
+			{
+				OutputErrorMessageWithFileInfo( m_path_source, "MIP map #%u couldn't be compressed", static_cast<unsigned int>( i ) );
+				goto OnExit;
+			}
+		}
+	}
+	// Write the texture to a file
+	BeginProfilingPhase( "write" );
+	if ( !( result = WriteTextureToFile( m_path_target, mipMaps, format, compressedMipMaps ) ) )
+	{
+		goto OnExit;
+	}
+
+OnExit:
+
+	return result;
+}
+
+// Helper Function Definitions
+//============================
+
+namespace
+{
+	eae6320::cResult WriteTextureToFile( const char* const i_path_target, const std::vector<eae6320::Assets::sImage>& i_mipMaps,
+		const eae6320::Graphics::TextureFormats::Compression::eType i_format, const std::vector<std::vector<uint8_t>>& i_compressedMipMaps )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Open the file
+		std::ofstream fout( i_path_target, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary );
+		if ( !fout.is_open() )
+		{
+			result = eae6320::Results::Failure;
+			eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target, "Target texture file couldn't be opened for writing" );
+			goto OnExit;
+		}
+
+		// Write the texture information
+		eae6320::Graphics::TextureFormats::sTextureInfo textureInfo;
+		{
+			textureInfo.signature = eae6320::Graphics::TextureFormats::s_signature;
+			textureInfo.version = eae6320::Graphics::TextureFormats::s_version;
+			const auto& baseMipMap = i_mipMaps.front();
+			if ( baseMipMap.width < ( 1u << ( sizeof( textureInfo.width ) * 8 ) ) )
+			{
+				textureInfo.width = static_cast<uint16_t>( baseMipMap.width );
+			}
+			else
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+					"The width (%u) is too big for a sTextureInfo", baseMipMap.width );
+				goto OnExit;
+			}
+			if ( baseMipMap.height < ( 1u << ( sizeof( textureInfo.height ) * 8 ) ) )
+			{
+				textureInfo.height = static_cast<uint16_t>( baseMipMap.height );
+			}
+			else
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+					"The height (%u) is too big for a sTextureInfo", baseMipMap.height );
+				goto OnExit;
+			}
+			if ( i_mipMaps.size() < ( 1u << ( sizeof( textureInfo.mipMapCount ) * 8 ) ) )
+			{
+				textureInfo.mipMapCount = static_cast<uint8_t>( i_mipMaps.size() );
+			}
+			else
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+					"There are too many MIP levels (%u) for a sTextureInfo", static_cast<unsigned int>( i_mipMaps.size() ) );
+				goto OnExit;
+			}
+			textureInfo.compressionType = i_format;
+		}
+		{
+			const auto byteCountToWrite = sizeof( textureInfo );
+			fout.write( reinterpret_cast<const char*>( &textureInfo ), byteCountToWrite );
+			if ( !fout.good() )
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+					"Failed to write %u bytes for the texture information", byteCountToWrite );
+				goto OnExit;
+			}
+		}
+		// Write the data for each MIP map
+		// (from smallest to largest, so that the run-time can read the smallest ones without reading the rest)
+		{
+			const auto mipMapCount = static_cast<uint_fast8_t>( textureInfo.mipMapCount );
+			for ( auto i = mipMapCount; i > 0; --i )
+			{
+				const auto mipLevel = static_cast<uint_fast8_t>( i - 1 );
+				const auto& currentMipMap = i_compressedMipMaps[mipLevel];
+				// Calculate how much memory this MIP level uses
+				const auto byteCount_currentMipLevel = eae6320::Graphics::TextureFormats::GetSizeOfMipMap( textureInfo, mipLevel );
+				if ( byteCount_currentMipLevel != currentMipMap.size() )
+				{
+					result = eae6320::Results::Failure;
+					eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+						"Unexpected mismatch between calculated byte count for MIP map #%u (%u) and compressed byte count (%u)",
+						mipLevel, static_cast<unsigned int>( byteCount_currentMipLevel ), static_cast<unsigned int>( currentMipMap.size() ) );
+					goto OnExit;
+				}
+				// Write this MIP map
+				{
+					fout.write( reinterpret_cast<const char*>( currentMipMap.data() ), byteCount_currentMipLevel );
+					if ( !fout.good() )
+					{
+						result = eae6320::Results::Failure;
+						eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+							"Failed to write %u bytes for MIP map #%u", static_cast<unsigned int>( byteCount_currentMipLevel ), mipLevel );
+						goto OnExit;
+					}
+				}
+			}
+		}
+
+	OnExit:
+
+		if ( fout.is_open() )
+		{
+			fout.close();
+			if ( fout.is_open() )
+			{
+				if ( result )
+				{
+					result = eae6320::Results::Failure;
+				}
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_target,
+					"Failed to close the target texture file after writing" );
+			}
+		}
+
+		return result;
+	}
+}
@@ -10,6 +10,8 @@
 
 #include <Tools/AssetBuildLibrary/cbBuilder.h>
 
+#include "ImageProcessing.h"
+
 // Class Declaration
 //==================
 
@@ -27,7 +29,21 @@ namespace eae6320
 			// Build
 			//------
 
+			// The optional arguments can be any of the following (in any order):
+			//	* A format: "BC1", "BC3", "BC4", "BC5", or "BC7"
+			//		(the default is BC1 for opaque images and BC3 for images with alpha)
+			//	* A quality: "fast", "normal" (the default), or "high"
+			//	* "linear" if the image stores data rather than colors (e.g. a normal map),
+			//		or "sRGB" if it stores colors (which is the default except for BC4 and BC5)
 			virtual cResult Build( const std::vector<std::string>& i_arguments ) override;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Loading the source image is the only platform-specific part of building a texture
+			cResult LoadSourceImage( sImage& o_image ) const;
 		};
 	}
 }
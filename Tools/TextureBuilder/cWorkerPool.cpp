@@ -0,0 +1,122 @@
+// Include Files
+//==============
+
+#include "cWorkerPool.h"
+
+#include <algorithm>
+
+// Interface
+//==========
+
+// Run
+//----
+
+void eae6320::Assets::cWorkerPool::Run( const size_t i_workItemCount, const fWork& i_function )
+{
+	if ( i_workItemCount == 0 )
+	{
+		return;
+	}
+	// Small chunks balance the load better (rows near the bottom of an image may be cheaper than rows at the top)
+	// but every chunk costs an atomic increment,
+	// and so each thread gets several chunks
+	{
+		constexpr size_t chunkCountPerThread = 8;
+		const auto chunkCount = static_cast<size_t>( GetThreadCount() ) * chunkCountPerThread;
+		m_workItemCountPerChunk = std::max<size_t>( 1, i_workItemCount / chunkCount );
+	}
+	if ( m_threads.empty() || ( i_workItemCount <= m_workItemCountPerChunk ) )
+	{
+		i_function( 0, i_workItemCount );
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_function = &i_function;
+		m_workItemCount = i_workItemCount;
+		m_nextWorkItem = 0;
+		m_busyThreadCount = static_cast<unsigned int>( m_threads.size() );
+		++m_jobIndex;
+	}
+	m_whenWorkIsAvailable.notify_all();
+	DoWork();
+	{
+		std::unique_lock<std::mutex> lock( m_mutex );
+		m_whenWorkIsCompleted.wait( lock, [this]() { return m_busyThreadCount == 0; } );
+		m_function = nullptr;
+	}
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Assets::cWorkerPool::cWorkerPool( const unsigned int i_threadCount )
+{
+	auto threadCount = i_threadCount;
+	if ( threadCount == 0 )
+	{
+		threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+	}
+	// The calling thread is one of the threads doing work
+	for ( unsigned int i = 1; i < threadCount; ++i )
+	{
+		m_threads.emplace_back( &cWorkerPool::WorkerThreadFunction, this );
+	}
+}
+
+eae6320::Assets::cWorkerPool::~cWorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_shouldThreadsExit = true;
+	}
+	m_whenWorkIsAvailable.notify_all();
+	for ( auto& thread : m_threads )
+	{
+		thread.join();
+	}
+}
+
+// Implementation
+//===============
+
+void eae6320::Assets::cWorkerPool::DoWork()
+{
+	while ( true )
+	{
+		const auto begin = m_nextWorkItem.fetch_add( m_workItemCountPerChunk );
+		if ( begin >= m_workItemCount )
+		{
+			break;
+		}
+		const auto end = std::min( begin + m_workItemCountPerChunk, m_workItemCount );
+		( *m_function )( begin, end );
+	}
+}
+
+void eae6320::Assets::cWorkerPool::WorkerThreadFunction()
+{
+	uint64_t lastJobIndex = 0;
+	while ( true )
+	{
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+			m_whenWorkIsAvailable.wait( lock, [this, lastJobIndex]() { return m_shouldThreadsExit || ( m_jobIndex != lastJobIndex ); } );
+			if ( m_shouldThreadsExit )
+			{
+				return;
+			}
+			lastJobIndex = m_jobIndex;
+		}
+		DoWork();
+		bool wasThisTheLastThread;
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			wasThisTheLastThread = ( --m_busyThreadCount == 0 );
+		}
+		if ( wasThisTheLastThread )
+		{
+			m_whenWorkIsCompleted.notify_one();
+		}
+	}
+}
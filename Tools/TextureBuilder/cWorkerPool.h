@@ -0,0 +1,96 @@
+/*
+	A worker pool splits a range of independent work items
+	(e.g. rows of 4x4 blocks) across a fixed set of threads
+
+	This is intentionally built on the standard library
+	so that the TextureBuilder doesn't depend on any platform-specific code
+	other than loading source images.
+*/
+
+#ifndef EAE6320_CWORKERPOOL_H
+#define EAE6320_CWORKERPOOL_H
+
+// Include Files
+//==============
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cWorkerPool
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The function is called with a [begin, end) range of work item indices
+			using fWork = std::function<void( const size_t i_begin, const size_t i_end )>;
+
+			// Run
+			//----
+
+			// Calls the function for every work item and returns once they have all been completed.
+			// The calling thread works on items too,
+			// and so a pool with no worker threads runs everything on the calling thread.
+			void Run( const size_t i_workItemCount, const fWork& i_function );
+
+			// Access
+			//-------
+
+			unsigned int GetThreadCount() const { return static_cast<unsigned int>( m_threads.size() ) + 1; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// A thread count of zero uses every hardware thread
+			explicit cWorkerPool( const unsigned int i_threadCount = 0 );
+			~cWorkerPool();
+
+			cWorkerPool( const cWorkerPool& ) = delete;
+			cWorkerPool& operator =( const cWorkerPool& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<std::thread> m_threads;
+			std::mutex m_mutex;
+			std::condition_variable m_whenWorkIsAvailable;
+			std::condition_variable m_whenWorkIsCompleted;
+
+			// The current job
+			const fWork* m_function = nullptr;
+			size_t m_workItemCount = 0;
+			size_t m_workItemCountPerChunk = 1;
+			std::atomic<size_t> m_nextWorkItem{ 0 };
+			// The job index changes every time Run() is called so that workers can tell new work from old
+			uint64_t m_jobIndex = 0;
+			unsigned int m_busyThreadCount = 0;
+			bool m_shouldThreadsExit = false;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void DoWork();
+			void WorkerThreadFunction();
+		};
+	}
+}
+
+#endif	// EAE6320_CWORKERPOOL_H